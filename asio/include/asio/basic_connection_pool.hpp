@@ -0,0 +1,235 @@
+//
+// basic_connection_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_BASIC_CONNECTION_POOL_HPP
+#define ASIO_BASIC_CONNECTION_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if (defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/basic_stream_socket.hpp"
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error.hpp"
+#include "asio/execution_context.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Keeps connected stream sockets for reuse.
+/**
+ * The basic_connection_pool class template holds connections to remote
+ * endpoints between uses, so that a client making a series of requests to the
+ * same endpoint can avoid the latency of establishing a new connection for
+ * each one.
+ *
+ * A connection is checked out by calling async_acquire(), which moves an idle
+ * connection to the requested endpoint into the caller's socket or, if there
+ * is none, connects the socket. Before an idle connection is handed out it is
+ * checked for having been closed by the peer, or for having unexpected data
+ * waiting to be read, and such connections are discarded. When the caller has
+ * finished with the connection it returns it by calling release(). If the
+ * socket is still open, the connection becomes idle and available for reuse.
+ *
+ * The number of connections to each endpoint, whether idle, in use or being
+ * established, is limited by max_connections_per_endpoint(). Once the limit is
+ * reached, async_acquire() waits until a connection to that endpoint is
+ * released. Idle connections are closed once they have been idle for longer
+ * than idle_timeout(). A single timer is shared by all endpoints for this
+ * purpose.
+ *
+ * The pool's internal operations are performed using its executor. The sockets
+ * passed to the pool should use the same execution context.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe. If the pool's execution context is run from
+ * more than one thread, the pool's executor must be a strand, and the pool must
+ * only be used from within that strand.
+ *
+ * @par Example
+ * @code
+ * asio::basic_connection_pool<asio::ip::tcp> pool(my_context);
+ * asio::ip::tcp::socket socket(my_context);
+ * ...
+ * pool.async_acquire(endpoint, socket,
+ *     [&](std::error_code ec)
+ *     {
+ *       if (!ec)
+ *       {
+ *         // Make a request using socket, and then:
+ *         pool.release(endpoint, socket);
+ *       }
+ *     });
+ * @endcode
+ */
+template <typename Protocol, typename Executor = executor>
+class basic_connection_pool
+  : private noncopyable
+{
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// The protocol type.
+  typedef Protocol protocol_type;
+
+  /// The endpoint type.
+  typedef typename Protocol::endpoint endpoint_type;
+
+  /// The type of the sockets held by the pool.
+  typedef basic_stream_socket<Protocol, Executor> socket_type;
+
+  /// The duration type used for the idle timeout.
+  typedef chrono::steady_clock::duration duration;
+
+  /// Construct a pool that uses the specified executor.
+  /**
+   * The pool allows at most 8 connections to each endpoint, and closes
+   * connections that have been idle for 30 seconds.
+   */
+  explicit basic_connection_pool(const executor_type& ex);
+
+  /// Construct a pool that uses the specified execution context.
+  /**
+   * The pool allows at most 8 connections to each endpoint, and closes
+   * connections that have been idle for 30 seconds.
+   */
+  template <typename ExecutionContext>
+  explicit basic_connection_pool(ExecutionContext& context,
+      typename enable_if<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      >::type* = 0);
+
+  /// Destructor.
+  /**
+   * Closes all idle connections. Any async_acquire() operations that are
+   * waiting for a connection complete with the
+   * asio::error::operation_aborted error. Connections that are in use
+   * are not affected.
+   */
+  ~basic_connection_pool();
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() ASIO_NOEXCEPT;
+
+  /// Get the maximum number of connections to each endpoint.
+  std::size_t max_connections_per_endpoint() const ASIO_NOEXCEPT;
+
+  /// Set the maximum number of connections to each endpoint.
+  /**
+   * The limit applies to new connections. Existing connections are not closed
+   * if they exceed it.
+   */
+  void max_connections_per_endpoint(std::size_t n);
+
+  /// Get the time after which idle connections are closed.
+  duration idle_timeout() const ASIO_NOEXCEPT;
+
+  /// Set the time after which idle connections are closed.
+  /**
+   * The new value applies to connections as they are checked for eviction.
+   */
+  void idle_timeout(const duration& d);
+
+  /// Get the number of idle connections held by the pool.
+  std::size_t idle_connections() const ASIO_NOEXCEPT;
+
+  /// Start an asynchronous operation to obtain a connection to an endpoint.
+  /**
+   * This function is used to asynchronously obtain a connection to the
+   * specified endpoint. The function call always returns immediately.
+   *
+   * If the pool holds an idle connection to the endpoint, the most recently
+   * used one that passes the health check is moved into @c socket. Otherwise,
+   * if the limit on connections to the endpoint has not been reached, @c
+   * socket is connected to the endpoint. Otherwise the operation waits until a
+   * connection to the endpoint is released.
+   *
+   * @param endpoint The remote endpoint to which a connection is required.
+   *
+   * @param socket The socket into which the connection is placed. Any
+   * connection it already holds is closed. Ownership of the socket is retained
+   * by the caller, which must guarantee that it remains valid until the
+   * handler is called.
+   *
+   * @param handler The handler to be called when the operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note If the operation succeeds, the caller must return the connection by
+   * passing the socket to release(), even if the socket has since been closed.
+   * If the operation fails, no connection is held and release() must not be
+   * called.
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code))
+        AcquireHandler ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(AcquireHandler,
+      void (asio::error_code))
+  async_acquire(const endpoint_type& endpoint, socket_type& socket,
+      ASIO_MOVE_ARG(AcquireHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type));
+
+  /// Return a connection to the pool.
+  /**
+   * This function is used to return a connection that was obtained using
+   * async_acquire(). If the socket is open, the connection is handed to an
+   * operation that is waiting for a connection to the same endpoint, or else
+   * held as an idle connection. If the socket is closed, the connection no
+   * longer counts towards the limit for the endpoint.
+   *
+   * Callers should close the socket before releasing it if the connection is
+   * not in a state in which it can be reused, such as after an error or when
+   * a response has not been read in full.
+   *
+   * @param endpoint The endpoint that was passed to async_acquire().
+   *
+   * @param socket The socket that was passed to async_acquire(). On return,
+   * the socket is closed.
+   */
+  void release(const endpoint_type& endpoint, socket_type& socket);
+
+private:
+  class state;
+  class initiate_async_acquire;
+
+  // The state shared with the pool's outstanding internal operations.
+  detail::shared_ptr<state> state_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/basic_connection_pool.hpp"
+
+#endif // (defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO))
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_BASIC_CONNECTION_POOL_HPP
@@ -23,6 +23,7 @@
 #include "asio/detail/throw_error.hpp"
 #include "asio/detail/type_traits.hpp"
 #include "asio/error.hpp"
+#include "asio/receive_metadata.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -692,6 +693,243 @@ public:
         initiate_async_send_to(this), handler, buffers, destination, flags);
   }
 
+#if defined(ASIO_HAS_MMSG) || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send several datagrams using a
+   * single system call. Each buffer in the buffer sequence is sent as a
+   * separate datagram, to the endpoint at the corresponding position in the
+   * @c destinations array. The function call always returns immediately.
+   *
+   * The operation completes as soon as at least one datagram has been sent, or
+   * an error occurs. At most 64 datagrams are sent by one operation. Any
+   * datagrams that were not sent may be passed to a subsequent operation.
+   *
+   * @param buffers A buffer sequence in which each buffer contains one
+   * datagram. Although the buffers object may be copied as necessary,
+   * ownership of the underlying memory blocks is retained by the caller, which
+   * must guarantee that they remain valid until the handler is called.
+   *
+   * @param destinations An array of remote endpoints, with one element for
+   * each buffer in @c buffers. Ownership of the array is retained by the
+   * caller, which must guarantee that it is valid until the handler is called.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t messages_transferred        // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Example
+   * @code
+   * std::vector<asio::const_buffer> buffers;
+   * buffers.push_back(asio::buffer(data1, size1));
+   * buffers.push_back(asio::buffer(data2, size2));
+   * asio::ip::udp::endpoint destinations[2] = { endpoint1, endpoint2 };
+   * socket.async_send_to_batch(buffers, destinations, handler);
+   * @endcode
+   *
+   * @note This function is only available on Linux, where it is implemented
+   * using @c sendmmsg().
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_to_batch(const ConstBufferSequence& buffers,
+      const endpoint_type* destinations,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_to_batch(this), handler, buffers,
+        destinations, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send several datagrams using a
+   * single system call. Each buffer in the buffer sequence is sent as a
+   * separate datagram, to the endpoint at the corresponding position in the
+   * @c destinations array. The function call always returns immediately.
+   *
+   * The operation completes as soon as at least one datagram has been sent, or
+   * an error occurs. At most 64 datagrams are sent by one operation. Any
+   * datagrams that were not sent may be passed to a subsequent operation.
+   *
+   * @param buffers A buffer sequence in which each buffer contains one
+   * datagram. Although the buffers object may be copied as necessary,
+   * ownership of the underlying memory blocks is retained by the caller, which
+   * must guarantee that they remain valid until the handler is called.
+   *
+   * @param destinations An array of remote endpoints, with one element for
+   * each buffer in @c buffers. Ownership of the array is retained by the
+   * caller, which must guarantee that it is valid until the handler is called.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t messages_transferred        // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note This function is only available on Linux, where it is implemented
+   * using @c sendmmsg().
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_to_batch(const ConstBufferSequence& buffers,
+      const endpoint_type* destinations, socket_base::message_flags flags,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_to_batch(this), handler,
+        buffers, destinations, flags);
+  }
+#endif // defined(ASIO_HAS_MMSG) || defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_UDP_GSO) || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous send of data split into datagrams of equal size.
+  /**
+   * This function is used to asynchronously send a sequence of datagrams to
+   * the specified remote endpoint using a single system call. The data is
+   * split by the kernel into datagrams of @c segment_size bytes, except for
+   * the last datagram which may be shorter. The function call always returns
+   * immediately.
+   *
+   * @param buffers The data to be sent. The total size must not exceed the
+   * maximum size of a single UDP datagram, and the number of segments must not
+   * exceed 64. Although the buffers object may be copied as necessary,
+   * ownership of the underlying memory blocks is retained by the caller, which
+   * must guarantee that they remain valid until the handler is called.
+   *
+   * @param destination The remote endpoint to which the data will be sent.
+   * Copies will be made of the endpoint as required.
+   *
+   * @param segment_size The size of each datagram. This must be between 1 and
+   * 65535 bytes, otherwise the operation fails with
+   * asio::error::invalid_argument.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Example
+   * To send 64 datagrams of 1200 bytes each:
+   * @code
+   * socket.async_send_to_segmented(
+   *     asio::buffer(data, 64 * 1200), destination, 1200, handler);
+   * @endcode
+   *
+   * @note This function is only available on Linux, where it is implemented
+   * using the @c UDP_SEGMENT control message.
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_to_segmented(const ConstBufferSequence& buffers,
+      const endpoint_type& destination,
+      std::size_t segment_size,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_to_segmented(this), handler,
+        buffers, destination, segment_size,
+        socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous send of data split into datagrams of equal size.
+  /**
+   * This function is used to asynchronously send a sequence of datagrams to
+   * the specified remote endpoint using a single system call. The data is
+   * split by the kernel into datagrams of @c segment_size bytes, except for
+   * the last datagram which may be shorter. The function call always returns
+   * immediately.
+   *
+   * @param buffers The data to be sent. The total size must not exceed the
+   * maximum size of a single UDP datagram, and the number of segments must not
+   * exceed 64. Although the buffers object may be copied as necessary,
+   * ownership of the underlying memory blocks is retained by the caller, which
+   * must guarantee that they remain valid until the handler is called.
+   *
+   * @param destination The remote endpoint to which the data will be sent.
+   * Copies will be made of the endpoint as required.
+   *
+   * @param segment_size The size of each datagram. This must be between 1 and
+   * 65535 bytes, otherwise the operation fails with
+   * asio::error::invalid_argument.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note This function is only available on Linux, where it is implemented
+   * using the @c UDP_SEGMENT control message.
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_to_segmented(const ConstBufferSequence& buffers,
+      const endpoint_type& destination,
+      std::size_t segment_size, socket_base::message_flags flags,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_to_segmented(this), handler,
+        buffers, destination, segment_size, flags);
+  }
+#endif // defined(ASIO_HAS_UDP_GSO) || defined(GENERATING_DOCUMENTATION)
+
   /// Receive some data on a connected socket.
   /**
    * This function is used to receive data on the datagram socket. The function
@@ -877,6 +1115,60 @@ public:
         initiate_async_receive(this), handler, buffers, flags);
   }
 
+#if defined(ASIO_HAS_MULTISHOT_RECEIVE) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous operation to receive datagrams continuously.
+  /**
+   * This function is used to asynchronously receive datagrams on a connected
+   * socket until the operation fails or is stopped. The function call always
+   * returns immediately.
+   *
+   * A single operation remains outstanding on the socket. Each time a
+   * datagram is received into the buffers, the handler is invoked, after which
+   * the operation receives again without needing to be restarted. While
+   * datagrams remain queued, subsequent receives are made directly, up to an
+   * implementation-defined limit, rather than by waiting for the socket to
+   * become ready.
+   *
+   * @param buffers One or more buffers into which the datagrams will be
+   * received. The same buffers are used for every datagram, so the handler
+   * must consume the data before it returns. Although the buffers object may
+   * be copied as necessary, ownership of the underlying memory blocks is
+   * retained by the caller, which must guarantee that they remain valid until
+   * the operation completes.
+   *
+   * @param handler The handler to be called for each datagram, and once more
+   * when the operation completes. A copy of the handler is made for each
+   * datagram, so the handler must be CopyConstructible. The function signature
+   * of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes received.
+   * ); @endcode
+   * The handler is invoked without error once for each datagram. The
+   * operation completes when the handler is invoked with an error, after which
+   * no further invocations are made. Calling cancel(), close() or the
+   * destructor, or moving the socket into a socket of another protocol type,
+   * stops the operation, which then completes with the
+   * asio::error::operation_aborted error. The handler will not be invoked from
+   * within this function.
+   *
+   * @note Since the handler may be invoked more than once, this function does
+   * not support completion tokens such as asio::use_future.
+   *
+   * @note The async_multishot_receive operation can only be used with a
+   * connected socket.
+   */
+  template <typename MutableBufferSequence, typename MultishotReadHandler>
+  void async_multishot_receive(const MutableBufferSequence& buffers,
+      ASIO_MOVE_ARG(MultishotReadHandler) handler)
+  {
+    initiate_async_multishot_receive(this)(
+        ASIO_MOVE_CAST(MultishotReadHandler)(handler), buffers, 0);
+  }
+#endif // defined(ASIO_HAS_MULTISHOT_RECEIVE)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Receive a datagram with the endpoint of the sender.
   /**
    * This function is used to receive a datagram. The function call will block
@@ -1065,60 +1357,566 @@ public:
         buffers, &sender_endpoint, flags);
   }
 
-private:
-  class initiate_async_send
-  { 
-  public:
-    typedef Executor executor_type;
-
-    explicit initiate_async_send(basic_datagram_socket* self)
-      : self_(self)
-    {
-    }
-
-    executor_type get_executor() const ASIO_NOEXCEPT
-    {
-      return self_->get_executor();
-    }
-
-    template <typename WriteHandler, typename ConstBufferSequence>
-    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
-        const ConstBufferSequence& buffers,
-        socket_base::message_flags flags) const
-    {
-      // If you get an error on the following line it means that your handler
-      // does not meet the documented type requirements for a WriteHandler.
-      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
-
-      detail::non_const_lvalue<WriteHandler> handler2(handler);
-      self_->impl_.get_service().async_send(
-          self_->impl_.get_implementation(), buffers, flags,
-          handler2.value, self_->impl_.get_implementation_executor());
-    }
-
-  private:
-    basic_datagram_socket* self_;
-  };
-
-  class initiate_async_send_to
+#if defined(ASIO_HAS_MMSG) || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive several datagrams using a
+   * single system call. Each buffer in the buffer sequence receives a separate
+   * datagram. The function call always returns immediately.
+   *
+   * The operation completes as soon as at least one datagram has been
+   * received, or an error occurs. It then receives as many of the datagrams
+   * already queued on the socket as there are buffers, up to a maximum of 64.
+   *
+   * @param buffers A buffer sequence in which each buffer receives one
+   * datagram. Although the buffers object may be copied as necessary,
+   * ownership of the underlying memory blocks is retained by the caller, which
+   * must guarantee that they remain valid until the handler is called.
+   *
+   * @param sender_endpoints An array with one element for each buffer in
+   * @c buffers. On completion, the first @c messages_transferred elements
+   * contain the endpoints of the senders of the received datagrams. Ownership
+   * of the array is retained by the caller, which must guarantee that it is
+   * valid until the handler is called.
+   *
+   * @param sizes An array with one element for each buffer in @c buffers. On
+   * completion, the first @c messages_transferred elements contain the number
+   * of bytes in each received datagram. Ownership of the array is retained by
+   * the caller, which must guarantee that it is valid until the handler is
+   * called.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t messages_transferred        // Number of datagrams received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Example
+   * @code
+   * std::vector<asio::mutable_buffer> buffers;
+   * buffers.push_back(asio::buffer(data1, size1));
+   * buffers.push_back(asio::buffer(data2, size2));
+   * asio::ip::udp::endpoint senders[2];
+   * std::size_t sizes[2];
+   * socket.async_receive_from_batch(buffers, senders, sizes, handler);
+   * @endcode
+   *
+   * @note This function is only available on Linux, where it is implemented
+   * using @c recvmmsg().
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_from_batch(const MutableBufferSequence& buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
   {
-  public:
-    typedef Executor executor_type;
-
-    explicit initiate_async_send_to(basic_datagram_socket* self)
-      : self_(self)
-    {
-    }
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_from_batch(this), handler, buffers,
+        sender_endpoints, sizes, socket_base::message_flags(0));
+  }
 
-    executor_type get_executor() const ASIO_NOEXCEPT
-    {
-      return self_->get_executor();
-    }
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive several datagrams using a
+   * single system call. Each buffer in the buffer sequence receives a separate
+   * datagram. The function call always returns immediately.
+   *
+   * The operation completes as soon as at least one datagram has been
+   * received, or an error occurs. It then receives as many of the datagrams
+   * already queued on the socket as there are buffers, up to a maximum of 64.
+   *
+   * @param buffers A buffer sequence in which each buffer receives one
+   * datagram. Although the buffers object may be copied as necessary,
+   * ownership of the underlying memory blocks is retained by the caller, which
+   * must guarantee that they remain valid until the handler is called.
+   *
+   * @param sender_endpoints An array with one element for each buffer in
+   * @c buffers. On completion, the first @c messages_transferred elements
+   * contain the endpoints of the senders of the received datagrams. Ownership
+   * of the array is retained by the caller, which must guarantee that it is
+   * valid until the handler is called.
+   *
+   * @param sizes An array with one element for each buffer in @c buffers. On
+   * completion, the first @c messages_transferred elements contain the number
+   * of bytes in each received datagram. Ownership of the array is retained by
+   * the caller, which must guarantee that it is valid until the handler is
+   * called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t messages_transferred        // Number of datagrams received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note This function is only available on Linux, where it is implemented
+   * using @c recvmmsg().
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_from_batch(const MutableBufferSequence& buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_from_batch(this), handler, buffers,
+        sender_endpoints, sizes, flags);
+  }
+#endif // defined(ASIO_HAS_MMSG) || defined(GENERATING_DOCUMENTATION)
 
-    template <typename WriteHandler, typename ConstBufferSequence>
-    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
-        const ConstBufferSequence& buffers, const endpoint_type& destination,
-        socket_base::message_flags flags) const
+#if defined(ASIO_HAS_UDP_GSO) || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous receive of one or more coalesced datagrams.
+  /**
+   * This function is used to asynchronously receive datagrams on a socket for
+   * which the ip::udp::gro option has been enabled. The kernel may coalesce
+   * consecutive datagrams of equal size from the same sender, and deliver
+   * them as a single unit. The function call always returns immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * The buffers should be large enough to hold the largest possible UDP
+   * datagram. Although the buffers object may be copied as necessary,
+   * ownership of the underlying memory blocks is retained by the caller, which
+   * must guarantee that they remain valid until the handler is called.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams. Ownership of the sender_endpoint
+   * object is retained by the caller, which must guarantee that it is valid
+   * until the handler is called.
+   *
+   * @param segment_size Receives the size of each of the received datagrams,
+   * except for the last which may be shorter. If the datagrams were not
+   * coalesced, this is equal to the number of bytes received. Ownership of
+   * the object is retained by the caller, which must guarantee that it is
+   * valid until the handler is called.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Example
+   * @code
+   * socket.set_option(asio::ip::udp::gro(true));
+   * ...
+   * socket.async_receive_from_coalesced(
+   *     asio::buffer(data, 65536), sender_endpoint, segment_size, handler);
+   * ...
+   * void handler(const asio::error_code& error, std::size_t length)
+   * {
+   *   for (std::size_t offset = 0; offset < length; offset += segment_size)
+   *   {
+   *     std::size_t n = std::min(segment_size, length - offset);
+   *     process_datagram(data + offset, n);
+   *   }
+   * }
+   * @endcode
+   *
+   * @note This function is only available on Linux, where it is implemented
+   * using the @c UDP_GRO control message.
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_from_coalesced(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint,
+      std::size_t& segment_size,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_from_coalesced(this), handler,
+        buffers, &sender_endpoint, &segment_size,
+        socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous receive of one or more coalesced datagrams.
+  /**
+   * This function is used to asynchronously receive datagrams on a socket for
+   * which the ip::udp::gro option has been enabled. The kernel may coalesce
+   * consecutive datagrams of equal size from the same sender, and deliver
+   * them as a single unit. The function call always returns immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * The buffers should be large enough to hold the largest possible UDP
+   * datagram. Although the buffers object may be copied as necessary,
+   * ownership of the underlying memory blocks is retained by the caller, which
+   * must guarantee that they remain valid until the handler is called.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams. Ownership of the sender_endpoint
+   * object is retained by the caller, which must guarantee that it is valid
+   * until the handler is called.
+   *
+   * @param segment_size Receives the size of each of the received datagrams,
+   * except for the last which may be shorter. If the datagrams were not
+   * coalesced, this is equal to the number of bytes received. Ownership of
+   * the object is retained by the caller, which must guarantee that it is
+   * valid until the handler is called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note This function is only available on Linux, where it is implemented
+   * using the @c UDP_GRO control message.
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_from_coalesced(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint,
+      std::size_t& segment_size, socket_base::message_flags flags,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_from_coalesced(this), handler,
+        buffers, &sender_endpoint, &segment_size, flags);
+  }
+#endif // defined(ASIO_HAS_UDP_GSO) || defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_RECEIVE_METADATA) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous receive that also obtains the message metadata.
+  /**
+   * This function is used to asynchronously receive data from the datagram
+   * socket, together with the ancillary data that the kernel reports for it,
+   * such as receive timestamps and the destination address. The function call
+   * always returns immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param metadata A receive_metadata object that is filled in with the
+   * ancillary data when the operation completes. Ownership of the metadata
+   * object is retained by the caller, which must guarantee that it is valid
+   * until the handler is called.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Example
+   * @code
+   * socket.set_option(asio::socket_base::timestamp(true));
+   * ...
+   * socket.async_receive_with_metadata(
+   *     asio::buffer(data, size), metadata, handler);
+   * @endcode
+   *
+   * @note The async_receive_with_metadata operation can only be used with a
+   * connected socket. Use the async_receive_from_with_metadata function to
+   * receive data on an unconnected datagram socket.
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_with_metadata(const MutableBufferSequence& buffers,
+      receive_metadata& metadata,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_with_metadata(this), handler, buffers,
+        static_cast<endpoint_type*>(0), &metadata,
+        socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous receive that also obtains the message metadata.
+  /**
+   * This function is used to asynchronously receive data from the datagram
+   * socket, together with the ancillary data that the kernel reports for it,
+   * such as receive timestamps and the destination address. The function call
+   * always returns immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param metadata A receive_metadata object that is filled in with the
+   * ancillary data when the operation completes. Ownership of the metadata
+   * object is retained by the caller, which must guarantee that it is valid
+   * until the handler is called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note The async_receive_with_metadata operation can only be used with a
+   * connected socket. Use the async_receive_from_with_metadata function to
+   * receive data on an unconnected datagram socket.
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_with_metadata(const MutableBufferSequence& buffers,
+      receive_metadata& metadata,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_with_metadata(this), handler, buffers,
+        static_cast<endpoint_type*>(0), &metadata, flags);
+  }
+
+  /// Start an asynchronous receive of a datagram that also obtains the
+  /// message metadata.
+  /**
+   * This function is used to asynchronously receive a datagram, together with
+   * the ancillary data that the kernel reports for it, such as receive
+   * timestamps and the destination address. The function call always returns
+   * immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagram. Ownership of the sender_endpoint object
+   * is retained by the caller, which must guarantee that it is valid until the
+   * handler is called.
+   *
+   * @param metadata A receive_metadata object that is filled in with the
+   * ancillary data when the operation completes. Ownership of the metadata
+   * object is retained by the caller, which must guarantee that it is valid
+   * until the handler is called.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Example
+   * @code
+   * socket.set_option(asio::ip::packet_info(true));
+   * ...
+   * socket.async_receive_from_with_metadata(
+   *     asio::buffer(data, size), sender_endpoint, metadata, handler);
+   * ...
+   * void handler(const asio::error_code& error, std::size_t length)
+   * {
+   *   if (!error && metadata.has_destination())
+   *     reply_from(metadata.destination_address(), sender_endpoint);
+   * }
+   * @endcode
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_from_with_metadata(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, receive_metadata& metadata,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_with_metadata(this), handler, buffers,
+        &sender_endpoint, &metadata, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous receive of a datagram that also obtains the
+  /// message metadata.
+  /**
+   * This function is used to asynchronously receive a datagram, together with
+   * the ancillary data that the kernel reports for it, such as receive
+   * timestamps and the destination address. The function call always returns
+   * immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagram. Ownership of the sender_endpoint object
+   * is retained by the caller, which must guarantee that it is valid until the
+   * handler is called.
+   *
+   * @param metadata A receive_metadata object that is filled in with the
+   * ancillary data when the operation completes. Ownership of the metadata
+   * object is retained by the caller, which must guarantee that it is valid
+   * until the handler is called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_from_with_metadata(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, receive_metadata& metadata,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_with_metadata(this), handler, buffers,
+        &sender_endpoint, &metadata, flags);
+  }
+#endif // defined(ASIO_HAS_RECEIVE_METADATA)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+private:
+  class initiate_async_send
+  { 
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        const ConstBufferSequence& buffers,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send(
+          self_->impl_.get_implementation(), buffers, flags,
+          handler2.value, self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
+  class initiate_async_send_to
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_to(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        const ConstBufferSequence& buffers, const endpoint_type& destination,
+        socket_base::message_flags flags) const
     {
       // If you get an error on the following line it means that your handler
       // does not meet the documented type requirements for a WriteHandler.
@@ -1134,6 +1932,79 @@ private:
     basic_datagram_socket* self_;
   };
 
+#if defined(ASIO_HAS_MMSG)
+  class initiate_async_send_to_batch
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_to_batch(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        const ConstBufferSequence& buffers, const endpoint_type* destinations,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_to_batch(
+          self_->impl_.get_implementation(), buffers, destinations, flags,
+          handler2.value, self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+#endif // defined(ASIO_HAS_MMSG)
+
+#if defined(ASIO_HAS_UDP_GSO)
+  class initiate_async_send_to_segmented
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_to_segmented(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        const ConstBufferSequence& buffers, const endpoint_type& destination,
+        std::size_t segment_size, socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_to_segmented(
+          self_->impl_.get_implementation(), buffers, destination,
+          segment_size, flags, handler2.value,
+          self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+#endif // defined(ASIO_HAS_UDP_GSO)
+
   class initiate_async_receive
   {
   public:
@@ -1168,6 +2039,35 @@ private:
     basic_datagram_socket* self_;
   };
 
+#if defined(ASIO_HAS_MULTISHOT_RECEIVE)
+  class initiate_async_multishot_receive
+  {
+  public:
+    explicit initiate_async_multishot_receive(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    template <typename MultishotReadHandler, typename MutableBufferSequence>
+    void operator()(ASIO_MOVE_ARG(MultishotReadHandler) handler,
+        const MutableBufferSequence& buffers,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(MultishotReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<MultishotReadHandler> handler2(handler);
+      self_->impl_.get_service().async_multishot_receive(
+          self_->impl_.get_implementation(), buffers, flags,
+          handler2.value, self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+#endif // defined(ASIO_HAS_MULTISHOT_RECEIVE)
+
   class initiate_async_receive_from
   {
   public:
@@ -1201,6 +2101,117 @@ private:
   private:
     basic_datagram_socket* self_;
   };
+
+#if defined(ASIO_HAS_MMSG)
+  class initiate_async_receive_from_batch
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_from_batch(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        const MutableBufferSequence& buffers, endpoint_type* sender_endpoints,
+        std::size_t* sizes, socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_from_batch(
+          self_->impl_.get_implementation(), buffers, sender_endpoints,
+          sizes, flags, handler2.value,
+          self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+#endif // defined(ASIO_HAS_MMSG)
+
+#if defined(ASIO_HAS_UDP_GSO)
+  class initiate_async_receive_from_coalesced
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_from_coalesced(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        const MutableBufferSequence& buffers, endpoint_type* sender_endpoint,
+        std::size_t* segment_size, socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_from_coalesced(
+          self_->impl_.get_implementation(), buffers, *sender_endpoint,
+          *segment_size, flags, handler2.value,
+          self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+#endif // defined(ASIO_HAS_UDP_GSO)
+
+#if defined(ASIO_HAS_RECEIVE_METADATA)
+  class initiate_async_receive_with_metadata
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_with_metadata(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        const MutableBufferSequence& buffers, endpoint_type* sender_endpoint,
+        receive_metadata* metadata, socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_with_metadata(
+          self_->impl_.get_implementation(), buffers, sender_endpoint,
+          *metadata, flags, handler2.value,
+          self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+#endif // defined(ASIO_HAS_RECEIVE_METADATA)
 };
 
 } // namespace asio
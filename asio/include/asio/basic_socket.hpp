@@ -36,6 +36,10 @@
 # include "asio/detail/reactive_socket_service.hpp"
 #endif
 
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+# include "asio/detail/chrono.hpp"
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
 #if defined(ASIO_HAS_MOVE)
 # include <utility>
 #endif // defined(ASIO_HAS_MOVE)
@@ -544,6 +548,9 @@ public:
    * will be passed the asio::error::operation_aborted error. Ownership
    * of the native socket is then transferred to the caller.
    *
+   * The native socket is returned in blocking mode, unless non-blocking mode
+   * was requested by calling non_blocking() with @c true.
+   *
    * @throws asio::system_error Thrown on failure.
    *
    * @note This function is unsupported on Windows versions prior to Windows
@@ -572,6 +579,9 @@ public:
    * will be passed the asio::error::operation_aborted error. Ownership
    * of the native socket is then transferred to the caller.
    *
+   * The native socket is returned in blocking mode, unless non-blocking mode
+   * was requested by calling non_blocking() with @c true.
+   *
    * @param ec Set to indicate what error occurred, if any.
    *
    * @note This function is unsupported on Windows versions prior to Windows
@@ -589,6 +599,70 @@ public:
     return impl_.get_service().release(impl_.get_implementation(), ec);
   }
 
+#if defined(ASIO_HAS_SOCKET_MIGRATION) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Move the socket to another execution context without closing it.
+  /**
+   * This function transfers the socket to the execution context of the
+   * specified executor, which then performs the socket's subsequent
+   * asynchronous operations. The socket's executor is replaced by @c ex.
+   * The connection is unaffected, and the socket's options and state, such as
+   * its non-blocking mode and expiry time, are retained.
+   *
+   * The socket must not have any outstanding asynchronous operations, so that
+   * no operation is lost in the transfer. A suitable point at which to
+   * migrate a socket is in the completion handler of its last operation,
+   * before the next one is started. Handlers of operations that have already
+   * completed are unaffected.
+   *
+   * @param ex The executor of the execution context to which the socket is to
+   * be moved.
+   *
+   * @throws asio::system_error Thrown on failure. If any asynchronous
+   * operations are outstanding, the error is asio::error::in_progress and
+   * the socket is left unchanged.
+   *
+   * @par Example
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * socket.async_read_some(asio::buffer(data),
+   *     [&](std::error_code ec, std::size_t n)
+   *     {
+   *       socket.migrate(other_context.get_executor());
+   *       // Subsequent operations are performed by other_context.
+   *     });
+   * @endcode
+   */
+  void migrate(const executor_type& ex)
+  {
+    asio::error_code ec;
+    impl_.migrate(ex, ec);
+    asio::detail::throw_error(ec, "migrate");
+  }
+
+  /// Move the socket to another execution context without closing it.
+  /**
+   * This function transfers the socket to the execution context of the
+   * specified executor, which then performs the socket's subsequent
+   * asynchronous operations. See migrate(const executor_type&) for details.
+   *
+   * @param ex The executor of the execution context to which the socket is to
+   * be moved.
+   *
+   * @param ec Set to indicate what error occurred, if any. If any
+   * asynchronous operations are outstanding, the error is
+   * asio::error::in_progress and the socket is left unchanged.
+   */
+  ASIO_SYNC_OP_VOID migrate(const executor_type& ex,
+      asio::error_code& ec)
+  {
+    impl_.migrate(ex, ec);
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+#endif // defined(ASIO_HAS_SOCKET_MIGRATION)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Get the native socket representation.
   /**
    * This function may be used to obtain the underlying representation of the
@@ -695,6 +769,81 @@ public:
     ASIO_SYNC_OP_VOID_RETURN(ec);
   }
 
+#if defined(ASIO_HAS_SOCKET_EXPIRY) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Get the socket's expiry time as an absolute time.
+  /**
+   * This function may be used to obtain the time at which the socket's
+   * outstanding asynchronous operations time out. A socket without an expiry
+   * time returns the maximum time point.
+   */
+  chrono::steady_clock::time_point expiry() const
+  {
+    return impl_.get_service().expiry(impl_.get_implementation());
+  }
+
+  /// Set the socket's expiry time as an absolute time.
+  /**
+   * This function sets the time at which the socket's outstanding
+   * asynchronous operations time out. An asynchronous connect, send, receive
+   * or wait operation that is started while the socket has an expiry time,
+   * and that has not completed when the expiry time is reached, finishes with
+   * the asio::error::timed_out error. An operation that is started after the
+   * expiry time has been reached finishes immediately with the same error.
+   *
+   * The socket remains open when its operations time out, and no timer object
+   * or additional asynchronous operation is required. Changing the expiry
+   * time affects outstanding operations that were started while an expiry
+   * time was set. The expiry time is cleared when the socket is closed.
+   *
+   * @param expiry_time The expiry time to be used for the socket.
+   *
+   * @par Example
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * socket.expires_after(std::chrono::seconds(30));
+   * asio::async_read(socket, asio::buffer(data, size),
+   *     [](std::error_code ec, std::size_t n)
+   *     {
+   *       if (ec == asio::error::timed_out)
+   *       {
+   *         // The peer did not send the data in time.
+   *       }
+   *     });
+   * @endcode
+   */
+  void expires_at(const chrono::steady_clock::time_point& expiry_time)
+  {
+    impl_.get_service().expires_at(impl_.get_implementation(), expiry_time);
+  }
+
+  /// Set the socket's expiry time relative to now.
+  /**
+   * This function sets the time at which the socket's outstanding
+   * asynchronous operations time out. See expires_at() for details.
+   *
+   * @param expiry_time The expiry time to be used for the socket, relative to
+   * now.
+   */
+  void expires_after(const chrono::steady_clock::duration& expiry_time)
+  {
+    impl_.get_service().expires_after(impl_.get_implementation(), expiry_time);
+  }
+
+  /// Clear the socket's expiry time.
+  /**
+   * This function removes the socket's expiry time, so that outstanding and
+   * subsequent asynchronous operations do not time out.
+   */
+  void expires_never()
+  {
+    impl_.get_service().expires_at(impl_.get_implementation(),
+        (chrono::steady_clock::time_point::max)());
+  }
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Determine whether the socket is at the out-of-band data mark.
   /**
    * This function is used to check whether the socket input is currently
@@ -1274,6 +1423,9 @@ public:
    * Consequently, the return value may be incorrect if the non-blocking mode
    * was set directly on the native socket.
    *
+   * @note On platforms where the socket is created in non-blocking mode, such
+   * as Linux, this function returns @c true as soon as the socket is open.
+   *
    * @par Example
    * This function is intended to allow the encapsulation of arbitrary
    * non-blocking system calls as asynchronous operations, in a way that is
@@ -1804,6 +1956,14 @@ protected:
 #else
   detail::io_object_impl<
     detail::reactive_socket_service<Protocol>, Executor> impl_;
+
+  // Accept operations assign new connections together with their state.
+  template <typename, typename>
+  friend class detail::reactive_socket_accept_op_base;
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT)
+  template <typename, typename, typename, typename>
+  friend class detail::reactive_socket_multishot_accept_op;
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
 #endif
 
 private:
@@ -25,6 +25,7 @@
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
 #include "asio/executor.hpp"
+#include "asio/incoming_cpu_dispatcher.hpp"
 #include "asio/socket_base.hpp"
 
 #if defined(ASIO_WINDOWS_RUNTIME)
@@ -686,6 +687,9 @@ public:
    * passed the asio::error::operation_aborted error. Ownership of the
    * native acceptor is then transferred to the caller.
    *
+   * The native acceptor is returned in blocking mode, unless non-blocking mode
+   * was requested by calling non_blocking() with @c true.
+   *
    * @throws asio::system_error Thrown on failure.
    *
    * @note This function is unsupported on Windows versions prior to Windows
@@ -714,6 +718,9 @@ public:
    * passed the asio::error::operation_aborted error. Ownership of the
    * native acceptor is then transferred to the caller.
    *
+   * The native acceptor is returned in blocking mode, unless non-blocking mode
+   * was requested by calling non_blocking() with @c true.
+   *
    * @param ec Set to indicate what error occurred, if any.
    *
    * @note This function is unsupported on Windows versions prior to Windows
@@ -1029,6 +1036,9 @@ public:
    * @note The current non-blocking mode is cached by the acceptor object.
    * Consequently, the return value may be incorrect if the non-blocking mode
    * was set directly on the native acceptor.
+   *
+   * @note On platforms where the acceptor is created in non-blocking mode, such
+   * as Linux, this function returns @c true as soon as the acceptor is open.
    */
   bool native_non_blocking() const
   {
@@ -2370,6 +2380,279 @@ public:
   }
 #endif // defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
 
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT) || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous operation to accept new connections continuously.
+  /**
+   * This function is used to asynchronously accept new connections until the
+   * operation fails or is stopped. The function call always returns
+   * immediately.
+   *
+   * A single operation remains outstanding on the acceptor. Each time the
+   * acceptor becomes ready, the operation accepts all pending connections, up
+   * to an implementation-defined limit, and then waits for more connections
+   * without needing to be restarted.
+   *
+   * This overload requires that the Protocol template parameter satisfy the
+   * AcceptableProtocol type requirements.
+   *
+   * @param handler The handler to be called for each accepted connection, and
+   * once more when the operation completes. A copy of the handler is made for
+   * each accepted connection, so the handler must be CopyConstructible. The
+   * function signature of the handler must be:
+   * @code void handler(
+   *   // Result of operation.
+   *   const asio::error_code& error,
+   *   // On success, the newly accepted socket.
+   *   typename Protocol::socket::template
+   *     rebind_executor<executor_type>::other peer
+   * ); @endcode
+   * The handler is invoked without error once for each new connection. The
+   * operation completes when the handler is invoked with an error, after which
+   * no further invocations are made. Calling cancel(), close() or the
+   * destructor, or moving the acceptor into an acceptor of another protocol
+   * type, stops the operation. Any connections that have already been
+   * accepted are delivered, and the operation then completes with the
+   * asio::error::operation_aborted error. The handler will not be invoked from
+   * within this function.
+   *
+   * Each connection is passed to a copy of the handler through the handler's
+   * associated executor. If that executor does not run the handler at once,
+   * as is the case for a strand that is busy in another thread, the operation
+   * may resume waiting for connections before the handler has run. The
+   * handler may stop the operation at any time.
+   *
+   * @param statistics An optional object that records how many connections
+   * were accepted on each wakeup. The object is reset when the operation
+   * starts. Ownership of the object is retained by the caller, which must
+   * guarantee that it is valid until the operation completes.
+   *
+   * @note Since the handler may be invoked more than once, this function does
+   * not support completion tokens such as asio::use_future.
+   *
+   * @par Example
+   * @code
+   * void accept_handler(const asio::error_code& error,
+   *     asio::ip::tcp::socket peer)
+   * {
+   *   if (!error)
+   *   {
+   *     // Accept succeeded.
+   *   }
+   * }
+   *
+   * ...
+   *
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * acceptor.async_multishot_accept(accept_handler);
+   * @endcode
+   */
+  template <typename MultishotAcceptHandler>
+  void async_multishot_accept(
+      ASIO_MOVE_ARG(MultishotAcceptHandler) handler,
+      multishot_accept_statistics* statistics = 0)
+  {
+    initiate_async_multishot_accept(this)(
+        ASIO_MOVE_CAST(MultishotAcceptHandler)(handler),
+        impl_.get_executor(), statistics,
+        static_cast<typename Protocol::socket::template
+          rebind_executor<executor_type>::other*>(0));
+  }
+
+  /// Start an asynchronous operation to accept new connections continuously.
+  /**
+   * This function is used to asynchronously accept new connections until the
+   * operation fails or is stopped. The function call always returns
+   * immediately.
+   *
+   * A single operation remains outstanding on the acceptor. Each time the
+   * acceptor becomes ready, the operation accepts all pending connections, up
+   * to an implementation-defined limit, and then waits for more connections
+   * without needing to be restarted.
+   *
+   * This overload requires that the Protocol template parameter satisfy the
+   * AcceptableProtocol type requirements.
+   *
+   * @param ex The I/O executor object to be used for the newly accepted
+   * sockets.
+   *
+   * @param handler The handler to be called for each accepted connection, and
+   * once more when the operation completes. A copy of the handler is made for
+   * each accepted connection, so the handler must be CopyConstructible. The
+   * function signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   typename Protocol::socket::template rebind_executor<
+   *     Executor1>::other peer // On success, the newly accepted socket.
+   * ); @endcode
+   * The handler is invoked without error once for each new connection. The
+   * operation completes when the handler is invoked with an error, after which
+   * no further invocations are made. Calling cancel(), close() or the
+   * destructor, or moving the acceptor into an acceptor of another protocol
+   * type, stops the operation. Any connections that have already been
+   * accepted are delivered, and the operation then completes with the
+   * asio::error::operation_aborted error. The handler will not be invoked from
+   * within this function.
+   *
+   * Each connection is passed to a copy of the handler through the handler's
+   * associated executor. If that executor does not run the handler at once,
+   * as is the case for a strand that is busy in another thread, the operation
+   * may resume waiting for connections before the handler has run. The
+   * handler may stop the operation at any time.
+   *
+   * @param statistics An optional object that records how many connections
+   * were accepted on each wakeup. The object is reset when the operation
+   * starts. Ownership of the object is retained by the caller, which must
+   * guarantee that it is valid until the operation completes.
+   *
+   * @note Since the handler may be invoked more than once, this function does
+   * not support completion tokens such as asio::use_future.
+   */
+  template <typename Executor1, typename MultishotAcceptHandler>
+  void async_multishot_accept(const Executor1& ex,
+      ASIO_MOVE_ARG(MultishotAcceptHandler) handler,
+      multishot_accept_statistics* statistics = 0,
+      typename enable_if<
+        is_executor<Executor1>::value
+      >::type* = 0)
+  {
+    initiate_async_multishot_accept(this)(
+        ASIO_MOVE_CAST(MultishotAcceptHandler)(handler), ex, statistics,
+        static_cast<typename Protocol::socket::template
+          rebind_executor<Executor1>::other*>(0));
+  }
+
+  /// Start an asynchronous operation to accept new connections continuously.
+  /**
+   * This function is used to asynchronously accept new connections until the
+   * operation fails or is stopped. The function call always returns
+   * immediately.
+   *
+   * A single operation remains outstanding on the acceptor. Each time the
+   * acceptor becomes ready, the operation accepts all pending connections, up
+   * to an implementation-defined limit, and then waits for more connections
+   * without needing to be restarted.
+   *
+   * This overload requires that the Protocol template parameter satisfy the
+   * AcceptableProtocol type requirements.
+   *
+   * @param context The I/O execution context object to be used for the newly
+   * accepted sockets.
+   *
+   * @param handler The handler to be called for each accepted connection, and
+   * once more when the operation completes. A copy of the handler is made for
+   * each accepted connection, so the handler must be CopyConstructible. The
+   * function signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   typename Protocol::socket::template rebind_executor<
+   *     typename ExecutionContext::executor_type>::other peer
+   *       // On success, the newly accepted socket.
+   * ); @endcode
+   * The handler is invoked without error once for each new connection. The
+   * operation completes when the handler is invoked with an error, after which
+   * no further invocations are made. Calling cancel(), close() or the
+   * destructor, or moving the acceptor into an acceptor of another protocol
+   * type, stops the operation. Any connections that have already been
+   * accepted are delivered, and the operation then completes with the
+   * asio::error::operation_aborted error. The handler will not be invoked from
+   * within this function.
+   *
+   * Each connection is passed to a copy of the handler through the handler's
+   * associated executor. If that executor does not run the handler at once,
+   * as is the case for a strand that is busy in another thread, the operation
+   * may resume waiting for connections before the handler has run. The
+   * handler may stop the operation at any time.
+   *
+   * @param statistics An optional object that records how many connections
+   * were accepted on each wakeup. The object is reset when the operation
+   * starts. Ownership of the object is retained by the caller, which must
+   * guarantee that it is valid until the operation completes.
+   *
+   * @note Since the handler may be invoked more than once, this function does
+   * not support completion tokens such as asio::use_future.
+   */
+  template <typename ExecutionContext, typename MultishotAcceptHandler>
+  void async_multishot_accept(ExecutionContext& context,
+      ASIO_MOVE_ARG(MultishotAcceptHandler) handler,
+      multishot_accept_statistics* statistics = 0,
+      typename enable_if<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      >::type* = 0)
+  {
+    initiate_async_multishot_accept(this)(
+        ASIO_MOVE_CAST(MultishotAcceptHandler)(handler),
+        context.get_executor(), statistics,
+        static_cast<typename Protocol::socket::template rebind_executor<
+          typename ExecutionContext::executor_type>::other*>(0));
+  }
+
+  /// Start an asynchronous operation to accept new connections continuously.
+  /**
+   * This function is used to asynchronously accept new connections until the
+   * operation fails or is stopped. The function call always returns
+   * immediately.
+   *
+   * A single operation remains outstanding on the acceptor. Each time the
+   * acceptor becomes ready, the operation accepts all pending connections, up
+   * to an implementation-defined limit, and then waits for more connections
+   * without needing to be restarted.
+   *
+   * This overload requires that the Protocol template parameter satisfy the
+   * AcceptableProtocol type requirements.
+   *
+   * @param dispatcher Selects the I/O executor to be used for each newly
+   * accepted socket, according to the CPU on which the socket's packets are
+   * received. The native socket is assigned directly to a socket object that
+   * uses the selected executor. A copy of the dispatcher is made.
+   *
+   * @param handler The handler to be called for each accepted connection, and
+   * once more when the operation completes. A copy of the handler is made for
+   * each accepted connection, so the handler must be CopyConstructible. The
+   * function signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   typename Protocol::socket::template rebind_executor<
+   *     Executor1>::other peer // On success, the newly accepted socket.
+   * ); @endcode
+   * The handler is invoked without error once for each new connection. The
+   * operation completes when the handler is invoked with an error, after which
+   * no further invocations are made. Calling cancel(), close() or the
+   * destructor, or moving the acceptor into an acceptor of another protocol
+   * type, stops the operation. Any connections that have already been
+   * accepted are delivered, and the operation then completes with the
+   * asio::error::operation_aborted error. The handler will not be invoked from
+   * within this function.
+   *
+   * Each connection is passed to a copy of the handler through the handler's
+   * associated executor. If that executor does not run the handler at once,
+   * as is the case for a strand that is busy in another thread, the operation
+   * may resume waiting for connections before the handler has run. The
+   * handler may stop the operation at any time.
+   *
+   * @param statistics An optional object that records how many connections
+   * were accepted on each wakeup. The object is reset when the operation
+   * starts. Ownership of the object is retained by the caller, which must
+   * guarantee that it is valid until the operation completes.
+   *
+   * @note Since the handler may be invoked more than once, this function does
+   * not support completion tokens such as asio::use_future.
+   */
+  template <typename Executor1, typename MultishotAcceptHandler>
+  void async_multishot_accept(
+      const incoming_cpu_dispatcher<Executor1>& dispatcher,
+      ASIO_MOVE_ARG(MultishotAcceptHandler) handler,
+      multishot_accept_statistics* statistics = 0)
+  {
+    initiate_async_multishot_accept(this)(
+        ASIO_MOVE_CAST(MultishotAcceptHandler)(handler),
+        dispatcher, statistics,
+        static_cast<typename Protocol::socket::template
+          rebind_executor<Executor1>::other*>(0));
+  }
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
+       //   || defined(GENERATING_DOCUMENTATION)
+
 private:
   // Disallow copying and assignment.
   basic_socket_acceptor(const basic_socket_acceptor&) ASIO_DELETED;
@@ -2476,6 +2759,37 @@ private:
     basic_socket_acceptor* self_;
   };
 
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT)
+  class initiate_async_multishot_accept
+  {
+  public:
+    explicit initiate_async_multishot_accept(basic_socket_acceptor* self)
+      : self_(self)
+    {
+    }
+
+    template <typename MultishotAcceptHandler,
+        typename Executor1, typename Socket>
+    void operator()(ASIO_MOVE_ARG(MultishotAcceptHandler) handler,
+        const Executor1& peer_ex,
+        multishot_accept_statistics* statistics, Socket*) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a MoveAcceptHandler.
+      ASIO_MOVE_ACCEPT_HANDLER_CHECK(
+          MultishotAcceptHandler, handler, Socket) type_check;
+
+      detail::non_const_lvalue<MultishotAcceptHandler> handler2(handler);
+      self_->impl_.get_service().async_multishot_accept(
+          self_->impl_.get_implementation(), peer_ex, statistics,
+          handler2.value, self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_socket_acceptor* self_;
+  };
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
+
 #if defined(ASIO_WINDOWS_RUNTIME)
   detail::io_object_impl<
     detail::null_socket_service<Protocol>, Executor> impl_;
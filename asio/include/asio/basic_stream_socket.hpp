@@ -19,10 +19,13 @@
 #include <cstddef>
 #include "asio/async_result.hpp"
 #include "asio/basic_socket.hpp"
+#include "asio/buffer.hpp"
+#include "asio/detail/cstdint.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
+#include "asio/receive_metadata.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -532,6 +535,263 @@ public:
         initiate_async_send(this), handler, buffers, flags);
   }
 
+  /// Start an asynchronous zero-copy send.
+  /**
+   * This function is used to asynchronously send data on the stream socket
+   * without copying it into the kernel. The function call always returns
+   * immediately.
+   *
+   * The handler is not called until the kernel has finished with the buffers,
+   * which may be after the data has been acknowledged by the peer. Sends of
+   * fewer than @c ASIO_ZERO_COPY_SEND_THRESHOLD bytes (10240 by default) are
+   * copied, as are all sends on platforms or sockets that do not support
+   * zero-copy transmission. In those cases the operation behaves like
+   * async_send.
+   *
+   * @param buffers One or more data buffers to be sent on the socket. Although
+   * the buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid, and are not modified, until the handler is called.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note The send operation may not transmit all of the data to the peer.
+   *
+   * @note If the operation is cancelled, or the socket is closed, after the
+   * data has been sent, the handler is called with the
+   * asio::error::operation_aborted error. The kernel may continue to
+   * read from the buffers until the data has been transmitted.
+   *
+   * @par Example
+   * @code
+   * socket.async_send_zero_copy(asio::buffer(data, size), handler);
+   * @endcode
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_zero_copy(const ConstBufferSequence& buffers,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_zero_copy(this), handler,
+        buffers, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous zero-copy send.
+  /**
+   * This function is used to asynchronously send data on the stream socket
+   * without copying it into the kernel. The function call always returns
+   * immediately.
+   *
+   * The handler is not called until the kernel has finished with the buffers,
+   * which may be after the data has been acknowledged by the peer. Sends of
+   * fewer than @c ASIO_ZERO_COPY_SEND_THRESHOLD bytes (10240 by default) are
+   * copied, as are all sends on platforms or sockets that do not support
+   * zero-copy transmission. In those cases the operation behaves like
+   * async_send.
+   *
+   * @param buffers One or more data buffers to be sent on the socket. Although
+   * the buffers object may be copied as necessary, ownership of the underlying
+   * memory blocks is retained by the caller, which must guarantee that they
+   * remain valid, and are not modified, until the handler is called.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note The send operation may not transmit all of the data to the peer.
+   *
+   * @note If the operation is cancelled, or the socket is closed, after the
+   * data has been sent, the handler is called with the
+   * asio::error::operation_aborted error. The kernel may continue to
+   * read from the buffers until the data has been transmitted.
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_zero_copy(const ConstBufferSequence& buffers,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_zero_copy(this), handler, buffers, flags);
+  }
+
+#if defined(ASIO_HAS_SENDFILE) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous send of data from a file.
+  /**
+   * This function is used to asynchronously send a range of bytes from a file
+   * on the stream socket. The data is transferred by the kernel using the
+   * @c sendfile system call, without being copied through user space. The
+   * function call always returns immediately.
+   *
+   * @param file A native file descriptor, such as the one returned by the
+   * @c native_handle() function of a posix::stream_descriptor. The caller
+   * must ensure that the descriptor remains open until the handler is called.
+   * The descriptor's file offset is not changed.
+   *
+   * @param offset The offset in the file of the first byte to be sent.
+   *
+   * @param size The number of bytes to be sent.
+   *
+   * @param handler The handler to be called when the send operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note Unlike async_send, the operation continues until all of the bytes
+   * have been sent, or an error occurs. If the file ends before @c size bytes
+   * have been sent, the operation fails with asio::error::eof.
+   *
+   * @note The @c sendfile system call raises the @c SIGPIPE signal if the
+   * peer has closed the connection. Programs that use this function should
+   * ignore @c SIGPIPE.
+   *
+   * @note This function is only available on Linux.
+   *
+   * @par Example
+   * @code
+   * socket.async_send_file(file.native_handle(), 0, file_size, handler);
+   * @endcode
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_send_file(int file, uint64_t offset, std::size_t size,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<WriteHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_send_file(this), handler, file, offset, size);
+  }
+#endif // defined(ASIO_HAS_SENDFILE)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_TCP_FAST_OPEN) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous connect that sends data with the connection request.
+  /**
+   * This function is used to asynchronously connect a stream socket to the
+   * specified remote endpoint using TCP Fast Open, which allows the initial
+   * data to be carried by the connection request and so saves a round trip
+   * for the first request on a new connection. The function call always
+   * returns immediately.
+   *
+   * Data is only sent with the connection request if the kernel already holds
+   * a Fast Open cookie for the peer, obtained from an earlier connection to
+   * it. Otherwise, or if client-side Fast Open is disabled, an ordinary
+   * connect is made and none of the data is sent.
+   *
+   * The socket is automatically opened if it is not already open. If the
+   * connect fails, and the socket was automatically opened, the socket is
+   * not returned to the closed state.
+   *
+   * @param peer_endpoint The remote endpoint to which the socket will be
+   * connected. Copies will be made of the endpoint object as required.
+   *
+   * @param buffers One or more data buffers to be sent with the connection
+   * request. Although the buffers object may be copied as necessary, ownership
+   * of the underlying memory blocks is retained by the caller, which must
+   * guarantee that they remain valid until the handler is called.
+   *
+   * @param handler The handler to be called when the connect operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note Any of the data that was not sent with the connection request,
+   * which may be all of it, must be written once the connect has completed.
+   * Consider using the @ref async_write function if you need to ensure that
+   * all data is written.
+   *
+   * @note Data sent with the connection request may be delivered to the peer
+   * more than once, so it should be used only for idempotent requests.
+   *
+   * @note This function is only available on Linux.
+   *
+   * @par Example
+   * @code
+   * socket.async_fast_open_connect(endpoint,
+   *     asio::buffer(request), connect_handler);
+   * @endcode
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ConnectHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ConnectHandler,
+      void (asio::error_code, std::size_t))
+  async_fast_open_connect(const endpoint_type& peer_endpoint,
+      const ConstBufferSequence& buffers,
+      ASIO_MOVE_ARG(ConnectHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    asio::error_code open_ec;
+    if (!this->is_open())
+    {
+      const protocol_type protocol = peer_endpoint.protocol();
+      this->impl_.get_service().open(
+          this->impl_.get_implementation(), protocol, open_ec);
+    }
+
+    return async_initiate<ConnectHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_fast_open_connect(this), handler,
+        peer_endpoint, buffers, open_ec);
+  }
+#endif // defined(ASIO_HAS_TCP_FAST_OPEN)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Receive some data on the socket.
   /**
    * This function is used to receive data on the stream socket. The function
@@ -745,6 +1005,120 @@ public:
         initiate_async_receive(this), handler, buffers, flags);
   }
 
+#if defined(ASIO_HAS_RECEIVE_METADATA) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous receive that also obtains the message metadata.
+  /**
+   * This function is used to asynchronously receive data from the stream
+   * socket, together with the ancillary data that the kernel reports for the
+   * received bytes, such as receive timestamps. The function call always
+   * returns immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param metadata A receive_metadata object that is filled in with the
+   * ancillary data when the operation completes. Ownership of the metadata
+   * object is retained by the caller, which must guarantee that it is valid
+   * until the handler is called.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Example
+   * @code
+   * socket.set_option(asio::socket_base::timestamp(true));
+   * ...
+   * socket.async_receive_with_metadata(
+   *     asio::buffer(data, size), metadata, handler);
+   * ...
+   * void handler(const asio::error_code& error, std::size_t length)
+   * {
+   *   if (!error && metadata.has_software_timestamp())
+   *     record_latency(metadata.software_timestamp());
+   * }
+   * @endcode
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_with_metadata(const MutableBufferSequence& buffers,
+      receive_metadata& metadata,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_with_metadata(this), handler, buffers,
+        static_cast<endpoint_type*>(0), &metadata,
+        socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous receive that also obtains the message metadata.
+  /**
+   * This function is used to asynchronously receive data from the stream
+   * socket, together with the ancillary data that the kernel reports for the
+   * received bytes, such as receive timestamps. The function call always
+   * returns immediately.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param metadata A receive_metadata object that is filled in with the
+   * ancillary data when the operation completes. Ownership of the metadata
+   * object is retained by the caller, which must guarantee that it is valid
+   * until the handler is called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   */
+  template <typename MutableBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, std::size_t))
+  async_receive_with_metadata(const MutableBufferSequence& buffers,
+      receive_metadata& metadata,
+      socket_base::message_flags flags,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, std::size_t)>(
+        initiate_async_receive_with_metadata(this), handler, buffers,
+        static_cast<endpoint_type*>(0), &metadata, flags);
+  }
+#endif // defined(ASIO_HAS_RECEIVE_METADATA)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Write some data to the socket.
   /**
    * This function is used to write data to the stream socket. The function call
@@ -972,6 +1346,146 @@ public:
         buffers, socket_base::message_flags(0));
   }
 
+#if defined(ASIO_HAS_POOLED_READ) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous read into a buffer obtained from a pool.
+  /**
+   * This function is used to asynchronously read data from the stream socket
+   * into a buffer that is obtained from a pool only once the socket is ready
+   * to read. The function call always returns immediately.
+   *
+   * Unlike async_read_some, no buffer is held while the operation waits for
+   * data to arrive. When the socket becomes ready, a buffer is acquired from
+   * the pool and the non-blocking read is performed immediately. If no data is
+   * available after all, the buffer is returned to the pool and the operation
+   * continues to wait.
+   *
+   * @param pool The pool from which the buffer is obtained, such as a
+   * buffer_pool object. Ownership of the pool is retained by the caller, which
+   * must guarantee that it remains valid until the handler is called.
+   *
+   * @param handler The handler to be called when the read operation completes.
+   * Copies will be made of the handler as required. The function signature of
+   * the handler must be:
+   * @code void handler(
+   *   // Result of operation.
+   *   const asio::error_code& error,
+   *
+   *   // The data that was read. The buffer is owned by the handler, which must
+   *   // return it to the pool when it is no longer required. If an error
+   *   // occurred the buffer is empty.
+   *   asio::mutable_buffer data
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note If the pool has no buffer available, the operation completes with
+   * the asio::error::no_buffer_space error and the data remains unread.
+   *
+   * @par Example
+   * @code
+   * void handle_read(const asio::error_code& error,
+   *     asio::mutable_buffer data)
+   * {
+   *   if (!error)
+   *   {
+   *     process(data);
+   *     pool.release(data);
+   *   }
+   * }
+   *
+   * ...
+   *
+   * socket.async_read_some_pooled(pool, handle_read);
+   * @endcode
+   */
+  template <typename BufferPool,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        asio::mutable_buffer)) ReadHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+      void (asio::error_code, asio::mutable_buffer))
+  async_read_some_pooled(BufferPool& pool,
+      ASIO_MOVE_ARG(ReadHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    return async_initiate<ReadHandler,
+      void (asio::error_code, asio::mutable_buffer)>(
+        initiate_async_receive_pooled(this), handler, &pool);
+  }
+#endif // defined(ASIO_HAS_POOLED_READ)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_MULTISHOT_RECEIVE) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous operation to read data continuously.
+  /**
+   * This function is used to asynchronously read data from the stream socket
+   * until the operation fails or is stopped. The function call always returns
+   * immediately.
+   *
+   * A single operation remains outstanding on the socket. Each time data is
+   * read into the buffers, the handler is invoked, after which the operation
+   * reads again without needing to be restarted. While data remains
+   * available, subsequent reads are made directly, up to an
+   * implementation-defined limit, rather than by waiting for the socket to
+   * become ready.
+   *
+   * @param buffers One or more buffers into which the data will be read. The
+   * same buffers are used for every read, so the handler must consume the data
+   * before it returns. The buffers must not be empty. Although the buffers
+   * object may be copied as necessary, ownership of the underlying memory
+   * blocks is retained by the caller, which must guarantee that they remain
+   * valid until the operation completes.
+   *
+   * @param handler The handler to be called for each read, and once more when
+   * the operation completes. A copy of the handler is made for each read, so
+   * the handler must be CopyConstructible. The function signature of the
+   * handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes read.
+   * ); @endcode
+   * The handler is invoked without error once for each read. The operation
+   * completes when the handler is invoked with an error, such as
+   * asio::error::eof when the peer closes the connection, after which
+   * no further invocations are made. Calling cancel(), close() or the
+   * destructor, or moving the socket into a socket of another protocol type,
+   * stops the operation, which then completes with the
+   * asio::error::operation_aborted error. The handler will not be invoked from
+   * within this function.
+   *
+   * @note Since the handler may be invoked more than once, this function does
+   * not support completion tokens such as asio::use_future.
+   *
+   * @par Example
+   * @code
+   * void read_handler(const asio::error_code& error,
+   *     std::size_t bytes_transferred)
+   * {
+   *   if (!error)
+   *   {
+   *     // Process the bytes_transferred bytes now in data.
+   *   }
+   * }
+   *
+   * ...
+   *
+   * socket.async_multishot_receive(asio::buffer(data, size), read_handler);
+   * @endcode
+   */
+  template <typename MutableBufferSequence, typename MultishotReadHandler>
+  void async_multishot_receive(const MutableBufferSequence& buffers,
+      ASIO_MOVE_ARG(MultishotReadHandler) handler)
+  {
+    initiate_async_multishot_receive(this)(
+        ASIO_MOVE_CAST(MultishotReadHandler)(handler), buffers, 0);
+  }
+#endif // defined(ASIO_HAS_MULTISHOT_RECEIVE)
+       //   || defined(GENERATING_DOCUMENTATION)
+
 private:
   class initiate_async_send
   {
@@ -1007,6 +1521,128 @@ private:
     basic_stream_socket* self_;
   };
 
+  class initiate_async_send_zero_copy
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_zero_copy(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        const ConstBufferSequence& buffers,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+      self_->impl_.get_service().async_send_zero_copy(
+          self_->impl_.get_implementation(), buffers, flags,
+          handler2.value, self_->impl_.get_implementation_executor());
+#else // defined(ASIO_HAS_MSG_ZEROCOPY)
+      self_->impl_.get_service().async_send(
+          self_->impl_.get_implementation(), buffers, flags,
+          handler2.value, self_->impl_.get_implementation_executor());
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+
+#if defined(ASIO_HAS_SENDFILE)
+  class initiate_async_send_file
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_file(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        int file, uint64_t offset, std::size_t size) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_file(
+          self_->impl_.get_implementation(), file, offset, size,
+          handler2.value, self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+#endif // defined(ASIO_HAS_SENDFILE)
+
+#if defined(ASIO_HAS_TCP_FAST_OPEN)
+  class initiate_async_fast_open_connect
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_fast_open_connect(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ConnectHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(ConnectHandler) handler,
+        const endpoint_type& peer_endpoint,
+        const ConstBufferSequence& buffers,
+        const asio::error_code& open_ec) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(ConnectHandler, handler) type_check;
+
+      if (open_ec)
+      {
+          asio::post(self_->impl_.get_executor(),
+              asio::detail::bind_handler(
+                ASIO_MOVE_CAST(ConnectHandler)(handler), open_ec,
+                static_cast<std::size_t>(0)));
+      }
+      else
+      {
+        detail::non_const_lvalue<ConnectHandler> handler2(handler);
+        self_->impl_.get_service().async_fast_open_connect(
+            self_->impl_.get_implementation(), peer_endpoint, buffers,
+            handler2.value, self_->impl_.get_implementation_executor());
+      }
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+#endif // defined(ASIO_HAS_TCP_FAST_OPEN)
+
   class initiate_async_receive
   {
   public:
@@ -1040,6 +1676,103 @@ private:
   private:
     basic_stream_socket* self_;
   };
+
+#if defined(ASIO_HAS_RECEIVE_METADATA)
+  class initiate_async_receive_with_metadata
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_with_metadata(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        const MutableBufferSequence& buffers, endpoint_type* sender_endpoint,
+        receive_metadata* metadata, socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_with_metadata(
+          self_->impl_.get_implementation(), buffers, sender_endpoint,
+          *metadata, flags, handler2.value,
+          self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+#endif // defined(ASIO_HAS_RECEIVE_METADATA)
+
+#if defined(ASIO_HAS_POOLED_READ)
+  class initiate_async_receive_pooled
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_pooled(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename BufferPool>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        BufferPool* pool) const
+    {
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_pooled(
+          self_->impl_.get_implementation(), *pool, handler2.value,
+          self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+#endif // defined(ASIO_HAS_POOLED_READ)
+
+#if defined(ASIO_HAS_MULTISHOT_RECEIVE)
+  class initiate_async_multishot_receive
+  {
+  public:
+    explicit initiate_async_multishot_receive(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    template <typename MultishotReadHandler, typename MutableBufferSequence>
+    void operator()(ASIO_MOVE_ARG(MultishotReadHandler) handler,
+        const MutableBufferSequence& buffers,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(MultishotReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<MultishotReadHandler> handler2(handler);
+      self_->impl_.get_service().async_multishot_receive(
+          self_->impl_.get_implementation(), buffers, flags,
+          handler2.value, self_->impl_.get_implementation_executor());
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+#endif // defined(ASIO_HAS_MULTISHOT_RECEIVE)
 };
 
 } // namespace asio
@@ -0,0 +1,119 @@
+//
+// buffer_pool.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_BUFFER_POOL_HPP
+#define ASIO_BUFFER_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/buffer.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A pool of fixed size buffers.
+/**
+ * The buffer_pool class hands out buffers of a fixed size, and retains
+ * released buffers so that they may be reused without further allocation.
+ * It is intended for use with basic_stream_socket::async_read_some_pooled(),
+ * which obtains a buffer only once data is ready to be read. When most
+ * connections are idle, the memory used for reading is then proportional to
+ * the number of reads in progress, rather than the number of connections.
+ *
+ * A user-defined pool may be used in place of this class. It must provide the
+ * following member functions, which may be called concurrently from any
+ * thread that runs the io_context:
+ * @code mutable_buffer acquire();
+ * void release(const mutable_buffer& b); @endcode
+ * The acquire() function returns an empty buffer if none is available.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ */
+class buffer_pool
+  : private noncopyable
+{
+public:
+  /// Construct a pool of buffers of the specified size.
+  /**
+   * @param buffer_size The size of each buffer.
+   *
+   * @param max_idle_buffers The maximum number of released buffers that are
+   * retained for reuse. Buffers released beyond this number are freed.
+   */
+  ASIO_DECL explicit buffer_pool(std::size_t buffer_size,
+      std::size_t max_idle_buffers = 1024);
+
+  /// Destructor.
+  /**
+   * Frees all retained buffers. Buffers that are still in use are not freed,
+   * and must not be released after the pool is destroyed.
+   */
+  ASIO_DECL ~buffer_pool();
+
+  /// Get the size of each buffer.
+  std::size_t buffer_size() const ASIO_NOEXCEPT
+  {
+    return buffer_size_;
+  }
+
+  /// Obtain a buffer from the pool.
+  /**
+   * @returns A buffer of buffer_size() bytes, or an empty buffer if memory
+   * could not be allocated.
+   */
+  ASIO_DECL mutable_buffer acquire() ASIO_NOEXCEPT;
+
+  /// Return a buffer to the pool.
+  /**
+   * @param b A buffer that was obtained from this pool. Only its data pointer
+   * is used, so the buffer may have been resized.
+   */
+  ASIO_DECL void release(const mutable_buffer& b) ASIO_NOEXCEPT;
+
+  /// Get the number of buffers that have been acquired and not yet released.
+  ASIO_DECL std::size_t in_use() const ASIO_NOEXCEPT;
+
+  /// Get the number of released buffers retained for reuse.
+  ASIO_DECL std::size_t idle() const ASIO_NOEXCEPT;
+
+private:
+  // Released buffers are kept on a list that is threaded through the buffers
+  // themselves.
+  struct idle_buffer
+  {
+    idle_buffer* next_;
+  };
+
+  mutable detail::mutex mutex_;
+  std::size_t buffer_size_;
+  std::size_t max_idle_buffers_;
+  idle_buffer* idle_buffers_;
+  std::size_t idle_count_;
+  std::size_t in_use_count_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/buffer_pool.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_BUFFER_POOL_HPP
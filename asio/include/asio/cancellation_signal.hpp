@@ -0,0 +1,372 @@
+//
+// cancellation_signal.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_CANCELLATION_SIGNAL_HPP
+#define ASIO_CANCELLATION_SIGNAL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <new>
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/detail/variadic_templates.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class cancellation_handler_base
+{
+public:
+  virtual void call() = 0;
+
+  virtual void* target() ASIO_NOEXCEPT = 0;
+
+  virtual ~cancellation_handler_base()
+  {
+  }
+};
+
+template <typename Handler>
+class cancellation_handler
+  : public cancellation_handler_base
+{
+public:
+#if defined(ASIO_HAS_VARIADIC_TEMPLATES)
+
+  template <typename... Args>
+  explicit cancellation_handler(ASIO_MOVE_ARG(Args)... args)
+    : handler_(ASIO_MOVE_CAST(Args)(args)...)
+  {
+  }
+
+#else // defined(ASIO_HAS_VARIADIC_TEMPLATES)
+
+  cancellation_handler()
+    : handler_()
+  {
+  }
+
+#define ASIO_PRIVATE_CANCELLATION_HANDLER_CTOR_DEF(n) \
+  template <ASIO_VARIADIC_TPARAMS(n)> \
+  explicit cancellation_handler(ASIO_VARIADIC_MOVE_PARAMS(n)) \
+    : handler_(ASIO_VARIADIC_MOVE_ARGS(n)) \
+  { \
+  } \
+  /**/
+  ASIO_VARIADIC_GENERATE(ASIO_PRIVATE_CANCELLATION_HANDLER_CTOR_DEF)
+#undef ASIO_PRIVATE_CANCELLATION_HANDLER_CTOR_DEF
+
+#endif // defined(ASIO_HAS_VARIADIC_TEMPLATES)
+
+  void call()
+  {
+    handler_();
+  }
+
+  void* target() ASIO_NOEXCEPT
+  {
+    return &handler_;
+  }
+
+  Handler& handler() ASIO_NOEXCEPT
+  {
+    return handler_;
+  }
+
+private:
+  Handler handler_;
+};
+
+} // namespace detail
+
+class cancellation_slot;
+
+namespace detail {
+
+void clear_cancellation_slot(cancellation_slot& slot, void* target);
+
+} // namespace detail
+
+/// A cancellation signal with a single slot.
+/**
+ * A cancellation_signal is used to request the cancellation of an individual
+ * asynchronous operation. The signal's slot is associated with the
+ * operation's completion handler, typically by using bind_cancellation_slot.
+ * When the operation starts, it installs a cancellation handler into the
+ * slot. Emitting the signal invokes that handler, which cancels the operation
+ * without affecting any other operations on the same I/O object. A cancelled
+ * operation completes with the asio::error::operation_aborted error.
+ *
+ * A slot may be reused by any number of operations in turn, but by only one
+ * at a time. The memory used to store the installed handler is retained by the
+ * signal and reused, so that connecting an operation does not normally
+ * require an allocation.
+ *
+ * An operation removes its handler from the slot when its completion handler
+ * is invoked, and when its I/O object is closed or destroyed. The signal must
+ * therefore remain valid until the operation connected to its slot has
+ * completed.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe. The signal must be emitted in the same thread,
+ * or on the same strand, as the completion handler of the operation connected
+ * to its slot.
+ *
+ * @par Example
+ * Abandoning a read without cancelling the socket's other operations:
+ * @code
+ * asio::cancellation_signal signal;
+ * ...
+ * socket.async_read_some(asio::buffer(data),
+ *     asio::bind_cancellation_slot(signal.slot(),
+ *       [](std::error_code ec, std::size_t n) { ... }));
+ * ...
+ * signal.emit(); // The read completes with operation_aborted.
+ * @endcode
+ */
+class cancellation_signal
+  : private noncopyable
+{
+public:
+  /// Construct a signal with an empty slot.
+  cancellation_signal()
+    : handler_(0),
+      memory_(0),
+      size_(0)
+  {
+  }
+
+  /// Destructor.
+  /**
+   * Destroys the handler installed in the slot, if any.
+   */
+  ~cancellation_signal()
+  {
+    if (handler_)
+      handler_->~cancellation_handler_base();
+    ::operator delete(memory_);
+  }
+
+  /// Emit the signal.
+  /**
+   * Invokes the handler installed in the slot, if any. Emitting a signal
+   * whose operation has already completed, or whose I/O object has been
+   * closed or destroyed, has no effect.
+   */
+  void emit()
+  {
+    if (handler_)
+      handler_->call();
+  }
+
+  /// Get the slot associated with the signal.
+  cancellation_slot slot() ASIO_NOEXCEPT;
+
+private:
+  friend class cancellation_slot;
+
+  // The handler that is currently installed in the slot.
+  detail::cancellation_handler_base* handler_;
+
+  // The memory used to store an installed handler.
+  void* memory_;
+  std::size_t size_;
+};
+
+/// A slot associated with a cancellation signal.
+/**
+ * A cancellation_slot is a lightweight handle to the slot of a
+ * cancellation_signal. A default-constructed slot is not connected to any
+ * signal, and asynchronous operations do not support cancellation through it.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class cancellation_slot
+{
+public:
+  /// Construct a slot that is not connected to a signal.
+  ASIO_CONSTEXPR cancellation_slot()
+    : signal_(0)
+  {
+  }
+
+#if defined(ASIO_HAS_VARIADIC_TEMPLATES) \
+  || defined(GENERATING_DOCUMENTATION)
+
+  /// Install a new handler into the slot, constructed from the arguments.
+  /**
+   * Any existing handler is destroyed first. The handler must be callable
+   * with the signature <tt>void()</tt>, and is invoked when the signal is
+   * emitted.
+   *
+   * @returns A reference to the newly installed handler.
+   *
+   * @note The slot must be connected to a signal.
+   */
+  template <typename CancellationHandler, typename... Args>
+  CancellationHandler& emplace(ASIO_MOVE_ARG(Args)... args)
+  {
+    typedef detail::cancellation_handler<CancellationHandler> handler_type;
+    handler_type* handler = new (prepare_memory(sizeof(handler_type)))
+      handler_type(ASIO_MOVE_CAST(Args)(args)...);
+    signal_->handler_ = handler;
+    return handler->handler();
+  }
+
+#else // defined(ASIO_HAS_VARIADIC_TEMPLATES)
+      //   || defined(GENERATING_DOCUMENTATION)
+
+  template <typename CancellationHandler>
+  CancellationHandler& emplace()
+  {
+    typedef detail::cancellation_handler<CancellationHandler> handler_type;
+    handler_type* handler = new (prepare_memory(sizeof(handler_type)))
+      handler_type;
+    signal_->handler_ = handler;
+    return handler->handler();
+  }
+
+#define ASIO_PRIVATE_CANCELLATION_SLOT_EMPLACE_DEF(n) \
+  template <typename CancellationHandler, ASIO_VARIADIC_TPARAMS(n)> \
+  CancellationHandler& emplace(ASIO_VARIADIC_MOVE_PARAMS(n)) \
+  { \
+    typedef detail::cancellation_handler<CancellationHandler> handler_type; \
+    handler_type* handler = new (prepare_memory(sizeof(handler_type))) \
+      handler_type(ASIO_VARIADIC_MOVE_ARGS(n)); \
+    signal_->handler_ = handler; \
+    return handler->handler(); \
+  } \
+  /**/
+  ASIO_VARIADIC_GENERATE(ASIO_PRIVATE_CANCELLATION_SLOT_EMPLACE_DEF)
+#undef ASIO_PRIVATE_CANCELLATION_SLOT_EMPLACE_DEF
+
+#endif // defined(ASIO_HAS_VARIADIC_TEMPLATES)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+  /// Install a handler into the slot.
+  /**
+   * Any existing handler is destroyed first. The handler must be callable
+   * with the signature <tt>void()</tt>, and is invoked when the signal is
+   * emitted.
+   *
+   * @returns A reference to the newly installed handler.
+   *
+   * @note The slot must be connected to a signal.
+   */
+  template <typename CancellationHandler>
+  typename decay<CancellationHandler>::type& assign(
+      ASIO_MOVE_ARG(CancellationHandler) handler)
+  {
+    return this->emplace<typename decay<CancellationHandler>::type>(
+        ASIO_MOVE_CAST(CancellationHandler)(handler));
+  }
+
+  /// Destroy the handler installed in the slot, if any.
+  void clear()
+  {
+    if (signal_ && signal_->handler_)
+    {
+      signal_->handler_->~cancellation_handler_base();
+      signal_->handler_ = 0;
+    }
+  }
+
+  /// Determine whether the slot is connected to a signal.
+  ASIO_CONSTEXPR bool is_connected() const ASIO_NOEXCEPT
+  {
+    return signal_ != 0;
+  }
+
+  /// Determine whether the slot has a handler installed.
+  bool has_handler() const ASIO_NOEXCEPT
+  {
+    return signal_ != 0 && signal_->handler_ != 0;
+  }
+
+  /// Compare two slots for equality.
+  friend ASIO_CONSTEXPR bool operator==(const cancellation_slot& lhs,
+      const cancellation_slot& rhs) ASIO_NOEXCEPT
+  {
+    return lhs.signal_ == rhs.signal_;
+  }
+
+  /// Compare two slots for inequality.
+  friend ASIO_CONSTEXPR bool operator!=(const cancellation_slot& lhs,
+      const cancellation_slot& rhs) ASIO_NOEXCEPT
+  {
+    return lhs.signal_ != rhs.signal_;
+  }
+
+private:
+  friend class cancellation_signal;
+  friend void detail::clear_cancellation_slot(
+      cancellation_slot& slot, void* target);
+
+  explicit ASIO_CONSTEXPR cancellation_slot(cancellation_signal* signal)
+    : signal_(signal)
+  {
+  }
+
+  // Get the target of the installed handler, if any.
+  void* handler_target() const ASIO_NOEXCEPT
+  {
+    return signal_ && signal_->handler_ ? signal_->handler_->target() : 0;
+  }
+
+  // Destroy any installed handler and return memory large enough to hold its
+  // replacement, reusing the signal's existing memory where possible.
+  void* prepare_memory(std::size_t size)
+  {
+    clear();
+    if (size > signal_->size_)
+    {
+      void* memory = ::operator new(size);
+      ::operator delete(signal_->memory_);
+      signal_->memory_ = memory;
+      signal_->size_ = size;
+    }
+    return signal_->memory_;
+  }
+
+  cancellation_signal* signal_;
+};
+
+inline cancellation_slot cancellation_signal::slot() ASIO_NOEXCEPT
+{
+  return cancellation_slot(this);
+}
+
+namespace detail {
+
+// Destroy the handler installed in the slot, but only if it is the one with
+// the specified target. The slot may already have been reused by another
+// operation.
+inline void clear_cancellation_slot(cancellation_slot& slot, void* target)
+{
+  if (slot.handler_target() == target)
+    slot.clear();
+}
+
+} // namespace detail
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_CANCELLATION_SIGNAL_HPP
@@ -18,6 +18,7 @@
 #include "asio/detail/config.hpp"
 #include "asio/async_result.hpp"
 #include "asio/basic_socket.hpp"
+#include "asio/detail/chrono.hpp"
 #include "asio/detail/type_traits.hpp"
 #include "asio/error.hpp"
 
@@ -1067,6 +1068,95 @@ async_connect(basic_socket<Protocol, Executor>& s, Iterator begin,
 
 /*@}*/
 
+#if (defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)) \
+  || defined(GENERATING_DOCUMENTATION)
+
+/**
+ * @defgroup async_race_connect asio::async_race_connect
+ *
+ * @brief The @c async_race_connect function is a composed asynchronous
+ * operation that establishes a socket connection by racing staggered
+ * connection attempts to the endpoints in a sequence.
+ */
+/*@{*/
+
+/// Asynchronously establishes a socket connection by racing connection
+/// attempts to the endpoints in a sequence.
+/**
+ * This function implements the connection racing algorithm of RFC 8305
+ * ("Happy Eyeballs"). Rather than waiting for each connection attempt to fail
+ * before trying the next endpoint, it starts a new attempt whenever the
+ * previous one has been outstanding for @c attempt_delay, or as soon as it
+ * fails. The first attempt to succeed wins: all other attempts are cancelled
+ * and the winning connection is moved into @c s.
+ *
+ * The endpoints are tried in the order given, except that endpoints of
+ * different address families are interleaved, starting with the family of
+ * the first endpoint. An unreachable address of one family therefore delays
+ * the attempts of the other family by at most @c attempt_delay.
+ *
+ * @param s The socket to be connected. If the socket is already open, it will
+ * be closed.
+ *
+ * @param endpoints A sequence of endpoints.
+ *
+ * @param attempt_delay The time to wait for an attempt to complete before
+ * starting the next one. RFC 8305 recommends a value of 250 milliseconds.
+ *
+ * @param handler The handler to be called when the connect operation
+ * completes. Copies will be made of the handler as required. The function
+ * signature of the handler must be:
+ * @code void handler(
+ *   // Result of operation. if the sequence is empty, set to
+ *   // asio::error::not_found. Otherwise, contains the
+ *   // error from the last connection attempt to fail.
+ *   const asio::error_code& error,
+ *
+ *   // On success, the successfully connected endpoint.
+ *   // Otherwise, a default-constructed endpoint.
+ *   const typename Protocol::endpoint& endpoint
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. On
+ * immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ *
+ * @par Per-Operation Cancellation
+ * If the handler has an associated cancellation slot, emitting the slot's
+ * signal cancels all outstanding attempts and the operation completes with
+ * asio::error::operation_aborted.
+ *
+ * @par Example
+ * @code void resolve_handler(
+ *     const asio::error_code& ec,
+ *     tcp::resolver::results_type results)
+ * {
+ *   if (!ec)
+ *   {
+ *     asio::async_race_connect(s, results,
+ *         asio::chrono::milliseconds(250), connect_handler);
+ *   }
+ * } @endcode
+ */
+template <typename Protocol, typename Executor, typename EndpointSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      typename Protocol::endpoint)) RangeConnectHandler
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(Executor)>
+ASIO_INITFN_AUTO_RESULT_TYPE(RangeConnectHandler,
+    void (asio::error_code, typename Protocol::endpoint))
+async_race_connect(basic_socket<Protocol, Executor>& s,
+    const EndpointSequence& endpoints,
+    const chrono::steady_clock::duration& attempt_delay,
+    ASIO_MOVE_ARG(RangeConnectHandler) handler
+      ASIO_DEFAULT_COMPLETION_TOKEN(Executor),
+    typename enable_if<is_endpoint_sequence<
+        EndpointSequence>::value>::type* = 0);
+
+/*@}*/
+
+#endif // (defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO))
+       //   || defined(GENERATING_DOCUMENTATION)
+
 } // namespace asio
 
 #include "asio/detail/pop_options.hpp"
@@ -0,0 +1,112 @@
+//
+// detail/allocation_accounting.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_ALLOCATION_ACCOUNTING_HPP
+#define ASIO_DETAIL_ALLOCATION_ACCOUNTING_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Records the number and size of the live internal allocations made on behalf
+// of an execution context, grouped by category.
+class allocation_accounting
+  : private noncopyable
+{
+public:
+  // The categories of allocation. These values must match those of
+  // io_context::allocation_category.
+  enum category
+  {
+    reactor_operations,
+    timer_operations,
+    strand_state,
+    coroutine_frames,
+    resolver_operations,
+    other_operations,
+    pooled_objects,
+    cached_memory,
+    max_categories
+  };
+
+  // The statistics recorded for each category.
+  struct statistics
+  {
+    std::size_t count;
+    std::size_t bytes;
+    std::size_t peak_count;
+    std::size_t peak_bytes;
+  };
+
+  // Constructor.
+  allocation_accounting()
+  {
+    for (int i = 0; i < max_categories; ++i)
+    {
+      statistics_[i].count = 0;
+      statistics_[i].bytes = 0;
+      statistics_[i].peak_count = 0;
+      statistics_[i].peak_bytes = 0;
+    }
+  }
+
+  // Record that an allocation of the specified size has been made.
+  void record_allocation(int c, std::size_t bytes)
+  {
+    mutex::scoped_lock lock(mutex_);
+    statistics& s = statistics_[c];
+    ++s.count;
+    s.bytes += bytes;
+    if (s.count > s.peak_count)
+      s.peak_count = s.count;
+    if (s.bytes > s.peak_bytes)
+      s.peak_bytes = s.bytes;
+  }
+
+  // Record that an allocation of the specified size has been freed.
+  void record_deallocation(int c, std::size_t bytes)
+  {
+    mutex::scoped_lock lock(mutex_);
+    statistics& s = statistics_[c];
+    --s.count;
+    s.bytes -= bytes;
+  }
+
+  // Get the statistics for a category.
+  statistics get_statistics(int c) const
+  {
+    mutex::scoped_lock lock(mutex_);
+    return statistics_[c];
+  }
+
+private:
+  // Mutex to protect access to the statistics.
+  mutable mutex mutex_;
+
+  // The statistics for each category.
+  statistics statistics_[max_categories];
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_ALLOCATION_ACCOUNTING_HPP
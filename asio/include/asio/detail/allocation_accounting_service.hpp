@@ -0,0 +1,124 @@
+//
+// detail/allocation_accounting_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_ALLOCATION_ACCOUNTING_SERVICE_HPP
+#define ASIO_DETAIL_ALLOCATION_ACCOUNTING_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/execution_context.hpp"
+
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+# include "asio/detail/allocation_accounting.hpp"
+# include "asio/detail/noncopyable.hpp"
+# include "asio/detail/thread_context.hpp"
+# include "asio/detail/thread_info_base.hpp"
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class allocation_accounting;
+
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
+// Owns the allocation accounting for an execution context.
+class allocation_accounting_service
+  : public execution_context_service_base<allocation_accounting_service>
+{
+public:
+  // Constructor.
+  explicit allocation_accounting_service(execution_context& context)
+    : execution_context_service_base<allocation_accounting_service>(context)
+  {
+  }
+
+  // Destroy all user-defined handler objects owned by the service.
+  void shutdown()
+  {
+  }
+
+  // Get the accounting object.
+  allocation_accounting& get()
+  {
+    return accounting_;
+  }
+
+private:
+  allocation_accounting accounting_;
+};
+
+// Get the allocation accounting for an execution context.
+inline allocation_accounting* get_allocation_accounting(
+    execution_context& context)
+{
+  return &use_service<allocation_accounting_service>(context).get();
+}
+
+// Records the lifetime of an object against the allocation accounting of the
+// context being run by the constructing thread. Objects created by threads
+// that are not running a context are not recorded.
+template <typename Object>
+class allocation_record
+  : private noncopyable
+{
+public:
+  allocation_record()
+    : accounting_(0)
+  {
+    typedef thread_context::thread_call_stack call_stack;
+    if (thread_info_base* this_thread = call_stack::top())
+      accounting_ = this_thread->get_allocation_accounting();
+    if (accounting_)
+    {
+      accounting_->record_allocation(
+          Object::allocation_category, sizeof(Object));
+    }
+  }
+
+  ~allocation_record()
+  {
+    if (accounting_)
+    {
+      accounting_->record_deallocation(
+          Object::allocation_category, sizeof(Object));
+    }
+  }
+
+private:
+  allocation_accounting* accounting_;
+};
+
+# define ASIO_DEFINE_ALLOCATION_RECORD(object) \
+  ; ::asio::detail::allocation_record<object> allocation_record_ \
+  /**/
+
+#else // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
+inline allocation_accounting* get_allocation_accounting(execution_context&)
+{
+  return 0;
+}
+
+# define ASIO_DEFINE_ALLOCATION_RECORD(object) /**/
+
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_ALLOCATION_ACCOUNTING_SERVICE_HPP
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <vector>
 #include "asio/buffer.hpp"
 #include "asio/detail/array_fwd.hpp"
 #include "asio/detail/socket_types.hpp"
@@ -65,8 +66,10 @@ protected:
   }
 #else // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
 public:
-  // The maximum number of buffers to support in a single operation.
-  enum { max_buffers = 64 < max_iov_len ? 64 : max_iov_len };
+  // The maximum number of buffers to support in a single operation. This is
+  // the platform's I/O vector limit, so that a long buffer sequence may be
+  // transferred using a single system call.
+  enum { max_buffers = max_iov_len };
 
 protected:
   typedef iovec native_buffer_type;
@@ -96,6 +99,12 @@ protected:
     iov.iov_len = buffer.size();
   }
 #endif // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+
+public:
+  // The maximum number of buffers that an adapter holds in-line. Longer
+  // sequences are translated into a heap-allocated array, so that adapters
+  // remain small enough for the stacks of stackful coroutines.
+  enum { max_inline_buffers = max_buffers < 64 ? max_buffers : 64 };
 };
 
 // Helper class to translate buffers into the native buffer representation.
@@ -116,7 +125,7 @@ public:
 
   native_buffer_type* buffers()
   {
-    return buffers_;
+    return overflow_.empty() ? buffers_ : &overflow_[0];
   }
 
   std::size_t count() const
@@ -170,12 +179,30 @@ private:
   void init(Iterator begin, Iterator end)
   {
     Iterator iter = begin;
-    for (; iter != end && count_ < max_buffers; ++iter, ++count_)
+    for (; iter != end && count_ < max_inline_buffers; ++iter, ++count_)
     {
       Buffer buffer(*iter);
       init_native_buffer(buffers_[count_], buffer);
       total_buffer_size_ += buffer.size();
     }
+
+    // Move a longer sequence to the heap.
+    if (iter != end && count_ < max_buffers)
+    {
+      const std::size_t initial_capacity = 2 * max_inline_buffers;
+      overflow_.reserve(
+          initial_capacity < static_cast<std::size_t>(max_buffers)
+            ? initial_capacity : static_cast<std::size_t>(max_buffers));
+      overflow_.assign(buffers_, buffers_ + count_);
+      for (; iter != end && count_ < max_buffers; ++iter, ++count_)
+      {
+        Buffer buffer(*iter);
+        native_buffer_type native_buffer;
+        init_native_buffer(native_buffer, buffer);
+        overflow_.push_back(native_buffer);
+        total_buffer_size_ += buffer.size();
+      }
+    }
   }
 
   template <typename Iterator>
@@ -237,7 +264,8 @@ private:
     return Buffer(storage.data(), storage.size() - unused_storage.size());
   }
 
-  native_buffer_type buffers_[max_buffers];
+  native_buffer_type buffers_[max_inline_buffers];
+  std::vector<native_buffer_type> overflow_;
   std::size_t count_;
   std::size_t total_buffer_size_;
 };
@@ -0,0 +1,104 @@
+//
+// detail/cancellation_completion.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_CANCELLATION_COMPLETION_HPP
+#define ASIO_DETAIL_CANCELLATION_COMPLETION_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/cancellation_signal.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Function object that removes an operation's cancellation handler from its
+// slot before invoking the wrapped completion function. It runs in the context
+// of the completion handler's executor, which is where the signal is emitted.
+template <typename Function>
+class cancellation_completion_function
+{
+public:
+  cancellation_completion_function(Function& function,
+      const cancellation_slot& slot, void* key)
+    : function_(ASIO_MOVE_CAST(Function)(function)),
+      slot_(slot),
+      key_(key)
+  {
+  }
+
+#if defined(ASIO_HAS_MOVE)
+  cancellation_completion_function(const cancellation_completion_function& other)
+    : function_(other.function_),
+      slot_(other.slot_),
+      key_(other.key_)
+  {
+  }
+
+  cancellation_completion_function(cancellation_completion_function&& other)
+    : function_(ASIO_MOVE_CAST(Function)(other.function_)),
+      slot_(other.slot_),
+      key_(other.key_)
+  {
+  }
+#endif // defined(ASIO_HAS_MOVE)
+
+  void operator()()
+  {
+    clear_cancellation_slot(slot_, key_);
+    function_();
+  }
+
+private:
+  Function function_;
+  cancellation_slot slot_;
+  void* key_;
+};
+
+// Helper class used by an operation to make its final upcall. The operation's
+// cancellation state is copied out so that it remains available after the
+// operation's memory has been deallocated.
+class cancellation_completion
+{
+public:
+  template <typename Op>
+  explicit cancellation_completion(Op* o)
+    : slot_(o->cancellation_slot_),
+      key_(o->cancellation_key_)
+  {
+  }
+
+  template <typename Work, typename Function, typename Handler>
+  void complete(Work& w, Function& function, Handler& handler)
+  {
+    if (key_)
+    {
+      cancellation_completion_function<Function> f(function, slot_, key_);
+      w.complete(f, handler);
+    }
+    else
+      w.complete(function, handler);
+  }
+
+private:
+  cancellation_slot slot_;
+  void* key_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_CANCELLATION_COMPLETION_HPP
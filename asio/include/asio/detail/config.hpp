@@ -914,6 +914,37 @@
 # endif // !defined(ASIO_DISABLE_STRING_VIEW)
 #endif // !defined(ASIO_HAS_STRING_VIEW)
 
+// Standard library support for polymorphic memory resources.
+#if !defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+# if !defined(ASIO_DISABLE_STD_MEMORY_RESOURCE)
+#  if defined(__clang__)
+#   if defined(ASIO_HAS_CLANG_LIBCXX)
+#    if (_LIBCPP_VERSION >= 16000) && (__cplusplus >= 201703)
+#     if __has_include(<memory_resource>)
+#      define ASIO_HAS_STD_MEMORY_RESOURCE 1
+#     endif // __has_include(<memory_resource>)
+#    endif // (_LIBCPP_VERSION >= 16000) && (__cplusplus >= 201703)
+#   else // defined(ASIO_HAS_CLANG_LIBCXX)
+#    if (__cplusplus >= 201703)
+#     if __has_include(<memory_resource>)
+#      define ASIO_HAS_STD_MEMORY_RESOURCE 1
+#     endif // __has_include(<memory_resource>)
+#    endif // (__cplusplus >= 201703)
+#   endif // defined(ASIO_HAS_CLANG_LIBCXX)
+#  elif defined(__GNUC__)
+#   if (__GNUC__ >= 9)
+#    if (__cplusplus >= 201703)
+#     define ASIO_HAS_STD_MEMORY_RESOURCE 1
+#    endif // (__cplusplus >= 201703)
+#   endif // (__GNUC__ >= 9)
+#  elif defined(ASIO_MSVC)
+#   if (_MSC_VER >= 1913 && _MSVC_LANG >= 201703)
+#    define ASIO_HAS_STD_MEMORY_RESOURCE 1
+#   endif // (_MSC_VER >= 1913 && _MSVC_LANG >= 201703)
+#  endif // defined(ASIO_MSVC)
+# endif // !defined(ASIO_DISABLE_STD_MEMORY_RESOURCE)
+#endif // !defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+
 // Standard library support for iostream move construction and assignment.
 #if !defined(ASIO_HAS_STD_IOSTREAM_MOVE)
 # if !defined(ASIO_DISABLE_STD_IOSTREAM_MOVE)
@@ -1109,7 +1140,7 @@
 # include <unistd.h>
 #endif // defined(ASIO_HAS_UNISTD_H)
 
-// Linux: epoll, eventfd and timerfd.
+// Linux: epoll, eventfd, timerfd and accept4.
 #if defined(__linux__)
 # include <linux/version.h>
 # if !defined(ASIO_HAS_EPOLL)
@@ -1133,6 +1164,51 @@
 #   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 8)
 #  endif // defined(ASIO_HAS_EPOLL)
 # endif // !defined(ASIO_HAS_TIMERFD)
+# if !defined(ASIO_HAS_ACCEPT4)
+#  if !defined(ASIO_DISABLE_ACCEPT4)
+#   if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 10)
+#    define ASIO_HAS_ACCEPT4 1
+#   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 10)
+#  endif // !defined(ASIO_DISABLE_ACCEPT4)
+# endif // !defined(ASIO_HAS_ACCEPT4)
+# if !defined(ASIO_HAS_MSG_ZEROCOPY)
+#  if !defined(ASIO_DISABLE_MSG_ZEROCOPY)
+#   if defined(ASIO_HAS_EPOLL)
+#    if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27)
+#     define ASIO_HAS_MSG_ZEROCOPY 1
+#    endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27)
+#   endif // defined(ASIO_HAS_EPOLL)
+#  endif // !defined(ASIO_DISABLE_MSG_ZEROCOPY)
+# endif // !defined(ASIO_HAS_MSG_ZEROCOPY)
+# if !defined(ASIO_HAS_TCP_FAST_OPEN)
+#  if !defined(ASIO_DISABLE_TCP_FAST_OPEN)
+#   if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 18)
+#    define ASIO_HAS_TCP_FAST_OPEN 1
+#   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 18)
+#  endif // !defined(ASIO_DISABLE_TCP_FAST_OPEN)
+# endif // !defined(ASIO_HAS_TCP_FAST_OPEN)
+# if !defined(ASIO_HAS_SENDFILE)
+#  if !defined(ASIO_DISABLE_SENDFILE)
+#   define ASIO_HAS_SENDFILE 1
+#  endif // !defined(ASIO_DISABLE_SENDFILE)
+# endif // !defined(ASIO_HAS_SENDFILE)
+# if !defined(ASIO_HAS_SPLICE)
+#  if !defined(ASIO_DISABLE_SPLICE)
+#   define ASIO_HAS_SPLICE 1
+#  endif // !defined(ASIO_DISABLE_SPLICE)
+# endif // !defined(ASIO_HAS_SPLICE)
+# if !defined(ASIO_HAS_MMSG)
+#  if !defined(ASIO_DISABLE_MMSG)
+#   define ASIO_HAS_MMSG 1
+#  endif // !defined(ASIO_DISABLE_MMSG)
+# endif // !defined(ASIO_HAS_MMSG)
+# if !defined(ASIO_HAS_UDP_GSO)
+#  if !defined(ASIO_DISABLE_UDP_GSO)
+#   if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29)
+#    define ASIO_HAS_UDP_GSO 1
+#   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29)
+#  endif // !defined(ASIO_DISABLE_UDP_GSO)
+# endif // !defined(ASIO_HAS_UDP_GSO)
 #endif // defined(__linux__)
 
 // Mac OS X, FreeBSD, NetBSD, OpenBSD: kqueue.
@@ -1240,6 +1316,81 @@
 # endif // !defined(ASIO_DISABLE_LOCAL_SOCKETS)
 #endif // !defined(ASIO_HAS_LOCAL_SOCKETS)
 
+// Multishot accept operations. Requires a reactor-based implementation.
+#if !defined(ASIO_HAS_MULTISHOT_ACCEPT)
+# if !defined(ASIO_DISABLE_MULTISHOT_ACCEPT)
+#  if defined(ASIO_HAS_MOVE) \
+  && !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_WINDOWS_RUNTIME)
+#   define ASIO_HAS_MULTISHOT_ACCEPT 1
+#  endif // defined(ASIO_HAS_MOVE)
+         //   && !defined(ASIO_HAS_IOCP)
+         //   && !defined(ASIO_WINDOWS_RUNTIME)
+# endif // !defined(ASIO_DISABLE_MULTISHOT_ACCEPT)
+#endif // !defined(ASIO_HAS_MULTISHOT_ACCEPT)
+
+// Receive operations that return ancillary data. Requires recvmsg() and a
+// reactor-based implementation.
+#if !defined(ASIO_HAS_RECEIVE_METADATA)
+# if !defined(ASIO_DISABLE_RECEIVE_METADATA)
+#  if !defined(ASIO_WINDOWS) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(__CYGWIN__)
+#   define ASIO_HAS_RECEIVE_METADATA 1
+#  endif // !defined(ASIO_WINDOWS)
+         //   && !defined(ASIO_WINDOWS_RUNTIME)
+         //   && !defined(__CYGWIN__)
+# endif // !defined(ASIO_DISABLE_RECEIVE_METADATA)
+#endif // !defined(ASIO_HAS_RECEIVE_METADATA)
+
+// Read operations that obtain a buffer from a pool once the socket is ready.
+// Requires a reactor-based implementation.
+#if !defined(ASIO_HAS_POOLED_READ)
+# if !defined(ASIO_DISABLE_POOLED_READ)
+#  if !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_WINDOWS_RUNTIME)
+#   define ASIO_HAS_POOLED_READ 1
+#  endif // !defined(ASIO_HAS_IOCP)
+         //   && !defined(ASIO_WINDOWS_RUNTIME)
+# endif // !defined(ASIO_DISABLE_POOLED_READ)
+#endif // !defined(ASIO_HAS_POOLED_READ)
+
+// Multishot receive operations. Requires a reactor-based implementation.
+#if !defined(ASIO_HAS_MULTISHOT_RECEIVE)
+# if !defined(ASIO_DISABLE_MULTISHOT_RECEIVE)
+#  if !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_WINDOWS_RUNTIME)
+#   define ASIO_HAS_MULTISHOT_RECEIVE 1
+#  endif // !defined(ASIO_HAS_IOCP)
+         //   && !defined(ASIO_WINDOWS_RUNTIME)
+# endif // !defined(ASIO_DISABLE_MULTISHOT_RECEIVE)
+#endif // !defined(ASIO_HAS_MULTISHOT_RECEIVE)
+
+// Socket expiry times. Requires a reactor-based implementation.
+#if !defined(ASIO_HAS_SOCKET_EXPIRY)
+# if !defined(ASIO_DISABLE_SOCKET_EXPIRY)
+#  if defined(ASIO_HAS_CHRONO) \
+  && !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_WINDOWS_RUNTIME)
+#   define ASIO_HAS_SOCKET_EXPIRY 1
+#  endif // defined(ASIO_HAS_CHRONO)
+         //   && !defined(ASIO_HAS_IOCP)
+         //   && !defined(ASIO_WINDOWS_RUNTIME)
+# endif // !defined(ASIO_DISABLE_SOCKET_EXPIRY)
+#endif // !defined(ASIO_HAS_SOCKET_EXPIRY)
+
+// Migration of sockets between execution contexts. Requires a reactor-based
+// implementation.
+#if !defined(ASIO_HAS_SOCKET_MIGRATION)
+# if !defined(ASIO_DISABLE_SOCKET_MIGRATION)
+#  if !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_WINDOWS_RUNTIME)
+#   define ASIO_HAS_SOCKET_MIGRATION 1
+#  endif // !defined(ASIO_HAS_IOCP)
+         //   && !defined(ASIO_WINDOWS_RUNTIME)
+# endif // !defined(ASIO_DISABLE_SOCKET_MIGRATION)
+#endif // !defined(ASIO_HAS_SOCKET_MIGRATION)
+
 // Can use sigaction() instead of signal().
 #if !defined(ASIO_HAS_SIGACTION)
 # if !defined(ASIO_DISABLE_SIGACTION)
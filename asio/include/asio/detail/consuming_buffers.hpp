@@ -17,9 +17,11 @@
 
 #include "asio/detail/config.hpp"
 #include <cstddef>
+#include <vector>
 #include "asio/buffer.hpp"
 #include "asio/detail/buffer_sequence_adapter.hpp"
 #include "asio/detail/limits.hpp"
+#include "asio/detail/memory.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -49,21 +51,65 @@ struct prepared_buffers_max<std::array<Elem, N> >
 
 #endif // defined(ASIO_HAS_STD_ARRAY)
 
-// A buffer sequence used to represent a subsequence of the buffers.
+// A buffer sequence used to represent a subsequence of the buffers. Short
+// subsequences are stored in-line. Longer ones, up to the number of buffers
+// that may be transferred in a single operation, are moved to an array that
+// is shared between copies, so that the sequence remains cheap to copy. The
+// array is supplied by the consuming_buffers object, which reuses it for each
+// subsequence once no earlier subsequence refers to it.
 template <typename Buffer, std::size_t MaxBuffers>
 struct prepared_buffers
 {
   typedef Buffer value_type;
   typedef const Buffer* const_iterator;
+  typedef shared_ptr<std::vector<Buffer> > storage_type;
 
-  enum { max_buffers = MaxBuffers < 16 ? MaxBuffers : 16 };
+  enum { max_inline_buffers = MaxBuffers < 16 ? MaxBuffers : 16 };
+  enum { max_buffers =
+    MaxBuffers < static_cast<std::size_t>(
+        buffer_sequence_adapter_base::max_buffers)
+      ? MaxBuffers : static_cast<std::size_t>(
+        buffer_sequence_adapter_base::max_buffers) };
 
   prepared_buffers() : count(0) {}
-  const_iterator begin() const { return elems; }
-  const_iterator end() const { return elems + count; }
 
-  Buffer elems[max_buffers];
+  const_iterator begin() const
+  {
+    return overflow ? &(*overflow)[0] : elems;
+  }
+
+  const_iterator end() const
+  {
+    return begin() + count;
+  }
+
+  void push_back(const Buffer& buffer, storage_type& storage)
+  {
+    if (count < static_cast<std::size_t>(max_inline_buffers))
+      elems[count] = buffer;
+    else
+    {
+      if (!overflow)
+      {
+        if (!storage || storage.use_count() > 1)
+        {
+          storage.reset(new std::vector<Buffer>());
+          const std::size_t initial_capacity = 2 * max_inline_buffers;
+          storage->reserve(
+              initial_capacity < static_cast<std::size_t>(max_buffers)
+                ? initial_capacity : static_cast<std::size_t>(max_buffers));
+        }
+        storage->assign(elems, elems + count);
+        overflow = storage;
+      }
+      overflow->push_back(buffer);
+    }
+    ++count;
+  }
+
+  Buffer elems[max_inline_buffers];
   std::size_t count;
+  storage_type overflow;
 };
 
 // A proxy for a sub-range in a list of buffers.
@@ -101,14 +147,14 @@ public:
 
     std::advance(next, next_elem_);
     std::size_t elem_offset = next_elem_offset_;
-    while (next != end && max_size > 0 && (result.count) < result.max_buffers)
+    while (next != end && max_size > 0
+        && result.count < static_cast<std::size_t>(result.max_buffers))
     {
-      Buffer next_buf = Buffer(*next) + elem_offset;
-      result.elems[result.count] = asio::buffer(next_buf, max_size);
-      max_size -= result.elems[result.count].size();
+      Buffer next_buf = asio::buffer(Buffer(*next) + elem_offset, max_size);
+      max_size -= next_buf.size();
       elem_offset = 0;
-      if (result.elems[result.count].size() > 0)
-        ++result.count;
+      if (next_buf.size() > 0)
+        result.push_back(next_buf, storage_);
       ++next;
     }
 
@@ -154,6 +200,7 @@ private:
   std::size_t total_consumed_;
   std::size_t next_elem_;
   std::size_t next_elem_offset_;
+  typename prepared_buffers_type::storage_type storage_;
 };
 
 // Base class of all consuming_buffers specialisations for single buffers.
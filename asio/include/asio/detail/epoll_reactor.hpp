@@ -66,6 +66,12 @@ public:
     int descriptor_;
     uint32_t registered_events_;
     op_queue<reactor_op> op_queue_[max_ops];
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    // Zero-copy sends waiting for the kernel to release their buffers. These
+    // are kept apart from the except_op queue so that they do not wait behind
+    // out-of-band receives.
+    op_queue<reactor_op> zero_copy_queue_;
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
     bool try_speculative_[max_ops];
     bool shutdown_;
 
@@ -113,6 +119,13 @@ public:
       per_descriptor_data& target_descriptor_data,
       per_descriptor_data& source_descriptor_data);
 
+  // Move a descriptor's registration to another reactor. Returns 0 on success,
+  // system error code on failure. Fails with asio::error::in_progress,
+  // leaving the descriptor registered with this reactor, if any operations are
+  // outstanding for the descriptor.
+  ASIO_DECL int migrate_descriptor(socket_type descriptor,
+      per_descriptor_data& descriptor_data, epoll_reactor& target);
+
   // Post a reactor operation for immediate completion.
   void post_immediate_completion(reactor_op* op, bool is_continuation)
   {
@@ -131,6 +144,19 @@ public:
   ASIO_DECL void cancel_ops(socket_type descriptor,
       per_descriptor_data& descriptor_data);
 
+  // Cancel all operations associated with the given descriptor. The
+  // handlers associated with the descriptor will be invoked with the
+  // specified error.
+  ASIO_DECL void cancel_ops(socket_type descriptor,
+      per_descriptor_data& descriptor_data, const asio::error_code& ec);
+
+  // Cancel the operation of the given type that has the specified
+  // cancellation key. The handler will be invoked with the operation_aborted
+  // error.
+  ASIO_DECL void cancel_ops_by_key(socket_type descriptor,
+      per_descriptor_data& descriptor_data,
+      int op_type, void* cancellation_key);
+
   // Cancel any operations that are running against the descriptor and remove
   // its registration from the reactor. The reactor resources associated with
   // the descriptor must be released by calling cleanup_descriptor_data.
@@ -170,6 +196,12 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& timer,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Cancel the timer operations associated with the given key.
+  template <typename Time_Traits>
+  void cancel_timer_by_key(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data* timer,
+      void* cancellation_key);
+
   // Move the timer operations associated with the given timer.
   template <typename Time_Traits>
   void move_timer(timer_queue<Time_Traits>& queue,
@@ -182,6 +214,18 @@ public:
   // Interrupt the select loop.
   ASIO_DECL void interrupt();
 
+  // Reserve space for the specified number of registered descriptors and
+  // pending timers.
+  ASIO_DECL void reserve(std::size_t descriptors, std::size_t timers);
+
+  // Release timer queue space that is no longer needed.
+  ASIO_DECL void trim_timers();
+
+  // Destroy descriptor state objects that are no longer needed, other than
+  // those still enqueued in the specified queue. The caller must ensure that
+  // no other thread is running the scheduler.
+  ASIO_DECL void trim_descriptors(const op_queue<operation>& pending);
+
 private:
   // The hint to pass to epoll_create to size its data structures.
   enum { epoll_size = 20000 };
@@ -199,6 +243,10 @@ private:
   // Free an existing descriptor state object.
   ASIO_DECL void free_descriptor_state(descriptor_state* s);
 
+  // Predicate used to determine whether a free descriptor state object may be
+  // destroyed.
+  struct descriptor_state_not_enqueued;
+
   // Helper function to add a new timer queue.
   ASIO_DECL void do_add_timer_queue(timer_queue_base& queue);
 
@@ -246,6 +294,9 @@ private:
   // Keep track of all registered descriptors.
   object_pool<descriptor_state> registered_descriptors_;
 
+  // The number of descriptor state objects retained when trimming.
+  std::size_t reserved_descriptors_;
+
   // Helper class to do post-perform_io cleanup.
   struct perform_io_cleanup_on_block_exit;
   friend struct perform_io_cleanup_on_block_exit;
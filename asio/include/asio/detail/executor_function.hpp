@@ -36,6 +36,11 @@ public:
     func_(this, false);
   }
 
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+  // The category used when recording allocations of derived objects.
+  enum { allocation_category = allocation_accounting::other_operations };
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
 protected:
   typedef void (*func_type)(executor_function_base*, bool);
 
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/detail/allocation_accounting_service.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/recycling_allocator.hpp"
@@ -232,6 +233,7 @@ struct get_hook_allocator<Handler, std::allocator<T> >
       } \
     } \
   } \
+  ASIO_DEFINE_ALLOCATION_RECORD(op) \
   /**/
 
 #define ASIO_DEFINE_TAGGED_HANDLER_ALLOCATOR_PTR(purpose, op) \
@@ -272,6 +274,7 @@ struct get_hook_allocator<Handler, std::allocator<T> >
       } \
     } \
   } \
+  ASIO_DEFINE_ALLOCATION_RECORD(op) \
   /**/
 
 #define ASIO_DEFINE_HANDLER_ALLOCATOR_PTR(op) \
@@ -147,6 +147,27 @@ void dev_poll_reactor::move_descriptor(socket_type,
 {
 }
 
+int dev_poll_reactor::migrate_descriptor(socket_type descriptor,
+    dev_poll_reactor::per_descriptor_data&, dev_poll_reactor& target)
+{
+  if (&target == this)
+    return 0;
+
+  asio::detail::mutex::scoped_lock lock(mutex_);
+
+  for (int i = 0; i < max_ops; ++i)
+    if (op_queue_[i].has_operation(descriptor))
+      return asio::error::in_progress;
+
+  // Remove the descriptor from /dev/poll. It is added to the target's when an
+  // operation is started on it.
+  ::pollfd& ev = add_pending_event_change(descriptor);
+  ev.events = POLLREMOVE;
+  interrupter_.interrupt();
+
+  return 0;
+}
+
 void dev_poll_reactor::start_op(int op_type, socket_type descriptor,
     dev_poll_reactor::per_descriptor_data&, reactor_op* op,
     bool is_continuation, bool allow_speculative)
@@ -201,6 +222,26 @@ void dev_poll_reactor::cancel_ops(socket_type descriptor,
   cancel_ops_unlocked(descriptor, asio::error::operation_aborted);
 }
 
+void dev_poll_reactor::cancel_ops(socket_type descriptor,
+    dev_poll_reactor::per_descriptor_data&, const asio::error_code& ec)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  cancel_ops_unlocked(descriptor, ec);
+}
+
+void dev_poll_reactor::cancel_ops_by_key(socket_type descriptor,
+    dev_poll_reactor::per_descriptor_data&,
+    int op_type, void* cancellation_key)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  op_queue<operation> ops;
+  bool need_interrupt = op_queue_[op_type].cancel_operations_by_key(
+      descriptor, ops, cancellation_key, asio::error::operation_aborted);
+  scheduler_.post_deferred_completions(ops);
+  if (need_interrupt)
+    interrupter_.interrupt();
+}
+
 void dev_poll_reactor::deregister_descriptor(socket_type descriptor,
     dev_poll_reactor::per_descriptor_data&, bool)
 {
@@ -212,6 +253,8 @@ void dev_poll_reactor::deregister_descriptor(socket_type descriptor,
   interrupter_.interrupt();
 
   // Cancel any outstanding operations associated with the descriptor.
+  for (int i = 0; i < max_ops; ++i)
+    op_queue_[i].release_cancellation_slots(descriptor);
   cancel_ops_unlocked(descriptor, asio::error::operation_aborted);
 }
 
@@ -382,6 +425,22 @@ int dev_poll_reactor::do_dev_poll_create()
   return fd;
 }
 
+void dev_poll_reactor::reserve(std::size_t, std::size_t timers)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.reserve(timers);
+}
+
+void dev_poll_reactor::trim_timers()
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.trim();
+}
+
+void dev_poll_reactor::trim_descriptors(const op_queue<operation>&)
+{
+}
+
 void dev_poll_reactor::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
@@ -43,7 +43,10 @@ epoll_reactor::epoll_reactor(asio::execution_context& ctx)
     epoll_fd_(do_epoll_create()),
     timer_fd_(do_timerfd_create()),
     shutdown_(false),
-    registered_descriptors_mutex_(mutex_.enabled())
+    registered_descriptors_mutex_(mutex_.enabled()),
+    registered_descriptors_(scheduler_.get_memory_resource(),
+        scheduler_.get_allocation_accounting()),
+    reserved_descriptors_(0)
 {
   // Add the interrupter's descriptor to epoll.
   epoll_event ev = { 0, { 0 } };
@@ -81,6 +84,9 @@ void epoll_reactor::shutdown()
   {
     for (int i = 0; i < max_ops; ++i)
       ops.push(state->op_queue_[i]);
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    ops.push(state->zero_copy_queue_);
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
     state->shutdown_ = true;
     registered_descriptors_.free(state);
   }
@@ -228,6 +234,58 @@ void epoll_reactor::move_descriptor(socket_type,
   source_descriptor_data = 0;
 }
 
+int epoll_reactor::migrate_descriptor(socket_type descriptor,
+    epoll_reactor::per_descriptor_data& descriptor_data,
+    epoll_reactor& target)
+{
+  if (!descriptor_data)
+    return asio::error::bad_descriptor;
+
+  if (&target == this)
+    return 0;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (descriptor_data->shutdown_)
+    return asio::error::operation_aborted;
+
+  for (int i = 0; i < max_ops; ++i)
+    if (!descriptor_data->op_queue_[i].empty())
+      return asio::error::in_progress;
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  if (!descriptor_data->zero_copy_queue_.empty())
+    return asio::error::in_progress;
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+  // Register with the target first, so that a failure leaves the descriptor
+  // usable with this reactor.
+  per_descriptor_data target_descriptor_data = 0;
+  if (int err = target.register_descriptor(descriptor, target_descriptor_data))
+  {
+    target.cleanup_descriptor_data(target_descriptor_data);
+    return err;
+  }
+
+  if (descriptor_data->registered_events_ != 0)
+  {
+    epoll_event ev = { 0, { 0 } };
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, descriptor, &ev);
+  }
+
+  descriptor_data->descriptor_ = -1;
+  descriptor_data->shutdown_ = true;
+
+  descriptor_lock.unlock();
+
+  ASIO_HANDLER_REACTOR_DEREGISTRATION((
+        context(), static_cast<uintmax_t>(descriptor),
+        reinterpret_cast<uintmax_t>(descriptor_data)));
+
+  free_descriptor_state(descriptor_data);
+  descriptor_data = target_descriptor_data;
+  return 0;
+}
+
 void epoll_reactor::start_op(int op_type, socket_type descriptor,
     epoll_reactor::per_descriptor_data& descriptor_data, reactor_op* op,
     bool is_continuation, bool allow_speculative)
@@ -257,6 +315,14 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
       {
         if (reactor_op::status status = op->perform())
         {
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+          if (status == reactor_op::done_and_wait_for_error)
+          {
+            descriptor_data->zero_copy_queue_.push(op);
+            scheduler_.work_started();
+            return;
+          }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
           if (status == reactor_op::done_and_exhausted)
             if (descriptor_data->registered_events_ != 0)
               descriptor_data->try_speculative_[op_type] = false;
@@ -318,8 +384,15 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
   scheduler_.work_started();
 }
 
-void epoll_reactor::cancel_ops(socket_type,
+void epoll_reactor::cancel_ops(socket_type descriptor,
     epoll_reactor::per_descriptor_data& descriptor_data)
+{
+  cancel_ops(descriptor, descriptor_data, asio::error::operation_aborted);
+}
+
+void epoll_reactor::cancel_ops(socket_type,
+    epoll_reactor::per_descriptor_data& descriptor_data,
+    const asio::error_code& ec)
 {
   if (!descriptor_data)
     return;
@@ -331,11 +404,53 @@ void epoll_reactor::cancel_ops(socket_type,
   {
     while (reactor_op* op = descriptor_data->op_queue_[i].front())
     {
-      op->ec_ = asio::error::operation_aborted;
+      op->ec_ = ec;
       descriptor_data->op_queue_[i].pop();
       ops.push(op);
     }
   }
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  while (reactor_op* op = descriptor_data->zero_copy_queue_.front())
+  {
+    op->ec_ = ec;
+    descriptor_data->zero_copy_queue_.pop();
+    ops.push(op);
+  }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+  descriptor_lock.unlock();
+
+  scheduler_.post_deferred_completions(ops);
+}
+
+void epoll_reactor::cancel_ops_by_key(socket_type,
+    epoll_reactor::per_descriptor_data& descriptor_data,
+    int op_type, void* cancellation_key)
+{
+  if (!descriptor_data)
+    return;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  op_queue<operation> ops;
+  op_queue<reactor_op> other_ops;
+  while (reactor_op* op = descriptor_data->op_queue_[op_type].front())
+  {
+    descriptor_data->op_queue_[op_type].pop();
+    if (op->cancellation_key_ == cancellation_key)
+    {
+      op->ec_ = asio::error::operation_aborted;
+      ops.push(op);
+
+      // The operation is no longer pending, so remove its handler from the
+      // slot. This is the handler that is currently being invoked, and it
+      // does not access its members after this function returns.
+      op->release_cancellation_slot();
+    }
+    else
+      other_ops.push(op);
+  }
+  descriptor_data->op_queue_[op_type].push(other_ops);
 
   descriptor_lock.unlock();
 
@@ -371,8 +486,21 @@ void epoll_reactor::deregister_descriptor(socket_type descriptor,
         op->ec_ = asio::error::operation_aborted;
         descriptor_data->op_queue_[i].pop();
         ops.push(op);
+
+        // The descriptor data may be freed once the descriptor is closed, so
+        // the operation can no longer be cancelled through its slot.
+        op->release_cancellation_slot();
       }
     }
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    while (reactor_op* op = descriptor_data->zero_copy_queue_.front())
+    {
+      op->ec_ = asio::error::operation_aborted;
+      descriptor_data->zero_copy_queue_.pop();
+      ops.push(op);
+      op->release_cancellation_slot();
+    }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
 
     descriptor_data->descriptor_ = -1;
     descriptor_data->shutdown_ = true;
@@ -634,6 +762,42 @@ void epoll_reactor::free_descriptor_state(epoll_reactor::descriptor_state* s)
   registered_descriptors_.free(s);
 }
 
+struct epoll_reactor::descriptor_state_not_enqueued
+{
+  bool operator()(descriptor_state* s) const
+  {
+    return !pending_->is_enqueued(s);
+  }
+
+  const op_queue<operation>* pending_;
+};
+
+void epoll_reactor::reserve(std::size_t descriptors, std::size_t timers)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.reserve(timers);
+  lock.unlock();
+
+  mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+  registered_descriptors_.reserve(descriptors,
+      ASIO_CONCURRENCY_HINT_IS_LOCKING(
+        REACTOR_IO, scheduler_.concurrency_hint()));
+  reserved_descriptors_ = descriptors;
+}
+
+void epoll_reactor::trim_timers()
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.trim();
+}
+
+void epoll_reactor::trim_descriptors(const op_queue<operation>& pending)
+{
+  mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+  descriptor_state_not_enqueued not_enqueued = { &pending };
+  registered_descriptors_.trim(reserved_descriptors_, not_enqueued);
+}
+
 void epoll_reactor::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
@@ -729,12 +893,39 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
   perform_io_cleanup_on_block_exit io_cleanup(reactor_);
   mutex::scoped_lock descriptor_lock(mutex_, mutex::scoped_lock::adopt_lock);
 
+  uint32_t except_events = events;
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  // The kernel reports that it has released the buffers of zero-copy sends
+  // using the socket's error queue, which raises EPOLLERR. The reports may
+  // arrive out of order, so every waiting send is checked.
+  if ((events & (EPOLLERR | EPOLLHUP)) && !zero_copy_queue_.empty())
+  {
+    op_queue<reactor_op> waiting_ops;
+    while (reactor_op* op = zero_copy_queue_.front())
+    {
+      zero_copy_queue_.pop();
+      if (op->perform())
+        io_cleanup.ops_.push(op);
+      else
+        waiting_ops.push(op);
+    }
+    zero_copy_queue_.push(waiting_ops);
+
+    // An EPOLLERR raised by these reports is not an exception condition, and
+    // would otherwise fail any outstanding out-of-band receive.
+    if ((events & EPOLLHUP) == 0)
+      except_events &= ~static_cast<uint32_t>(EPOLLERR);
+  }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
   // Exception operations must be processed first to ensure that any
   // out-of-band data is read before normal data.
   static const int flag[max_ops] = { EPOLLIN, EPOLLOUT, EPOLLPRI };
   for (int j = max_ops - 1; j >= 0; --j)
   {
-    if (events & (flag[j] | EPOLLERR | EPOLLHUP))
+    uint32_t ready_events = (j == except_op) ? except_events : events;
+    if (ready_events & (flag[j] | EPOLLERR | EPOLLHUP))
     {
       try_speculative_[j] = true;
       while (reactor_op* op = op_queue_[j].front())
@@ -742,6 +933,13 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
         if (reactor_op::status status = op->perform())
         {
           op_queue_[j].pop();
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+          if (status == reactor_op::done_and_wait_for_error)
+          {
+            zero_copy_queue_.push(op);
+            continue;
+          }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
           io_cleanup.ops_.push(op);
           if (status == reactor_op::done_and_exhausted)
           {
@@ -51,7 +51,10 @@ kqueue_reactor::kqueue_reactor(asio::execution_context& ctx)
     kqueue_fd_(do_kqueue_create()),
     interrupter_(),
     shutdown_(false),
-    registered_descriptors_mutex_(mutex_.enabled())
+    registered_descriptors_mutex_(mutex_.enabled()),
+    registered_descriptors_(scheduler_.get_memory_resource(),
+        scheduler_.get_allocation_accounting()),
+    reserved_descriptors_(0)
 {
   struct kevent events[1];
   ASIO_KQUEUE_EV_SET(&events[0], interrupter_.read_descriptor(),
@@ -190,6 +193,55 @@ void kqueue_reactor::move_descriptor(socket_type,
   source_descriptor_data = 0;
 }
 
+int kqueue_reactor::migrate_descriptor(socket_type descriptor,
+    kqueue_reactor::per_descriptor_data& descriptor_data,
+    kqueue_reactor& target)
+{
+  if (!descriptor_data)
+    return asio::error::bad_descriptor;
+
+  if (&target == this)
+    return 0;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (descriptor_data->shutdown_)
+    return asio::error::operation_aborted;
+
+  for (int i = 0; i < max_ops; ++i)
+    if (!descriptor_data->op_queue_[i].empty())
+      return asio::error::in_progress;
+
+  // Register with the target first, so that a failure leaves the descriptor
+  // usable with this reactor.
+  per_descriptor_data target_descriptor_data = 0;
+  if (int err = target.register_descriptor(descriptor, target_descriptor_data))
+  {
+    target.cleanup_descriptor_data(target_descriptor_data);
+    return err;
+  }
+
+  struct kevent events[2];
+  ASIO_KQUEUE_EV_SET(&events[0], descriptor,
+      EVFILT_READ, EV_DELETE, 0, 0, 0);
+  ASIO_KQUEUE_EV_SET(&events[1], descriptor,
+      EVFILT_WRITE, EV_DELETE, 0, 0, 0);
+  ::kevent(kqueue_fd_, events, descriptor_data->num_kevents_, 0, 0, 0);
+
+  descriptor_data->descriptor_ = -1;
+  descriptor_data->shutdown_ = true;
+
+  descriptor_lock.unlock();
+
+  ASIO_HANDLER_REACTOR_DEREGISTRATION((
+        context(), static_cast<uintmax_t>(descriptor),
+        reinterpret_cast<uintmax_t>(descriptor_data)));
+
+  free_descriptor_state(descriptor_data);
+  descriptor_data = target_descriptor_data;
+  return 0;
+}
+
 void kqueue_reactor::start_op(int op_type, socket_type descriptor,
     kqueue_reactor::per_descriptor_data& descriptor_data, reactor_op* op,
     bool is_continuation, bool allow_speculative)
@@ -262,8 +314,15 @@ void kqueue_reactor::start_op(int op_type, socket_type descriptor,
   scheduler_.work_started();
 }
 
-void kqueue_reactor::cancel_ops(socket_type,
+void kqueue_reactor::cancel_ops(socket_type descriptor,
     kqueue_reactor::per_descriptor_data& descriptor_data)
+{
+  cancel_ops(descriptor, descriptor_data, asio::error::operation_aborted);
+}
+
+void kqueue_reactor::cancel_ops(socket_type,
+    kqueue_reactor::per_descriptor_data& descriptor_data,
+    const asio::error_code& ec)
 {
   if (!descriptor_data)
     return;
@@ -275,7 +334,7 @@ void kqueue_reactor::cancel_ops(socket_type,
   {
     while (reactor_op* op = descriptor_data->op_queue_[i].front())
     {
-      op->ec_ = asio::error::operation_aborted;
+      op->ec_ = ec;
       descriptor_data->op_queue_[i].pop();
       ops.push(op);
     }
@@ -286,6 +345,40 @@ void kqueue_reactor::cancel_ops(socket_type,
   scheduler_.post_deferred_completions(ops);
 }
 
+void kqueue_reactor::cancel_ops_by_key(socket_type,
+    kqueue_reactor::per_descriptor_data& descriptor_data,
+    int op_type, void* cancellation_key)
+{
+  if (!descriptor_data)
+    return;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  op_queue<operation> ops;
+  op_queue<reactor_op> other_ops;
+  while (reactor_op* op = descriptor_data->op_queue_[op_type].front())
+  {
+    descriptor_data->op_queue_[op_type].pop();
+    if (op->cancellation_key_ == cancellation_key)
+    {
+      op->ec_ = asio::error::operation_aborted;
+      ops.push(op);
+
+      // The operation is no longer pending, so remove its handler from the
+      // slot. This is the handler that is currently being invoked, and it
+      // does not access its members after this function returns.
+      op->release_cancellation_slot();
+    }
+    else
+      other_ops.push(op);
+  }
+  descriptor_data->op_queue_[op_type].push(other_ops);
+
+  descriptor_lock.unlock();
+
+  scheduler_.post_deferred_completions(ops);
+}
+
 void kqueue_reactor::deregister_descriptor(socket_type descriptor,
     kqueue_reactor::per_descriptor_data& descriptor_data, bool closing)
 {
@@ -319,6 +412,10 @@ void kqueue_reactor::deregister_descriptor(socket_type descriptor,
         op->ec_ = asio::error::operation_aborted;
         descriptor_data->op_queue_[i].pop();
         ops.push(op);
+
+        // The descriptor data may be freed once the descriptor is closed, so
+        // the operation can no longer be cancelled through its slot.
+        op->release_cancellation_slot();
       }
     }
 
@@ -534,6 +631,42 @@ void kqueue_reactor::free_descriptor_state(kqueue_reactor::descriptor_state* s)
   registered_descriptors_.free(s);
 }
 
+struct kqueue_reactor::descriptor_state_not_enqueued
+{
+  bool operator()(descriptor_state* s) const
+  {
+    return !pending_->is_enqueued(s);
+  }
+
+  const op_queue<operation>* pending_;
+};
+
+void kqueue_reactor::reserve(std::size_t descriptors, std::size_t timers)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.reserve(timers);
+  lock.unlock();
+
+  mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+  registered_descriptors_.reserve(descriptors,
+      ASIO_CONCURRENCY_HINT_IS_LOCKING(
+        REACTOR_IO, scheduler_.concurrency_hint()));
+  reserved_descriptors_ = descriptors;
+}
+
+void kqueue_reactor::trim_timers()
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.trim();
+}
+
+void kqueue_reactor::trim_descriptors(const op_queue<operation>& pending)
+{
+  mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+  descriptor_state_not_enqueued not_enqueued = { &pending };
+  registered_descriptors_.trim(reserved_descriptors_, not_enqueued);
+}
+
 void kqueue_reactor::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
@@ -29,11 +29,25 @@ namespace detail {
 
 reactive_socket_service_base::reactive_socket_service_base(
     execution_context& context)
-  : reactor_(use_service<reactor>(context))
+  : reactor_(use_service<reactor>(context)),
+    multishot_ops_(0)
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+    , scheduler_(use_service<scheduler>(context))
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
 {
   reactor_.init_task();
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+  reactor_.add_timer_queue(timer_queue_);
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
 }
 
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+reactive_socket_service_base::~reactive_socket_service_base()
+{
+  reactor_.remove_timer_queue(timer_queue_);
+}
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
 void reactive_socket_service_base::base_shutdown()
 {
 }
@@ -43,21 +57,49 @@ void reactive_socket_service_base::construct(
 {
   impl.socket_ = invalid_socket;
   impl.state_ = 0;
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  impl.zero_copy_send_state_ = 0;
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+  impl.expiry_ = (expiry_time_type::max)();
+  impl.expiry_op_ = 0;
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
 }
 
 void reactive_socket_service_base::base_move_construct(
     reactive_socket_service_base::base_implementation_type& impl,
+    reactive_socket_service_base& other_service,
     reactive_socket_service_base::base_implementation_type& other_impl)
-  ASIO_NOEXCEPT
 {
+  // A multishot operation remains registered with the service that started
+  // it, so it must be stopped if the socket is moved to another service.
+  if (other_impl.state_ & socket_ops::multishot)
+  {
+    if (&other_service == this)
+      move_multishot_ops(impl, other_impl);
+    else
+      other_service.stop_multishot_ops(other_impl);
+  }
+
   impl.socket_ = other_impl.socket_;
   other_impl.socket_ = invalid_socket;
 
   impl.state_ = other_impl.state_;
   other_impl.state_ = 0;
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  impl.zero_copy_send_state_ = other_impl.zero_copy_send_state_;
+  other_impl.zero_copy_send_state_ = 0;
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
 
   reactor_.move_descriptor(impl.socket_,
       impl.reactor_data_, other_impl.reactor_data_);
+
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+  if (&other_service == this)
+    move_expiry(impl, other_impl);
+  else
+    transfer_expiry(impl, other_service, other_impl);
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
 }
 
 void reactive_socket_service_base::base_move_assign(
@@ -67,11 +109,34 @@ void reactive_socket_service_base::base_move_assign(
 {
   destroy(impl);
 
+  if (other_impl.state_ & socket_ops::multishot)
+  {
+    if (&other_service == this)
+      move_multishot_ops(impl, other_impl);
+    else
+      other_service.stop_multishot_ops(other_impl);
+  }
+
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+  if (&other_service == this)
+    move_expiry(impl, other_impl);
+  else
+  {
+    other_service.stop_expiry(other_impl);
+    impl.expiry_ = other_impl.expiry_;
+    other_impl.expiry_ = (expiry_time_type::max)();
+  }
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
   impl.socket_ = other_impl.socket_;
   other_impl.socket_ = invalid_socket;
 
   impl.state_ = other_impl.state_;
   other_impl.state_ = 0;
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  impl.zero_copy_send_state_ = other_impl.zero_copy_send_state_;
+  other_impl.zero_copy_send_state_ = 0;
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
 
   other_service.reactor_.move_descriptor(impl.socket_,
       impl.reactor_data_, other_impl.reactor_data_);
@@ -85,8 +150,19 @@ void reactive_socket_service_base::destroy(
     ASIO_HANDLER_OPERATION((reactor_.context(),
           "socket", &impl, impl.socket_, "close"));
 
+    if (impl.state_ & socket_ops::multishot)
+      stop_multishot_ops(impl);
+
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+    stop_expiry(impl);
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
     reactor_.deregister_descriptor(impl.socket_, impl.reactor_data_,
         (impl.state_ & socket_ops::possible_dup) == 0);
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    delete impl.zero_copy_send_state_;
+    impl.zero_copy_send_state_ = 0;
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
 
     asio::error_code ignored_ec;
     socket_ops::close(impl.socket_, impl.state_, true, ignored_ec);
@@ -104,8 +180,19 @@ asio::error_code reactive_socket_service_base::close(
     ASIO_HANDLER_OPERATION((reactor_.context(),
           "socket", &impl, impl.socket_, "close"));
 
+    if (impl.state_ & socket_ops::multishot)
+      stop_multishot_ops(impl);
+
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+    stop_expiry(impl);
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
     reactor_.deregister_descriptor(impl.socket_, impl.reactor_data_,
         (impl.state_ & socket_ops::possible_dup) == 0);
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    delete impl.zero_copy_send_state_;
+    impl.zero_copy_send_state_ = 0;
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
 
     socket_ops::close(impl.socket_, impl.state_, false, ec);
 
@@ -142,14 +229,106 @@ socket_type reactive_socket_service_base::release(
   ASIO_HANDLER_OPERATION((reactor_.context(),
         "socket", &impl, impl.socket_, "release"));
 
+  if (impl.state_ & socket_ops::multishot)
+    stop_multishot_ops(impl);
+
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+  stop_expiry(impl);
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
   reactor_.deregister_descriptor(impl.socket_, impl.reactor_data_, false);
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  delete impl.zero_copy_send_state_;
+  impl.zero_copy_send_state_ = 0;
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
   reactor_.cleanup_descriptor_data(impl.reactor_data_);
+
+  // The socket may have been put into non-blocking mode when it was created or
+  // by an asynchronous operation. Unless the user asked for non-blocking mode,
+  // return the socket to the caller in blocking mode.
+  if ((impl.state_ & socket_ops::internal_non_blocking) != 0
+      && (impl.state_ & socket_ops::user_set_non_blocking) == 0)
+  {
+    asio::error_code ignored_ec;
+    socket_ops::set_internal_non_blocking(
+        impl.socket_, impl.state_, false, ignored_ec);
+  }
+
   socket_type sock = impl.socket_;
   construct(impl);
   ec = asio::error_code();
   return sock;
 }
 
+#if defined(ASIO_HAS_SOCKET_MIGRATION)
+asio::error_code reactive_socket_service_base::migrate(
+    reactive_socket_service_base::base_implementation_type& impl,
+    reactive_socket_service_base& target_service, asio::error_code& ec)
+{
+  if (&target_service == this || !is_open(impl))
+  {
+    ec = asio::error_code();
+    return ec;
+  }
+
+  ASIO_HANDLER_OPERATION((reactor_.context(),
+        "socket", &impl, impl.socket_, "migrate"));
+
+  // A multishot operation remains registered with this service between the
+  // delivery of its results and its restart, even though the reactor has no
+  // operation queued for it.
+  if (impl.state_ & socket_ops::multishot)
+  {
+    mutex::scoped_lock lock(mutex_);
+    for (reactive_socket_multishot_op_base* op = multishot_ops_;
+        op; op = op->next_)
+    {
+      if (op->impl_ == &impl)
+      {
+        ec = asio::error::in_progress;
+        return ec;
+      }
+    }
+  }
+
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+  // Prevent the expiry operation from using the reactor registration while it
+  // is being moved.
+  mutex::scoped_lock expiry_lock(expiry_mutex_);
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
+  if (int err = reactor_.migrate_descriptor(impl.socket_,
+        impl.reactor_data_, target_service.reactor_))
+  {
+    ec = asio::error_code(err,
+        asio::error::get_system_category());
+    return ec;
+  }
+
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+  // The expiry time is retained, and the target service creates its own
+  // expiry operation when one is next needed.
+  if (reactive_socket_expiry_op* op = impl.expiry_op_)
+  {
+    impl.expiry_op_ = 0;
+    if (op->armed_)
+    {
+      // The operation destroys itself when it completes.
+      op->impl_ = 0;
+      reactor_.cancel_timer(timer_queue_, op->timer_data_);
+    }
+    else
+    {
+      delete op;
+    }
+  }
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
+  ec = asio::error_code();
+  return ec;
+}
+#endif // defined(ASIO_HAS_SOCKET_MIGRATION)
+
 asio::error_code reactive_socket_service_base::cancel(
     reactive_socket_service_base::base_implementation_type& impl,
     asio::error_code& ec)
@@ -163,11 +342,64 @@ asio::error_code reactive_socket_service_base::cancel(
   ASIO_HANDLER_OPERATION((reactor_.context(),
         "socket", &impl, impl.socket_, "cancel"));
 
+  if (impl.state_ & socket_ops::multishot)
+    stop_multishot_ops(impl);
+
   reactor_.cancel_ops(impl.socket_, impl.reactor_data_);
   ec = asio::error_code();
   return ec;
 }
 
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+void reactive_socket_service_base::expires_at(
+    reactive_socket_service_base::base_implementation_type& impl,
+    const expiry_time_type& expiry_time)
+{
+  // A multishot operation reads the expiry time when it is restarted, which
+  // happens with the multishot mutex held.
+  mutex::scoped_lock lock(mutex_);
+  mutex::scoped_lock expiry_lock(expiry_mutex_);
+
+  impl.expiry_ = expiry_time;
+
+  // A waiting expiry operation sees a later expiry time when it completes and
+  // reschedules itself, but must be woken to see an earlier one.
+  if (reactive_socket_expiry_op* op = impl.expiry_op_)
+    if (op->armed_ && expiry_time < op->time_)
+      reactor_.cancel_timer(timer_queue_, op->timer_data_);
+}
+
+void reactive_socket_service_base::handle_expiry(
+    reactive_socket_expiry_op* op, bool owner)
+{
+  mutex::scoped_lock lock(expiry_mutex_);
+
+  op->armed_ = false;
+  if (!op->impl_)
+  {
+    lock.unlock();
+    delete op;
+  }
+  else if (owner)
+  {
+    expiry_time_type expiry_time = op->impl_->expiry_;
+    if (expiry_time <= expiry_time_traits::now())
+    {
+      reactor_.cancel_ops(op->socket_, op->reactor_data_,
+          asio::error::timed_out);
+    }
+    else if (expiry_time != (expiry_time_type::max)())
+    {
+      schedule_expiry(op, expiry_time);
+    }
+  }
+
+  // The completion of an expiry operation is not counted as work.
+  if (owner)
+    scheduler_.compensating_work_started();
+}
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
 asio::error_code reactive_socket_service_base::do_open(
     reactive_socket_service_base::base_implementation_type& impl,
     int af, int type, int protocol, asio::error_code& ec)
@@ -178,7 +410,8 @@ asio::error_code reactive_socket_service_base::do_open(
     return ec;
   }
 
-  socket_holder sock(socket_ops::socket(af, type, protocol, ec));
+  socket_ops::state_type state = 0;
+  socket_holder sock(socket_ops::socket(af, type, protocol, state, ec));
   if (sock.get() == invalid_socket)
     return ec;
 
@@ -196,6 +429,7 @@ asio::error_code reactive_socket_service_base::do_open(
   case SOCK_DGRAM: impl.state_ = socket_ops::datagram_oriented; break;
   default: impl.state_ = 0; break;
   }
+  impl.state_ |= state;
   ec = asio::error_code();
   return ec;
 }
@@ -203,7 +437,7 @@ asio::error_code reactive_socket_service_base::do_open(
 asio::error_code reactive_socket_service_base::do_assign(
     reactive_socket_service_base::base_implementation_type& impl, int type,
     const reactive_socket_service_base::native_handle_type& native_socket,
-    asio::error_code& ec)
+    socket_ops::state_type state, asio::error_code& ec)
 {
   if (is_open(impl))
   {
@@ -226,7 +460,7 @@ asio::error_code reactive_socket_service_base::do_assign(
   case SOCK_DGRAM: impl.state_ = socket_ops::datagram_oriented; break;
   default: impl.state_ = 0; break;
   }
-  impl.state_ |= socket_ops::possible_dup;
+  impl.state_ |= state;
   ec = asio::error_code();
   return ec;
 }
@@ -242,6 +476,15 @@ void reactive_socket_service_base::start_op(
         || socket_ops::set_internal_non_blocking(
           impl.socket_, impl.state_, true, op->ec_))
     {
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+      if (impl.expiry_ != (expiry_time_type::max)())
+      {
+        start_op_with_expiry(impl, op_type, op,
+            is_continuation, is_non_blocking);
+        return;
+      }
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
       reactor_.start_op(op_type, impl.socket_,
           impl.reactor_data_, op, is_continuation, is_non_blocking);
       return;
@@ -269,6 +512,17 @@ void reactive_socket_service_base::start_connect_op(
     reactor_op* op, bool is_continuation,
     const socket_addr_type* addr, size_t addrlen)
 {
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+  // Do not start connecting if the expiry time has already been reached.
+  if (impl.expiry_ != (expiry_time_type::max)()
+      && impl.expiry_ <= expiry_time_traits::now())
+  {
+    op->ec_ = asio::error::timed_out;
+    reactor_.post_immediate_completion(op, is_continuation);
+    return;
+  }
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
   if ((impl.state_ & socket_ops::non_blocking)
       || socket_ops::set_internal_non_blocking(
         impl.socket_, impl.state_, true, op->ec_))
@@ -279,6 +533,15 @@ void reactive_socket_service_base::start_connect_op(
           || op->ec_ == asio::error::would_block)
       {
         op->ec_ = asio::error_code();
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+        if (impl.expiry_ != (expiry_time_type::max)())
+        {
+          start_op_with_expiry(impl, reactor::connect_op,
+              op, is_continuation, false);
+          return;
+        }
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
         reactor_.start_op(reactor::connect_op, impl.socket_,
             impl.reactor_data_, op, is_continuation, false);
         return;
@@ -289,6 +552,308 @@ void reactive_socket_service_base::start_connect_op(
   reactor_.post_immediate_completion(op, is_continuation);
 }
 
+#if defined(ASIO_HAS_TCP_FAST_OPEN)
+void reactive_socket_service_base::start_fast_open_connect_op(
+    reactive_socket_service_base::base_implementation_type& impl,
+    reactor_op* op, bool is_continuation, const socket_addr_type* addr,
+    size_t addrlen, const socket_ops::buf* bufs, size_t count)
+{
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+  // Do not start connecting if the expiry time has already been reached.
+  if (impl.expiry_ != (expiry_time_type::max)()
+      && impl.expiry_ <= expiry_time_traits::now())
+  {
+    op->ec_ = asio::error::timed_out;
+    reactor_.post_immediate_completion(op, is_continuation);
+    return;
+  }
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
+  if ((impl.state_ & socket_ops::non_blocking)
+      || socket_ops::set_internal_non_blocking(
+        impl.socket_, impl.state_, true, op->ec_))
+  {
+    // Starts the connect. If the kernel holds a Fast Open cookie for the peer
+    // then some or all of the data goes out with the SYN and the number of
+    // bytes is returned. Otherwise the connect proceeds normally, the data is
+    // not sent, and the call fails with EINPROGRESS.
+    signed_size_type bytes = socket_ops::sendto(impl.socket_,
+        bufs, count, MSG_FASTOPEN, addr, addrlen, op->ec_);
+    if (bytes >= 0
+        || op->ec_ == asio::error::in_progress
+        || op->ec_ == asio::error::would_block)
+    {
+      op->ec_ = asio::error_code();
+      op->bytes_transferred_ = bytes > 0 ? bytes : 0;
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+      if (impl.expiry_ != (expiry_time_type::max)())
+      {
+        start_op_with_expiry(impl, reactor::connect_op,
+            op, is_continuation, false);
+        return;
+      }
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
+      reactor_.start_op(reactor::connect_op, impl.socket_,
+          impl.reactor_data_, op, is_continuation, false);
+      return;
+    }
+
+    // Client-side Fast Open is disabled by the net.ipv4.tcp_fastopen sysctl,
+    // so fall back to an ordinary connect.
+    if (op->ec_ == asio::error::operation_not_supported)
+    {
+      op->ec_ = asio::error_code();
+      start_connect_op(impl, op, is_continuation, addr, addrlen);
+      return;
+    }
+  }
+
+  reactor_.post_immediate_completion(op, is_continuation);
+}
+#endif // defined(ASIO_HAS_TCP_FAST_OPEN)
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+zero_copy_send_state* reactive_socket_service_base::enable_zero_copy_send(
+    reactive_socket_service_base::base_implementation_type& impl)
+{
+  if (!impl.zero_copy_send_state_ && is_open(impl))
+  {
+    // Zero-copy sends are not supported by all socket types or kernels. The
+    // state is still created, to prevent repeated attempts to enable them.
+    int optval = 1;
+    asio::error_code ec;
+    socket_ops::setsockopt(impl.socket_, impl.state_, SOL_SOCKET,
+        SO_ZEROCOPY, &optval, sizeof(optval), ec);
+    impl.zero_copy_send_state_ = new zero_copy_send_state(!ec);
+  }
+  return impl.zero_copy_send_state_;
+}
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+void reactive_socket_service_base::start_multishot_op(
+    reactive_socket_service_base::base_implementation_type& impl,
+    reactive_socket_multishot_op_base* op, bool is_continuation)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  op->impl_ = &impl;
+  op->next_ = multishot_ops_;
+  op->prev_ = 0;
+  if (multishot_ops_)
+    multishot_ops_->prev_ = op;
+  multishot_ops_ = op;
+
+  op->socket_ = impl.socket_;
+  op->state_ = impl.state_;
+  impl.state_ |= socket_ops::multishot;
+
+  // The lock is held while starting the operation so that it cannot race
+  // with the socket being cancelled, closed or destroyed.
+  start_op(impl, reactor::read_op, op, is_continuation, true, false);
+}
+
+bool reactive_socket_service_base::restart_multishot_op(
+    reactive_socket_multishot_op_base* op)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  if (!op->impl_)
+  {
+    op->ec_ = asio::error::operation_aborted;
+    return false;
+  }
+
+  op->socket_ = op->impl_->socket_;
+  op->state_ = op->impl_->state_;
+  start_op(*op->impl_, reactor::read_op, op, true, true, false);
+  return true;
+}
+
+bool reactive_socket_service_base::resume_multishot_op(
+    reactive_socket_multishot_op_base* op)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  if (!op->impl_)
+  {
+    op->ec_ = asio::error::operation_aborted;
+    return false;
+  }
+
+  op->socket_ = op->impl_->socket_;
+  op->state_ = op->impl_->state_;
+  return true;
+}
+
+void reactive_socket_service_base::end_multishot_op(
+    reactive_socket_multishot_op_base* op)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  if (op->impl_)
+    remove_multishot_op(op);
+}
+
+void reactive_socket_service_base::stop_multishot_ops(
+    reactive_socket_service_base::base_implementation_type& impl)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  reactive_socket_multishot_op_base* op = multishot_ops_;
+  while (op)
+  {
+    reactive_socket_multishot_op_base* next_op = op->next_;
+    if (op->impl_ == &impl)
+      remove_multishot_op(op);
+    op = next_op;
+  }
+
+  impl.state_ &= ~socket_ops::multishot;
+}
+
+void reactive_socket_service_base::remove_multishot_op(
+  reactive_socket_multishot_op_base* op)
+{
+  if (multishot_ops_ == op)
+    multishot_ops_ = op->next_;
+  if (op->prev_)
+    op->prev_->next_ = op->next_;
+  if (op->next_)
+    op->next_->prev_ = op->prev_;
+  op->next_ = 0;
+  op->prev_ = 0;
+  op->impl_ = 0;
+}
+
+void reactive_socket_service_base::move_multishot_ops(
+    reactive_socket_service_base::base_implementation_type& impl,
+    reactive_socket_service_base::base_implementation_type& other_impl)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  for (reactive_socket_multishot_op_base* op = multishot_ops_;
+      op; op = op->next_)
+  {
+    if (op->impl_ == &other_impl)
+      op->impl_ = &impl;
+  }
+}
+
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+void reactive_socket_service_base::start_op_with_expiry(
+    reactive_socket_service_base::base_implementation_type& impl,
+    int op_type, reactor_op* op, bool is_continuation,
+    bool allow_speculative)
+{
+  mutex::scoped_lock lock(expiry_mutex_);
+
+  if (impl.expiry_ <= expiry_time_traits::now())
+  {
+    lock.unlock();
+    op->ec_ = asio::error::timed_out;
+    reactor_.post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  reactive_socket_expiry_op* expiry_op = impl.expiry_op_;
+  if (!expiry_op)
+    expiry_op = impl.expiry_op_ = new reactive_socket_expiry_op(*this, impl);
+
+  // The lock is not held while starting the operation, as the mutex is shared
+  // by all of the service's sockets.
+  lock.unlock();
+  reactor_.start_op(op_type, impl.socket_,
+      impl.reactor_data_, op, is_continuation, allow_speculative);
+  lock.lock();
+
+  expiry_op->socket_ = impl.socket_;
+  expiry_op->reactor_data_ = impl.reactor_data_;
+  if (!expiry_op->armed_)
+    schedule_expiry(expiry_op, impl.expiry_);
+}
+
+void reactive_socket_service_base::schedule_expiry(
+    reactive_socket_expiry_op* op, const expiry_time_type& expiry_time)
+{
+  op->time_ = expiry_time;
+  op->armed_ = true;
+  reactor_.schedule_timer(timer_queue_, expiry_time, op->timer_data_, op);
+
+  // A waiting expiry operation must not, by itself, keep the scheduler
+  // running. It is only ever scheduled while an operation is outstanding, so
+  // this cannot cause the scheduler to run out of work.
+  scheduler_.work_finished();
+}
+
+bool reactive_socket_service_base::stop_expiry(
+    reactive_socket_service_base::base_implementation_type& impl)
+{
+  if (reactive_socket_expiry_op* op = impl.expiry_op_)
+  {
+    mutex::scoped_lock lock(expiry_mutex_);
+
+    impl.expiry_op_ = 0;
+    if (op->armed_)
+    {
+      // The operation destroys itself when it completes.
+      op->impl_ = 0;
+      reactor_.cancel_timer(timer_queue_, op->timer_data_);
+      return true;
+    }
+    else
+    {
+      lock.unlock();
+      delete op;
+    }
+  }
+  return false;
+}
+
+void reactive_socket_service_base::move_expiry(
+    reactive_socket_service_base::base_implementation_type& impl,
+    reactive_socket_service_base::base_implementation_type& other_impl)
+{
+  impl.expiry_ = other_impl.expiry_;
+  impl.expiry_op_ = other_impl.expiry_op_;
+
+  // The expiry operation must see a valid expiry time throughout the move.
+  if (impl.expiry_op_)
+  {
+    mutex::scoped_lock lock(expiry_mutex_);
+    impl.expiry_op_->impl_ = &impl;
+  }
+
+  other_impl.expiry_ = (expiry_time_type::max)();
+  other_impl.expiry_op_ = 0;
+}
+
+void reactive_socket_service_base::transfer_expiry(
+    reactive_socket_service_base::base_implementation_type& impl,
+    reactive_socket_service_base& other_service,
+    reactive_socket_service_base::base_implementation_type& other_impl)
+{
+  // The other service's expiry operation is in that service's timer queue,
+  // so it is stopped and replaced by one belonging to this service.
+  bool armed = other_service.stop_expiry(other_impl);
+
+  impl.expiry_ = other_impl.expiry_;
+  impl.expiry_op_ = 0;
+  other_impl.expiry_ = (expiry_time_type::max)();
+
+  // Any outstanding operations continue to wait for the expiry time.
+  if (armed && impl.expiry_ != (expiry_time_type::max)())
+  {
+    mutex::scoped_lock lock(expiry_mutex_);
+    reactive_socket_expiry_op* op = impl.expiry_op_ =
+      new reactive_socket_expiry_op(*this, impl);
+    op->socket_ = impl.socket_;
+    op->reactor_data_ = impl.reactor_data_;
+    schedule_expiry(op, impl.expiry_);
+  }
+}
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
 } // namespace detail
 } // namespace asio
 
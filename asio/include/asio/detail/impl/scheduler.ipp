@@ -103,6 +103,25 @@ struct scheduler::work_cleanup
   thread_info* this_thread_;
 };
 
+struct scheduler::running_thread
+{
+  explicit running_thread(scheduler* s)
+    : scheduler_(thread_call_stack::contains(s) ? 0 : s)
+  {
+    // Nested calls are counted only once per thread.
+    if (scheduler_)
+      ++scheduler_->running_threads_;
+  }
+
+  ~running_thread()
+  {
+    if (scheduler_)
+      --scheduler_->running_threads_;
+  }
+
+  scheduler* scheduler_;
+};
+
 scheduler::scheduler(asio::execution_context& ctx,
     int concurrency_hint, bool own_thread)
   : asio::detail::execution_context_service_base<scheduler>(ctx),
@@ -116,9 +135,12 @@ scheduler::scheduler(asio::execution_context& ctx,
     task_(0),
     task_interrupted_(true),
     outstanding_work_(0),
+    running_threads_(0),
     stopped_(false),
     shutdown_(false),
     concurrency_hint_(concurrency_hint),
+    memory_resource_(asio::detail::get_memory_resource(ctx)),
+    allocation_accounting_(asio::detail::get_allocation_accounting(ctx)),
     thread_(0)
 {
   ASIO_HANDLER_TRACKING_INIT;
@@ -193,7 +215,8 @@ std::size_t scheduler::run(asio::error_code& ec)
     return 0;
   }
 
-  thread_info this_thread;
+  running_thread running(this);
+  thread_info this_thread(memory_resource_, allocation_accounting_);
   this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
 
@@ -215,7 +238,8 @@ std::size_t scheduler::run_one(asio::error_code& ec)
     return 0;
   }
 
-  thread_info this_thread;
+  running_thread running(this);
+  thread_info this_thread(memory_resource_, allocation_accounting_);
   this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
 
@@ -233,7 +257,8 @@ std::size_t scheduler::wait_one(long usec, asio::error_code& ec)
     return 0;
   }
 
-  thread_info this_thread;
+  running_thread running(this);
+  thread_info this_thread(memory_resource_, allocation_accounting_);
   this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
 
@@ -251,7 +276,8 @@ std::size_t scheduler::poll(asio::error_code& ec)
     return 0;
   }
 
-  thread_info this_thread;
+  running_thread running(this);
+  thread_info this_thread(memory_resource_, allocation_accounting_);
   this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
 
@@ -282,7 +308,8 @@ std::size_t scheduler::poll_one(asio::error_code& ec)
     return 0;
   }
 
-  thread_info this_thread;
+  running_thread running(this);
+  thread_info this_thread(memory_resource_, allocation_accounting_);
   this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
 
@@ -318,6 +345,39 @@ void scheduler::restart()
   stopped_ = false;
 }
 
+void scheduler::reserve(std::size_t descriptors, std::size_t timers)
+{
+  init_task();
+
+  mutex::scoped_lock lock(mutex_);
+  reactor* task = task_;
+  lock.unlock();
+
+  if (task)
+    task->reserve(descriptors, timers);
+}
+
+void scheduler::trim()
+{
+  thread_info_base* this_thread = thread_call_stack::contains(this);
+  if (this_thread)
+    this_thread->release_cached_memory();
+
+  mutex::scoped_lock lock(mutex_);
+  reactor* task = task_;
+
+  // Descriptor state objects may still be referenced by operations that the
+  // task has returned to other threads, so they are only destroyed when no
+  // other thread is running the scheduler. Holding the lock prevents any new
+  // thread from dequeuing such an operation.
+  if (task && running_threads_ == (this_thread ? 1 : 0))
+    task->trim_descriptors(op_queue_);
+  lock.unlock();
+
+  if (task)
+    task->trim_timers();
+}
+
 void scheduler::compensating_work_started()
 {
   thread_info_base* this_thread = thread_call_stack::contains(this);
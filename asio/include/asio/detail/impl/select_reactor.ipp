@@ -140,6 +140,23 @@ void select_reactor::move_descriptor(socket_type,
 {
 }
 
+int select_reactor::migrate_descriptor(socket_type descriptor,
+    select_reactor::per_descriptor_data&, select_reactor& target)
+{
+  if (&target == this)
+    return 0;
+
+  asio::detail::mutex::scoped_lock lock(mutex_);
+
+  for (int i = 0; i < max_ops; ++i)
+    if (op_queue_[i].has_operation(descriptor))
+      return asio::error::in_progress;
+
+  // The descriptor is only added to the target's fd sets when an operation is
+  // started on it, so there is nothing further to do.
+  return 0;
+}
+
 void select_reactor::start_op(int op_type, socket_type descriptor,
     select_reactor::per_descriptor_data&, reactor_op* op,
     bool is_continuation, bool)
@@ -165,10 +182,32 @@ void select_reactor::cancel_ops(socket_type descriptor,
   cancel_ops_unlocked(descriptor, asio::error::operation_aborted);
 }
 
+void select_reactor::cancel_ops(socket_type descriptor,
+    select_reactor::per_descriptor_data&, const asio::error_code& ec)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  cancel_ops_unlocked(descriptor, ec);
+}
+
+void select_reactor::cancel_ops_by_key(socket_type descriptor,
+    select_reactor::per_descriptor_data&,
+    int op_type, void* cancellation_key)
+{
+  asio::detail::mutex::scoped_lock lock(mutex_);
+  op_queue<operation> ops;
+  bool need_interrupt = op_queue_[op_type].cancel_operations_by_key(
+      descriptor, ops, cancellation_key, asio::error::operation_aborted);
+  scheduler_.post_deferred_completions(ops);
+  if (need_interrupt)
+    interrupter_.interrupt();
+}
+
 void select_reactor::deregister_descriptor(socket_type descriptor,
     select_reactor::per_descriptor_data&, bool)
 {
   asio::detail::mutex::scoped_lock lock(mutex_);
+  for (int i = 0; i < max_ops; ++i)
+    op_queue_[i].release_cancellation_slots(descriptor);
   cancel_ops_unlocked(descriptor, asio::error::operation_aborted);
 }
 
@@ -287,6 +326,22 @@ void select_reactor::run_thread()
 }
 #endif // defined(ASIO_HAS_IOCP)
 
+void select_reactor::reserve(std::size_t, std::size_t timers)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.reserve(timers);
+}
+
+void select_reactor::trim_timers()
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.trim();
+}
+
+void select_reactor::trim_descriptors(const op_queue<operation>&)
+{
+}
+
 void select_reactor::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
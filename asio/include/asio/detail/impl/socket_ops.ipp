@@ -41,6 +41,10 @@
 #endif // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
        // || defined(__MACH__) && defined(__APPLE__)
 
+#if defined(ASIO_HAS_SENDFILE)
+# include <sys/sendfile.h>
+#endif // defined(ASIO_HAS_SENDFILE)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -103,16 +107,46 @@ inline socket_type call_accept(SockLenType msghdr::*,
   return result;
 }
 
-socket_type accept(socket_type s, socket_addr_type* addr,
-    std::size_t* addrlen, asio::error_code& ec)
+#if defined(ASIO_HAS_ACCEPT4)
+template <typename SockLenType>
+inline socket_type call_accept4(SockLenType msghdr::*, socket_type s,
+    socket_addr_type* addr, std::size_t* addrlen, int flags)
+{
+  SockLenType tmp_addrlen = addrlen ? (SockLenType)*addrlen : 0;
+  socket_type result = ::accept4(s, addr, addrlen ? &tmp_addrlen : 0, flags);
+  if (addrlen)
+    *addrlen = (std::size_t)tmp_addrlen;
+  return result;
+}
+#endif // defined(ASIO_HAS_ACCEPT4)
+
+inline socket_type accept_socket(socket_type s, socket_addr_type* addr,
+    std::size_t* addrlen, bool non_blocking, state_type& new_state,
+    asio::error_code& ec)
 {
+  new_state = 0;
+
   if (s == invalid_socket)
   {
     ec = asio::error::bad_descriptor;
     return invalid_socket;
   }
 
+#if defined(ASIO_HAS_ACCEPT4)
+  // Create the new socket with the required flags, so that no further system
+  // calls are needed to set them. Fall back to accept() if the kernel does
+  // not support accept4().
+  int flags = SOCK_CLOEXEC | (non_blocking ? SOCK_NONBLOCK : 0);
+  socket_type new_s = call_accept4(
+      &msghdr::msg_namelen, s, addr, addrlen, flags);
+  if (new_s == invalid_socket && errno == ENOSYS)
+    new_s = call_accept(&msghdr::msg_namelen, s, addr, addrlen);
+  else if (new_s != invalid_socket && non_blocking)
+    new_state = internal_non_blocking;
+#else // defined(ASIO_HAS_ACCEPT4)
+  (void)non_blocking;
   socket_type new_s = call_accept(&msghdr::msg_namelen, s, addr, addrlen);
+#endif // defined(ASIO_HAS_ACCEPT4)
   get_last_error(ec, new_s == invalid_socket);
   if (new_s == invalid_socket)
     return new_s;
@@ -125,6 +159,7 @@ socket_type accept(socket_type s, socket_addr_type* addr,
   if (result != 0)
   {
     ::close(new_s);
+    new_state = 0;
     return invalid_socket;
   }
 #endif
@@ -133,6 +168,19 @@ socket_type accept(socket_type s, socket_addr_type* addr,
   return new_s;
 }
 
+socket_type accept(socket_type s, socket_addr_type* addr,
+    std::size_t* addrlen, asio::error_code& ec)
+{
+  state_type new_state = 0;
+  return accept_socket(s, addr, addrlen, false, new_state, ec);
+}
+
+socket_type accept(socket_type s, socket_addr_type* addr,
+    std::size_t* addrlen, state_type& new_state, asio::error_code& ec)
+{
+  return accept_socket(s, addr, addrlen, true, new_state, ec);
+}
+
 socket_type sync_accept(socket_type s, state_type state,
     socket_addr_type* addr, std::size_t* addrlen, asio::error_code& ec)
 {
@@ -226,12 +274,12 @@ void complete_iocp_accept(socket_type s,
 
 bool non_blocking_accept(socket_type s,
     state_type state, socket_addr_type* addr, std::size_t* addrlen,
-    asio::error_code& ec, socket_type& new_socket)
+    asio::error_code& ec, socket_type& new_socket, state_type& new_state)
 {
   for (;;)
   {
     // Accept the waiting connection.
-    new_socket = socket_ops::accept(s, addr, addrlen, ec);
+    new_socket = socket_ops::accept(s, addr, addrlen, new_state, ec);
 
     // Check if operation succeeded.
     if (new_socket != invalid_socket)
@@ -1362,6 +1410,177 @@ bool non_blocking_recvmsg(socket_type s,
   }
 }
 
+#if defined(ASIO_HAS_MMSG)
+
+bool non_blocking_recvmmsg(socket_type s,
+    mmsghdr* msgs, size_t count, int flags,
+    asio::error_code& ec, size_t& messages_transferred)
+{
+  for (;;)
+  {
+    // Read as many messages as are available, up to the number supplied.
+    int result = ::recvmmsg(s, msgs,
+        static_cast<unsigned int>(count), flags, 0);
+    get_last_error(ec, result < 0);
+
+    // Check if operation succeeded.
+    if (result >= 0)
+    {
+      messages_transferred = result;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    messages_transferred = 0;
+    return true;
+  }
+}
+
+#endif // defined(ASIO_HAS_MMSG)
+
+#if defined(ASIO_HAS_RECEIVE_METADATA) \
+  || defined(ASIO_HAS_LOCAL_SOCKETS)
+
+bool non_blocking_recvmsg_control(socket_type s,
+    buf* bufs, size_t count, int in_flags, bool is_stream,
+    socket_addr_type* addr, std::size_t* addrlen, void* control,
+    std::size_t* control_size, int& out_flags,
+    asio::error_code& ec, size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    msghdr msg = msghdr();
+    if (addr)
+    {
+      init_msghdr_msg_name(msg.msg_name, addr);
+      msg.msg_namelen = static_cast<int>(*addrlen);
+    }
+    msg.msg_iov = bufs;
+    msg.msg_iovlen = static_cast<int>(count);
+    msg.msg_control = control;
+    msg.msg_controllen = *control_size;
+
+    // Read some data.
+    signed_size_type bytes = ::recvmsg(s, &msg, in_flags);
+    get_last_error(ec, bytes < 0);
+
+    // Check for end of stream.
+    if (is_stream && bytes == 0)
+    {
+      ec = asio::error::eof;
+      out_flags = 0;
+      *control_size = 0;
+      bytes_transferred = 0;
+      return true;
+    }
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      if (addr)
+        *addrlen = msg.msg_namelen;
+      out_flags = msg.msg_flags;
+      *control_size = msg.msg_controllen;
+      bytes_transferred = bytes;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    out_flags = 0;
+    *control_size = 0;
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+#endif // defined(ASIO_HAS_RECEIVE_METADATA)
+       //   || defined(ASIO_HAS_LOCAL_SOCKETS)
+
+#if defined(ASIO_HAS_UDP_GSO)
+
+bool non_blocking_recvfrom_coalesced(socket_type s,
+    buf* bufs, size_t count, int flags, socket_addr_type* addr,
+    std::size_t* addrlen, asio::error_code& ec,
+    size_t& bytes_transferred, size_t& segment_size)
+{
+  union
+  {
+    cmsghdr header;
+    char buffer[CMSG_SPACE(sizeof(int))];
+  } control;
+
+  for (;;)
+  {
+    msghdr msg = msghdr();
+    init_msghdr_msg_name(msg.msg_name, addr);
+    msg.msg_namelen = static_cast<int>(*addrlen);
+    msg.msg_iov = bufs;
+    msg.msg_iovlen = static_cast<int>(count);
+    msg.msg_control = control.buffer;
+    msg.msg_controllen = sizeof(control.buffer);
+
+    // Read some data.
+    signed_size_type bytes = ::recvmsg(s, &msg, flags);
+    get_last_error(ec, bytes < 0);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      *addrlen = msg.msg_namelen;
+      bytes_transferred = bytes;
+
+      // Datagrams that were not coalesced carry no segment size.
+      segment_size = bytes_transferred;
+      for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+          cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+      {
+        if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO)
+        {
+          int value = 0;
+          std::memcpy(&value, CMSG_DATA(cmsg), sizeof(value));
+          segment_size = static_cast<size_t>(value);
+        }
+      }
+
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    bytes_transferred = 0;
+    segment_size = 0;
+    return true;
+  }
+}
+
+#endif // defined(ASIO_HAS_UDP_GSO)
+
 #endif // defined(ASIO_HAS_IOCP)
 
 signed_size_type send(socket_type s, const buf* bufs, size_t count,
@@ -1588,6 +1807,96 @@ bool non_blocking_send1(socket_type s,
   }
 }
 
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+
+bool non_blocking_sendmsg_control(socket_type s,
+    const buf* bufs, size_t count, int flags, const void* control,
+    std::size_t control_size, asio::error_code& ec,
+    size_t& bytes_transferred)
+{
+  msghdr msg = msghdr();
+  msg.msg_iov = const_cast<buf*>(bufs);
+  msg.msg_iovlen = static_cast<int>(count);
+  msg.msg_control = const_cast<void*>(control);
+  msg.msg_controllen = control_size;
+#if defined(__linux__)
+  flags |= MSG_NOSIGNAL;
+#endif // defined(__linux__)
+
+  for (;;)
+  {
+    // Write some data.
+    signed_size_type bytes = ::sendmsg(s, &msg, flags);
+    get_last_error(ec, bytes < 0);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      bytes_transferred = bytes;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+#if defined(ASIO_HAS_SENDFILE)
+
+bool non_blocking_sendfile(socket_type s, int fd,
+    uint64_t offset, size_t size, asio::error_code& ec,
+    size_t& bytes_transferred)
+{
+  off_t file_offset = static_cast<off_t>(offset);
+  if (file_offset < 0 || static_cast<uint64_t>(file_offset) != offset)
+  {
+    ec = asio::error::invalid_argument;
+    bytes_transferred = 0;
+    return true;
+  }
+
+  for (;;)
+  {
+    // Write some data directly from the file.
+    signed_size_type bytes = ::sendfile(s, fd, &file_offset, size);
+    get_last_error(ec, bytes < 0);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      bytes_transferred = bytes;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+#endif // defined(ASIO_HAS_SENDFILE)
+
 #endif // defined(ASIO_HAS_IOCP)
 
 signed_size_type sendto(socket_type s, const buf* bufs, size_t count,
@@ -1800,12 +2109,141 @@ bool non_blocking_sendto1(socket_type s,
   }
 }
 
+#if defined(ASIO_HAS_MMSG)
+
+bool non_blocking_sendmmsg(socket_type s,
+    mmsghdr* msgs, size_t count, int flags,
+    asio::error_code& ec, size_t& messages_transferred)
+{
+#if defined(__linux__)
+  flags |= MSG_NOSIGNAL;
+#endif // defined(__linux__)
+
+  for (;;)
+  {
+    // Write as many messages as the socket will accept.
+    int result = ::sendmmsg(s, msgs,
+        static_cast<unsigned int>(count), flags);
+    get_last_error(ec, result < 0);
+
+    // Check if operation succeeded.
+    if (result >= 0)
+    {
+      messages_transferred = result;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    messages_transferred = 0;
+    return true;
+  }
+}
+
+#endif // defined(ASIO_HAS_MMSG)
+
+#if defined(ASIO_HAS_UDP_GSO)
+
+bool non_blocking_sendto_segmented(socket_type s,
+    const buf* bufs, size_t count, int flags,
+    const socket_addr_type* addr, std::size_t addrlen,
+    size_t segment_size, asio::error_code& ec, size_t& bytes_transferred)
+{
+  union
+  {
+    cmsghdr header;
+    char buffer[CMSG_SPACE(sizeof(uint16_t))];
+  } control;
+  std::memset(control.buffer, 0, sizeof(control.buffer));
+
+  msghdr msg = msghdr();
+  init_msghdr_msg_name(msg.msg_name, addr);
+  msg.msg_namelen = static_cast<int>(addrlen);
+  msg.msg_iov = const_cast<buf*>(bufs);
+  msg.msg_iovlen = static_cast<int>(count);
+  msg.msg_control = control.buffer;
+  msg.msg_controllen = sizeof(control.buffer);
+
+  // Attach the segment size to the message.
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_UDP;
+  cmsg->cmsg_type = UDP_SEGMENT;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+  uint16_t value = static_cast<uint16_t>(segment_size);
+  std::memcpy(CMSG_DATA(cmsg), &value, sizeof(value));
+
+  flags |= MSG_NOSIGNAL;
+
+  for (;;)
+  {
+    // Write some data.
+    signed_size_type bytes = ::sendmsg(s, &msg, flags);
+    get_last_error(ec, bytes < 0);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      bytes_transferred = bytes;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == asio::error::would_block
+        || ec == asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+#endif // defined(ASIO_HAS_UDP_GSO)
+
 #endif // !defined(ASIO_HAS_IOCP)
 
-socket_type socket(int af, int type, int protocol,
-    asio::error_code& ec)
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+inline socket_type call_socket(int af, int type, int protocol,
+    bool non_blocking, state_type& new_state)
 {
+#if defined(SOCK_NONBLOCK) && defined(SOCK_CLOEXEC)
+  // Create the socket with the required flags, so that no further system calls
+  // are needed to set them. Fall back to a plain socket() call if the kernel
+  // does not support the flags.
+  int flags = SOCK_CLOEXEC | (non_blocking ? SOCK_NONBLOCK : 0);
+  socket_type s = ::socket(af, type | flags, protocol);
+  if (s < 0 && errno == EINVAL)
+    return ::socket(af, type, protocol);
+  if (s >= 0 && non_blocking)
+    new_state = internal_non_blocking;
+  return s;
+#else // defined(SOCK_NONBLOCK) && defined(SOCK_CLOEXEC)
+  (void)non_blocking;
+  (void)new_state;
+  return ::socket(af, type, protocol);
+#endif // defined(SOCK_NONBLOCK) && defined(SOCK_CLOEXEC)
+}
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+inline socket_type open_socket(int af, int type, int protocol,
+    bool non_blocking, state_type& new_state, asio::error_code& ec)
+{
+  new_state = 0;
+
 #if defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+  (void)non_blocking;
   socket_type s = ::WSASocketW(af, type, protocol, 0, 0, WSA_FLAG_OVERLAPPED);
   get_last_error(ec, s == invalid_socket);
   if (s == invalid_socket)
@@ -1823,8 +2261,10 @@ socket_type socket(int af, int type, int protocol,
 
   return s;
 #elif defined(__MACH__) && defined(__APPLE__) || defined(__FreeBSD__)
-  socket_type s = ::socket(af, type, protocol);
+  socket_type s = call_socket(af, type, protocol, non_blocking, new_state);
   get_last_error(ec, s < 0);
+  if (s < 0)
+    return invalid_socket;
 
   int optval = 1;
   int result = ::setsockopt(s, SOL_SOCKET,
@@ -1833,17 +2273,31 @@ socket_type socket(int af, int type, int protocol,
   if (result != 0)
   {
     ::close(s);
+    new_state = 0;
     return invalid_socket;
   }
 
   return s;
 #else
-  int s = ::socket(af, type, protocol);
+  int s = call_socket(af, type, protocol, non_blocking, new_state);
   get_last_error(ec, s < 0);
   return s;
 #endif
 }
 
+socket_type socket(int af, int type, int protocol,
+    asio::error_code& ec)
+{
+  state_type new_state = 0;
+  return open_socket(af, type, protocol, false, new_state, ec);
+}
+
+socket_type socket(int af, int type, int protocol,
+    state_type& new_state, asio::error_code& ec)
+{
+  return open_socket(af, type, protocol, true, new_state, ec);
+}
+
 template <typename SockLenType>
 inline int call_setsockopt(SockLenType msghdr::*,
     socket_type s, int level, int optname,
@@ -27,7 +27,9 @@ strand_executor_service::strand_executor_service(execution_context& ctx)
   : execution_context_service_base<strand_executor_service>(ctx),
     mutex_(),
     salt_(0),
-    impl_list_(0)
+    impl_list_(0),
+    memory_resource_(asio::detail::get_memory_resource(ctx)),
+    allocation_accounting_(asio::detail::get_allocation_accounting(ctx))
 {
 }
 
@@ -52,7 +54,16 @@ void strand_executor_service::shutdown()
 strand_executor_service::implementation_type
 strand_executor_service::create_implementation()
 {
-  implementation_type new_impl(new strand_impl);
+  strand_impl* impl = new (allocate_memory(memory_resource_,
+        sizeof(strand_impl))) strand_impl;
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+  allocation_accounting_->record_allocation(
+      allocation_accounting::strand_state, sizeof(strand_impl));
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
+  strand_impl_deleter deleter = { memory_resource_, allocation_accounting_ };
+  implementation_type new_impl(impl, deleter,
+      memory_resource_allocator<strand_impl>(memory_resource_));
   new_impl->locked_ = false;
   new_impl->shutdown_ = false;
 
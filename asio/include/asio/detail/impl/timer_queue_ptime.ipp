@@ -26,7 +26,9 @@
 namespace asio {
 namespace detail {
 
-timer_queue<time_traits<boost::posix_time::ptime> >::timer_queue()
+timer_queue<time_traits<boost::posix_time::ptime> >::timer_queue(
+    memory_resource* resource)
+  : impl_(resource)
 {
 }
 
@@ -69,12 +71,29 @@ void timer_queue<time_traits<boost::posix_time::ptime> >::get_all_timers(
   impl_.get_all_timers(ops);
 }
 
+void timer_queue<time_traits<boost::posix_time::ptime> >::reserve(
+    std::size_t n)
+{
+  impl_.reserve(n);
+}
+
+void timer_queue<time_traits<boost::posix_time::ptime> >::trim(std::size_t n)
+{
+  impl_.trim(n);
+}
+
 std::size_t timer_queue<time_traits<boost::posix_time::ptime> >::cancel_timer(
     per_timer_data& timer, op_queue<operation>& ops, std::size_t max_cancelled)
 {
   return impl_.cancel_timer(timer, ops, max_cancelled);
 }
 
+void timer_queue<time_traits<boost::posix_time::ptime> >::cancel_timer_by_key(
+    per_timer_data* timer, op_queue<operation>& ops, void* cancellation_key)
+{
+  impl_.cancel_timer_by_key(timer, ops, cancellation_key);
+}
+
 void timer_queue<time_traits<boost::posix_time::ptime> >::move_timer(
     per_timer_data& target, per_timer_data& source)
 {
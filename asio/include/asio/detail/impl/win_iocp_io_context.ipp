@@ -88,7 +88,9 @@ win_iocp_io_context::win_iocp_io_context(
     shutdown_(0),
     gqcs_timeout_(get_gqcs_timeout()),
     dispatch_required_(0),
-    concurrency_hint_(concurrency_hint)
+    concurrency_hint_(concurrency_hint),
+    memory_resource_(asio::detail::get_memory_resource(ctx)),
+    allocation_accounting_(asio::detail::get_allocation_accounting(ctx))
 {
   ASIO_HANDLER_TRACKING_INIT;
 
@@ -196,7 +198,7 @@ size_t win_iocp_io_context::run(asio::error_code& ec)
     return 0;
   }
 
-  win_iocp_thread_info this_thread;
+  win_iocp_thread_info this_thread(memory_resource_, allocation_accounting_);
   thread_call_stack::context ctx(this, this_thread);
 
   size_t n = 0;
@@ -215,7 +217,7 @@ size_t win_iocp_io_context::run_one(asio::error_code& ec)
     return 0;
   }
 
-  win_iocp_thread_info this_thread;
+  win_iocp_thread_info this_thread(memory_resource_, allocation_accounting_);
   thread_call_stack::context ctx(this, this_thread);
 
   return do_one(INFINITE, ec);
@@ -230,7 +232,7 @@ size_t win_iocp_io_context::wait_one(long usec, asio::error_code& ec)
     return 0;
   }
 
-  win_iocp_thread_info this_thread;
+  win_iocp_thread_info this_thread(memory_resource_, allocation_accounting_);
   thread_call_stack::context ctx(this, this_thread);
 
   return do_one(usec < 0 ? INFINITE : ((usec - 1) / 1000 + 1), ec);
@@ -245,7 +247,7 @@ size_t win_iocp_io_context::poll(asio::error_code& ec)
     return 0;
   }
 
-  win_iocp_thread_info this_thread;
+  win_iocp_thread_info this_thread(memory_resource_, allocation_accounting_);
   thread_call_stack::context ctx(this, this_thread);
 
   size_t n = 0;
@@ -264,7 +266,7 @@ size_t win_iocp_io_context::poll_one(asio::error_code& ec)
     return 0;
   }
 
-  win_iocp_thread_info this_thread;
+  win_iocp_thread_info this_thread(memory_resource_, allocation_accounting_);
   thread_call_stack::context ctx(this, this_thread);
 
   return do_one(0, ec);
@@ -528,6 +530,21 @@ DWORD win_iocp_io_context::get_gqcs_timeout()
   return default_gqcs_timeout;
 }
 
+void win_iocp_io_context::reserve(std::size_t, std::size_t timers)
+{
+  mutex::scoped_lock lock(dispatch_mutex_);
+  timer_queues_.reserve(timers);
+}
+
+void win_iocp_io_context::trim()
+{
+  if (thread_info_base* this_thread = thread_call_stack::contains(this))
+    this_thread->release_cached_memory();
+
+  mutex::scoped_lock lock(dispatch_mutex_);
+  timer_queues_.trim();
+}
+
 void win_iocp_io_context::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(dispatch_mutex_);
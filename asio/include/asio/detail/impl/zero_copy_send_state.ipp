@@ -0,0 +1,105 @@
+//
+// detail/impl/zero_copy_send_state.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_ZERO_COPY_SEND_STATE_IPP
+#define ASIO_DETAIL_IMPL_ZERO_COPY_SEND_STATE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#include <cstring>
+#include <linux/errqueue.h>
+#include "asio/detail/zero_copy_send_state.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+void zero_copy_send_state::drain(socket_type s)
+{
+  for (;;)
+  {
+    union
+    {
+      cmsghdr header;
+      char data[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+    } control;
+
+    msghdr msg = msghdr();
+    msg.msg_control = &control;
+    msg.msg_controllen = sizeof(control);
+
+    // Reads from the error queue never block. Stop when it is empty.
+    if (::recvmsg(s, &msg, MSG_ERRQUEUE) < 0)
+      return;
+
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg != 0; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+      if ((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR)
+          || (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR))
+      {
+        sock_extended_err err;
+        using namespace std; // For memcpy.
+        memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+        if (err.ee_errno == 0 && err.ee_origin == SO_EE_ORIGIN_ZEROCOPY)
+        {
+          record(err.ee_info, err.ee_data);
+          if ((err.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0)
+            enabled_ = false;
+        }
+      }
+    }
+  }
+}
+
+void zero_copy_send_state::record(uint32_t first, uint32_t last)
+{
+  if (static_cast<int32_t>(first - completed_) > 0)
+  {
+    pending_.push_back(std::make_pair(first, last));
+    return;
+  }
+
+  if (static_cast<int32_t>(last + 1 - completed_) > 0)
+    completed_ = last + 1;
+
+  // Merge any out of order ranges that are now contiguous.
+  for (std::size_t i = 0; i < pending_.size(); )
+  {
+    if (static_cast<int32_t>(pending_[i].first - completed_) <= 0)
+    {
+      if (static_cast<int32_t>(pending_[i].second + 1 - completed_) > 0)
+        completed_ = pending_[i].second + 1;
+      pending_[i] = pending_.back();
+      pending_.pop_back();
+      i = 0;
+    }
+    else
+    {
+      ++i;
+    }
+  }
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#endif // ASIO_DETAIL_IMPL_ZERO_COPY_SEND_STATE_IPP
@@ -133,6 +133,24 @@ public:
   }
 #endif // defined(ASIO_HAS_MOVE)
 
+  // Move the implementation to the service of the specified executor's
+  // execution context, and associate the object with the executor.
+  asio::error_code migrate(const executor_type& ex,
+      asio::error_code& ec)
+  {
+    service_type& target_service =
+      asio::use_service<IoObjectService>(ex.context());
+    service_->migrate(implementation_, target_service, ec);
+    if (!ec)
+    {
+      service_ = &target_service;
+      implementation_executor_.~implementation_executor_type();
+      new (&implementation_executor_) implementation_executor_type(
+          ex, (is_native_io_executor)(ex));
+    }
+    return ec;
+  }
+
   // Get the executor associated with the object.
   executor_type get_executor() ASIO_NOEXCEPT
   {
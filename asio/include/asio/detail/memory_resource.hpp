@@ -0,0 +1,153 @@
+//
+// detail/memory_resource.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_MEMORY_RESOURCE_HPP
+#define ASIO_DETAIL_MEMORY_RESOURCE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <new>
+
+#if defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+# include <memory_resource>
+#endif // defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+#if defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+typedef std::pmr::memory_resource memory_resource;
+#else // defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+// Memory resources are not supported, and only null pointers to this type are
+// ever used.
+class memory_resource;
+#endif // defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+
+// Allocate memory from a resource, or using ::operator new if the resource
+// pointer is null.
+inline void* allocate_memory(memory_resource* resource, std::size_t size)
+{
+#if defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+  if (resource)
+    return resource->allocate(size, alignof(std::max_align_t));
+#else // defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+  (void)resource;
+#endif // defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+  return ::operator new(size);
+}
+
+// Return memory obtained from allocate_memory().
+inline void deallocate_memory(memory_resource* resource,
+    void* pointer, std::size_t size)
+{
+#if defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+  if (resource)
+  {
+    resource->deallocate(pointer, size, alignof(std::max_align_t));
+    return;
+  }
+#else // defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+  (void)resource;
+#endif // defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+  (void)size;
+  ::operator delete(pointer);
+}
+
+// An allocator, suitable for use with standard containers, that obtains its
+// memory from a resource.
+template <typename T>
+class memory_resource_allocator
+{
+public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template <typename U>
+  struct rebind
+  {
+    typedef memory_resource_allocator<U> other;
+  };
+
+  explicit memory_resource_allocator(memory_resource* resource = 0)
+    : resource_(resource)
+  {
+  }
+
+  template <typename U>
+  memory_resource_allocator(const memory_resource_allocator<U>& a)
+    : resource_(a.resource())
+  {
+  }
+
+  memory_resource* resource() const
+  {
+    return resource_;
+  }
+
+  T* allocate(std::size_t n)
+  {
+    return static_cast<T*>(allocate_memory(resource_, sizeof(T) * n));
+  }
+
+  void deallocate(T* p, std::size_t n)
+  {
+    deallocate_memory(resource_, p, sizeof(T) * n);
+  }
+
+  template <typename U>
+  void construct(U* p, const U& value)
+  {
+    ::new (static_cast<void*>(p)) U(value);
+  }
+
+  template <typename U>
+  void destroy(U* p)
+  {
+    p->~U();
+  }
+
+  std::size_t max_size() const
+  {
+    return static_cast<std::size_t>(-1) / sizeof(T);
+  }
+
+  friend bool operator==(const memory_resource_allocator& a,
+      const memory_resource_allocator& b)
+  {
+    return a.resource_ == b.resource_;
+  }
+
+  friend bool operator!=(const memory_resource_allocator& a,
+      const memory_resource_allocator& b)
+  {
+    return a.resource_ != b.resource_;
+  }
+
+private:
+  memory_resource* resource_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_MEMORY_RESOURCE_HPP
@@ -0,0 +1,71 @@
+//
+// detail/memory_resource_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_MEMORY_RESOURCE_SERVICE_HPP
+#define ASIO_DETAIL_MEMORY_RESOURCE_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/memory_resource.hpp"
+#include "asio/execution_context.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Records the memory resource to be used for an execution context's internal
+// allocations. The service is added by the context's constructor, before any
+// other service is created, and is absent if no resource was specified.
+class memory_resource_service
+  : public execution_context_service_base<memory_resource_service>
+{
+public:
+  // Constructor.
+  explicit memory_resource_service(execution_context& context,
+      memory_resource* resource = 0)
+    : execution_context_service_base<memory_resource_service>(context),
+      resource_(resource)
+  {
+  }
+
+  // Destroy all user-defined handler objects owned by the service.
+  void shutdown()
+  {
+  }
+
+  // Get the memory resource.
+  memory_resource* get() const
+  {
+    return resource_;
+  }
+
+private:
+  memory_resource* resource_;
+};
+
+// Get the memory resource to be used for the context's internal allocations.
+// Returns a null pointer if the default allocation functions are to be used.
+inline memory_resource* get_memory_resource(execution_context& context)
+{
+  if (!has_service<memory_resource_service>(context))
+    return 0;
+  return use_service<memory_resource_service>(context).get();
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_MEMORY_RESOURCE_SERVICE_HPP
@@ -15,35 +15,70 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include "asio/detail/memory_resource.hpp"
 #include "asio/detail/noncopyable.hpp"
 
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+# include "asio/detail/allocation_accounting.hpp"
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
 namespace detail {
 
+class allocation_accounting;
+
 template <typename Object>
 class object_pool;
 
 class object_pool_access
 {
+private:
+  // Owns uninitialised memory for an object until construction succeeds.
+  template <typename Object>
+  struct raw_memory
+  {
+    explicit raw_memory(memory_resource* r)
+      : resource(r),
+        pointer(allocate_memory(r, sizeof(Object)))
+    {
+    }
+
+    ~raw_memory()
+    {
+      if (pointer)
+        deallocate_memory(resource, pointer, sizeof(Object));
+    }
+
+    memory_resource* resource;
+    void* pointer;
+  };
+
 public:
   template <typename Object>
-  static Object* create()
+  static Object* create(memory_resource* resource)
   {
-    return new Object;
+    raw_memory<Object> mem(resource);
+    Object* o = new (mem.pointer) Object;
+    mem.pointer = 0;
+    return o;
   }
 
   template <typename Object, typename Arg>
-  static Object* create(Arg arg)
+  static Object* create(memory_resource* resource, Arg arg)
   {
-    return new Object(arg);
+    raw_memory<Object> mem(resource);
+    Object* o = new (mem.pointer) Object(arg);
+    mem.pointer = 0;
+    return o;
   }
 
   template <typename Object>
-  static void destroy(Object* o)
+  static void destroy(memory_resource* resource, Object* o)
   {
-    delete o;
+    o->~Object();
+    deallocate_memory(resource, o, sizeof(Object));
   }
 
   template <typename Object>
@@ -64,10 +99,16 @@ class object_pool
   : private noncopyable
 {
 public:
-  // Constructor.
-  object_pool()
-    : live_list_(0),
-      free_list_(0)
+  // Constructor. Objects are allocated from the specified memory resource, or
+  // using ::operator new if the resource pointer is null. The memory owned by
+  // the pool is recorded with the allocation accounting, if specified.
+  explicit object_pool(memory_resource* resource = 0,
+      allocation_accounting* accounting = 0)
+    : resource_(resource),
+      accounting_(accounting),
+      live_list_(0),
+      free_list_(0),
+      size_(0)
   {
   }
 
@@ -91,7 +132,10 @@ public:
     if (o)
       free_list_ = object_pool_access::next(free_list_);
     else
-      o = object_pool_access::create<Object>();
+    {
+      o = object_pool_access::create<Object>(resource_);
+      record_creation();
+    }
 
     object_pool_access::next(o) = live_list_;
     object_pool_access::prev(o) = 0;
@@ -110,7 +154,10 @@ public:
     if (o)
       free_list_ = object_pool_access::next(free_list_);
     else
-      o = object_pool_access::create<Object>(arg);
+    {
+      o = object_pool_access::create<Object>(resource_, arg);
+      record_creation();
+    }
 
     object_pool_access::next(o) = live_list_;
     object_pool_access::prev(o) = 0;
@@ -144,6 +191,51 @@ public:
     free_list_ = o;
   }
 
+  // Get the total number of objects owned by the pool, both live and free.
+  std::size_t size() const
+  {
+    return size_;
+  }
+
+  // Ensure that the pool owns at least the specified number of objects, by
+  // adding newly constructed objects to the free list.
+  template <typename Arg>
+  void reserve(std::size_t n, Arg arg)
+  {
+    while (size_ < n)
+    {
+      Object* o = object_pool_access::create<Object>(resource_, arg);
+      object_pool_access::next(o) = free_list_;
+      object_pool_access::prev(o) = 0;
+      free_list_ = o;
+      record_creation();
+    }
+  }
+
+  // Destroy objects on the free list until the pool owns no more than the
+  // specified number of objects. Objects for which the predicate returns false
+  // are retained. Returns the number of objects destroyed.
+  template <typename Predicate>
+  std::size_t trim(std::size_t n, Predicate can_destroy)
+  {
+    std::size_t destroyed = 0;
+    Object** link = &free_list_;
+    while (*link && size_ > n)
+    {
+      Object* o = *link;
+      if (can_destroy(o))
+      {
+        *link = object_pool_access::next(o);
+        object_pool_access::destroy(resource_, o);
+        record_destruction();
+        ++destroyed;
+      }
+      else
+        link = &object_pool_access::next(o);
+    }
+    return destroyed;
+  }
+
 private:
   // Helper function to destroy all elements in a list.
   void destroy_list(Object* list)
@@ -152,15 +244,50 @@ private:
     {
       Object* o = list;
       list = object_pool_access::next(o);
-      object_pool_access::destroy(o);
+      object_pool_access::destroy(resource_, o);
+      record_destruction();
+    }
+  }
+
+  // Update the object count and the allocation accounting.
+  void record_creation()
+  {
+    ++size_;
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+    if (accounting_)
+    {
+      accounting_->record_allocation(
+          allocation_accounting::pooled_objects, sizeof(Object));
     }
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
   }
 
+  void record_destruction()
+  {
+    --size_;
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+    if (accounting_)
+    {
+      accounting_->record_deallocation(
+          allocation_accounting::pooled_objects, sizeof(Object));
+    }
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+  }
+
+  // The memory resource used to allocate objects.
+  memory_resource* resource_;
+
+  // The allocation accounting used to record the objects, if any.
+  allocation_accounting* accounting_;
+
   // The list of live objects.
   Object* live_list_;
 
   // The free list.
   Object* free_list_;
+
+  // The total number of objects owned by the pool.
+  std::size_t size_;
 };
 
 } // namespace detail
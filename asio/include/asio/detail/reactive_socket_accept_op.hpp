@@ -18,6 +18,7 @@
 #include "asio/detail/config.hpp"
 #include "asio/detail/bind_handler.hpp"
 #include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/cancellation_completion.hpp"
 #include "asio/detail/fenced_block.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/reactor_op.hpp"
@@ -41,6 +42,7 @@ public:
         &reactive_socket_accept_op_base::do_perform, complete_func),
       socket_(socket),
       state_(state),
+      new_state_(0),
       peer_(peer),
       protocol_(protocol),
       peer_endpoint_(peer_endpoint),
@@ -56,8 +58,8 @@ public:
     socket_type new_socket = invalid_socket;
     status result = socket_ops::non_blocking_accept(o->socket_,
         o->state_, o->peer_endpoint_ ? o->peer_endpoint_->data() : 0,
-        o->peer_endpoint_ ? &o->addrlen_ : 0, o->ec_, new_socket)
-    ? done : not_done;
+        o->peer_endpoint_ ? &o->addrlen_ : 0, o->ec_, new_socket,
+        o->new_state_) ? done : not_done;
     o->new_socket_.reset(new_socket);
 
     ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_accept", o->ec_));
@@ -71,7 +73,9 @@ public:
     {
       if (peer_endpoint_)
         peer_endpoint_->resize(addrlen_);
-      peer_.assign(protocol_, new_socket_.get(), ec_);
+      peer_.impl_.get_service().assign_accepted(
+          peer_.impl_.get_implementation(), protocol_,
+          new_socket_.get(), new_state_, ec_);
       if (!ec_)
         new_socket_.release();
     }
@@ -80,6 +84,7 @@ public:
 private:
   socket_type socket_;
   socket_ops::state_type state_;
+  socket_ops::state_type new_state_;
   socket_holder new_socket_;
   Socket& peer_;
   Protocol protocol_;
@@ -131,6 +136,7 @@ public:
     // deallocated the memory here.
     detail::binder1<Handler, asio::error_code>
       handler(o->handler_, o->ec_);
+    cancellation_completion c(o);
     p.h = asio::detail::addressof(handler.handler_);
     p.reset();
 
@@ -139,7 +145,7 @@ public:
     {
       fenced_block b(fenced_block::half);
       ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_));
-      w.complete(handler, handler.handler_);
+      c.complete(w, handler, handler.handler_);
       ASIO_HANDLER_INVOCATION_END;
     }
   }
@@ -203,6 +209,7 @@ public:
       asio::error_code, peer_socket_type>
         handler(0, ASIO_MOVE_CAST(Handler)(o->handler_), o->ec_,
           ASIO_MOVE_CAST(peer_socket_type)(*o));
+    cancellation_completion c(o);
     p.h = asio::detail::addressof(handler.handler_);
     p.reset();
 
@@ -211,7 +218,7 @@ public:
     {
       fenced_block b(fenced_block::half);
       ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, "..."));
-      w.complete(handler, handler.handler_);
+      c.complete(w, handler, handler.handler_);
       ASIO_HANDLER_INVOCATION_END;
     }
   }
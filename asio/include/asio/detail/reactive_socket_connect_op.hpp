@@ -18,6 +18,7 @@
 #include "asio/detail/config.hpp"
 #include "asio/detail/bind_handler.hpp"
 #include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/cancellation_completion.hpp"
 #include "asio/detail/fenced_block.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/reactor_op.hpp"
@@ -92,6 +93,7 @@ public:
     // deallocated the memory here.
     detail::binder1<Handler, asio::error_code>
       handler(o->handler_, o->ec_);
+    cancellation_completion c(o);
     p.h = asio::detail::addressof(handler.handler_);
     p.reset();
 
@@ -100,6 +102,66 @@ public:
     {
       fenced_block b(fenced_block::half);
       ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_));
+      c.complete(w, handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  IoExecutor io_executor_;
+};
+
+#if defined(ASIO_HAS_TCP_FAST_OPEN)
+
+// A connect whose initial data may have been sent with the connection
+// request. The number of bytes accepted by the kernel when the connect was
+// started is passed to the handler once the connection is established.
+template <typename Handler, typename IoExecutor>
+class reactive_socket_fast_open_connect_op
+  : public reactive_socket_connect_op_base
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_fast_open_connect_op);
+
+  reactive_socket_fast_open_connect_op(const asio::error_code& success_ec,
+      socket_type socket, Handler& handler, const IoExecutor& io_ex)
+    : reactive_socket_connect_op_base(success_ec, socket,
+        &reactive_socket_fast_open_connect_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_fast_open_connect_op* o
+      (static_cast<reactive_socket_fast_open_connect_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->ec_ ? 0 : o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
       w.complete(handler, handler.handler_);
       ASIO_HANDLER_INVOCATION_END;
     }
@@ -110,6 +172,8 @@ private:
   IoExecutor io_executor_;
 };
 
+#endif // defined(ASIO_HAS_TCP_FAST_OPEN)
+
 } // namespace detail
 } // namespace asio
 
@@ -0,0 +1,193 @@
+//
+// detail/reactive_socket_multishot_accept_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_MULTISHOT_ACCEPT_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_MULTISHOT_ACCEPT_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT)
+
+#include "asio/socket_base.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactive_socket_service_base.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Determines the I/O executor used for each accepted socket. By default, all
+// sockets use the executor supplied when the operation is started.
+template <typename PeerIoExecutor>
+struct multishot_accept_peer_executor
+{
+  typedef PeerIoExecutor type;
+
+  template <typename Protocol>
+  static const type& get(const PeerIoExecutor& ex,
+      const Protocol&, socket_type)
+  {
+    return ex;
+  }
+};
+
+template <typename Protocol, typename PeerIoExecutor,
+    typename Handler, typename IoExecutor>
+class reactive_socket_multishot_accept_op :
+  public reactive_socket_multishot_accept_op_base
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_multishot_accept_op);
+
+  reactive_socket_multishot_accept_op(const asio::error_code& success_ec,
+      reactive_socket_service_base& service,
+      const PeerIoExecutor& peer_io_ex, const Protocol& protocol,
+      socket_base::multishot_accept_statistics* statistics,
+      Handler& handler, const IoExecutor& io_ex)
+    : reactive_socket_multishot_accept_op_base(success_ec, service,
+        &reactive_socket_multishot_accept_op::do_complete),
+      peer_io_executor_(peer_io_ex),
+      protocol_(protocol),
+      statistics_(statistics),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    if (statistics_)
+    {
+      statistics_->wakeups = 0;
+      statistics_->accepted = 0;
+      statistics_->peak_accepted = 0;
+    }
+
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_multishot_accept_op* o(
+        static_cast<reactive_socket_multishot_accept_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    if (owner)
+    {
+      // Record the number of connections accepted on this wakeup.
+      if (o->statistics_)
+      {
+        ++o->statistics_->wakeups;
+        o->statistics_->accepted += o->count_;
+        if (o->count_ > o->statistics_->peak_accepted)
+          o->statistics_->peak_accepted = o->count_;
+      }
+
+      // Stop the operation if an upcall exits via an exception.
+      stop_guard guard = { o };
+
+      // Deliver each new connection to a copy of the handler, through the
+      // handler's executor. If the executor defers the upcalls, the operation
+      // is restarted before they are made. This is safe because the handler
+      // can only stop the operation through the service, which synchronises
+      // with a restart, and each upcall owns its own socket.
+      for (std::size_t i = 0; i < o->count_ && !o->ec_; ++i)
+      {
+        peer_socket_type peer(peer_executor::get(
+              o->peer_io_executor_, o->protocol_, o->sockets_[i]));
+        peer.impl_.get_service().assign_accepted(
+            peer.impl_.get_implementation(), o->protocol_,
+            o->sockets_[i], o->states_[i], o->ec_);
+        if (o->ec_)
+          break;
+        o->sockets_[i] = invalid_socket;
+
+        detail::move_binder2<Handler,
+          asio::error_code, peer_socket_type>
+            handler(0, Handler(o->handler_), o->ec_,
+              ASIO_MOVE_CAST(peer_socket_type)(peer));
+
+        fenced_block b(fenced_block::half);
+        ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, "..."));
+        w.complete(handler, handler.handler_);
+        ASIO_HANDLER_INVOCATION_END;
+      }
+      guard.op_ = 0;
+
+      // Wait for more connections, unless the operation has been stopped.
+      if (!o->ec_)
+      {
+        o->count_ = 0;
+        handler_work<Handler, IoExecutor>::start(o->handler_, o->io_executor_);
+        if (o->service_.restart_multishot_op(o))
+        {
+          p.v = p.p = 0;
+          return;
+        }
+
+        // Balance the work started above.
+        handler_work<Handler, IoExecutor> w2(o->handler_, o->io_executor_);
+      }
+    }
+
+    o->service_.end_multishot_op(o);
+    o->close_accepted();
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the final upcall is made.
+    detail::move_binder2<Handler,
+      asio::error_code, peer_socket_type>
+        handler(0, ASIO_MOVE_CAST(Handler)(o->handler_), o->ec_,
+          peer_socket_type(peer_executor::get(
+              o->peer_io_executor_, o->protocol_, invalid_socket)));
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, "..."));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  typedef multishot_accept_peer_executor<PeerIoExecutor> peer_executor;
+  typedef typename Protocol::socket::template rebind_executor<
+    typename peer_executor::type>::other peer_socket_type;
+
+  PeerIoExecutor peer_io_executor_;
+  Protocol protocol_;
+  socket_base::multishot_accept_statistics* statistics_;
+  Handler handler_;
+  IoExecutor io_executor_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_MULTISHOT_ACCEPT_OP_HPP
@@ -0,0 +1,299 @@
+//
+// detail/reactive_socket_multishot_recv_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_MULTISHOT_RECV_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_MULTISHOT_RECV_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MULTISHOT_RECEIVE)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactive_socket_service_base.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename MutableBufferSequence>
+class reactive_socket_multishot_recv_op_base :
+  public reactive_socket_multishot_op_base
+{
+public:
+  // The maximum number of receives completed in-line after each wakeup.
+  enum { max_receives = 16 };
+
+  reactive_socket_multishot_recv_op_base(const asio::error_code& success_ec,
+      reactive_socket_service_base& service,
+      const MutableBufferSequence& buffers,
+      socket_base::message_flags flags, func_type complete_func)
+    : reactive_socket_multishot_op_base(success_ec, service,
+        &reactive_socket_multishot_recv_op_base::do_perform, complete_func),
+      buffers_(buffers),
+      flags_(flags)
+  {
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_multishot_recv_op_base* o(
+        static_cast<reactive_socket_multishot_recv_op_base*>(base));
+
+    typedef buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs_type;
+
+    // The operation is performed repeatedly, so any result from a previous
+    // receive must be discarded.
+    o->bytes_transferred_ = 0;
+
+    status result;
+    if (bufs_type::is_single_buffer)
+    {
+      result = socket_ops::non_blocking_recv1(o->socket_,
+          bufs_type::first(o->buffers_).data(),
+          bufs_type::first(o->buffers_).size(), o->flags_,
+          (o->state_ & socket_ops::stream_oriented) != 0,
+          o->ec_, o->bytes_transferred_) ? done : not_done;
+    }
+    else
+    {
+      bufs_type bufs(o->buffers_);
+      result = socket_ops::non_blocking_recv(o->socket_,
+          bufs.buffers(), bufs.count(), o->flags_,
+          (o->state_ & socket_ops::stream_oriented) != 0,
+          o->ec_, o->bytes_transferred_) ? done : not_done;
+    }
+
+    if (result == done)
+      if ((o->state_ & socket_ops::stream_oriented) != 0)
+        if (o->bytes_transferred_ == 0)
+          result = done_and_exhausted;
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_recv",
+          o->ec_, o->bytes_transferred_));
+
+    return result;
+  }
+
+  // Stops the operation if the delivery of data is interrupted.
+  struct stop_guard
+  {
+    reactive_socket_multishot_recv_op_base* op_;
+
+    ~stop_guard()
+    {
+      if (op_)
+        op_->service_.end_multishot_op(op_);
+    }
+  };
+
+private:
+  MutableBufferSequence buffers_;
+  socket_base::message_flags flags_;
+};
+
+template <typename MutableBufferSequence, typename Handler, typename IoExecutor>
+class reactive_socket_multishot_recv_op :
+  public reactive_socket_multishot_recv_op_base<MutableBufferSequence>
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_multishot_recv_op);
+
+  reactive_socket_multishot_recv_op(const asio::error_code& success_ec,
+      reactive_socket_service_base& service,
+      const MutableBufferSequence& buffers, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+    : reactive_socket_multishot_recv_op_base<MutableBufferSequence>(
+        success_ec, service, buffers, flags,
+        &reactive_socket_multishot_recv_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_multishot_recv_op* o(
+        static_cast<reactive_socket_multishot_recv_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    if (owner && !o->ec_)
+    {
+      // The data is delivered from within the handler's executor. If the
+      // executor defers the delivery, such as when the handler is bound to a
+      // strand, the buffers are not read into again until it has run.
+      deliverer d(o);
+      p.v = p.p = 0;
+      w.complete(d, o->handler_);
+      return;
+    }
+
+    o->service_.end_multishot_op(o);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, 0);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  // Function object that owns the operation while its data is being
+  // delivered. The operation is destroyed if the function object is destroyed
+  // without having been invoked.
+  class deliverer
+  {
+  public:
+    explicit deliverer(reactive_socket_multishot_recv_op* o)
+      : op_(o)
+    {
+    }
+
+    deliverer(const deliverer& other)
+      : op_(other.op_)
+    {
+      other.op_ = 0;
+    }
+
+    ~deliverer()
+    {
+      if (op_)
+      {
+        ptr p = { asio::detail::addressof(op_->handler_), op_, op_ };
+        op_->service_.end_multishot_op(op_);
+      }
+    }
+
+    void operator()()
+    {
+      reactive_socket_multishot_recv_op* o = op_;
+      op_ = 0;
+      reactive_socket_multishot_recv_op::deliver(o);
+    }
+
+  private:
+    deliverer& operator=(const deliverer&);
+
+    mutable reactive_socket_multishot_recv_op* op_;
+  };
+
+  // Deliver the results of the operation's receives, from within the
+  // handler's executor.
+  static void deliver(reactive_socket_multishot_recv_op* o)
+  {
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    {
+      // Stop the operation if an upcall exits via an exception.
+      typename op_base::stop_guard guard = { o };
+
+      // Deliver each successful receive to a copy of the handler. While data
+      // remains available, further receives are performed in-line rather
+      // than by returning to the reactor, up to the per-wakeup budget. Each
+      // receive is performed only after the previous upcall has returned,
+      // and the operation has not been restarted during an upcall, so the
+      // handler may safely cancel, close or destroy the socket.
+      for (std::size_t n = 0; !o->ec_; )
+      {
+        detail::binder2<Handler, asio::error_code, std::size_t>
+          handler(0, Handler(o->handler_), o->ec_, o->bytes_transferred_);
+
+        fenced_block b(fenced_block::half);
+        ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+        asio_handler_invoke_helpers::invoke(handler, handler.handler_);
+        ASIO_HANDLER_INVOCATION_END;
+
+        if (++n == op_base::max_receives
+            || !o->service_.resume_multishot_op(o))
+          break;
+
+        if (!o->perform())
+        {
+          // No more data is available, so wait for the reactor.
+          o->ec_ = asio::error_code();
+          break;
+        }
+      }
+      guard.op_ = 0;
+    }
+
+    // Wait for more data, unless the operation has been stopped.
+    if (!o->ec_)
+    {
+      handler_work<Handler, IoExecutor>::start(o->handler_, o->io_executor_);
+      if (o->service_.restart_multishot_op(o))
+      {
+        p.v = p.p = 0;
+        return;
+      }
+
+      // Balance the work started above.
+      handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+    }
+
+    o->service_.end_multishot_op(o);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the final upcall is made. All data has already been delivered.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, 0);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the final upcall. This function is already running within the
+    // handler's executor.
+    fenced_block b(fenced_block::half);
+    ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+    asio_handler_invoke_helpers::invoke(handler, handler.handler_);
+    ASIO_HANDLER_INVOCATION_END;
+  }
+
+  typedef reactive_socket_multishot_recv_op_base<MutableBufferSequence> op_base;
+
+  Handler handler_;
+  IoExecutor io_executor_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_MULTISHOT_RECEIVE)
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_MULTISHOT_RECV_OP_HPP
@@ -0,0 +1,181 @@
+//
+// detail/reactive_socket_recv_metadata_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_RECV_METADATA_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_RECV_METADATA_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_RECEIVE_METADATA)
+
+#include "asio/receive_metadata.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename MutableBufferSequence, typename Endpoint>
+class reactive_socket_recv_metadata_op_base : public reactor_op
+{
+public:
+  reactive_socket_recv_metadata_op_base(const asio::error_code& success_ec,
+      socket_type socket, socket_ops::state_type state,
+      const MutableBufferSequence& buffers, Endpoint* endpoint,
+      receive_metadata& metadata, socket_base::message_flags flags,
+      func_type complete_func)
+    : reactor_op(success_ec,
+        &reactive_socket_recv_metadata_op_base::do_perform, complete_func),
+      socket_(socket),
+      state_(state),
+      buffers_(buffers),
+      sender_endpoint_(endpoint),
+      metadata_(metadata),
+      flags_(flags)
+  {
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_recv_metadata_op_base* o(
+        static_cast<reactive_socket_recv_metadata_op_base*>(base));
+
+    typedef buffer_sequence_adapter<asio::mutable_buffer,
+        MutableBufferSequence> bufs_type;
+
+    // The ancillary data is received into a buffer on the stack and decoded
+    // into the caller's metadata object.
+    union
+    {
+      cmsghdr header;
+      char buffer[max_control_size];
+    } control;
+    std::size_t control_size = sizeof(control.buffer);
+
+    bufs_type bufs(o->buffers_);
+    std::size_t addr_len = o->sender_endpoint_
+      ? o->sender_endpoint_->capacity() : 0;
+    int out_flags = 0;
+    status result = socket_ops::non_blocking_recvmsg_control(o->socket_,
+        bufs.buffers(), bufs.count(), o->flags_,
+        (o->state_ & socket_ops::stream_oriented) != 0,
+        o->sender_endpoint_ ? o->sender_endpoint_->data() : 0, &addr_len,
+        control.buffer, &control_size, out_flags,
+        o->ec_, o->bytes_transferred_) ? done : not_done;
+
+    if (result)
+    {
+      if (o->sender_endpoint_ && !o->ec_)
+        o->sender_endpoint_->resize(addr_len);
+      o->metadata_.assign(out_flags, control.buffer, control_size);
+
+      if ((o->state_ & socket_ops::stream_oriented) != 0)
+        if (o->bytes_transferred_ == 0)
+          result = done_and_exhausted;
+    }
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_recvmsg_control",
+          o->ec_, o->bytes_transferred_));
+
+    return result;
+  }
+
+private:
+  // The size of the buffer used to receive ancillary data. This is enough for
+  // timestamps, packet information, and a few other control messages.
+  enum { max_control_size = 256 };
+
+  socket_type socket_;
+  socket_ops::state_type state_;
+  MutableBufferSequence buffers_;
+  Endpoint* sender_endpoint_;
+  receive_metadata& metadata_;
+  socket_base::message_flags flags_;
+};
+
+template <typename MutableBufferSequence, typename Endpoint,
+    typename Handler, typename IoExecutor>
+class reactive_socket_recv_metadata_op :
+  public reactive_socket_recv_metadata_op_base<MutableBufferSequence, Endpoint>
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_recv_metadata_op);
+
+  reactive_socket_recv_metadata_op(const asio::error_code& success_ec,
+      socket_type socket, socket_ops::state_type state,
+      const MutableBufferSequence& buffers, Endpoint* endpoint,
+      receive_metadata& metadata, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+    : reactive_socket_recv_metadata_op_base<MutableBufferSequence, Endpoint>(
+        success_ec, socket, state, buffers, endpoint, metadata, flags,
+        &reactive_socket_recv_metadata_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_recv_metadata_op* o(
+        static_cast<reactive_socket_recv_metadata_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  IoExecutor io_executor_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_RECEIVE_METADATA)
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_RECV_METADATA_OP_HPP
@@ -0,0 +1,161 @@
+//
+// detail/reactive_socket_recv_pooled_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_RECV_POOLED_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_RECV_POOLED_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_POOLED_READ)
+
+#include "asio/buffer.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename BufferPool>
+class reactive_socket_recv_pooled_op_base : public reactor_op
+{
+public:
+  reactive_socket_recv_pooled_op_base(const asio::error_code& success_ec,
+      socket_type socket, socket_ops::state_type state,
+      BufferPool& pool, func_type complete_func)
+    : reactor_op(success_ec,
+        &reactive_socket_recv_pooled_op_base::do_perform, complete_func),
+      socket_(socket),
+      state_(state),
+      pool_(pool)
+  {
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_recv_pooled_op_base* o(
+        static_cast<reactive_socket_recv_pooled_op_base*>(base));
+
+    // The buffer is held only for the duration of the read attempt, unless
+    // data is received into it.
+    asio::mutable_buffer buffer = o->pool_.acquire();
+    if (buffer.size() == 0)
+    {
+      o->ec_ = asio::error::no_buffer_space;
+      o->bytes_transferred_ = 0;
+      return done;
+    }
+
+    bool is_stream = (o->state_ & socket_ops::stream_oriented) != 0;
+    status result = socket_ops::non_blocking_recv1(o->socket_,
+        buffer.data(), buffer.size(), 0, is_stream,
+        o->ec_, o->bytes_transferred_) ? done : not_done;
+
+    if (result == done && !o->ec_)
+      o->buffer_ = asio::mutable_buffer(buffer.data(), o->bytes_transferred_);
+    else
+      o->pool_.release(buffer);
+
+    if (result == done)
+      if (is_stream)
+        if (o->bytes_transferred_ == 0)
+          result = done_and_exhausted;
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_recv",
+          o->ec_, o->bytes_transferred_));
+
+    return result;
+  }
+
+protected:
+  socket_type socket_;
+  socket_ops::state_type state_;
+  BufferPool& pool_;
+  asio::mutable_buffer buffer_;
+};
+
+template <typename BufferPool, typename Handler, typename IoExecutor>
+class reactive_socket_recv_pooled_op :
+  public reactive_socket_recv_pooled_op_base<BufferPool>
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_recv_pooled_op);
+
+  reactive_socket_recv_pooled_op(const asio::error_code& success_ec,
+      socket_type socket, socket_ops::state_type state, BufferPool& pool,
+      Handler& handler, const IoExecutor& io_ex)
+    : reactive_socket_recv_pooled_op_base<BufferPool>(success_ec, socket,
+        state, pool, &reactive_socket_recv_pooled_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_recv_pooled_op* o(
+        static_cast<reactive_socket_recv_pooled_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+    BufferPool& pool = o->pool_;
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, asio::mutable_buffer>
+      handler(o->handler_, o->ec_, o->buffer_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required. Otherwise, the buffer is returned to the
+    // pool as there is no handler to take ownership of it.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_.size()));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+    else if (handler.arg2_.size() > 0)
+    {
+      pool.release(handler.arg2_);
+    }
+  }
+
+private:
+  Handler handler_;
+  IoExecutor io_executor_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_POOLED_READ)
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_RECV_POOLED_OP_HPP
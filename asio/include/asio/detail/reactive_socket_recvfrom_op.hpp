@@ -18,6 +18,7 @@
 #include "asio/detail/config.hpp"
 #include "asio/detail/bind_handler.hpp"
 #include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/cancellation_completion.hpp"
 #include "asio/detail/fenced_block.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/reactor_op.hpp"
@@ -132,6 +133,7 @@ public:
     // deallocated the memory here.
     detail::binder2<Handler, asio::error_code, std::size_t>
       handler(o->handler_, o->ec_, o->bytes_transferred_);
+    cancellation_completion c(o);
     p.h = asio::detail::addressof(handler.handler_);
     p.reset();
 
@@ -140,7 +142,7 @@ public:
     {
       fenced_block b(fenced_block::half);
       ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
-      w.complete(handler, handler.handler_);
+      c.complete(w, handler, handler.handler_);
       ASIO_HANDLER_INVOCATION_END;
     }
   }
@@ -0,0 +1,184 @@
+//
+// detail/reactive_socket_send_zero_copy_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_SEND_ZERO_COPY_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_SEND_ZERO_COPY_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/detail/zero_copy_send_state.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename ConstBufferSequence>
+class reactive_socket_send_zero_copy_op_base : public reactor_op
+{
+public:
+  reactive_socket_send_zero_copy_op_base(const asio::error_code& success_ec,
+      socket_type socket, socket_ops::state_type state,
+      zero_copy_send_state* zero_copy, const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, func_type complete_func)
+    : reactor_op(success_ec,
+        &reactive_socket_send_zero_copy_op_base::do_perform, complete_func),
+      socket_(socket),
+      state_(state),
+      zero_copy_(zero_copy),
+      buffers_(buffers),
+      flags_(flags),
+      waiting_(false),
+      id_(0)
+  {
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_send_zero_copy_op_base* o(
+        static_cast<reactive_socket_send_zero_copy_op_base*>(base));
+
+    // Once the data has been sent, the operation waits in the reactor until
+    // the kernel reports that it has released the buffers.
+    if (o->waiting_)
+    {
+      o->zero_copy_->drain(o->socket_);
+      return o->zero_copy_->is_complete(o->id_) ? done : not_done;
+    }
+
+    typedef buffer_sequence_adapter<asio::const_buffer,
+        ConstBufferSequence> bufs_type;
+
+    bufs_type bufs(o->buffers_);
+    bool zero_copy = o->zero_copy_ && o->zero_copy_->enabled()
+      && bufs.total_size() >= ASIO_ZERO_COPY_SEND_THRESHOLD;
+
+    if (!socket_ops::non_blocking_send(o->socket_, bufs.buffers(),
+          bufs.count(), o->flags_ | (zero_copy ? MSG_ZEROCOPY : 0),
+          o->ec_, o->bytes_transferred_))
+      return not_done;
+
+    // The kernel limits the memory used to track zero-copy sends. When that
+    // limit is reached, fall back to copying the data.
+    if (zero_copy && o->ec_ == asio::error::no_buffer_space)
+    {
+      zero_copy = false;
+      if (!socket_ops::non_blocking_send(o->socket_, bufs.buffers(),
+            bufs.count(), o->flags_, o->ec_, o->bytes_transferred_))
+        return not_done;
+    }
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_send",
+          o->ec_, o->bytes_transferred_));
+
+    if (zero_copy && !o->ec_ && o->bytes_transferred_ > 0)
+    {
+      o->id_ = o->zero_copy_->next_id();
+      o->waiting_ = true;
+      return done_and_wait_for_error;
+    }
+
+    if ((o->state_ & socket_ops::stream_oriented) != 0)
+      if (o->bytes_transferred_ < bufs.total_size())
+        return done_and_exhausted;
+
+    return done;
+  }
+
+private:
+  socket_type socket_;
+  socket_ops::state_type state_;
+  zero_copy_send_state* zero_copy_;
+  ConstBufferSequence buffers_;
+  socket_base::message_flags flags_;
+  bool waiting_;
+  uint32_t id_;
+};
+
+template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+class reactive_socket_send_zero_copy_op :
+  public reactive_socket_send_zero_copy_op_base<ConstBufferSequence>
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_send_zero_copy_op);
+
+  reactive_socket_send_zero_copy_op(const asio::error_code& success_ec,
+      socket_type socket, socket_ops::state_type state,
+      zero_copy_send_state* zero_copy, const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+    : reactive_socket_send_zero_copy_op_base<ConstBufferSequence>(
+        success_ec, socket, state, zero_copy, buffers, flags,
+        &reactive_socket_send_zero_copy_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_send_zero_copy_op* o(
+        static_cast<reactive_socket_send_zero_copy_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  IoExecutor io_executor_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_SEND_ZERO_COPY_OP_HPP
@@ -0,0 +1,156 @@
+//
+// detail/reactive_socket_sendfile_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_SENDFILE_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_SENDFILE_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_SENDFILE)
+
+#include "asio/error.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class reactive_socket_sendfile_op_base : public reactor_op
+{
+public:
+  reactive_socket_sendfile_op_base(const asio::error_code& success_ec,
+      socket_type socket, int file, uint64_t offset,
+      std::size_t size, func_type complete_func)
+    : reactor_op(success_ec,
+        &reactive_socket_sendfile_op_base::do_perform, complete_func),
+      socket_(socket),
+      file_(file),
+      offset_(offset),
+      remaining_(size)
+  {
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_sendfile_op_base* o(
+        static_cast<reactive_socket_sendfile_op_base*>(base));
+
+    // Keep sending until the whole range has been transferred, the socket's
+    // send buffer is full, or an error occurs. Progress made before the send
+    // buffer fills is retained when the operation is performed again.
+    while (o->remaining_ > 0)
+    {
+      std::size_t bytes = 0;
+      if (!socket_ops::non_blocking_sendfile(o->socket_, o->file_,
+            o->offset_, o->remaining_, o->ec_, bytes))
+        return not_done;
+
+      ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_sendfile",
+            o->ec_, bytes));
+
+      if (o->ec_)
+        return done;
+
+      // The file ended before the whole range was sent.
+      if (bytes == 0)
+      {
+        o->ec_ = asio::error::eof;
+        return done;
+      }
+
+      o->offset_ += bytes;
+      o->remaining_ -= bytes;
+      o->bytes_transferred_ += bytes;
+    }
+
+    return done;
+  }
+
+private:
+  socket_type socket_;
+  int file_;
+  uint64_t offset_;
+  std::size_t remaining_;
+};
+
+template <typename Handler, typename IoExecutor>
+class reactive_socket_sendfile_op : public reactive_socket_sendfile_op_base
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_sendfile_op);
+
+  reactive_socket_sendfile_op(const asio::error_code& success_ec,
+      socket_type socket, int file, uint64_t offset, std::size_t size,
+      Handler& handler, const IoExecutor& io_ex)
+    : reactive_socket_sendfile_op_base(success_ec, socket, file, offset,
+        size, &reactive_socket_sendfile_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_sendfile_op* o(
+        static_cast<reactive_socket_sendfile_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  IoExecutor io_executor_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_SENDFILE)
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_SENDFILE_OP_HPP
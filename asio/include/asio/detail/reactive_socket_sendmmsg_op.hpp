@@ -0,0 +1,161 @@
+//
+// detail/reactive_socket_sendmmsg_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_SENDMMSG_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_SENDMMSG_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MMSG)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+template <typename ConstBufferSequence, typename Endpoint>
+class reactive_socket_sendmmsg_op_base : public reactor_op
+{
+public:
+  reactive_socket_sendmmsg_op_base(const asio::error_code& success_ec,
+      socket_type socket, const ConstBufferSequence& buffers,
+      const Endpoint* endpoints, socket_base::message_flags flags,
+      func_type complete_func)
+    : reactor_op(success_ec,
+        &reactive_socket_sendmmsg_op_base::do_perform, complete_func),
+      socket_(socket),
+      buffers_(buffers),
+      destinations_(endpoints),
+      flags_(flags)
+  {
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_sendmmsg_op_base* o(
+        static_cast<reactive_socket_sendmmsg_op_base*>(base));
+
+    typedef buffer_sequence_adapter<asio::const_buffer,
+        ConstBufferSequence> bufs_type;
+
+    // Each buffer is sent as one datagram.
+    bufs_type bufs(o->buffers_);
+    mmsghdr msgs[max_messages];
+    std::size_t count = bufs.count() < max_messages
+      ? bufs.count() : static_cast<std::size_t>(max_messages);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      msgs[i] = mmsghdr();
+      msgs[i].msg_hdr.msg_name =
+        const_cast<socket_addr_type*>(o->destinations_[i].data());
+      msgs[i].msg_hdr.msg_namelen = o->destinations_[i].size();
+      msgs[i].msg_hdr.msg_iov = const_cast<socket_ops::buf*>(bufs.buffers()) + i;
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    if (!socket_ops::non_blocking_sendmmsg(o->socket_, msgs, count,
+          o->flags_, o->ec_, o->bytes_transferred_))
+      return not_done;
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_sendmmsg",
+          o->ec_, o->bytes_transferred_));
+
+    return done;
+  }
+
+private:
+  // The maximum number of datagrams sent by one operation.
+  enum { max_messages = 64 };
+
+  socket_type socket_;
+  ConstBufferSequence buffers_;
+  const Endpoint* destinations_;
+  socket_base::message_flags flags_;
+};
+
+template <typename ConstBufferSequence, typename Endpoint,
+    typename Handler, typename IoExecutor>
+class reactive_socket_sendmmsg_op :
+  public reactive_socket_sendmmsg_op_base<ConstBufferSequence, Endpoint>
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_sendmmsg_op);
+
+  reactive_socket_sendmmsg_op(const asio::error_code& success_ec,
+      socket_type socket, const ConstBufferSequence& buffers,
+      const Endpoint* endpoints, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+    : reactive_socket_sendmmsg_op_base<ConstBufferSequence, Endpoint>(
+        success_ec, socket, buffers, endpoints, flags,
+        &reactive_socket_sendmmsg_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_sendmmsg_op* o(
+        static_cast<reactive_socket_sendmmsg_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  IoExecutor io_executor_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_MMSG)
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_SENDMMSG_OP_HPP
@@ -19,6 +19,7 @@
 
 #if !defined(ASIO_HAS_IOCP)
 
+#include "asio/associated_cancellation_slot.hpp"
 #include "asio/buffer.hpp"
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
@@ -29,7 +30,14 @@
 #include "asio/detail/reactive_null_buffers_op.hpp"
 #include "asio/detail/reactive_socket_accept_op.hpp"
 #include "asio/detail/reactive_socket_connect_op.hpp"
+#include "asio/detail/reactive_socket_multishot_accept_op.hpp"
+#include "asio/detail/reactive_socket_multishot_recv_op.hpp"
+#include "asio/detail/reactive_socket_recv_metadata_op.hpp"
+#include "asio/detail/reactive_socket_recvfrom_gro_op.hpp"
 #include "asio/detail/reactive_socket_recvfrom_op.hpp"
+#include "asio/detail/reactive_socket_recvmmsg_op.hpp"
+#include "asio/detail/reactive_socket_sendmmsg_op.hpp"
+#include "asio/detail/reactive_socket_sendto_gso_op.hpp"
 #include "asio/detail/reactive_socket_sendto_op.hpp"
 #include "asio/detail/reactive_socket_service_base.hpp"
 #include "asio/detail/reactor.hpp"
@@ -90,7 +98,7 @@ public:
   void move_construct(implementation_type& impl,
       implementation_type& other_impl) ASIO_NOEXCEPT
   {
-    this->base_move_construct(impl, other_impl);
+    this->base_move_construct(impl, *this, other_impl);
 
     impl.protocol_ = other_impl.protocol_;
     other_impl.protocol_ = endpoint_type().protocol();
@@ -110,11 +118,11 @@ public:
   // Move-construct a new socket implementation from another protocol type.
   template <typename Protocol1>
   void converting_move_construct(implementation_type& impl,
-      reactive_socket_service<Protocol1>&,
+      reactive_socket_service<Protocol1>& other_service,
       typename reactive_socket_service<
         Protocol1>::implementation_type& other_impl)
   {
-    this->base_move_construct(impl, other_impl);
+    this->base_move_construct(impl, other_service, other_impl);
 
     impl.protocol_ = protocol_type(other_impl.protocol_);
     other_impl.protocol_ = typename Protocol1::endpoint().protocol();
@@ -135,7 +143,19 @@ public:
       const protocol_type& protocol, const native_handle_type& native_socket,
       asio::error_code& ec)
   {
-    if (!do_assign(impl, protocol.type(), native_socket, ec))
+    if (!do_assign(impl, protocol.type(),
+          native_socket, socket_ops::possible_dup, ec))
+      impl.protocol_ = protocol;
+    return ec;
+  }
+
+  // Assign a newly accepted native socket to a socket implementation. The
+  // state argument holds the state bits that were set when accepting it.
+  asio::error_code assign_accepted(implementation_type& impl,
+      const protocol_type& protocol, const native_handle_type& native_socket,
+      socket_ops::state_type state, asio::error_code& ec)
+  {
+    if (!do_assign(impl, protocol.type(), native_socket, state, ec))
       impl.protocol_ = protocol;
     return ec;
   }
@@ -260,6 +280,9 @@ public:
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
     // Allocate and construct an operation to wrap the handler.
     typedef reactive_socket_sendto_op<ConstBufferSequence,
         endpoint_type, Handler, IoExecutor> op;
@@ -271,6 +294,15 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_send_to"));
 
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_slot_ = slot;
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, impl.reactor_data_, impl.socket_, reactor::write_op);
+    }
+
     start_op(impl, reactor::write_op, p.p, is_continuation, true, false);
     p.v = p.p = 0;
   }
@@ -284,6 +316,9 @@ public:
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
     // Allocate and construct an operation to wrap the handler.
     typedef reactive_null_buffers_op<Handler, IoExecutor> op;
     typename op::ptr p = { asio::detail::addressof(handler),
@@ -293,9 +328,82 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_send_to(null_buffers)"));
 
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_slot_ = slot;
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, impl.reactor_data_, impl.socket_, reactor::write_op);
+    }
+
     start_op(impl, reactor::write_op, p.p, is_continuation, false, false);
     p.v = p.p = 0;
   }
+#if defined(ASIO_HAS_MMSG)
+  // Start an asynchronous send of one datagram per buffer. The data being
+  // sent must be valid for the lifetime of the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_to_batch(implementation_type& impl,
+      const ConstBufferSequence& buffers,
+      const endpoint_type* destinations, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_sendmmsg_op<ConstBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        buffers, destinations, flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_to_batch"));
+
+    start_op(impl, reactor::write_op, p.p, is_continuation, true, false);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_MMSG)
+
+#if defined(ASIO_HAS_UDP_GSO)
+  // Start an asynchronous send of data that is split into datagrams of the
+  // given segment size. The data being sent must be valid for the lifetime of
+  // the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_to_segmented(implementation_type& impl,
+      const ConstBufferSequence& buffers, const endpoint_type& destination,
+      std::size_t segment_size, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_sendto_gso_op<ConstBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, buffers,
+        destination, segment_size, flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_to_segmented"));
+
+    // The segment size is passed to the kernel as a 16-bit value.
+    if (segment_size == 0 || segment_size > 65535)
+    {
+      p.p->ec_ = asio::error::invalid_argument;
+      reactor_.post_immediate_completion(p.p, is_continuation);
+    }
+    else
+      start_op(impl, reactor::write_op, p.p, is_continuation, true, false);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_UDP_GSO)
+
 
   // Receive a datagram with the endpoint of the sender. Returns the number of
   // bytes received.
@@ -358,6 +466,9 @@ public:
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
     // Allocate and construct an operation to wrap the handler.
     typedef reactive_socket_recvfrom_op<MutableBufferSequence,
         endpoint_type, Handler, IoExecutor> op;
@@ -370,6 +481,17 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_receive_from"));
 
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_slot_ = slot;
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, impl.reactor_data_, impl.socket_,
+            (flags & socket_base::message_out_of_band)
+              ? reactor::except_op : reactor::read_op);
+    }
+
     start_op(impl,
         (flags & socket_base::message_out_of_band)
           ? reactor::except_op : reactor::read_op,
@@ -386,6 +508,9 @@ public:
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
     // Allocate and construct an operation to wrap the handler.
     typedef reactive_null_buffers_op<Handler, IoExecutor> op;
     typename op::ptr p = { asio::detail::addressof(handler),
@@ -395,6 +520,17 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_receive_from(null_buffers)"));
 
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_slot_ = slot;
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, impl.reactor_data_, impl.socket_,
+            (flags & socket_base::message_out_of_band)
+              ? reactor::except_op : reactor::read_op);
+    }
+
     // Reset endpoint since it can be given no sensible value at this time.
     sender_endpoint = endpoint_type();
 
@@ -404,6 +540,110 @@ public:
         p.p, is_continuation, false, false);
     p.v = p.p = 0;
   }
+#if defined(ASIO_HAS_MMSG)
+  // Start an asynchronous receive of one datagram per buffer. The buffers,
+  // endpoints and sizes must be valid for the lifetime of the asynchronous
+  // operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_from_batch(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type* sender_endpoints,
+      std::size_t* sizes, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recvmmsg_op<MutableBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, buffers,
+        sender_endpoints, sizes, flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_from_batch"));
+
+    start_op(impl,
+        (flags & socket_base::message_out_of_band)
+          ? reactor::except_op : reactor::read_op,
+        p.p, is_continuation, true, false);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_MMSG)
+
+#if defined(ASIO_HAS_RECEIVE_METADATA)
+  // Start an asynchronous receive that also obtains the ancillary data for the
+  // received message. The sender endpoint may be null if it is not required.
+  // The buffers, endpoint and metadata must be valid for the lifetime of the
+  // asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_with_metadata(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type* sender_endpoint,
+      receive_metadata& metadata, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recv_metadata_op<MutableBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, impl.state_,
+        buffers, sender_endpoint, metadata, flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_with_metadata"));
+
+    start_op(impl,
+        (flags & socket_base::message_out_of_band)
+          ? reactor::except_op : reactor::read_op,
+        p.p, is_continuation,
+        (flags & socket_base::message_out_of_band) == 0,
+        ((impl.state_ & socket_ops::stream_oriented)
+          && buffer_sequence_adapter<asio::mutable_buffer,
+            MutableBufferSequence>::all_empty(buffers)));
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_RECEIVE_METADATA)
+
+#if defined(ASIO_HAS_UDP_GSO)
+  // Start an asynchronous receive of one or more coalesced datagrams. The
+  // buffer, endpoint and segment size must be valid for the lifetime of the
+  // asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_from_coalesced(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type& sender_endpoint,
+      std::size_t& segment_size, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recvfrom_gro_op<MutableBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, buffers,
+        sender_endpoint, segment_size, flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_from_coalesced"));
+
+    start_op(impl,
+        (flags & socket_base::message_out_of_band)
+          ? reactor::except_op : reactor::read_op,
+        p.p, is_continuation, true, false);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_UDP_GSO)
+
 
   // Accept a new connection.
   template <typename Socket>
@@ -444,6 +684,9 @@ public:
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
     // Allocate and construct an operation to wrap the handler.
     typedef reactive_socket_accept_op<Socket, Protocol, Handler, IoExecutor> op;
     typename op::ptr p = { asio::detail::addressof(handler),
@@ -454,6 +697,15 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_accept"));
 
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_slot_ = slot;
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, impl.reactor_data_, impl.socket_, reactor::read_op);
+    }
+
     start_accept_op(impl, p.p, is_continuation, peer.is_open());
     p.v = p.p = 0;
   }
@@ -469,6 +721,9 @@ public:
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
     // Allocate and construct an operation to wrap the handler.
     typedef reactive_socket_move_accept_op<Protocol,
         PeerIoExecutor, Handler, IoExecutor> op;
@@ -480,11 +735,87 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_accept"));
 
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_slot_ = slot;
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, impl.reactor_data_, impl.socket_, reactor::read_op);
+    }
+
     start_accept_op(impl, p.p, is_continuation, false);
     p.v = p.p = 0;
   }
 #endif // defined(ASIO_HAS_MOVE)
 
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT)
+  // Start an asynchronous accept that delivers each new connection to a copy
+  // of the handler, until the operation fails or is stopped. The statistics
+  // object, if any, must be valid until the operation completes.
+  template <typename PeerIoExecutor, typename Handler, typename IoExecutor>
+  void async_multishot_accept(implementation_type& impl,
+      const PeerIoExecutor& peer_io_ex,
+      socket_base::multishot_accept_statistics* statistics,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_multishot_accept_op<Protocol,
+        PeerIoExecutor, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, *this, peer_io_ex,
+        impl.protocol_, statistics, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_multishot_accept"));
+
+    start_multishot_op(impl, p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
+
+#if defined(ASIO_HAS_MULTISHOT_RECEIVE)
+  // Start an asynchronous receive that delivers each chunk of data to a copy
+  // of the handler, until the operation fails or is stopped. The buffers must
+  // be valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_multishot_receive(implementation_type& impl,
+      const MutableBufferSequence& buffers, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_multishot_recv_op<
+        MutableBufferSequence, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, *this, buffers, flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_multishot_receive"));
+
+    // A zero-sized receive on a stream would complete immediately and
+    // repeatedly, so it is rejected.
+    if ((impl.state_ & socket_ops::stream_oriented)
+        && buffer_sequence_adapter<asio::mutable_buffer,
+          MutableBufferSequence>::all_empty(buffers))
+    {
+      p.p->ec_ = asio::error::invalid_argument;
+      reactor_.post_immediate_completion(p.p, is_continuation);
+    }
+    else
+      start_multishot_op(impl, p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_MULTISHOT_RECEIVE)
+
   // Connect the socket to the specified endpoint.
   asio::error_code connect(implementation_type& impl,
       const endpoint_type& peer_endpoint, asio::error_code& ec)
@@ -503,6 +834,9 @@ public:
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
     // Allocate and construct an operation to wrap the handler.
     typedef reactive_socket_connect_op<Handler, IoExecutor> op;
     typename op::ptr p = { asio::detail::addressof(handler),
@@ -512,10 +846,50 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_connect"));
 
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_slot_ = slot;
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, impl.reactor_data_, impl.socket_, reactor::connect_op);
+    }
+
     start_connect_op(impl, p.p, is_continuation,
         peer_endpoint.data(), peer_endpoint.size());
     p.v = p.p = 0;
   }
+
+#if defined(ASIO_HAS_TCP_FAST_OPEN)
+  // Start an asynchronous connect that may send data with the connection
+  // request.
+  template <typename ConstBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_fast_open_connect(implementation_type& impl,
+      const endpoint_type& peer_endpoint, const ConstBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_fast_open_connect_op<Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_fast_open_connect"));
+
+    buffer_sequence_adapter<asio::const_buffer,
+        ConstBufferSequence> bufs(buffers);
+
+    start_fast_open_connect_op(impl, p.p, is_continuation,
+        peer_endpoint.data(), peer_endpoint.size(),
+        bufs.buffers(), bufs.count());
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_TCP_FAST_OPEN)
 };
 
 } // namespace detail
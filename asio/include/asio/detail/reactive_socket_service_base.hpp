@@ -20,34 +20,61 @@
 #if !defined(ASIO_HAS_IOCP) \
   && !defined(ASIO_WINDOWS_RUNTIME)
 
+#include "asio/associated_cancellation_slot.hpp"
 #include "asio/buffer.hpp"
 #include "asio/error.hpp"
 #include "asio/execution_context.hpp"
 #include "asio/socket_base.hpp"
 #include "asio/detail/buffer_sequence_adapter.hpp"
 #include "asio/detail/memory.hpp"
+#include "asio/detail/mutex.hpp"
 #include "asio/detail/reactive_null_buffers_op.hpp"
 #include "asio/detail/reactive_socket_recv_op.hpp"
+#include "asio/detail/reactive_socket_recv_pooled_op.hpp"
 #include "asio/detail/reactive_socket_recvmsg_op.hpp"
 #include "asio/detail/reactive_socket_send_op.hpp"
+#include "asio/detail/reactive_socket_sendfile_op.hpp"
+#include "asio/detail/reactive_socket_send_zero_copy_op.hpp"
 #include "asio/detail/reactive_wait_op.hpp"
 #include "asio/detail/reactor.hpp"
 #include "asio/detail/reactor_op.hpp"
 #include "asio/detail/socket_holder.hpp"
 #include "asio/detail/socket_ops.hpp"
 #include "asio/detail/socket_types.hpp"
+#include "asio/detail/zero_copy_send_state.hpp"
+
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+# include "asio/wait_traits.hpp"
+# include "asio/detail/chrono.hpp"
+# include "asio/detail/chrono_time_traits.hpp"
+# include "asio/detail/scheduler.hpp"
+# include "asio/detail/timer_queue.hpp"
+# include "asio/detail/wait_op.hpp"
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
 
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
 namespace detail {
 
+class reactive_socket_multishot_op_base;
+class reactive_socket_expiry_op;
+
 class reactive_socket_service_base
 {
 public:
   // The native type of a socket.
   typedef socket_type native_handle_type;
 
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+  // The time traits used for socket expiry times.
+  typedef chrono_time_traits<chrono::steady_clock,
+      asio::wait_traits<chrono::steady_clock> > expiry_time_traits;
+
+  // The type used to represent a socket expiry time.
+  typedef expiry_time_traits::time_type expiry_time_type;
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
   // The implementation type of the socket.
   struct base_implementation_type
   {
@@ -59,11 +86,30 @@ public:
 
     // Per-descriptor data used by the reactor.
     reactor::per_descriptor_data reactor_data_;
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    // The state of zero-copy sends, created when the first one is started.
+    zero_copy_send_state* zero_copy_send_state_;
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+    // The time at which outstanding operations time out.
+    expiry_time_type expiry_;
+
+    // The operation that waits for the expiry time, created when the first
+    // operation is started while an expiry time is set.
+    reactive_socket_expiry_op* expiry_op_;
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
   };
 
   // Constructor.
   ASIO_DECL reactive_socket_service_base(execution_context& context);
 
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+  // Destructor.
+  ASIO_DECL ~reactive_socket_service_base();
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
   // Destroy all user-defined handler objects owned by the service.
   ASIO_DECL void base_shutdown();
 
@@ -72,7 +118,8 @@ public:
 
   // Move-construct a new socket implementation.
   ASIO_DECL void base_move_construct(base_implementation_type& impl,
-      base_implementation_type& other_impl) ASIO_NOEXCEPT;
+      reactive_socket_service_base& other_service,
+      base_implementation_type& other_impl);
 
   // Move-assign from another socket implementation.
   ASIO_DECL void base_move_assign(base_implementation_type& impl,
@@ -96,6 +143,13 @@ public:
   ASIO_DECL socket_type release(
       base_implementation_type& impl, asio::error_code& ec);
 
+#if defined(ASIO_HAS_SOCKET_MIGRATION)
+  // Move the socket to the service of another execution context. Fails with
+  // asio::error::in_progress if any operations are outstanding.
+  ASIO_DECL asio::error_code migrate(base_implementation_type& impl,
+      reactive_socket_service_base& target_service, asio::error_code& ec);
+#endif // defined(ASIO_HAS_SOCKET_MIGRATION)
+
   // Get the native socket representation.
   native_handle_type native_handle(base_implementation_type& impl)
   {
@@ -106,6 +160,31 @@ public:
   ASIO_DECL asio::error_code cancel(
       base_implementation_type& impl, asio::error_code& ec);
 
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+  // Get the time at which outstanding operations time out.
+  expiry_time_type expiry(const base_implementation_type& impl) const
+  {
+    return impl.expiry_;
+  }
+
+  // Set the time at which outstanding operations time out.
+  ASIO_DECL void expires_at(base_implementation_type& impl,
+      const expiry_time_type& expiry_time);
+
+  // Set the time at which outstanding operations time out, relative to now.
+  void expires_after(base_implementation_type& impl,
+      const expiry_time_traits::duration_type& expiry_time)
+  {
+    expires_at(impl, expiry_time_traits::add(
+          expiry_time_traits::now(), expiry_time));
+  }
+
+  // Time out the socket's outstanding operations if the expiry time has been
+  // reached, or wait for it again. Called when an expiry operation completes
+  // or is destroyed.
+  ASIO_DECL void handle_expiry(reactive_socket_expiry_op* op, bool owner);
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
   // Determine whether the socket is at the out-of-band data mark.
   bool at_mark(const base_implementation_type& impl,
       asio::error_code& ec) const
@@ -199,6 +278,9 @@ public:
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
     // Allocate and construct an operation to wrap the handler.
     typedef reactive_wait_op<Handler, IoExecutor> op;
     typename op::ptr p = { asio::detail::addressof(handler),
@@ -227,6 +309,15 @@ public:
         return;
     }
 
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_slot_ = slot;
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, impl.reactor_data_, impl.socket_, op_type);
+    }
+
     start_op(impl, op_type, p.p, is_continuation, false, false);
     p.v = p.p = 0;
   }
@@ -274,6 +365,9 @@ public:
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
     // Allocate and construct an operation to wrap the handler.
     typedef reactive_socket_send_op<
         ConstBufferSequence, Handler, IoExecutor> op;
@@ -285,12 +379,77 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_send"));
 
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_slot_ = slot;
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, impl.reactor_data_, impl.socket_, reactor::write_op);
+    }
+
+    start_op(impl, reactor::write_op, p.p, is_continuation, true,
+        ((impl.state_ & socket_ops::stream_oriented)
+          && buffer_sequence_adapter<asio::const_buffer,
+            ConstBufferSequence>::all_empty(buffers)));
+    p.v = p.p = 0;
+  }
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  // Start an asynchronous zero-copy send. The operation does not complete
+  // until the kernel has released the buffers.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_zero_copy(base_implementation_type& impl,
+      const ConstBufferSequence& buffers, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_send_zero_copy_op<
+        ConstBufferSequence, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, impl.state_,
+        enable_zero_copy_send(impl), buffers, flags, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_zero_copy"));
+
     start_op(impl, reactor::write_op, p.p, is_continuation, true,
         ((impl.state_ & socket_ops::stream_oriented)
           && buffer_sequence_adapter<asio::const_buffer,
             ConstBufferSequence>::all_empty(buffers)));
     p.v = p.p = 0;
   }
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#if defined(ASIO_HAS_SENDFILE)
+  // Start an asynchronous send of a range of bytes from a file. The operation
+  // completes when the whole range has been sent, or an error occurs.
+  template <typename Handler, typename IoExecutor>
+  void async_send_file(base_implementation_type& impl, int file,
+      uint64_t offset, std::size_t size, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_sendfile_op<Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        file, offset, size, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_file"));
+
+    start_op(impl, reactor::write_op, p.p, is_continuation, true, size == 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_SENDFILE)
 
   // Start an asynchronous wait until data can be sent without blocking.
   template <typename Handler, typename IoExecutor>
@@ -300,6 +459,9 @@ public:
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
     // Allocate and construct an operation to wrap the handler.
     typedef reactive_null_buffers_op<Handler, IoExecutor> op;
     typename op::ptr p = { asio::detail::addressof(handler),
@@ -309,6 +471,15 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_send(null_buffers)"));
 
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_slot_ = slot;
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, impl.reactor_data_, impl.socket_, reactor::write_op);
+    }
+
     start_op(impl, reactor::write_op, p.p, is_continuation, false, false);
     p.v = p.p = 0;
   }
@@ -357,6 +528,9 @@ public:
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
     // Allocate and construct an operation to wrap the handler.
     typedef reactive_socket_recv_op<
         MutableBufferSequence, Handler, IoExecutor> op;
@@ -368,6 +542,17 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_receive"));
 
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_slot_ = slot;
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, impl.reactor_data_, impl.socket_,
+            (flags & socket_base::message_out_of_band)
+              ? reactor::except_op : reactor::read_op);
+    }
+
     start_op(impl,
         (flags & socket_base::message_out_of_band)
           ? reactor::except_op : reactor::read_op,
@@ -388,6 +573,9 @@ public:
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
     // Allocate and construct an operation to wrap the handler.
     typedef reactive_null_buffers_op<Handler, IoExecutor> op;
     typename op::ptr p = { asio::detail::addressof(handler),
@@ -397,6 +585,17 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_receive(null_buffers)"));
 
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_slot_ = slot;
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, impl.reactor_data_, impl.socket_,
+            (flags & socket_base::message_out_of_band)
+              ? reactor::except_op : reactor::read_op);
+    }
+
     start_op(impl,
         (flags & socket_base::message_out_of_band)
           ? reactor::except_op : reactor::read_op,
@@ -404,6 +603,33 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(ASIO_HAS_POOLED_READ)
+  // Start an asynchronous receive into a buffer that is obtained from the
+  // pool once the socket is ready. The pool must be valid for the lifetime of
+  // the asynchronous operation.
+  template <typename BufferPool, typename Handler, typename IoExecutor>
+  void async_receive_pooled(base_implementation_type& impl,
+      BufferPool& pool, Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recv_pooled_op<
+        BufferPool, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        impl.state_, pool, handler, io_ex);
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_pooled"));
+
+    start_op(impl, reactor::read_op, p.p, is_continuation, true, false);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_POOLED_READ)
+
   // Receive some data with associated flags. Returns the number of bytes
   // received.
   template <typename MutableBufferSequence>
@@ -446,6 +672,9 @@ public:
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
     // Allocate and construct an operation to wrap the handler.
     typedef reactive_socket_recvmsg_op<
         MutableBufferSequence, Handler, IoExecutor> op;
@@ -457,6 +686,17 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_receive_with_flags"));
 
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_slot_ = slot;
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, impl.reactor_data_, impl.socket_,
+            (in_flags & socket_base::message_out_of_band)
+              ? reactor::except_op : reactor::read_op);
+    }
+
     start_op(impl,
         (in_flags & socket_base::message_out_of_band)
           ? reactor::except_op : reactor::read_op,
@@ -475,6 +715,9 @@ public:
     bool is_continuation =
       asio_handler_cont_helpers::is_continuation(handler);
 
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
     // Allocate and construct an operation to wrap the handler.
     typedef reactive_null_buffers_op<Handler, IoExecutor> op;
     typename op::ptr p = { asio::detail::addressof(handler),
@@ -484,6 +727,17 @@ public:
     ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
           &impl, impl.socket_, "async_receive_with_flags(null_buffers)"));
 
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_slot_ = slot;
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, impl.reactor_data_, impl.socket_,
+            (in_flags & socket_base::message_out_of_band)
+              ? reactor::except_op : reactor::read_op);
+    }
+
     // Clear out_flags, since we cannot give it any other sensible value when
     // performing a null_buffers operation.
     out_flags = 0;
@@ -501,10 +755,12 @@ protected:
       base_implementation_type& impl, int af,
       int type, int protocol, asio::error_code& ec);
 
-  // Assign a native socket to a socket implementation.
+  // Assign a native socket to a socket implementation. The state argument
+  // holds any state bits that are already known for the native socket.
   ASIO_DECL asio::error_code do_assign(
       base_implementation_type& impl, int type,
-      const native_handle_type& native_socket, asio::error_code& ec);
+      const native_handle_type& native_socket,
+      socket_ops::state_type state, asio::error_code& ec);
 
   // Start the asynchronous read or write operation.
   ASIO_DECL void start_op(base_implementation_type& impl, int op_type,
@@ -519,11 +775,304 @@ protected:
       reactor_op* op, bool is_continuation,
       const socket_addr_type* addr, size_t addrlen);
 
+#if defined(ASIO_HAS_TCP_FAST_OPEN)
+  // Start the asynchronous connect operation, sending the initial data with
+  // the connection request where possible.
+  ASIO_DECL void start_fast_open_connect_op(base_implementation_type& impl,
+      reactor_op* op, bool is_continuation, const socket_addr_type* addr,
+      size_t addrlen, const socket_ops::buf* bufs, size_t count);
+#endif // defined(ASIO_HAS_TCP_FAST_OPEN)
+
+  // Helper class used to implement per-operation cancellation. The
+  // descriptor's reactor data is copied, rather than referenced, so that the
+  // handler remains valid if the socket is moved.
+  class reactor_op_cancellation
+  {
+  public:
+    reactor_op_cancellation(reactor* r,
+        reactor::per_descriptor_data reactor_data,
+        socket_type descriptor, int op_type)
+      : reactor_(r),
+        reactor_data_(reactor_data),
+        descriptor_(descriptor),
+        op_type_(op_type)
+    {
+    }
+
+    void operator()()
+    {
+      reactor_->cancel_ops_by_key(descriptor_, reactor_data_, op_type_, this);
+    }
+
+  private:
+    reactor* reactor_;
+    reactor::per_descriptor_data reactor_data_;
+    socket_type descriptor_;
+    int op_type_;
+  };
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+  // Get the zero-copy send state for the implementation, creating it and
+  // enabling zero-copy sends on the socket if required. Returns null if the
+  // socket is not open.
+  ASIO_DECL zero_copy_send_state* enable_zero_copy_send(
+      base_implementation_type& impl);
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+  // Start a multishot operation and register it with the service.
+  ASIO_DECL void start_multishot_op(base_implementation_type& impl,
+      reactive_socket_multishot_op_base* op, bool is_continuation);
+
+public:
+  // Restart a multishot operation after its results have been delivered.
+  // Returns false if the operation has been stopped.
+  ASIO_DECL bool restart_multishot_op(reactive_socket_multishot_op_base* op);
+
+  // Prepare a multishot operation to perform further I/O without waiting for
+  // the reactor. Returns false if the operation has been stopped.
+  ASIO_DECL bool resume_multishot_op(reactive_socket_multishot_op_base* op);
+
+  // Unregister a multishot operation that has finished.
+  ASIO_DECL void end_multishot_op(reactive_socket_multishot_op_base* op);
+
+private:
+  // Stop any multishot operations associated with the implementation.
+  ASIO_DECL void stop_multishot_ops(base_implementation_type& impl);
+
+  // Remove a multishot operation from the list. The mutex must be held.
+  ASIO_DECL void remove_multishot_op(reactive_socket_multishot_op_base* op);
+
+  // Associate any multishot operations with a new implementation.
+  ASIO_DECL void move_multishot_ops(base_implementation_type& impl,
+      base_implementation_type& other_impl);
+
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+  // Start an operation on a socket that has an expiry time, failing it if the
+  // expiry time has already been reached.
+  ASIO_DECL void start_op_with_expiry(base_implementation_type& impl,
+      int op_type, reactor_op* op, bool is_continuation,
+      bool allow_speculative);
+
+  // Add an expiry operation to the timer queue. The mutex must be held.
+  ASIO_DECL void schedule_expiry(reactive_socket_expiry_op* op,
+      const expiry_time_type& expiry_time);
+
+  // Stop waiting for the implementation's expiry time. Returns true if the
+  // expiry operation was waiting.
+  ASIO_DECL bool stop_expiry(base_implementation_type& impl);
+
+  // Associate any expiry operation with a new implementation.
+  ASIO_DECL void move_expiry(base_implementation_type& impl,
+      base_implementation_type& other_impl);
+
+  // Take the expiry time of an implementation that belongs to another
+  // service, and wait for it if the other service was waiting.
+  ASIO_DECL void transfer_expiry(base_implementation_type& impl,
+      reactive_socket_service_base& other_service,
+      base_implementation_type& other_impl);
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
+protected:
   // The selector that performs event demultiplexing for the service.
   reactor& reactor_;
 
   // Cached success value to avoid accessing category singleton.
   const asio::error_code success_ec_;
+
+private:
+  // Mutex to protect access to the multishot operations.
+  mutex mutex_;
+
+  // The registered multishot operations.
+  reactive_socket_multishot_op_base* multishot_ops_;
+
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+  // The scheduler that runs the expiry operations.
+  scheduler& scheduler_;
+
+  // Mutex to protect access to the expiry operations.
+  mutex expiry_mutex_;
+
+  // The queue of expiry operations waiting for their expiry times.
+  timer_queue<expiry_time_traits> timer_queue_;
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+};
+
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+
+// An expiry operation waits for a socket's expiry time and then times out the
+// socket's outstanding operations. It is created once per socket, and is
+// reused whenever an operation is started while an expiry time is set.
+class reactive_socket_expiry_op : public wait_op
+{
+public:
+  reactive_socket_expiry_op(reactive_socket_service_base& service,
+      reactive_socket_service_base::base_implementation_type& impl)
+    : wait_op(&reactive_socket_expiry_op::do_complete),
+      service_(service),
+      impl_(&impl),
+      socket_(invalid_socket),
+      reactor_data_(),
+      armed_(false)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    reactive_socket_expiry_op* o(static_cast<reactive_socket_expiry_op*>(base));
+    o->service_.handle_expiry(o, owner != 0);
+  }
+
+private:
+  friend class reactive_socket_service_base;
+
+  // The service that owns the operation.
+  reactive_socket_service_base& service_;
+
+  // The socket implementation, or null if the socket has been closed or
+  // destroyed, in which case the operation destroys itself on completion.
+  reactive_socket_service_base::base_implementation_type* impl_;
+
+  // The socket and reactor data as at the most recent operation start.
+  socket_type socket_;
+  reactor::per_descriptor_data reactor_data_;
+
+  // The timer queue entry, and the time for which it was scheduled.
+  timer_queue<reactive_socket_service_base::expiry_time_traits>::per_timer_data
+    timer_data_;
+  reactive_socket_service_base::expiry_time_type time_;
+
+  // Whether the operation is in the timer queue, or waiting to complete.
+  bool armed_;
+};
+
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
+// A multishot operation remains registered with the service that started it,
+// so that the operation can be stopped when the socket is cancelled, closed or
+// destroyed between wakeups.
+class reactive_socket_multishot_op_base : public reactor_op
+{
+public:
+  reactive_socket_multishot_op_base(const asio::error_code& success_ec,
+      reactive_socket_service_base& service,
+      perform_func_type perform_func, func_type complete_func)
+    : reactor_op(success_ec, perform_func, complete_func),
+      service_(service),
+      impl_(0),
+      next_(0),
+      prev_(0),
+      socket_(invalid_socket),
+      state_(0)
+  {
+  }
+
+protected:
+  friend class reactive_socket_service_base;
+
+  // The service with which the operation is registered.
+  reactive_socket_service_base& service_;
+
+  // The socket implementation, or null if the operation has been stopped.
+  reactive_socket_service_base::base_implementation_type* impl_;
+
+  // The links in the service's list of multishot operations.
+  reactive_socket_multishot_op_base* next_;
+  reactive_socket_multishot_op_base* prev_;
+
+  // The socket and state as at the most recent (re)start.
+  socket_type socket_;
+  socket_ops::state_type state_;
+};
+
+// A multishot accept operation drains the listen queue on each wakeup.
+class reactive_socket_multishot_accept_op_base :
+  public reactive_socket_multishot_op_base
+{
+public:
+  // The maximum number of connections accepted on each wakeup.
+  enum { max_accepts = 16 };
+
+  reactive_socket_multishot_accept_op_base(
+      const asio::error_code& success_ec,
+      reactive_socket_service_base& service, func_type complete_func)
+    : reactive_socket_multishot_op_base(success_ec, service,
+        &reactive_socket_multishot_accept_op_base::do_perform, complete_func),
+      count_(0)
+  {
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_multishot_accept_op_base* o(
+        static_cast<reactive_socket_multishot_accept_op_base*>(base));
+
+    // Drain the listen queue, up to the per-wakeup budget.
+    while (o->count_ < max_accepts)
+    {
+      asio::error_code ec;
+      socket_type new_socket = invalid_socket;
+      socket_ops::state_type new_state = 0;
+      if (!socket_ops::non_blocking_accept(o->socket_,
+            o->state_, 0, 0, ec, new_socket, new_state))
+        break;
+
+      if (new_socket == invalid_socket)
+      {
+        // Errors are reported only when they prevent any progress, since a
+        // persistent error will simply recur on the next wakeup.
+        if (o->count_ == 0)
+          o->ec_ = ec;
+        break;
+      }
+
+      o->sockets_[o->count_] = new_socket;
+      o->states_[o->count_] = new_state;
+      ++o->count_;
+    }
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_accept", o->ec_));
+
+    return (o->count_ > 0 || o->ec_) ? done : not_done;
+  }
+
+  // Close any accepted connections that have not been delivered.
+  void close_accepted()
+  {
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+      if (sockets_[i] != invalid_socket)
+      {
+        asio::error_code ignored_ec;
+        socket_ops::state_type state = 0;
+        socket_ops::close(sockets_[i], state, true, ignored_ec);
+      }
+    }
+    count_ = 0;
+  }
+
+  // Stops the operation if the delivery of connections is interrupted.
+  struct stop_guard
+  {
+    reactive_socket_multishot_accept_op_base* op_;
+
+    ~stop_guard()
+    {
+      if (op_)
+      {
+        op_->service_.end_multishot_op(op_);
+        op_->close_accepted();
+      }
+    }
+  };
+
+protected:
+  // The connections accepted on the current wakeup.
+  std::size_t count_;
+  socket_type sockets_[max_accepts];
+  socket_ops::state_type states_[max_accepts];
 };
 
 } // namespace detail
@@ -16,8 +16,13 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/cancellation_signal.hpp"
 #include "asio/detail/operation.hpp"
 
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+# include "asio/detail/allocation_accounting.hpp"
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -33,9 +38,35 @@ public:
   // The number of bytes transferred, to be passed to the completion handler.
   std::size_t bytes_transferred_;
 
+  // The operation key used for targeted cancellation.
+  void* cancellation_key_;
+
+  // The slot into which the operation's cancellation handler is installed.
+  cancellation_slot cancellation_slot_;
+
+  // Remove the operation's handler from its slot. The handler will not be
+  // removed again when the operation completes, as by then the slot may have
+  // been reused by another operation.
+  void release_cancellation_slot()
+  {
+    clear_cancellation_slot(cancellation_slot_, cancellation_key_);
+    cancellation_key_ = 0;
+  }
+
   // Status returned by perform function. May be used to decide whether it is
   // worth performing more operations on the descriptor immediately.
-  enum status { not_done, done, done_and_exhausted };
+  enum status { not_done, done, done_and_exhausted
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+    // The operation has finished with its current queue and must wait for a
+    // report on the descriptor's error queue.
+    , done_and_wait_for_error
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+  };
+
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+  // The category used when recording allocations of derived operations.
+  enum { allocation_category = allocation_accounting::reactor_operations };
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
 
   // Perform the operation. Returns true if it is finished.
   status perform()
@@ -51,6 +82,7 @@ protected:
     : operation(complete_func),
       ec_(success_ec),
       bytes_transferred_(0),
+      cancellation_key_(0),
       perform_func_(perform_func)
   {
   }
@@ -100,6 +100,53 @@ public:
     return this->cancel_operations(operations_.find(descriptor), ops, ec);
   }
 
+  // Cancel the operations associated with the descriptor that have the
+  // specified cancellation key. Returns true if any operations were
+  // cancelled, in which case the reactor's event demultiplexing function may
+  // need to be interrupted and restarted.
+  bool cancel_operations_by_key(Descriptor descriptor, op_queue<operation>& ops,
+      void* cancellation_key, const asio::error_code& ec =
+        asio::error::operation_aborted)
+  {
+    bool result = false;
+    iterator i = operations_.find(descriptor);
+    if (i != operations_.end())
+    {
+      op_queue<reactor_op> other_ops;
+      while (reactor_op* op = i->second.front())
+      {
+        i->second.pop();
+        if (op->cancellation_key_ == cancellation_key)
+        {
+          op->ec_ = ec;
+          ops.push(op);
+          op->release_cancellation_slot();
+          result = true;
+        }
+        else
+          other_ops.push(op);
+      }
+      i->second.push(other_ops);
+      if (i->second.empty())
+        operations_.erase(i);
+    }
+    return result;
+  }
+
+  // Remove the cancellation handlers of the operations associated with the
+  // descriptor from their slots, as the operations can no longer be cancelled
+  // individually once the descriptor has been deregistered.
+  void release_cancellation_slots(Descriptor descriptor)
+  {
+    iterator i = operations_.find(descriptor);
+    if (i != operations_.end())
+    {
+      for (reactor_op* op = i->second.front();
+          op; op = op_queue_access::next(op))
+        op->release_cancellation_slot();
+    }
+  }
+
   // Whether there are no operations in the queue.
   bool empty() const
   {
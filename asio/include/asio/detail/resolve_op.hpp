@@ -19,6 +19,10 @@
 #include "asio/error.hpp"
 #include "asio/detail/operation.hpp"
 
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+# include "asio/detail/allocation_accounting.hpp"
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -30,6 +34,11 @@ public:
   // The error code to be passed to the completion handler.
   asio::error_code ec_;
 
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+  // The category used when recording allocations of derived operations.
+  enum { allocation_category = allocation_accounting::resolver_operations };
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
 protected:
   resolve_op(func_type complete_func)
     : operation(complete_func)
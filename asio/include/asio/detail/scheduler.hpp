@@ -19,9 +19,11 @@
 
 #include "asio/error_code.hpp"
 #include "asio/execution_context.hpp"
+#include "asio/detail/allocation_accounting_service.hpp"
 #include "asio/detail/atomic_count.hpp"
 #include "asio/detail/conditionally_enabled_event.hpp"
 #include "asio/detail/conditionally_enabled_mutex.hpp"
+#include "asio/detail/memory_resource_service.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/reactor_fwd.hpp"
 #include "asio/detail/scheduler_operation.hpp"
@@ -81,6 +83,13 @@ public:
   // Restart in preparation for a subsequent run invocation.
   ASIO_DECL void restart();
 
+  // Reserve space in the task for the specified number of registered
+  // descriptors and pending timers.
+  ASIO_DECL void reserve(std::size_t descriptors, std::size_t timers);
+
+  // Release memory that is held for reuse but is not currently needed.
+  ASIO_DECL void trim();
+
   // Notify that some work has started.
   void work_started()
   {
@@ -131,6 +140,20 @@ public:
     return concurrency_hint_;
   }
 
+  // Get the memory resource used for internal allocations. Returns a null
+  // pointer if the default allocation functions are used.
+  memory_resource* get_memory_resource() const
+  {
+    return memory_resource_;
+  }
+
+  // Get the allocation accounting for the scheduler's context. Returns a null
+  // pointer if allocation accounting is not enabled.
+  allocation_accounting* get_allocation_accounting() const
+  {
+    return allocation_accounting_;
+  }
+
 private:
   // The mutex type used by this scheduler.
   typedef conditionally_enabled_mutex mutex;
@@ -172,6 +195,10 @@ private:
   struct work_cleanup;
   friend struct work_cleanup;
 
+  // Helper class to count the threads that are running the scheduler.
+  struct running_thread;
+  friend struct running_thread;
+
   // Whether to optimise for single-threaded use cases.
   const bool one_thread_;
 
@@ -196,6 +223,9 @@ private:
   // The count of unfinished work.
   atomic_count outstanding_work_;
 
+  // The number of threads that are running the scheduler.
+  atomic_count running_threads_;
+
   // The queue of handlers that are ready to be delivered.
   op_queue<operation> op_queue_;
 
@@ -208,6 +238,12 @@ private:
   // The concurrency hint used to initialise the scheduler.
   const int concurrency_hint_;
 
+  // The memory resource used for internal allocations.
+  memory_resource* const memory_resource_;
+
+  // The allocation accounting for the context, if enabled.
+  allocation_accounting* const allocation_accounting_;
+
   // The thread that is running the scheduler.
   asio::detail::thread* thread_;
 };
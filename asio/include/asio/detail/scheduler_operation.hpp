@@ -19,6 +19,10 @@
 #include "asio/detail/handler_tracking.hpp"
 #include "asio/detail/op_queue.hpp"
 
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+# include "asio/detail/allocation_accounting.hpp"
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -33,6 +37,11 @@ class scheduler_operation ASIO_INHERIT_TRACKED_HANDLER
 public:
   typedef scheduler_operation operation_type;
 
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+  // The category used when recording allocations of derived operations.
+  enum { allocation_category = allocation_accounting::other_operations };
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
   void complete(void* owner, const asio::error_code& ec,
       std::size_t bytes_transferred)
   {
@@ -28,6 +28,12 @@ class scheduler_operation;
 
 struct scheduler_thread_info : public thread_info_base
 {
+  scheduler_thread_info(memory_resource* resource,
+      allocation_accounting* accounting)
+    : thread_info_base(resource, accounting)
+  {
+  }
+
   op_queue<scheduler_operation> private_op_queue;
   long private_outstanding_work;
 };
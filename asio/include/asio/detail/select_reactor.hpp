@@ -105,6 +105,18 @@ public:
   // operation_aborted error.
   ASIO_DECL void cancel_ops(socket_type descriptor, per_descriptor_data&);
 
+  // Cancel all operations associated with the given descriptor. The
+  // handlers associated with the descriptor will be invoked with the
+  // specified error.
+  ASIO_DECL void cancel_ops(socket_type descriptor,
+      per_descriptor_data&, const asio::error_code& ec);
+
+  // Cancel the operation of the given type that has the specified
+  // cancellation key. The handler will be invoked with the operation_aborted
+  // error.
+  ASIO_DECL void cancel_ops_by_key(socket_type descriptor,
+      per_descriptor_data&, int op_type, void* cancellation_key);
+
   // Cancel any operations that are running against the descriptor and remove
   // its registration from the reactor. The reactor resources associated with
   // the descriptor must be released by calling cleanup_descriptor_data.
@@ -126,6 +138,13 @@ public:
       per_descriptor_data& target_descriptor_data,
       per_descriptor_data& source_descriptor_data);
 
+  // Move a descriptor's registration to another reactor. Returns 0 on success,
+  // system error code on failure. Fails with asio::error::in_progress,
+  // leaving the descriptor registered with this reactor, if any operations are
+  // outstanding for the descriptor.
+  ASIO_DECL int migrate_descriptor(socket_type descriptor,
+      per_descriptor_data& descriptor_data, select_reactor& target);
+
   // Add a new timer queue to the reactor.
   template <typename Time_Traits>
   void add_timer_queue(timer_queue<Time_Traits>& queue);
@@ -148,6 +167,12 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& timer,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Cancel the timer operations associated with the given key.
+  template <typename Time_Traits>
+  void cancel_timer_by_key(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data* timer,
+      void* cancellation_key);
+
   // Move the timer operations associated with the given timer.
   template <typename Time_Traits>
   void move_timer(timer_queue<Time_Traits>& queue,
@@ -160,6 +185,16 @@ public:
   // Interrupt the select loop.
   ASIO_DECL void interrupt();
 
+  // Reserve space for the specified number of pending timers. Descriptor
+  // state is not pooled by this reactor, so the descriptor count is ignored.
+  ASIO_DECL void reserve(std::size_t descriptors, std::size_t timers);
+
+  // Release timer queue space that is no longer needed.
+  ASIO_DECL void trim_timers();
+
+  // Descriptor state is not pooled by this reactor, so this is a no-op.
+  ASIO_DECL void trim_descriptors(const op_queue<operation>& pending);
+
 private:
 #if defined(ASIO_HAS_IOCP)
   // Run the select loop in the thread.
@@ -18,6 +18,7 @@
 #include "asio/detail/config.hpp"
 
 #include "asio/error_code.hpp"
+#include "asio/detail/cstdint.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/socket_types.hpp"
 
@@ -52,7 +53,10 @@ enum
   datagram_oriented = 32,
 
   // The socket may have been dup()-ed.
-  possible_dup = 64
+  possible_dup = 64,
+
+  // The socket may have outstanding multishot operations.
+  multishot = 128
 };
 
 typedef unsigned char state_type;
@@ -66,6 +70,12 @@ typedef weak_ptr<void> weak_cancel_token_type;
 ASIO_DECL socket_type accept(socket_type s, socket_addr_type* addr,
     std::size_t* addrlen, asio::error_code& ec);
 
+// Accept a connection, creating the new socket in non-blocking mode where this
+// can be done without additional system calls. The state of the new socket is
+// returned in new_state.
+ASIO_DECL socket_type accept(socket_type s, socket_addr_type* addr,
+    std::size_t* addrlen, state_type& new_state, asio::error_code& ec);
+
 ASIO_DECL socket_type sync_accept(socket_type s,
     state_type state, socket_addr_type* addr,
     std::size_t* addrlen, asio::error_code& ec);
@@ -81,7 +91,7 @@ ASIO_DECL void complete_iocp_accept(socket_type s,
 
 ASIO_DECL bool non_blocking_accept(socket_type s,
     state_type state, socket_addr_type* addr, std::size_t* addrlen,
-    asio::error_code& ec, socket_type& new_socket);
+    asio::error_code& ec, socket_type& new_socket, state_type& new_state);
 
 #endif // defined(ASIO_HAS_IOCP)
 
@@ -222,6 +232,35 @@ ASIO_DECL bool non_blocking_recvmsg(socket_type s,
     buf* bufs, size_t count, int in_flags, int& out_flags,
     asio::error_code& ec, size_t& bytes_transferred);
 
+#if defined(ASIO_HAS_MMSG)
+
+ASIO_DECL bool non_blocking_recvmmsg(socket_type s,
+    mmsghdr* msgs, size_t count, int flags,
+    asio::error_code& ec, size_t& messages_transferred);
+
+#endif // defined(ASIO_HAS_MMSG)
+
+#if defined(ASIO_HAS_RECEIVE_METADATA) \
+  || defined(ASIO_HAS_LOCAL_SOCKETS)
+
+ASIO_DECL bool non_blocking_recvmsg_control(socket_type s,
+    buf* bufs, size_t count, int in_flags, bool is_stream,
+    socket_addr_type* addr, std::size_t* addrlen, void* control,
+    std::size_t* control_size, int& out_flags,
+    asio::error_code& ec, size_t& bytes_transferred);
+
+#endif // defined(ASIO_HAS_RECEIVE_METADATA)
+       //   || defined(ASIO_HAS_LOCAL_SOCKETS)
+
+#if defined(ASIO_HAS_UDP_GSO)
+
+ASIO_DECL bool non_blocking_recvfrom_coalesced(socket_type s,
+    buf* bufs, size_t count, int flags, socket_addr_type* addr,
+    std::size_t* addrlen, asio::error_code& ec,
+    size_t& bytes_transferred, size_t& segment_size);
+
+#endif // defined(ASIO_HAS_UDP_GSO)
+
 #endif // defined(ASIO_HAS_IOCP)
 
 ASIO_DECL signed_size_type send(socket_type s, const buf* bufs,
@@ -253,6 +292,23 @@ ASIO_DECL bool non_blocking_send1(socket_type s,
     const void* data, size_t size, int flags,
     asio::error_code& ec, size_t& bytes_transferred);
 
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+
+ASIO_DECL bool non_blocking_sendmsg_control(socket_type s,
+    const buf* bufs, size_t count, int flags, const void* control,
+    std::size_t control_size, asio::error_code& ec,
+    size_t& bytes_transferred);
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+#if defined(ASIO_HAS_SENDFILE)
+
+ASIO_DECL bool non_blocking_sendfile(socket_type s, int fd,
+    uint64_t offset, size_t size, asio::error_code& ec,
+    size_t& bytes_transferred);
+
+#endif // defined(ASIO_HAS_SENDFILE)
+
 #endif // defined(ASIO_HAS_IOCP)
 
 ASIO_DECL signed_size_type sendto(socket_type s, const buf* bufs,
@@ -283,11 +339,34 @@ ASIO_DECL bool non_blocking_sendto1(socket_type s,
     const socket_addr_type* addr, std::size_t addrlen,
     asio::error_code& ec, size_t& bytes_transferred);
 
+#if defined(ASIO_HAS_MMSG)
+
+ASIO_DECL bool non_blocking_sendmmsg(socket_type s,
+    mmsghdr* msgs, size_t count, int flags,
+    asio::error_code& ec, size_t& messages_transferred);
+
+#endif // defined(ASIO_HAS_MMSG)
+
+#if defined(ASIO_HAS_UDP_GSO)
+
+ASIO_DECL bool non_blocking_sendto_segmented(socket_type s,
+    const buf* bufs, size_t count, int flags,
+    const socket_addr_type* addr, std::size_t addrlen,
+    size_t segment_size, asio::error_code& ec, size_t& bytes_transferred);
+
+#endif // defined(ASIO_HAS_UDP_GSO)
+
 #endif // !defined(ASIO_HAS_IOCP)
 
 ASIO_DECL socket_type socket(int af, int type, int protocol,
     asio::error_code& ec);
 
+// Create a socket in non-blocking mode where this can be done without
+// additional system calls. The state of the new socket is returned in
+// new_state.
+ASIO_DECL socket_type socket(int af, int type, int protocol,
+    state_type& new_state, asio::error_code& ec);
+
 ASIO_DECL int setsockopt(socket_type s, state_type& state,
     int level, int optname, const void* optval,
     std::size_t optlen, asio::error_code& ec);
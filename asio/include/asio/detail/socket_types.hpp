@@ -81,6 +81,9 @@
 # if !defined(__SYMBIAN32__)
 #  include <netinet/tcp.h>
 # endif
+# if defined(ASIO_HAS_UDP_GSO)
+#  include <netinet/udp.h>
+# endif // defined(ASIO_HAS_UDP_GSO)
 # include <arpa/inet.h>
 # include <netdb.h>
 # include <net/if.h>
@@ -19,6 +19,8 @@
 #include "asio/detail/atomic_count.hpp"
 #include "asio/detail/executor_op.hpp"
 #include "asio/detail/memory.hpp"
+#include "asio/detail/allocation_accounting_service.hpp"
+#include "asio/detail/memory_resource_service.hpp"
 #include "asio/detail/mutex.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/scheduler_operation.hpp"
@@ -127,6 +129,29 @@ private:
 
   // The head of a linked list of all implementations.
   strand_impl* impl_list_;
+
+  // Destroys implementations allocated from the memory resource.
+  struct strand_impl_deleter
+  {
+    memory_resource* resource_;
+    allocation_accounting* accounting_;
+
+    void operator()(strand_impl* impl) const
+    {
+      impl->~strand_impl();
+      deallocate_memory(resource_, impl, sizeof(strand_impl));
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+      accounting_->record_deallocation(
+          allocation_accounting::strand_state, sizeof(strand_impl));
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+    }
+  };
+
+  // The memory resource used to allocate implementations.
+  memory_resource* memory_resource_;
+
+  // The allocation accounting for the context, if enabled.
+  allocation_accounting* allocation_accounting_;
 };
 
 } // namespace detail
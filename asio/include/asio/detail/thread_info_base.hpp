@@ -17,13 +17,26 @@
 
 #include <climits>
 #include <cstddef>
+#include <cstring>
+#include "asio/detail/memory_resource.hpp"
 #include "asio/detail/noncopyable.hpp"
 
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+# include "asio/detail/allocation_accounting.hpp"
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
 #include "asio/detail/push_options.hpp"
 
+// The maximum number of blocks retained per size class and per purpose.
+#if !defined(ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE)
+# define ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE 4
+#endif // !defined(ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE)
+
 namespace asio {
 namespace detail {
 
+class allocation_accounting;
+
 class thread_info_base
   : private noncopyable
 {
@@ -43,16 +56,81 @@ public:
     enum { mem_index = 2 };
   };
 
-  thread_info_base()
+  // Counters describing how well the thread's block cache is performing.
+  struct cache_statistics
+  {
+    // Number of allocations satisfied from the cache.
+    std::size_t hits;
+
+    // Number of allocations that had to call ::operator new.
+    std::size_t misses;
+
+    // Number of deallocations whose block was retained in the cache.
+    std::size_t recycled;
+
+    // Number of deallocations whose block was passed to ::operator delete.
+    std::size_t released;
+  };
+
+  explicit thread_info_base(memory_resource* resource = 0,
+      allocation_accounting* accounting = 0)
+    : memory_resource_(resource),
+      allocation_accounting_(accounting)
   {
     for (int i = 0; i < max_mem_index; ++i)
-      reusable_memory_[i] = 0;
+    {
+      for (int j = 0; j < max_size_class; ++j)
+      {
+        reusable_memory_[i][j].head = 0;
+        reusable_memory_[i][j].count = 0;
+      }
+    }
+
+    statistics_.hits = 0;
+    statistics_.misses = 0;
+    statistics_.recycled = 0;
+    statistics_.released = 0;
   }
 
   ~thread_info_base()
+  {
+    release_cached_memory();
+  }
+
+  // Free all blocks currently held in the thread's cache.
+  void release_cached_memory()
   {
     for (int i = 0; i < max_mem_index; ++i)
-      ::operator delete(reusable_memory_[i]);
+    {
+      for (int j = 0; j < max_size_class; ++j)
+      {
+        while (void* pointer = reusable_memory_[i][j].head)
+        {
+          reusable_memory_[i][j].head = *static_cast<void**>(pointer);
+          record_cache_removal(this, block_size(size_class_chunks(j)));
+          deallocate_memory(memory_resource_, pointer,
+              block_size(size_class_chunks(j)));
+        }
+        reusable_memory_[i][j].count = 0;
+      }
+    }
+  }
+
+  // Get the allocation accounting of the context that the thread is running.
+  // Returns a null pointer if allocation accounting is not enabled.
+  allocation_accounting* get_allocation_accounting() const
+  {
+    return allocation_accounting_;
+  }
+
+  // Obtain the cache statistics for the thread. Returns statistics with all
+  // counters set to zero if the calling thread has no thread information.
+  static cache_statistics statistics(const thread_info_base* this_thread)
+  {
+    if (this_thread)
+      return this_thread->statistics_;
+    cache_statistics empty = { 0, 0, 0, 0 };
+    return empty;
   }
 
   static void* allocate(thread_info_base* this_thread, std::size_t size)
@@ -71,50 +149,174 @@ public:
       std::size_t size)
   {
     std::size_t chunks = (size + chunk_size - 1) / chunk_size;
+    int size_class = size_class_of(chunks);
 
-    if (this_thread && this_thread->reusable_memory_[Purpose::mem_index])
+    if (size_class < max_size_class)
     {
-      void* const pointer = this_thread->reusable_memory_[Purpose::mem_index];
-      this_thread->reusable_memory_[Purpose::mem_index] = 0;
+      // Blocks are allocated at the full size of their class so that any
+      // cached block in the class can satisfy any request that maps to it.
+      chunks = size_class_chunks(size_class);
 
-      unsigned char* const mem = static_cast<unsigned char*>(pointer);
-      if (static_cast<std::size_t>(mem[0]) >= chunks)
+      if (this_thread)
       {
-        mem[size] = mem[0];
-        return pointer;
+        free_list& list =
+          this_thread->reusable_memory_[Purpose::mem_index][size_class];
+        if (void* const pointer = list.head)
+        {
+          list.head = *static_cast<void**>(pointer);
+          --list.count;
+          ++this_thread->statistics_.hits;
+          record_cache_removal(this_thread, block_size(chunks));
+          mark_block(pointer, size, chunks, this_thread->memory_resource_);
+          return pointer;
+        }
       }
+    }
 
-      ::operator delete(pointer);
+    memory_resource* resource = 0;
+    if (this_thread)
+    {
+      ++this_thread->statistics_.misses;
+      resource = this_thread->memory_resource_;
     }
 
-    void* const pointer = ::operator new(chunks * chunk_size + 1);
-    unsigned char* const mem = static_cast<unsigned char*>(pointer);
-    mem[size] = (chunks <= UCHAR_MAX) ? static_cast<unsigned char>(chunks) : 0;
+    void* const pointer = allocate_memory(resource, block_size(chunks));
+    mark_block(pointer, size, chunks, resource);
     return pointer;
   }
 
+  // Blocks record their size class in the trailing byte, so a block may be
+  // returned to the cache of a different thread to the one that allocated it.
+  // This is the case for handlers that complete on another thread. The cache
+  // of each thread is bounded, and any excess blocks are freed. Blocks are
+  // only cached by threads that use the same memory resource.
   template <typename Purpose>
   static void deallocate(Purpose, thread_info_base* this_thread,
       void* pointer, std::size_t size)
   {
-    if (size <= chunk_size * UCHAR_MAX)
+    unsigned char* const mem = static_cast<unsigned char*>(pointer);
+    memory_resource* resource = block_resource(pointer, size);
+    std::size_t chunks = mem[size]
+      ? mem[size] : (size + chunk_size - 1) / chunk_size;
+
+    if (this_thread)
     {
-      if (this_thread && this_thread->reusable_memory_[Purpose::mem_index] == 0)
+      int size_class = size_class_of(chunks);
+      if (size_class < max_size_class
+          && size_class_chunks(size_class) == chunks
+          && resource == this_thread->memory_resource_)
       {
-        unsigned char* const mem = static_cast<unsigned char*>(pointer);
-        mem[0] = mem[size];
-        this_thread->reusable_memory_[Purpose::mem_index] = pointer;
-        return;
+        free_list& list =
+          this_thread->reusable_memory_[Purpose::mem_index][size_class];
+        if (list.count < ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE)
+        {
+          *static_cast<void**>(pointer) = list.head;
+          list.head = pointer;
+          ++list.count;
+          ++this_thread->statistics_.recycled;
+          record_cache_insertion(this_thread, block_size(chunks));
+          return;
+        }
       }
+
+      ++this_thread->statistics_.released;
     }
 
-    ::operator delete(pointer);
+    deallocate_memory(resource, pointer, block_size(chunks));
   }
 
 private:
   enum { chunk_size = 4 };
   enum { max_mem_index = 3 };
-  void* reusable_memory_[max_mem_index];
+
+  // Size classes are powers of two from 16 bytes up to the largest block that
+  // can have its size recorded in the trailing byte.
+  enum { min_size_class_chunks = 4 };
+  enum { max_size_class = 7 };
+
+  static int size_class_of(std::size_t chunks)
+  {
+    int size_class = 0;
+    std::size_t class_chunks = min_size_class_chunks;
+    while (size_class < max_size_class && class_chunks < chunks)
+    {
+      ++size_class;
+      class_chunks = size_class_chunks(size_class);
+    }
+    return size_class;
+  }
+
+  static std::size_t size_class_chunks(int size_class)
+  {
+    std::size_t class_chunks = min_size_class_chunks << size_class;
+    return class_chunks <= UCHAR_MAX ? class_chunks : UCHAR_MAX;
+  }
+
+  // Blocks are laid out as the user's memory, followed by a byte containing
+  // the number of chunks in the block, followed by the memory resource from
+  // which the block was obtained.
+  static std::size_t block_size(std::size_t chunks)
+  {
+    return chunks * chunk_size + 1 + sizeof(memory_resource*);
+  }
+
+  static void mark_block(void* pointer, std::size_t size,
+      std::size_t chunks, memory_resource* resource)
+  {
+    unsigned char* const mem = static_cast<unsigned char*>(pointer);
+    mem[size] = (chunks <= UCHAR_MAX) ? static_cast<unsigned char>(chunks) : 0;
+    std::memcpy(mem + size + 1, &resource, sizeof(memory_resource*));
+  }
+
+  static memory_resource* block_resource(void* pointer, std::size_t size)
+  {
+    memory_resource* resource;
+    unsigned char* const mem = static_cast<unsigned char*>(pointer);
+    std::memcpy(&resource, mem + size + 1, sizeof(memory_resource*));
+    return resource;
+  }
+
+  // Record the memory held by the cache with the allocation accounting.
+  static void record_cache_insertion(thread_info_base* this_thread,
+      std::size_t bytes)
+  {
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+    if (this_thread->allocation_accounting_)
+    {
+      this_thread->allocation_accounting_->record_allocation(
+          allocation_accounting::cached_memory, bytes);
+    }
+#else // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+    (void)this_thread;
+    (void)bytes;
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+  }
+
+  static void record_cache_removal(thread_info_base* this_thread,
+      std::size_t bytes)
+  {
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+    if (this_thread->allocation_accounting_)
+    {
+      this_thread->allocation_accounting_->record_deallocation(
+          allocation_accounting::cached_memory, bytes);
+    }
+#else // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+    (void)this_thread;
+    (void)bytes;
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+  }
+
+  struct free_list
+  {
+    void* head;
+    int count;
+  };
+
+  memory_resource* memory_resource_;
+  allocation_accounting* allocation_accounting_;
+  free_list reusable_memory_[max_mem_index][max_size_class];
+  cache_statistics statistics_;
 };
 
 } // namespace detail
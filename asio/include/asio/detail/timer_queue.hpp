@@ -21,6 +21,7 @@
 #include "asio/detail/cstdint.hpp"
 #include "asio/detail/date_time_fwd.hpp"
 #include "asio/detail/limits.hpp"
+#include "asio/detail/memory_resource.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/timer_queue_base.hpp"
 #include "asio/detail/wait_op.hpp"
@@ -66,10 +67,11 @@ public:
     per_timer_data* prev_;
   };
 
-  // Constructor.
-  timer_queue()
+  // Constructor. The heap is allocated from the specified memory resource, or
+  // using ::operator new if the resource pointer is null.
+  explicit timer_queue(memory_resource* resource = 0)
     : timers_(),
-      heap_()
+      heap_(memory_resource_allocator<heap_entry>(resource))
   {
   }
 
@@ -171,6 +173,27 @@ public:
     heap_.clear();
   }
 
+  // Reserve space for the specified number of pending timers.
+  virtual void reserve(std::size_t n)
+  {
+    heap_.reserve(n);
+  }
+
+  // Release any space beyond that needed for the pending timers, retaining
+  // space for at least the specified number of timers.
+  virtual void trim(std::size_t n)
+  {
+    if (n < heap_.size())
+      n = heap_.size();
+    if (heap_.capacity() > n)
+    {
+      heap_type heap(heap_.get_allocator());
+      heap.reserve(n);
+      heap.insert(heap.end(), heap_.begin(), heap_.end());
+      heap_.swap(heap);
+    }
+  }
+
   // Cancel and dequeue operations for the given timer.
   std::size_t cancel_timer(per_timer_data& timer, op_queue<operation>& ops,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)())
@@ -185,6 +208,10 @@ public:
         timer.op_queue_.pop();
         ops.push(op);
         ++num_cancelled;
+
+        // The timer may be destroyed before the operation completes, so it
+        // can no longer be cancelled through its slot.
+        op->release_cancellation_slot();
       }
       if (timer.op_queue_.empty())
         remove_timer(timer);
@@ -192,9 +219,39 @@ public:
     return num_cancelled;
   }
 
-  // Move operations from one timer to another, empty timer.
+  // Cancel and dequeue the operations for the given timer that have the
+  // specified cancellation key.
+  void cancel_timer_by_key(per_timer_data* timer,
+      op_queue<operation>& ops, void* cancellation_key)
+  {
+    if (timer->prev_ != 0 || timer == timers_)
+    {
+      op_queue<wait_op> other_ops;
+      while (wait_op* op = timer->op_queue_.front())
+      {
+        timer->op_queue_.pop();
+        if (op->cancellation_key_ == cancellation_key)
+        {
+          op->ec_ = asio::error::operation_aborted;
+          ops.push(op);
+          op->release_cancellation_slot();
+        }
+        else
+          other_ops.push(op);
+      }
+      timer->op_queue_.push(other_ops);
+      if (timer->op_queue_.empty())
+        remove_timer(*timer);
+    }
+  }
+
+  // Move operations from one timer to another, empty timer. The operations'
+  // cancellation handlers refer to the source timer, so they are removed.
   void move_timer(per_timer_data& target, per_timer_data& source)
   {
+    for (wait_op* op = source.op_queue_.front();
+        op; op = op_queue_access::next(op))
+      op->release_cancellation_slot();
     target.op_queue_.push(source.op_queue_);
 
     target.heap_index_ = source.heap_index_;
@@ -348,8 +405,11 @@ private:
     per_timer_data* timer_;
   };
 
+  typedef std::vector<heap_entry,
+      memory_resource_allocator<heap_entry> > heap_type;
+
   // The heap of timers, with the earliest timer at the front.
-  std::vector<heap_entry> heap_;
+  heap_type heap_;
 };
 
 } // namespace detail
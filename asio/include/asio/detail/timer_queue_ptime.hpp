@@ -46,7 +46,7 @@ public:
     per_timer_data;
 
   // Constructor.
-  ASIO_DECL timer_queue();
+  ASIO_DECL explicit timer_queue(memory_resource* resource = 0);
 
   // Destructor.
   ASIO_DECL virtual ~timer_queue();
@@ -72,11 +72,22 @@ public:
   // Dequeue all timers.
   ASIO_DECL virtual void get_all_timers(op_queue<operation>& ops);
 
+  // Reserve space for the specified number of pending timers.
+  ASIO_DECL virtual void reserve(std::size_t n);
+
+  // Release any space beyond that needed for the pending timers.
+  ASIO_DECL virtual void trim(std::size_t n);
+
   // Cancel and dequeue operations for the given timer.
   ASIO_DECL std::size_t cancel_timer(
       per_timer_data& timer, op_queue<operation>& ops,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Cancel and dequeue the operations for the given timer that have the
+  // specified cancellation key.
+  ASIO_DECL void cancel_timer_by_key(per_timer_data* timer,
+      op_queue<operation>& ops, void* cancellation_key);
+
   // Move operations from one timer to another, empty timer.
   ASIO_DECL void move_timer(per_timer_data& target,
       per_timer_data& source);
@@ -50,8 +50,19 @@ public:
   // Dequeue all timers.
   ASIO_DECL void get_all_timers(op_queue<operation>& ops);
 
+  // Reserve space for the specified number of pending timers in each queue,
+  // including queues that are added to the set later.
+  ASIO_DECL void reserve(std::size_t n);
+
+  // Release any space in the queues beyond that needed for pending timers or
+  // requested by reserve().
+  ASIO_DECL void trim();
+
 private:
   timer_queue_base* first_;
+
+  // The number of timers for which each queue reserves space.
+  std::size_t reserved_;
 };
 
 } // namespace detail
@@ -16,8 +16,13 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/cancellation_signal.hpp"
 #include "asio/detail/operation.hpp"
 
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+# include "asio/detail/allocation_accounting.hpp"
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -30,9 +35,30 @@ public:
   // The error code to be passed to the completion handler.
   asio::error_code ec_;
 
+  // The operation key used for targeted cancellation.
+  void* cancellation_key_;
+
+  // The slot into which the operation's cancellation handler is installed.
+  cancellation_slot cancellation_slot_;
+
+  // Remove the operation's handler from its slot. The handler will not be
+  // removed again when the operation completes, as by then the slot may have
+  // been reused by another operation.
+  void release_cancellation_slot()
+  {
+    clear_cancellation_slot(cancellation_slot_, cancellation_key_);
+    cancellation_key_ = 0;
+  }
+
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+  // The category used when recording allocations of derived operations.
+  enum { allocation_category = allocation_accounting::timer_operations };
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
 protected:
   wait_op(func_type func)
-    : operation(func)
+    : operation(func),
+      cancellation_key_(0)
   {
   }
 };
@@ -20,6 +20,8 @@
 #if defined(ASIO_HAS_IOCP)
 
 #include "asio/detail/limits.hpp"
+#include "asio/detail/allocation_accounting_service.hpp"
+#include "asio/detail/memory_resource_service.hpp"
 #include "asio/detail/mutex.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/scoped_ptr.hpp"
@@ -95,6 +97,14 @@ public:
     ::InterlockedExchange(&stopped_, 0);
   }
 
+  // Reserve space for the specified number of pending timers. Sockets do not
+  // use pooled descriptor state with I/O completion ports, so the descriptor
+  // count is ignored.
+  ASIO_DECL void reserve(std::size_t descriptors, std::size_t timers);
+
+  // Release memory that is held for reuse but is not currently needed.
+  ASIO_DECL void trim();
+
   // Notify that some work has started.
   void work_started()
   {
@@ -197,6 +207,12 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data& timer,
       std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)());
 
+  // Cancel the timer operations associated with the given key.
+  template <typename Time_Traits>
+  void cancel_timer_by_key(timer_queue<Time_Traits>& queue,
+      typename timer_queue<Time_Traits>::per_timer_data* timer,
+      void* cancellation_key);
+
   // Move the timer operations associated with the given timer.
   template <typename Time_Traits>
   void move_timer(timer_queue<Time_Traits>& queue,
@@ -209,6 +225,20 @@ public:
     return concurrency_hint_;
   }
 
+  // Get the memory resource used for internal allocations. Returns a null
+  // pointer if the default allocation functions are used.
+  memory_resource* get_memory_resource() const
+  {
+    return memory_resource_;
+  }
+
+  // Get the allocation accounting for the io_context. Returns a null pointer
+  // if allocation accounting is not enabled.
+  allocation_accounting* get_allocation_accounting() const
+  {
+    return allocation_accounting_;
+  }
+
 private:
 #if defined(WINVER) && (WINVER < 0x0500)
   typedef DWORD dword_ptr_t;
@@ -319,6 +349,12 @@ private:
   // The concurrency hint used to initialise the io_context.
   const int concurrency_hint_;
 
+  // The memory resource used for internal allocations.
+  memory_resource* const memory_resource_;
+
+  // The allocation accounting for the io_context, if enabled.
+  allocation_accounting* const allocation_accounting_;
+
   // The thread that is running the io_context.
   scoped_ptr<thread> thread_;
 };
@@ -24,6 +24,10 @@
 #include "asio/detail/socket_types.hpp"
 #include "asio/error_code.hpp"
 
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+# include "asio/detail/allocation_accounting.hpp"
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -40,6 +44,11 @@ class win_iocp_operation
 public:
   typedef win_iocp_operation operation_type;
 
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+  // The category used when recording allocations of derived operations.
+  enum { allocation_category = allocation_accounting::other_operations };
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
   void complete(void* owner, const asio::error_code& ec,
       std::size_t bytes_transferred)
   {
@@ -24,6 +24,11 @@ namespace detail {
 
 struct win_iocp_thread_info : public thread_info_base
 {
+  win_iocp_thread_info(memory_resource* resource,
+      allocation_accounting* accounting)
+    : thread_info_base(resource, accounting)
+  {
+  }
 };
 
 } // namespace detail
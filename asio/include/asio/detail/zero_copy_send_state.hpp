@@ -0,0 +1,106 @@
+//
+// detail/zero_copy_send_state.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_ZERO_COPY_SEND_STATE_HPP
+#define ASIO_DETAIL_ZERO_COPY_SEND_STATE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/socket_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+// Sends smaller than this many bytes are copied, as the cost of pinning the
+// pages and handling the completion notification exceeds that of the copy.
+#if !defined(ASIO_ZERO_COPY_SEND_THRESHOLD)
+# define ASIO_ZERO_COPY_SEND_THRESHOLD 10240
+#endif // !defined(ASIO_ZERO_COPY_SEND_THRESHOLD)
+
+namespace asio {
+namespace detail {
+
+// Tracks the MSG_ZEROCOPY sends made on a socket. The kernel numbers each
+// such send, and reports ranges of completed sends on the socket's error
+// queue. All member functions must be called with the reactor's descriptor
+// lock held.
+class zero_copy_send_state
+  : private noncopyable
+{
+public:
+  // Constructor.
+  explicit zero_copy_send_state(bool enabled)
+    : enabled_(enabled),
+      next_(0),
+      completed_(0)
+  {
+  }
+
+  // Whether zero-copy sends should be attempted. Becomes false if the kernel
+  // reports that it had to copy the data, as happens on loopback.
+  bool enabled() const
+  {
+    return enabled_;
+  }
+
+  // Allocate the identifier of a zero-copy send that has just been made.
+  uint32_t next_id()
+  {
+    return next_++;
+  }
+
+  // Determine whether the kernel has released the buffers of a send.
+  bool is_complete(uint32_t id) const
+  {
+    return static_cast<int32_t>(completed_ - id) > 0;
+  }
+
+  // Read all pending completion notifications from the error queue.
+  ASIO_DECL void drain(socket_type s);
+
+private:
+  // Record that the sends in the range [first, last] have completed.
+  ASIO_DECL void record(uint32_t first, uint32_t last);
+
+  // Whether zero-copy sends should be attempted.
+  bool enabled_;
+
+  // The identifier of the next zero-copy send.
+  uint32_t next_;
+
+  // All sends before this identifier have completed.
+  uint32_t completed_;
+
+  // Completed ranges that were reported out of order.
+  std::vector<std::pair<uint32_t, uint32_t> > pending_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/zero_copy_send_state.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY)
+
+#endif // ASIO_DETAIL_ZERO_COPY_SEND_STATE_HPP
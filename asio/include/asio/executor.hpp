@@ -57,20 +57,24 @@ public:
 
   /// Copy constructor.
   executor(const executor& other) ASIO_NOEXCEPT
-    : impl_(other.clone())
+    : impl_(other.clone(storage_))
   {
   }
 
 #if defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
   /// Move constructor.
   executor(executor&& other) ASIO_NOEXCEPT
-    : impl_(other.impl_)
+    : impl_(other.release(storage_))
   {
-    other.impl_ = 0;
   }
 #endif // defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
 
   /// Construct a polymorphic wrapper for the specified executor.
+  /**
+   * Small executors are stored within the polymorphic wrapper itself, and
+   * constructing or copying the wrapper does not allocate memory. Larger
+   * executors are allocated and shared between copies of the wrapper.
+   */
   template <typename Executor>
   executor(Executor e);
 
@@ -88,8 +92,11 @@ public:
   /// Assignment operator.
   executor& operator=(const executor& other) ASIO_NOEXCEPT
   {
-    destroy();
-    impl_ = other.clone();
+    if (this != &other)
+    {
+      destroy();
+      impl_ = other.clone(storage_);
+    }
     return *this;
   }
 
@@ -97,9 +104,11 @@ public:
   // Move assignment operator.
   executor& operator=(executor&& other) ASIO_NOEXCEPT
   {
-    destroy();
-    impl_ = other.impl_;
-    other.impl_ = 0;
+    if (this != &other)
+    {
+      destroy();
+      impl_ = other.release(storage_);
+    }
     return *this;
   }
 #endif // defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
@@ -119,8 +128,7 @@ public:
   {
     executor tmp(ASIO_MOVE_CAST(Executor)(e));
     destroy();
-    impl_ = tmp.impl_;
-    tmp.impl_ = 0;
+    impl_ = tmp.release(storage_);
     return *this;
   }
 
@@ -255,6 +263,19 @@ private:
 #if !defined(GENERATING_DOCUMENTATION)
   class function;
   template <typename, typename> class impl;
+  template <typename, typename> class inline_impl;
+
+  // The amount of storage available for implementations held inline.
+  enum { inline_storage_size = 6 * sizeof(void*) };
+
+  // Storage suitably aligned to hold small implementations inline.
+  union storage_type
+  {
+    void* pointer_;
+    double double_;
+    long long_;
+    unsigned char data_[inline_storage_size];
+  };
 
 #if !defined(ASIO_NO_TYPEID)
   typedef const std::type_info& type_id_result_type;
@@ -277,7 +298,8 @@ private:
   class impl_base
   {
   public:
-    virtual impl_base* clone() const ASIO_NOEXCEPT = 0;
+    virtual impl_base* clone(storage_type& s) const ASIO_NOEXCEPT = 0;
+    virtual impl_base* move(storage_type& s) ASIO_NOEXCEPT = 0;
     virtual void destroy() ASIO_NOEXCEPT = 0;
     virtual execution_context& context() ASIO_NOEXCEPT = 0;
     virtual void on_work_started() ASIO_NOEXCEPT = 0;
@@ -310,10 +332,19 @@ private:
     return impl_;
   }
 
-  // Helper function to clone another implementation.
-  impl_base* clone() const ASIO_NOEXCEPT
+  // Helper function to clone the implementation into the specified storage.
+  impl_base* clone(storage_type& s) const ASIO_NOEXCEPT
   {
-    return impl_ ? impl_->clone() : 0;
+    return impl_ ? impl_->clone(s) : 0;
+  }
+
+  // Helper function to transfer ownership of the implementation into the
+  // specified storage.
+  impl_base* release(storage_type& s) ASIO_NOEXCEPT
+  {
+    impl_base* i = impl_ ? impl_->move(s) : 0;
+    impl_ = 0;
+    return i;
   }
 
   // Helper function to destroy an implementation.
@@ -324,6 +355,7 @@ private:
   }
 
   impl_base* impl_;
+  storage_type storage_;
 #endif // !defined(GENERATING_DOCUMENTATION)
 };
 
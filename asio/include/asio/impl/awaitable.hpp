@@ -16,10 +16,12 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <cstring>
 #include <exception>
 #include <new>
 #include <tuple>
 #include <utility>
+#include "asio/detail/allocation_accounting_service.hpp"
 #include "asio/detail/thread_context.hpp"
 #include "asio/detail/thread_info_base.hpp"
 #include "asio/detail/type_traits.hpp"
@@ -73,6 +75,45 @@ class awaitable_frame_base
 {
 public:
 #if !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+  // Frames are recorded against the accounting of the context being run by
+  // the allocating thread. The accounting is stored after the frame so that
+  // the frame may be freed by any thread.
+  void* operator new(std::size_t size)
+  {
+    asio::detail::thread_info_base* this_thread =
+      asio::detail::thread_context::thread_call_stack::top();
+    asio::detail::allocation_accounting* accounting =
+      this_thread ? this_thread->get_allocation_accounting() : 0;
+    void* pointer = asio::detail::thread_info_base::allocate(
+        asio::detail::thread_info_base::awaitable_frame_tag(),
+        this_thread, size + sizeof(accounting));
+    std::memcpy(static_cast<char*>(pointer) + size,
+        &accounting, sizeof(accounting));
+    if (accounting)
+    {
+      accounting->record_allocation(
+          asio::detail::allocation_accounting::coroutine_frames, size);
+    }
+    return pointer;
+  }
+
+  void operator delete(void* pointer, std::size_t size)
+  {
+    asio::detail::allocation_accounting* accounting;
+    std::memcpy(&accounting, static_cast<char*>(pointer) + size,
+        sizeof(accounting));
+    if (accounting)
+    {
+      accounting->record_deallocation(
+          asio::detail::allocation_accounting::coroutine_frames, size);
+    }
+    asio::detail::thread_info_base::deallocate(
+        asio::detail::thread_info_base::awaitable_frame_tag(),
+        asio::detail::thread_context::thread_call_stack::top(),
+        pointer, size + sizeof(accounting));
+  }
+#else // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
   void* operator new(std::size_t size)
   {
     return asio::detail::thread_info_base::allocate(
@@ -88,6 +129,7 @@ public:
         asio::detail::thread_context::thread_call_stack::top(),
         pointer, size);
   }
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
 #endif // !defined(ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
 
   // The frame starts in a suspended state until the awaitable_thread object
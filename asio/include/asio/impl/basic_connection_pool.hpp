@@ -0,0 +1,687 @@
+//
+// impl/basic_connection_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_BASIC_CONNECTION_POOL_HPP
+#define ASIO_IMPL_BASIC_CONNECTION_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <list>
+#include <map>
+#include "asio/basic_waitable_timer.hpp"
+#include "asio/buffer.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/op_queue.hpp"
+#include "asio/post.hpp"
+#include "asio/socket_base.hpp"
+#include "asio/wait_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Base class for the async_acquire operations of a connection pool.
+template <typename Socket>
+class connection_pool_op
+{
+public:
+  // Get the socket into which the connection is to be placed.
+  Socket& socket()
+  {
+    return *socket_;
+  }
+
+  // Invoke the handler with the specified result.
+  void complete(const asio::error_code& ec)
+  {
+    ec_ = ec;
+    complete_func_(this, true);
+  }
+
+  // Destroy the operation without invoking the handler.
+  void destroy()
+  {
+    complete_func_(this, false);
+  }
+
+protected:
+  typedef void (*complete_func_type)(connection_pool_op*, bool);
+
+  connection_pool_op(Socket& socket, complete_func_type complete_func)
+    : next_(0),
+      socket_(&socket),
+      complete_func_(complete_func)
+  {
+  }
+
+  // Prevents deletion through this type.
+  ~connection_pool_op()
+  {
+  }
+
+  asio::error_code ec_;
+
+private:
+  friend class op_queue_access;
+
+  connection_pool_op* next_;
+  Socket* socket_;
+  complete_func_type complete_func_;
+};
+
+template <typename Socket, typename Handler, typename IoExecutor>
+class connection_pool_handler_op : public connection_pool_op<Socket>
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(connection_pool_handler_op);
+
+  connection_pool_handler_op(Socket& socket,
+      Handler& handler, const IoExecutor& io_ex)
+    : connection_pool_op<Socket>(socket,
+        &connection_pool_handler_op::do_complete),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+  }
+
+  static void do_complete(connection_pool_op<Socket>* base, bool invoke)
+  {
+    // Take ownership of the handler object.
+    connection_pool_handler_op* o(
+        static_cast<connection_pool_handler_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made.
+    detail::binder1<Handler, asio::error_code>
+      handler(o->handler_, o->ec_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (invoke)
+    {
+      fenced_block b(fenced_block::half);
+      w.complete(handler, handler.handler_);
+    }
+  }
+
+private:
+  Handler handler_;
+  IoExecutor io_executor_;
+};
+
+// Completes an operation from the pool's executor. The operation is owned by
+// the function object, and is destroyed if the function object is destroyed
+// without having been invoked.
+template <typename Socket, typename Executor>
+class connection_pool_op_completion
+{
+public:
+  typedef Executor executor_type;
+
+  connection_pool_op_completion(const Executor& ex,
+      connection_pool_op<Socket>* op, const asio::error_code& ec)
+    : executor_(ex),
+      op_(op),
+      ec_(ec)
+  {
+  }
+
+  connection_pool_op_completion(connection_pool_op_completion&& other)
+    : executor_(ASIO_MOVE_CAST(Executor)(other.executor_)),
+      op_(other.op_),
+      ec_(other.ec_)
+  {
+    other.op_ = 0;
+  }
+
+  ~connection_pool_op_completion()
+  {
+    if (op_)
+      op_->destroy();
+  }
+
+  executor_type get_executor() const ASIO_NOEXCEPT
+  {
+    return executor_;
+  }
+
+  void operator()()
+  {
+    connection_pool_op<Socket>* op = op_;
+    op_ = 0;
+    op->complete(ec_);
+  }
+
+private:
+  connection_pool_op_completion& operator=(
+      const connection_pool_op_completion&) ASIO_DELETED;
+
+  Executor executor_;
+  connection_pool_op<Socket>* op_;
+  asio::error_code ec_;
+};
+
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename Protocol, typename Executor>
+class basic_connection_pool<Protocol, Executor>::state
+  : private noncopyable
+{
+public:
+  typedef detail::connection_pool_op<socket_type> op;
+
+  explicit state(const executor_type& ex)
+    : executor_(ex),
+      max_connections_(8),
+      idle_timeout_(chrono::seconds(30)),
+      idle_count_(0),
+      timer_(ex),
+      timer_armed_(false),
+      shut_down_(false)
+  {
+  }
+
+  static void acquire(const detail::shared_ptr<state>& self,
+      const endpoint_type& endpoint, op* o)
+  {
+    if (self->shut_down_)
+    {
+      self->post_completion(o, asio::error::operation_aborted);
+      return;
+    }
+
+    endpoint_state& e = self->endpoints_[endpoint];
+
+    // Prefer the most recently used connection, which is the least likely to
+    // have been closed by the peer.
+    while (!e.idle_.empty())
+    {
+      socket_type& idle_socket = e.idle_.back().socket_;
+      bool usable = is_usable(idle_socket);
+      if (usable)
+        o->socket() = ASIO_MOVE_CAST(socket_type)(idle_socket);
+      else
+        close_connection(e, idle_socket);
+      e.idle_.pop_back();
+      --self->idle_count_;
+
+      if (usable)
+      {
+        self->post_completion(o, asio::error_code());
+        return;
+      }
+    }
+
+    if (e.connections_ < self->max_connections_)
+    {
+      ++e.connections_;
+      start_connect(self, endpoint, o);
+    }
+    else
+    {
+      e.waiters_.push(o);
+    }
+  }
+
+  static void release(const detail::shared_ptr<state>& self,
+      const endpoint_type& endpoint, socket_type& socket)
+  {
+    typename endpoint_map::iterator iter = self->endpoints_.find(endpoint);
+    if (iter == self->endpoints_.end())
+    {
+      asio::error_code ignored_ec;
+      socket.close(ignored_ec);
+      return;
+    }
+
+    endpoint_state& e = iter->second;
+    if (socket.is_open())
+    {
+      // Hand the connection directly to an operation that is waiting for one.
+      if (op* o = e.waiters_.front())
+      {
+        e.waiters_.pop();
+        o->socket() = ASIO_MOVE_CAST(socket_type)(socket);
+        self->post_completion(o, asio::error_code());
+        return;
+      }
+
+      e.idle_.push_back(idle_connection(socket));
+      ++self->idle_count_;
+      start_timer(self);
+      return;
+    }
+
+    // The connection's slot is now free for an operation that is waiting.
+    close_connection(e, socket);
+    if (op* o = e.waiters_.front())
+    {
+      e.waiters_.pop();
+      ++e.connections_;
+      start_connect(self, endpoint, o);
+    }
+    else if (e.connections_ == 0)
+    {
+      self->endpoints_.erase(iter);
+    }
+  }
+
+  void shutdown()
+  {
+    shut_down_ = true;
+
+    for (typename endpoint_map::iterator iter = endpoints_.begin();
+        iter != endpoints_.end(); ++iter)
+    {
+      endpoint_state& e = iter->second;
+      while (!e.idle_.empty())
+      {
+        close_connection(e, e.idle_.back().socket_);
+        e.idle_.pop_back();
+      }
+
+      while (op* o = e.waiters_.front())
+      {
+        e.waiters_.pop();
+        post_completion(o, asio::error::operation_aborted);
+      }
+    }
+
+    endpoints_.clear();
+    idle_count_ = 0;
+
+    asio::error_code ignored_ec;
+    timer_.cancel(ignored_ec);
+  }
+
+  executor_type executor_;
+  std::size_t max_connections_;
+  duration idle_timeout_;
+  std::size_t idle_count_;
+
+private:
+  typedef basic_waitable_timer<chrono::steady_clock,
+      wait_traits<chrono::steady_clock>, Executor> timer_type;
+
+  struct idle_connection
+  {
+    explicit idle_connection(socket_type& socket)
+      : socket_(ASIO_MOVE_CAST(socket_type)(socket)),
+        since_(chrono::steady_clock::now())
+    {
+    }
+
+    socket_type socket_;
+    chrono::steady_clock::time_point since_;
+  };
+
+  struct endpoint_state
+  {
+    endpoint_state()
+      : connections_(0)
+    {
+    }
+
+    // The number of connections, whether idle, in use or being established.
+    std::size_t connections_;
+
+    // The idle connections, least recently used first.
+    std::list<idle_connection> idle_;
+
+    // The operations waiting for a connection.
+    detail::op_queue<op> waiters_;
+  };
+
+  typedef std::map<endpoint_type, endpoint_state> endpoint_map;
+
+  class connect_handler
+  {
+  public:
+    typedef Executor executor_type;
+
+    connect_handler(const detail::shared_ptr<state>& self,
+        const endpoint_type& endpoint, op* o)
+      : self_(self),
+        endpoint_(endpoint),
+        op_(o)
+    {
+    }
+
+    connect_handler(connect_handler&& other)
+      : self_(ASIO_MOVE_CAST(detail::shared_ptr<state>)(other.self_)),
+        endpoint_(other.endpoint_),
+        op_(other.op_)
+    {
+      other.op_ = 0;
+    }
+
+    ~connect_handler()
+    {
+      if (op_)
+        op_->destroy();
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->executor_;
+    }
+
+    void operator()(const asio::error_code& ec)
+    {
+      op* o = op_;
+      op_ = 0;
+      state::handle_connect(self_, endpoint_, o, ec);
+    }
+
+  private:
+    connect_handler& operator=(const connect_handler&) ASIO_DELETED;
+
+    detail::shared_ptr<state> self_;
+    endpoint_type endpoint_;
+    op* op_;
+  };
+
+  class timer_handler
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit timer_handler(const detail::shared_ptr<state>& self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->executor_;
+    }
+
+    void operator()(const asio::error_code&)
+    {
+      state::handle_timer(self_);
+    }
+
+  private:
+    detail::shared_ptr<state> self_;
+  };
+
+  // Check whether an idle connection may be used. The connection must not
+  // have been closed by the peer, and there must be no data waiting to be
+  // read, since it cannot belong to any request that has yet to be made.
+  static bool is_usable(socket_type& socket)
+  {
+    asio::error_code ec;
+    bool non_blocking = socket.non_blocking();
+    socket.non_blocking(true, ec);
+    if (ec)
+      return false;
+
+    char data;
+    socket.receive(asio::buffer(&data, 1),
+        socket_base::message_peek, ec);
+
+    asio::error_code ignored_ec;
+    socket.non_blocking(non_blocking, ignored_ec);
+    return ec == asio::error::would_block;
+  }
+
+  static void close_connection(endpoint_state& e, socket_type& socket)
+  {
+    asio::error_code ignored_ec;
+    socket.close(ignored_ec);
+    --e.connections_;
+  }
+
+  static void start_connect(const detail::shared_ptr<state>& self,
+      const endpoint_type& endpoint, op* o)
+  {
+    asio::error_code ignored_ec;
+    o->socket().close(ignored_ec);
+    o->socket().async_connect(endpoint, connect_handler(self, endpoint, o));
+  }
+
+  static void handle_connect(const detail::shared_ptr<state>& self,
+      const endpoint_type& endpoint, op* o, const asio::error_code& ec)
+  {
+    if (ec && !self->shut_down_)
+    {
+      // The failed connection gives up its slot. If any operations are waiting
+      // then the next one makes its own attempt.
+      typename endpoint_map::iterator iter = self->endpoints_.find(endpoint);
+      if (iter != self->endpoints_.end())
+      {
+        endpoint_state& e = iter->second;
+        --e.connections_;
+        if (op* next = e.waiters_.front())
+        {
+          e.waiters_.pop();
+          ++e.connections_;
+          start_connect(self, endpoint, next);
+        }
+        else if (e.connections_ == 0 && e.idle_.empty())
+        {
+          self->endpoints_.erase(iter);
+        }
+      }
+    }
+
+    o->complete(ec);
+  }
+
+  // Start the timer for the connection that will be the next to become
+  // eligible for eviction, if the timer is not already running.
+  static void start_timer(const detail::shared_ptr<state>& self)
+  {
+    if (self->timer_armed_ || self->idle_count_ == 0)
+      return;
+
+    chrono::steady_clock::time_point earliest
+      = (chrono::steady_clock::time_point::max)();
+    for (typename endpoint_map::iterator iter = self->endpoints_.begin();
+        iter != self->endpoints_.end(); ++iter)
+    {
+      if (!iter->second.idle_.empty()
+          && iter->second.idle_.front().since_ < earliest)
+        earliest = iter->second.idle_.front().since_;
+    }
+
+    self->timer_armed_ = true;
+    self->timer_.expires_at(earliest + self->idle_timeout_);
+    self->timer_.async_wait(timer_handler(self));
+  }
+
+  static void handle_timer(const detail::shared_ptr<state>& self)
+  {
+    self->timer_armed_ = false;
+    if (self->shut_down_)
+      return;
+
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    typename endpoint_map::iterator iter = self->endpoints_.begin();
+    while (iter != self->endpoints_.end())
+    {
+      endpoint_state& e = iter->second;
+      while (!e.idle_.empty()
+          && now - e.idle_.front().since_ >= self->idle_timeout_)
+      {
+        close_connection(e, e.idle_.front().socket_);
+        e.idle_.pop_front();
+        --self->idle_count_;
+      }
+
+      if (e.connections_ == 0 && e.waiters_.empty())
+        self->endpoints_.erase(iter++);
+      else
+        ++iter;
+    }
+
+    start_timer(self);
+  }
+
+  void post_completion(op* o, const asio::error_code& ec)
+  {
+    asio::post(detail::connection_pool_op_completion<
+        socket_type, executor_type>(executor_, o, ec));
+  }
+
+  timer_type timer_;
+  bool timer_armed_;
+  bool shut_down_;
+  endpoint_map endpoints_;
+};
+
+template <typename Protocol, typename Executor>
+class basic_connection_pool<Protocol, Executor>::initiate_async_acquire
+{
+public:
+  typedef Executor executor_type;
+
+  explicit initiate_async_acquire(basic_connection_pool* self)
+    : self_(self)
+  {
+  }
+
+  executor_type get_executor() const ASIO_NOEXCEPT
+  {
+    return self_->get_executor();
+  }
+
+  template <typename AcquireHandler>
+  void operator()(ASIO_MOVE_ARG(AcquireHandler) handler,
+      const endpoint_type& endpoint, socket_type* socket) const
+  {
+    // If you get an error on the following line it means that your handler
+    // does not meet the documented type requirements for a ConnectHandler.
+    ASIO_CONNECT_HANDLER_CHECK(AcquireHandler, handler) type_check;
+
+    detail::non_const_lvalue<AcquireHandler> handler2(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef detail::connection_pool_handler_op<socket_type,
+        typename decay<AcquireHandler>::type, executor_type> op;
+    typename op::ptr p = { asio::detail::addressof(handler2.value),
+      op::ptr::allocate(handler2.value), 0 };
+    p.p = new (p.v) op(*socket, handler2.value, self_->get_executor());
+
+    state::acquire(self_->state_, endpoint, p.p);
+    p.v = p.p = 0;
+  }
+
+private:
+  basic_connection_pool* self_;
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+template <typename Protocol, typename Executor>
+basic_connection_pool<Protocol, Executor>::basic_connection_pool(
+    const executor_type& ex)
+  : state_(new state(ex))
+{
+}
+
+template <typename Protocol, typename Executor>
+template <typename ExecutionContext>
+basic_connection_pool<Protocol, Executor>::basic_connection_pool(
+    ExecutionContext& context,
+    typename enable_if<
+      is_convertible<ExecutionContext&, execution_context&>::value
+    >::type*)
+  : state_(new state(context.get_executor()))
+{
+}
+
+template <typename Protocol, typename Executor>
+basic_connection_pool<Protocol, Executor>::~basic_connection_pool()
+{
+  state_->shutdown();
+}
+
+template <typename Protocol, typename Executor>
+inline typename basic_connection_pool<Protocol, Executor>::executor_type
+basic_connection_pool<Protocol, Executor>::get_executor() ASIO_NOEXCEPT
+{
+  return state_->executor_;
+}
+
+template <typename Protocol, typename Executor>
+inline std::size_t basic_connection_pool<Protocol,
+    Executor>::max_connections_per_endpoint() const ASIO_NOEXCEPT
+{
+  return state_->max_connections_;
+}
+
+template <typename Protocol, typename Executor>
+inline void basic_connection_pool<Protocol,
+    Executor>::max_connections_per_endpoint(std::size_t n)
+{
+  state_->max_connections_ = n;
+}
+
+template <typename Protocol, typename Executor>
+inline typename basic_connection_pool<Protocol, Executor>::duration
+basic_connection_pool<Protocol, Executor>::idle_timeout() const ASIO_NOEXCEPT
+{
+  return state_->idle_timeout_;
+}
+
+template <typename Protocol, typename Executor>
+inline void basic_connection_pool<Protocol, Executor>::idle_timeout(
+    const duration& d)
+{
+  state_->idle_timeout_ = d;
+}
+
+template <typename Protocol, typename Executor>
+inline std::size_t basic_connection_pool<Protocol,
+    Executor>::idle_connections() const ASIO_NOEXCEPT
+{
+  return state_->idle_count_;
+}
+
+template <typename Protocol, typename Executor>
+template <
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code)) AcquireHandler>
+inline ASIO_INITFN_AUTO_RESULT_TYPE(AcquireHandler,
+    void (asio::error_code))
+basic_connection_pool<Protocol, Executor>::async_acquire(
+    const endpoint_type& endpoint, socket_type& socket,
+    ASIO_MOVE_ARG(AcquireHandler) handler)
+{
+  return async_initiate<AcquireHandler, void (asio::error_code)>(
+      initiate_async_acquire(this), handler, endpoint, &socket);
+}
+
+template <typename Protocol, typename Executor>
+inline void basic_connection_pool<Protocol, Executor>::release(
+    const endpoint_type& endpoint, socket_type& socket)
+{
+  state::release(state_, endpoint, socket);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_BASIC_CONNECTION_POOL_HPP
@@ -0,0 +1,107 @@
+//
+// impl/buffer_pool.ipp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_BUFFER_POOL_IPP
+#define ASIO_IMPL_BUFFER_POOL_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <new>
+#include "asio/buffer_pool.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+buffer_pool::buffer_pool(std::size_t buffer_size,
+    std::size_t max_idle_buffers)
+  : buffer_size_(buffer_size < sizeof(idle_buffer)
+      ? sizeof(idle_buffer) : buffer_size),
+    max_idle_buffers_(max_idle_buffers),
+    idle_buffers_(0),
+    idle_count_(0),
+    in_use_count_(0)
+{
+}
+
+buffer_pool::~buffer_pool()
+{
+  while (idle_buffers_)
+  {
+    idle_buffer* b = idle_buffers_;
+    idle_buffers_ = b->next_;
+    ::operator delete(b);
+  }
+}
+
+mutable_buffer buffer_pool::acquire() ASIO_NOEXCEPT
+{
+  detail::mutex::scoped_lock lock(mutex_);
+
+  void* data = idle_buffers_;
+  if (data)
+  {
+    idle_buffers_ = idle_buffers_->next_;
+    --idle_count_;
+  }
+  else
+  {
+    lock.unlock();
+    data = ::operator new(buffer_size_, std::nothrow);
+    if (!data)
+      return mutable_buffer();
+    lock.lock();
+  }
+
+  ++in_use_count_;
+  return mutable_buffer(data, buffer_size_);
+}
+
+void buffer_pool::release(const mutable_buffer& b) ASIO_NOEXCEPT
+{
+  if (!b.data())
+    return;
+
+  detail::mutex::scoped_lock lock(mutex_);
+  --in_use_count_;
+
+  if (idle_count_ < max_idle_buffers_)
+  {
+    idle_buffer* idle = static_cast<idle_buffer*>(b.data());
+    idle->next_ = idle_buffers_;
+    idle_buffers_ = idle;
+    ++idle_count_;
+    return;
+  }
+
+  lock.unlock();
+  ::operator delete(b.data());
+}
+
+std::size_t buffer_pool::in_use() const ASIO_NOEXCEPT
+{
+  detail::mutex::scoped_lock lock(mutex_);
+  return in_use_count_;
+}
+
+std::size_t buffer_pool::idle() const ASIO_NOEXCEPT
+{
+  detail::mutex::scoped_lock lock(mutex_);
+  return idle_count_;
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_BUFFER_POOL_IPP
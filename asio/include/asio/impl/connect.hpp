@@ -16,18 +16,24 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <algorithm>
+#include <vector>
 #include "asio/associated_allocator.hpp"
+#include "asio/associated_cancellation_slot.hpp"
 #include "asio/associated_executor.hpp"
+#include "asio/basic_waitable_timer.hpp"
 #include "asio/detail/bind_handler.hpp"
 #include "asio/detail/handler_alloc_helpers.hpp"
 #include "asio/detail/handler_cont_helpers.hpp"
 #include "asio/detail/handler_invoke_helpers.hpp"
 #include "asio/detail/handler_tracking.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/mutex.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
 #include "asio/post.hpp"
+#include "asio/wait_traits.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -388,6 +394,13 @@ namespace detail
           if (!ec)
             break;
 
+          // An attempt cancelled through the handler's cancellation slot ends
+          // the operation, rather than moving on to the next endpoint.
+          if (ec == asio::error::operation_aborted
+              && asio::get_associated_cancellation_slot(
+                handler_).is_connected())
+            break;
+
           ++iter;
           ++index_;
         }
@@ -595,6 +608,13 @@ namespace detail
           if (!ec)
             break;
 
+          // An attempt cancelled through the handler's cancellation slot ends
+          // the operation, rather than moving on to the next endpoint.
+          if (ec == asio::error::operation_aborted
+              && asio::get_associated_cancellation_slot(
+                handler_).is_connected())
+            break;
+
           ++iter_;
         }
 
@@ -719,6 +739,369 @@ namespace detail
   private:
     basic_socket<Protocol, Executor>& socket_;
   };
+
+#if defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+
+  // Reorder endpoints so that address families alternate, starting with the
+  // family of the first endpoint, as described in RFC 8305 section 4.
+  template <typename Endpoint>
+  void interleave_address_families(std::vector<Endpoint>& endpoints)
+  {
+    if (endpoints.size() < 3)
+      return;
+
+    std::vector<Endpoint> first, rest;
+    for (std::size_t i = 0; i < endpoints.size(); ++i)
+    {
+      if (endpoints[i].protocol().family()
+          == endpoints[0].protocol().family())
+        first.push_back(endpoints[i]);
+      else
+        rest.push_back(endpoints[i]);
+    }
+
+    endpoints.clear();
+    for (std::size_t i = 0; i < first.size() || i < rest.size(); ++i)
+    {
+      if (i < first.size())
+        endpoints.push_back(first[i]);
+      if (i < rest.size())
+        endpoints.push_back(rest[i]);
+    }
+  }
+
+  // The socket used for an individual connection attempt. The basic_socket
+  // destructor is protected, so a trivial derived class allows attempts to be
+  // made for any socket protocol.
+  template <typename Protocol, typename Executor>
+  class race_connect_socket : public basic_socket<Protocol, Executor>
+  {
+  public:
+    explicit race_connect_socket(const Executor& ex)
+      : basic_socket<Protocol, Executor>(ex)
+    {
+    }
+  };
+
+  template <typename State>
+  class race_connect_attempt_handler;
+
+  template <typename State>
+  class race_connect_delay_handler;
+
+  // The state shared by all attempts of a single racing connect operation.
+  // Attempts may complete concurrently when the handler's executor is not a
+  // strand, so all members are protected by the mutex.
+  template <typename Protocol, typename Executor, typename RangeConnectHandler>
+  class race_connect_state
+  {
+  public:
+    typedef basic_socket<Protocol, Executor> socket_type;
+
+    typedef typename Protocol::endpoint endpoint_type;
+
+    typedef basic_waitable_timer<chrono::steady_clock,
+        wait_traits<chrono::steady_clock>, Executor> timer_type;
+
+    typedef typename associated_executor<RangeConnectHandler,
+        Executor>::type handler_executor_type;
+
+    typedef typename associated_allocator<
+        RangeConnectHandler>::type handler_allocator_type;
+
+    template <typename EndpointSequence>
+    race_connect_state(basic_socket<Protocol, Executor>& sock,
+        const EndpointSequence& endpoints,
+        const chrono::steady_clock::duration& attempt_delay,
+        RangeConnectHandler& handler)
+      : socket_(sock),
+        endpoints_(endpoints.begin(), endpoints.end()),
+        timer_(sock.get_executor()),
+        attempt_delay_(attempt_delay),
+        generation_(0),
+        next_(0),
+        pending_(0),
+        done_(false),
+        cancelled_(false),
+        handler_executor_((get_associated_executor)(
+              handler, sock.get_executor())),
+        handler_allocator_((get_associated_allocator)(handler)),
+        handler_(ASIO_MOVE_CAST(RangeConnectHandler)(handler))
+    {
+      interleave_address_families(endpoints_);
+      sockets_.reserve(endpoints_.size());
+      for (std::size_t i = 0; i < endpoints_.size(); ++i)
+        sockets_.push_back(race_connect_socket<Protocol, Executor>(
+              sock.get_executor()));
+    }
+
+    static void start(const shared_ptr<race_connect_state>& self)
+    {
+      asio::error_code ec;
+      self->socket_.close(ec);
+
+      if (self->endpoints_.empty())
+      {
+        ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_race_connect"));
+        asio::post(self->socket_.get_executor(),
+            detail::bind_handler(
+              ASIO_MOVE_CAST(RangeConnectHandler)(self->handler_),
+              asio::error::not_found, endpoint_type()));
+        return;
+      }
+
+      mutex::scoped_lock lock(self->mutex_);
+      start_attempt(self);
+    }
+
+    static void attempt_complete(const shared_ptr<race_connect_state>& self,
+        std::size_t index, const asio::error_code& ec)
+    {
+      mutex::scoped_lock lock(self->mutex_);
+
+      --self->pending_;
+      if (self->done_)
+        return;
+
+      if (!ec && self->sockets_[index].is_open())
+      {
+        // The first attempt to succeed wins. Abandon the others and hand the
+        // connected socket over to the caller.
+        self->done_ = true;
+        self->stop_attempts(index);
+        self->socket_ = ASIO_MOVE_CAST(socket_type)(self->sockets_[index]);
+        lock.unlock();
+
+        self->handler_(static_cast<const asio::error_code&>(ec),
+            static_cast<const endpoint_type&>(self->endpoints_[index]));
+        return;
+      }
+
+      asio::error_code ignored_ec;
+      self->sockets_[index].close(ignored_ec);
+      self->last_error_ = ec ? ec : asio::error::operation_aborted;
+
+      // A failed attempt makes way for the next one immediately.
+      if (!self->cancelled_ && self->next_ < self->endpoints_.size())
+      {
+        start_attempt(self);
+        return;
+      }
+
+      if (self->pending_ == 0)
+      {
+        self->done_ = true;
+        self->stop_attempts(self->endpoints_.size());
+        asio::error_code result_ec = self->cancelled_
+          ? asio::error_code(asio::error::operation_aborted)
+          : self->last_error_;
+        lock.unlock();
+
+        self->handler_(static_cast<const asio::error_code&>(result_ec),
+            static_cast<const endpoint_type&>(endpoint_type()));
+      }
+    }
+
+    static void delay_complete(const shared_ptr<race_connect_state>& self,
+        std::size_t generation)
+    {
+      mutex::scoped_lock lock(self->mutex_);
+
+      if (!self->done_ && !self->cancelled_
+          && generation == self->generation_
+          && self->next_ < self->endpoints_.size())
+        start_attempt(self);
+    }
+
+    void cancel()
+    {
+      mutex::scoped_lock lock(mutex_);
+
+      if (!done_ && !cancelled_)
+      {
+        // The outstanding attempts complete with operation_aborted, and the
+        // last of them completes the operation.
+        cancelled_ = true;
+        stop_attempts(endpoints_.size());
+      }
+    }
+
+    handler_executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return handler_executor_;
+    }
+
+    handler_allocator_type get_allocator() const ASIO_NOEXCEPT
+    {
+      return handler_allocator_;
+    }
+
+  private:
+    // Start an attempt to the next endpoint and, if any endpoints remain,
+    // restart the delay after which the one following it is started.
+    static void start_attempt(const shared_ptr<race_connect_state>& self)
+    {
+      std::size_t index = self->next_++;
+      ++self->pending_;
+      ASIO_HANDLER_LOCATION((__FILE__, __LINE__, "async_race_connect"));
+      self->sockets_[index].async_connect(self->endpoints_[index],
+          race_connect_attempt_handler<race_connect_state>(self, index));
+
+      ++self->generation_;
+      if (self->next_ < self->endpoints_.size())
+      {
+        self->timer_.expires_after(self->attempt_delay_);
+        self->timer_.async_wait(
+            race_connect_delay_handler<race_connect_state>(
+              self, self->generation_));
+      }
+      else
+      {
+        self->timer_.cancel();
+      }
+    }
+
+    // Stop the delay and close all attempts other than the one specified.
+    void stop_attempts(std::size_t except)
+    {
+      ++generation_;
+      timer_.cancel();
+
+      asio::error_code ignored_ec;
+      for (std::size_t i = 0; i < next_; ++i)
+        if (i != except)
+          sockets_[i].close(ignored_ec);
+    }
+
+    mutex mutex_;
+    basic_socket<Protocol, Executor>& socket_;
+    std::vector<endpoint_type> endpoints_;
+    std::vector<race_connect_socket<Protocol, Executor> > sockets_;
+    timer_type timer_;
+    chrono::steady_clock::duration attempt_delay_;
+    std::size_t generation_;
+    std::size_t next_;
+    std::size_t pending_;
+    bool done_;
+    bool cancelled_;
+    asio::error_code last_error_;
+    handler_executor_type handler_executor_;
+    handler_allocator_type handler_allocator_;
+    RangeConnectHandler handler_;
+  };
+
+  template <typename State>
+  class race_connect_attempt_handler
+  {
+  public:
+    race_connect_attempt_handler(const shared_ptr<State>& state,
+        std::size_t index)
+      : state_(state),
+        index_(index)
+    {
+    }
+
+    void operator()(const asio::error_code& ec)
+    {
+      State::attempt_complete(state_, index_, ec);
+    }
+
+  //private:
+    shared_ptr<State> state_;
+    std::size_t index_;
+  };
+
+  template <typename State>
+  class race_connect_delay_handler
+  {
+  public:
+    race_connect_delay_handler(const shared_ptr<State>& state,
+        std::size_t generation)
+      : state_(state),
+        generation_(generation)
+    {
+    }
+
+    void operator()(const asio::error_code&)
+    {
+      State::delay_complete(state_, generation_);
+    }
+
+  //private:
+    shared_ptr<State> state_;
+    std::size_t generation_;
+  };
+
+  // Installed into the handler's cancellation slot. The state is held weakly
+  // so that a signal outliving the operation does not keep it alive.
+  template <typename State>
+  class race_connect_cancellation
+  {
+  public:
+    explicit race_connect_cancellation(const shared_ptr<State>& state)
+      : state_(state)
+    {
+    }
+
+    void operator()()
+    {
+      if (shared_ptr<State> state = state_.lock())
+        state->cancel();
+    }
+
+  private:
+    weak_ptr<State> state_;
+  };
+
+  template <typename Protocol, typename Executor>
+  class initiate_async_race_connect
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_race_connect(basic_socket<Protocol, Executor>& s)
+      : socket_(s)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return socket_.get_executor();
+    }
+
+    template <typename RangeConnectHandler, typename EndpointSequence>
+    void operator()(ASIO_MOVE_ARG(RangeConnectHandler) handler,
+        const EndpointSequence& endpoints,
+        const chrono::steady_clock::duration& attempt_delay) const
+    {
+      // If you get an error on the following line it means that your
+      // handler does not meet the documented type requirements for an
+      // RangeConnectHandler.
+      ASIO_RANGE_CONNECT_HANDLER_CHECK(RangeConnectHandler,
+          handler, typename Protocol::endpoint) type_check;
+
+      typedef race_connect_state<Protocol, Executor,
+        typename decay<RangeConnectHandler>::type> state_type;
+
+      typename associated_cancellation_slot<
+        typename decay<RangeConnectHandler>::type>::type slot
+          = (get_associated_cancellation_slot)(handler);
+
+      non_const_lvalue<RangeConnectHandler> handler2(handler);
+      shared_ptr<state_type> state(new state_type(socket_,
+            endpoints, attempt_delay, handler2.value));
+
+      if (slot.is_connected())
+        slot.template emplace<race_connect_cancellation<state_type> >(state);
+
+      state_type::start(state);
+    }
+
+  private:
+    basic_socket<Protocol, Executor>& socket_;
+  };
+
+#endif // defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
 } // namespace detail
 
 #if !defined(GENERATING_DOCUMENTATION)
@@ -761,6 +1144,26 @@ struct associated_executor<
   }
 };
 
+template <typename Protocol, typename Executor, typename EndpointSequence,
+    typename ConnectCondition, typename RangeConnectHandler,
+    typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::range_connect_op<Protocol, Executor, EndpointSequence,
+      ConnectCondition, RangeConnectHandler>, CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+      RangeConnectHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::range_connect_op<Protocol, Executor, EndpointSequence,
+        ConnectCondition, RangeConnectHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<RangeConnectHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 template <typename Protocol, typename Executor, typename Iterator,
     typename ConnectCondition, typename IteratorConnectHandler,
     typename Allocator>
@@ -803,6 +1206,83 @@ struct associated_executor<
   }
 };
 
+template <typename Protocol, typename Executor, typename Iterator,
+    typename ConnectCondition, typename IteratorConnectHandler,
+    typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::iterator_connect_op<Protocol, Executor,
+      Iterator, ConnectCondition, IteratorConnectHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+      IteratorConnectHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::iterator_connect_op<Protocol, Executor,
+        Iterator, ConnectCondition, IteratorConnectHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<IteratorConnectHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
+#if defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+
+template <typename State, typename Allocator>
+struct associated_allocator<
+    detail::race_connect_attempt_handler<State>, Allocator>
+{
+  typedef typename State::handler_allocator_type type;
+
+  static type get(const detail::race_connect_attempt_handler<State>& h,
+      const Allocator& = Allocator()) ASIO_NOEXCEPT
+  {
+    return h.state_->get_allocator();
+  }
+};
+
+template <typename State, typename Executor1>
+struct associated_executor<
+    detail::race_connect_attempt_handler<State>, Executor1>
+{
+  typedef typename State::handler_executor_type type;
+
+  static type get(const detail::race_connect_attempt_handler<State>& h,
+      const Executor1& = Executor1()) ASIO_NOEXCEPT
+  {
+    return h.state_->get_executor();
+  }
+};
+
+template <typename State, typename Allocator>
+struct associated_allocator<
+    detail::race_connect_delay_handler<State>, Allocator>
+{
+  typedef typename State::handler_allocator_type type;
+
+  static type get(const detail::race_connect_delay_handler<State>& h,
+      const Allocator& = Allocator()) ASIO_NOEXCEPT
+  {
+    return h.state_->get_allocator();
+  }
+};
+
+template <typename State, typename Executor1>
+struct associated_executor<
+    detail::race_connect_delay_handler<State>, Executor1>
+{
+  typedef typename State::handler_executor_type type;
+
+  static type get(const detail::race_connect_delay_handler<State>& h,
+      const Executor1& = Executor1()) ASIO_NOEXCEPT
+  {
+    return h.state_->get_executor();
+  }
+};
+
+#endif // defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+
 #endif // !defined(GENERATING_DOCUMENTATION)
 
 template <typename Protocol, typename Executor, typename EndpointSequence,
@@ -906,6 +1386,28 @@ async_connect(basic_socket<Protocol, Executor>& s, Iterator begin,
       handler, begin, end, connect_condition);
 }
 
+#if defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+
+template <typename Protocol, typename Executor, typename EndpointSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      typename Protocol::endpoint)) RangeConnectHandler>
+inline ASIO_INITFN_AUTO_RESULT_TYPE(RangeConnectHandler,
+    void (asio::error_code, typename Protocol::endpoint))
+async_race_connect(basic_socket<Protocol, Executor>& s,
+    const EndpointSequence& endpoints,
+    const chrono::steady_clock::duration& attempt_delay,
+    ASIO_MOVE_ARG(RangeConnectHandler) handler,
+    typename enable_if<is_endpoint_sequence<
+        EndpointSequence>::value>::type*)
+{
+  return async_initiate<RangeConnectHandler,
+    void (asio::error_code, typename Protocol::endpoint)>(
+      detail::initiate_async_race_connect<Protocol, Executor>(s),
+      handler, endpoints, attempt_delay);
+}
+
+#endif // defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+
 } // namespace asio
 
 #include "asio/detail/pop_options.hpp"
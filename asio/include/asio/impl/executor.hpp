@@ -21,6 +21,7 @@
 #include "asio/detail/global.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/recycling_allocator.hpp"
+#include "asio/detail/type_traits.hpp"
 #include "asio/executor.hpp"
 #include "asio/system_executor.hpp"
 
@@ -32,45 +33,153 @@ namespace asio {
 
 #if defined(ASIO_HAS_MOVE)
 
-// Lightweight, move-only function object wrapper.
+// Lightweight, move-only function object wrapper. Small function objects are
+// stored inline, while larger ones are allocated using the associated
+// allocator.
 class executor::function
 {
 public:
   template <typename F, typename Alloc>
   explicit function(F f, const Alloc& a)
   {
-    // Allocate and construct an operation to wrap the function.
-    typedef detail::executor_function<F, Alloc> func_type;
-    typename func_type::ptr p = {
-      detail::addressof(a), func_type::ptr::allocate(a), 0 };
-    func_ = new (p.v) func_type(ASIO_MOVE_CAST(F)(f), a);
-    p.v = 0;
+    typedef integral_constant<bool,
+      sizeof(F) <= sizeof(storage_type)
+        && alignment_of<F>::value <= alignment_of<storage_type>::value
+        && is_nothrow_move_constructible<F>::value> is_inline;
+
+    construct(ASIO_MOVE_CAST(F)(f), a, is_inline());
   }
 
   function(function&& other) ASIO_NOEXCEPT
-    : func_(other.func_)
+    : ops_(other.ops_)
   {
-    other.func_ = 0;
+    if (ops_)
+      ops_->move_(storage_, other.storage_);
+    other.ops_ = 0;
   }
 
   ~function()
   {
-    if (func_)
-      func_->destroy();
+    if (ops_)
+      ops_->complete_(storage_, false);
   }
 
   void operator()()
   {
-    if (func_)
+    if (ops_)
     {
-      detail::executor_function_base* func = func_;
-      func_ = 0;
-      func->complete();
+      const ops* o = ops_;
+      ops_ = 0;
+      o->complete_(storage_, true);
     }
   }
 
 private:
-  detail::executor_function_base* func_;
+  // The amount of storage available for function objects held inline.
+  enum { inline_storage_size = 4 * sizeof(void*) };
+
+  // Storage suitably aligned to hold small function objects inline.
+  union storage_type
+  {
+    void* pointer_;
+    double double_;
+    long long_;
+    unsigned char data_[inline_storage_size];
+  };
+
+  // The operations used to manage the stored function object.
+  struct ops
+  {
+    void (*move_)(storage_type& to, storage_type& from);
+    void (*complete_)(storage_type& s, bool call);
+  };
+
+  // Construct a function object inline.
+  template <typename F, typename Alloc>
+  void construct(ASIO_MOVE_ARG(F) f, const Alloc&, true_type)
+  {
+    new (&storage_) F(ASIO_MOVE_CAST(F)(f));
+    ops_ = &inline_ops<F>::value;
+  }
+
+  // Allocate and construct an operation to wrap the function.
+  template <typename F, typename Alloc>
+  void construct(ASIO_MOVE_ARG(F) f, const Alloc& a, false_type)
+  {
+    typedef detail::executor_function<F, Alloc> func_type;
+    typename func_type::ptr p = {
+      detail::addressof(a), func_type::ptr::allocate(a), 0 };
+    storage_.pointer_ = new (p.v) func_type(ASIO_MOVE_CAST(F)(f), a);
+    p.v = 0;
+    ops_ = &allocated_ops<func_type>::value;
+  }
+
+  // Operations for a function object stored inline.
+  template <typename F>
+  struct inline_ops
+  {
+    static void move(storage_type& to, storage_type& from)
+    {
+      F* f = static_cast<F*>(static_cast<void*>(&from));
+      new (&to) F(ASIO_MOVE_CAST(F)(*f));
+      f->~F();
+    }
+
+    static void complete(storage_type& s, bool call)
+    {
+      // Move the function out of the storage so that it is destroyed and the
+      // wrapper is empty before the upcall is made.
+      F* f = static_cast<F*>(static_cast<void*>(&s));
+      F function(ASIO_MOVE_CAST(F)(*f));
+      f->~F();
+
+      // Make the upcall if required.
+      if (call)
+      {
+        function();
+      }
+    }
+
+    static const ops value;
+  };
+
+  // Operations for a function object wrapped in an allocated operation.
+  template <typename Func>
+  struct allocated_ops
+  {
+    static void move(storage_type& to, storage_type& from)
+    {
+      to.pointer_ = from.pointer_;
+    }
+
+    static void complete(storage_type& s, bool call)
+    {
+      Func* func = static_cast<Func*>(s.pointer_);
+      if (call)
+        func->complete();
+      else
+        func->destroy();
+    }
+
+    static const ops value;
+  };
+
+  const ops* ops_;
+  storage_type storage_;
+};
+
+template <typename F>
+const executor::function::ops executor::function::inline_ops<F>::value =
+{
+  &executor::function::inline_ops<F>::move,
+  &executor::function::inline_ops<F>::complete
+};
+
+template <typename Func>
+const executor::function::ops executor::function::allocated_ops<Func>::value =
+{
+  &executor::function::allocated_ops<Func>::move,
+  &executor::function::allocated_ops<Func>::complete
 };
 
 #else // defined(ASIO_HAS_MOVE)
@@ -122,6 +231,97 @@ private:
 
 #endif // defined(ASIO_HAS_MOVE)
 
+// Polymorphic executor implementation stored inline within the wrapper. It is
+// used only when the executor and allocator can be copied and moved without
+// throwing, as copying and moving the wrapper cannot fail.
+template <typename Executor, typename Allocator>
+class executor::inline_impl
+  : public executor::impl_base
+{
+public:
+  inline_impl(const Executor& e, const Allocator& a) ASIO_NOEXCEPT
+    : impl_base(false),
+      executor_(e),
+      allocator_(a)
+  {
+  }
+
+  impl_base* clone(storage_type& s) const ASIO_NOEXCEPT
+  {
+    return new (&s) inline_impl(*this);
+  }
+
+  impl_base* move(storage_type& s) ASIO_NOEXCEPT
+  {
+    inline_impl* p = new (&s) inline_impl(ASIO_MOVE_CAST(inline_impl)(*this));
+    this->~inline_impl();
+    return p;
+  }
+
+  void destroy() ASIO_NOEXCEPT
+  {
+    this->~inline_impl();
+  }
+
+  void on_work_started() ASIO_NOEXCEPT
+  {
+    executor_.on_work_started();
+  }
+
+  void on_work_finished() ASIO_NOEXCEPT
+  {
+    executor_.on_work_finished();
+  }
+
+  execution_context& context() ASIO_NOEXCEPT
+  {
+    return executor_.context();
+  }
+
+  void dispatch(ASIO_MOVE_ARG(function) f)
+  {
+    executor_.dispatch(ASIO_MOVE_CAST(function)(f), allocator_);
+  }
+
+  void post(ASIO_MOVE_ARG(function) f)
+  {
+    executor_.post(ASIO_MOVE_CAST(function)(f), allocator_);
+  }
+
+  void defer(ASIO_MOVE_ARG(function) f)
+  {
+    executor_.defer(ASIO_MOVE_CAST(function)(f), allocator_);
+  }
+
+  type_id_result_type target_type() const ASIO_NOEXCEPT
+  {
+    return type_id<Executor>();
+  }
+
+  void* target() ASIO_NOEXCEPT
+  {
+    return &executor_;
+  }
+
+  const void* target() const ASIO_NOEXCEPT
+  {
+    return &executor_;
+  }
+
+  bool equals(const impl_base* e) const ASIO_NOEXCEPT
+  {
+    if (this == e)
+      return true;
+    if (target_type() != e->target_type())
+      return false;
+    return executor_ == *static_cast<const Executor*>(e->target());
+  }
+
+private:
+  Executor executor_;
+  Allocator allocator_;
+};
+
 // Default polymorphic executor implementation.
 template <typename Executor, typename Allocator>
 class executor::impl
@@ -130,7 +330,30 @@ class executor::impl
 public:
   typedef ASIO_REBIND_ALLOC(Allocator, impl) allocator_type;
 
-  static impl_base* create(const Executor& e, Allocator a = Allocator())
+  static impl_base* create(const Executor& e,
+      const Allocator& a, storage_type& s)
+  {
+    typedef inline_impl<Executor, Allocator> inline_type;
+    typedef integral_constant<bool,
+      sizeof(inline_type) <= sizeof(storage_type)
+        && alignment_of<inline_type>::value
+          <= alignment_of<storage_type>::value
+        && is_nothrow_copy_constructible<Executor>::value
+        && is_nothrow_move_constructible<Executor>::value
+        && is_nothrow_copy_constructible<Allocator>::value
+        && is_nothrow_move_constructible<Allocator>::value> is_inline;
+
+    return impl::create(e, a, s, is_inline());
+  }
+
+  static impl_base* create(const Executor& e,
+      const Allocator& a, storage_type& s, true_type)
+  {
+    return new (&s) inline_impl<Executor, Allocator>(e, a);
+  }
+
+  static impl_base* create(const Executor& e,
+      const Allocator& a, storage_type&, false_type)
   {
     raw_mem mem(a);
     impl* p = new (mem.ptr_) impl(e, a);
@@ -146,12 +369,17 @@ public:
   {
   }
 
-  impl_base* clone() const ASIO_NOEXCEPT
+  impl_base* clone(storage_type&) const ASIO_NOEXCEPT
   {
     detail::ref_count_up(ref_count_);
     return const_cast<impl_base*>(static_cast<const impl_base*>(this));
   }
 
+  impl_base* move(storage_type&) ASIO_NOEXCEPT
+  {
+    return this;
+  }
+
   void destroy() ASIO_NOEXCEPT
   {
     if (detail::ref_count_down(ref_count_))
@@ -253,7 +481,7 @@ class executor::impl<system_executor, Allocator>
 {
 public:
   static impl_base* create(const system_executor&,
-      const Allocator& = Allocator())
+      const Allocator&, storage_type&)
   {
     return &detail::global<impl<system_executor, std::allocator<void> > >();
   }
@@ -263,11 +491,16 @@ public:
   {
   }
 
-  impl_base* clone() const ASIO_NOEXCEPT
+  impl_base* clone(storage_type&) const ASIO_NOEXCEPT
   {
     return const_cast<impl_base*>(static_cast<const impl_base*>(this));
   }
 
+  impl_base* move(storage_type&) ASIO_NOEXCEPT
+  {
+    return this;
+  }
+
   void destroy() ASIO_NOEXCEPT
   {
   }
@@ -331,13 +564,14 @@ private:
 
 template <typename Executor>
 executor::executor(Executor e)
-  : impl_(impl<Executor, std::allocator<void> >::create(e))
+  : impl_(impl<Executor, std::allocator<void> >::create(
+        e, std::allocator<void>(), storage_))
 {
 }
 
 template <typename Executor, typename Allocator>
 executor::executor(allocator_arg_t, const Allocator& a, Executor e)
-  : impl_(impl<Executor, Allocator>::create(e, a))
+  : impl_(impl<Executor, Allocator>::create(e, a, storage_))
 {
 }
 
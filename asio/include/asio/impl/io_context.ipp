@@ -19,6 +19,7 @@
 #include "asio/io_context.hpp"
 #include "asio/detail/concurrency_hint.hpp"
 #include "asio/detail/limits.hpp"
+#include "asio/detail/memory_resource_service.hpp"
 #include "asio/detail/scoped_ptr.hpp"
 #include "asio/detail/service_registry.hpp"
 #include "asio/detail/throw_error.hpp"
@@ -45,6 +46,20 @@ io_context::io_context(int concurrency_hint)
 {
 }
 
+#if defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+io_context::io_context(std::pmr::memory_resource* resource)
+  : impl_(add_impl(resource, ASIO_CONCURRENCY_HINT_DEFAULT))
+{
+}
+
+io_context::io_context(int concurrency_hint,
+    std::pmr::memory_resource* resource)
+  : impl_(add_impl(resource, concurrency_hint == 1
+          ? ASIO_CONCURRENCY_HINT_1 : concurrency_hint))
+{
+}
+#endif // defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+
 io_context::impl_type& io_context::add_impl(io_context::impl_type* impl)
 {
   asio::detail::scoped_ptr<impl_type> scoped_impl(impl);
@@ -52,6 +67,29 @@ io_context::impl_type& io_context::add_impl(io_context::impl_type* impl)
   return *scoped_impl.release();
 }
 
+#if defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+io_context::impl_type& io_context::add_impl(
+    std::pmr::memory_resource* resource, int concurrency_hint)
+{
+  // The memory resource must be registered before the implementation is
+  // created, so that the implementation and all subsequently created services
+  // are able to find it.
+  typedef asio::detail::memory_resource_service resource_service;
+  asio::detail::scoped_ptr<resource_service> scoped_service(
+      new resource_service(*this, resource));
+  asio::add_service<resource_service>(*this, scoped_service.get());
+  scoped_service.release();
+
+  return add_impl(new impl_type(*this, concurrency_hint, false));
+}
+
+std::pmr::memory_resource* io_context::get_memory_resource() const
+  ASIO_NOEXCEPT
+{
+  return impl_.get_memory_resource();
+}
+#endif // defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+
 io_context::~io_context()
 {
 }
@@ -131,6 +169,28 @@ void io_context::restart()
   impl_.restart();
 }
 
+void io_context::reserve(std::size_t descriptors, std::size_t timers)
+{
+  impl_.reserve(descriptors, timers);
+}
+
+void io_context::trim()
+{
+  impl_.trim();
+}
+
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+io_context::allocation_statistics io_context::get_allocation_statistics(
+    io_context::allocation_category category) const
+{
+  detail::allocation_accounting::statistics s =
+    impl_.get_allocation_accounting()->get_statistics(category);
+  allocation_statistics result = { s.count, s.bytes,
+    s.peak_count, s.peak_bytes };
+  return result;
+}
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
 io_context::service::service(asio::io_context& owner)
   : execution_context::service(owner)
 {
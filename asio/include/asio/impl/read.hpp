@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include "asio/associated_allocator.hpp"
+#include "asio/associated_cancellation_slot.hpp"
 #include "asio/associated_executor.hpp"
 #include "asio/buffer.hpp"
 #include "asio/completion_condition.hpp"
@@ -552,6 +553,27 @@ struct associated_executor<
   }
 };
 
+template <typename AsyncReadStream, typename MutableBufferSequence,
+    typename MutableBufferIterator, typename CompletionCondition,
+    typename ReadHandler, typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::read_op<AsyncReadStream, MutableBufferSequence,
+      MutableBufferIterator, CompletionCondition, ReadHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+      ReadHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::read_op<AsyncReadStream, MutableBufferSequence,
+        MutableBufferIterator, CompletionCondition, ReadHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<ReadHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 #endif // !defined(GENERATING_DOCUMENTATION)
 
 template <typename AsyncReadStream,
@@ -832,6 +854,27 @@ struct associated_executor<
   }
 };
 
+template <typename AsyncReadStream, typename DynamicBuffer_v1,
+    typename CompletionCondition, typename ReadHandler,
+    typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::read_dynbuf_v1_op<AsyncReadStream,
+      DynamicBuffer_v1, CompletionCondition, ReadHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+      ReadHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::read_dynbuf_v1_op<AsyncReadStream,
+        DynamicBuffer_v1, CompletionCondition, ReadHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<ReadHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 #endif // !defined(GENERATING_DOCUMENTATION)
 
 template <typename AsyncReadStream, typename DynamicBuffer_v1,
@@ -1154,6 +1197,27 @@ struct associated_executor<
   }
 };
 
+template <typename AsyncReadStream, typename DynamicBuffer_v2,
+    typename CompletionCondition, typename ReadHandler,
+    typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::read_dynbuf_v2_op<AsyncReadStream,
+      DynamicBuffer_v2, CompletionCondition, ReadHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+      ReadHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::read_dynbuf_v2_op<AsyncReadStream,
+        DynamicBuffer_v2, CompletionCondition, ReadHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<ReadHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 #endif // !defined(GENERATING_DOCUMENTATION)
 
 template <typename AsyncReadStream, typename DynamicBuffer_v2,
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include "asio/associated_allocator.hpp"
+#include "asio/associated_cancellation_slot.hpp"
 #include "asio/associated_executor.hpp"
 #include "asio/buffer.hpp"
 #include "asio/completion_condition.hpp"
@@ -423,6 +424,29 @@ struct associated_executor<
   }
 };
 
+template <typename AsyncRandomAccessReadDevice,
+    typename MutableBufferSequence, typename MutableBufferIterator,
+    typename CompletionCondition, typename ReadHandler,
+    typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::read_at_op<AsyncRandomAccessReadDevice, MutableBufferSequence,
+    MutableBufferIterator, CompletionCondition, ReadHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+      ReadHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::read_at_op<AsyncRandomAccessReadDevice,
+      MutableBufferSequence, MutableBufferIterator,
+      CompletionCondition, ReadHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<ReadHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 #endif // !defined(GENERATING_DOCUMENTATION)
 
 template <typename AsyncRandomAccessReadDevice,
@@ -697,6 +721,27 @@ struct associated_executor<
   }
 };
 
+template <typename AsyncRandomAccessReadDevice, typename Allocator,
+    typename CompletionCondition, typename ReadHandler,
+    typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::read_at_streambuf_op<AsyncRandomAccessReadDevice,
+      Allocator, CompletionCondition, ReadHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+      ReadHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::read_at_streambuf_op<AsyncRandomAccessReadDevice,
+        Allocator, CompletionCondition, ReadHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<ReadHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 #endif // !defined(GENERATING_DOCUMENTATION)
 
 template <typename AsyncRandomAccessReadDevice,
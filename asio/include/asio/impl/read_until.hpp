@@ -20,6 +20,7 @@
 #include <vector>
 #include <utility>
 #include "asio/associated_allocator.hpp"
+#include "asio/associated_cancellation_slot.hpp"
 #include "asio/associated_executor.hpp"
 #include "asio/buffer.hpp"
 #include "asio/buffers_iterator.hpp"
@@ -1050,6 +1051,26 @@ struct associated_executor<
   }
 };
 
+template <typename AsyncReadStream, typename DynamicBuffer_v1,
+    typename ReadHandler, typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::read_until_delim_op_v1<AsyncReadStream,
+      DynamicBuffer_v1, ReadHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+      ReadHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::read_until_delim_op_v1<AsyncReadStream,
+        DynamicBuffer_v1, ReadHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<ReadHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 #endif // !defined(GENERATING_DOCUMENTATION)
 
 template <typename AsyncReadStream, typename DynamicBuffer_v1,
@@ -1356,6 +1377,26 @@ struct associated_executor<
   }
 };
 
+template <typename AsyncReadStream, typename DynamicBuffer_v1,
+    typename ReadHandler, typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::read_until_delim_string_op_v1<AsyncReadStream,
+      DynamicBuffer_v1, ReadHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+      ReadHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::read_until_delim_string_op_v1<AsyncReadStream,
+        DynamicBuffer_v1, ReadHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<ReadHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 #endif // !defined(GENERATING_DOCUMENTATION)
 
 template <typename AsyncReadStream, typename DynamicBuffer_v1,
@@ -1669,6 +1710,26 @@ struct associated_executor<
   }
 };
 
+template <typename AsyncReadStream, typename DynamicBuffer_v1,
+    typename RegEx, typename ReadHandler, typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::read_until_expr_op_v1<AsyncReadStream,
+      DynamicBuffer_v1, RegEx, ReadHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+      ReadHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::read_until_expr_op_v1<AsyncReadStream,
+        DynamicBuffer_v1, RegEx, ReadHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<ReadHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 #endif // !defined(GENERATING_DOCUMENTATION)
 
 template <typename AsyncReadStream, typename DynamicBuffer_v1,
@@ -1980,6 +2041,26 @@ struct associated_executor<
   }
 };
 
+template <typename AsyncReadStream, typename DynamicBuffer_v1,
+    typename MatchCondition, typename ReadHandler, typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::read_until_match_op_v1<AsyncReadStream,
+      DynamicBuffer_v1, MatchCondition, ReadHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+      ReadHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::read_until_match_op_v1<AsyncReadStream,
+        DynamicBuffer_v1, MatchCondition, ReadHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<ReadHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 #endif // !defined(GENERATING_DOCUMENTATION)
 
 template <typename AsyncReadStream,
@@ -2348,6 +2429,26 @@ struct associated_executor<
   }
 };
 
+template <typename AsyncReadStream, typename DynamicBuffer_v2,
+    typename ReadHandler, typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::read_until_delim_op_v2<AsyncReadStream,
+      DynamicBuffer_v2, ReadHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+      ReadHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::read_until_delim_op_v2<AsyncReadStream,
+        DynamicBuffer_v2, ReadHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<ReadHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 #endif // !defined(GENERATING_DOCUMENTATION)
 
 template <typename AsyncReadStream, typename DynamicBuffer_v2,
@@ -2660,6 +2761,26 @@ struct associated_executor<
   }
 };
 
+template <typename AsyncReadStream, typename DynamicBuffer_v2,
+    typename ReadHandler, typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::read_until_delim_string_op_v2<AsyncReadStream,
+      DynamicBuffer_v2, ReadHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+      ReadHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::read_until_delim_string_op_v2<AsyncReadStream,
+        DynamicBuffer_v2, ReadHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<ReadHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 #endif // !defined(GENERATING_DOCUMENTATION)
 
 template <typename AsyncReadStream,
@@ -2981,6 +3102,26 @@ struct associated_executor<
   }
 };
 
+template <typename AsyncReadStream, typename DynamicBuffer_v2,
+    typename RegEx, typename ReadHandler, typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::read_until_expr_op_v2<AsyncReadStream,
+      DynamicBuffer_v2, RegEx, ReadHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+      ReadHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::read_until_expr_op_v2<AsyncReadStream,
+        DynamicBuffer_v2, RegEx, ReadHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<ReadHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 #endif // !defined(GENERATING_DOCUMENTATION)
 
 template <typename AsyncReadStream, typename DynamicBuffer_v2,
@@ -3297,6 +3438,26 @@ struct associated_executor<
   }
 };
 
+template <typename AsyncReadStream, typename DynamicBuffer_v2,
+    typename MatchCondition, typename ReadHandler, typename CancellationSlot>
+struct associated_cancellation_slot<
+    detail::read_until_match_op_v2<AsyncReadStream,
+      DynamicBuffer_v2, MatchCondition, ReadHandler>,
+    CancellationSlot>
+{
+  typedef typename associated_cancellation_slot<
+      ReadHandler, CancellationSlot>::type type;
+
+  static type get(
+      const detail::read_until_match_op_v2<AsyncReadStream,
+        DynamicBuffer_v2, MatchCondition, ReadHandler>& h,
+      const CancellationSlot& s = CancellationSlot()) ASIO_NOEXCEPT
+  {
+    return associated_cancellation_slot<ReadHandler,
+        CancellationSlot>::get(h.handler_, s);
+  }
+};
+
 #endif // !defined(GENERATING_DOCUMENTATION)
 
 template <typename AsyncReadStream,
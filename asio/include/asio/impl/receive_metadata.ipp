@@ -0,0 +1,152 @@
+//
+// impl/receive_metadata.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_RECEIVE_METADATA_IPP
+#define ASIO_IMPL_RECEIVE_METADATA_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_RECEIVE_METADATA)
+
+#include <cstring>
+#include "asio/receive_metadata.hpp"
+#include "asio/detail/socket_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+#if defined(SCM_TIMESTAMPING) || defined(SCM_TIMESTAMPNS)
+inline asio::uint64_t timespec_to_nanoseconds(const timespec& ts)
+{
+  return static_cast<asio::uint64_t>(ts.tv_sec) * 1000000000
+    + static_cast<asio::uint64_t>(ts.tv_nsec);
+}
+#endif // defined(SCM_TIMESTAMPING) || defined(SCM_TIMESTAMPNS)
+
+} // namespace detail
+
+receive_metadata::receive_metadata() ASIO_NOEXCEPT
+  : flags_(0),
+    has_software_timestamp_(false),
+    has_hardware_timestamp_(false),
+    has_destination_(false),
+    software_timestamp_(0),
+    hardware_timestamp_(0),
+    destination_address_(),
+    interface_index_(0)
+{
+}
+
+bool receive_metadata::truncated() const ASIO_NOEXCEPT
+{
+  return (flags_ & MSG_TRUNC) != 0;
+}
+
+bool receive_metadata::control_truncated() const ASIO_NOEXCEPT
+{
+  return (flags_ & MSG_CTRUNC) != 0;
+}
+
+void receive_metadata::assign(socket_base::message_flags flags,
+    const void* control, std::size_t control_size)
+{
+  *this = receive_metadata();
+  flags_ = flags;
+
+  msghdr msg = msghdr();
+  msg.msg_control = const_cast<void*>(control);
+  msg.msg_controllen = control_size;
+
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+      cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+  {
+#if defined(SCM_TIMESTAMPING)
+    // Software, deprecated and raw hardware timestamps, in that order.
+    if (cmsg->cmsg_level == SOL_SOCKET
+        && cmsg->cmsg_type == SCM_TIMESTAMPING)
+    {
+      timespec ts[3];
+      std::memcpy(ts, CMSG_DATA(cmsg), sizeof(ts));
+      if (ts[0].tv_sec != 0 || ts[0].tv_nsec != 0)
+      {
+        has_software_timestamp_ = true;
+        software_timestamp_ = detail::timespec_to_nanoseconds(ts[0]);
+      }
+      if (ts[2].tv_sec != 0 || ts[2].tv_nsec != 0)
+      {
+        has_hardware_timestamp_ = true;
+        hardware_timestamp_ = detail::timespec_to_nanoseconds(ts[2]);
+      }
+    }
+#endif // defined(SCM_TIMESTAMPING)
+
+#if defined(SCM_TIMESTAMPNS)
+    if (cmsg->cmsg_level == SOL_SOCKET
+        && cmsg->cmsg_type == SCM_TIMESTAMPNS)
+    {
+      timespec ts;
+      std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+      has_software_timestamp_ = true;
+      software_timestamp_ = detail::timespec_to_nanoseconds(ts);
+    }
+#endif // defined(SCM_TIMESTAMPNS)
+
+#if defined(SCM_TIMESTAMP)
+    if (cmsg->cmsg_level == SOL_SOCKET
+        && cmsg->cmsg_type == SCM_TIMESTAMP)
+    {
+      timeval tv;
+      std::memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+      has_software_timestamp_ = true;
+      software_timestamp_ = static_cast<asio::uint64_t>(tv.tv_sec) * 1000000000
+        + static_cast<asio::uint64_t>(tv.tv_usec) * 1000;
+    }
+#endif // defined(SCM_TIMESTAMP)
+
+#if defined(IP_PKTINFO)
+    if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO)
+    {
+      in_pktinfo info;
+      std::memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+      has_destination_ = true;
+      destination_address_ = ip::address_v4(
+          ntohl(info.ipi_addr.s_addr));
+      interface_index_ = static_cast<unsigned int>(info.ipi_ifindex);
+    }
+#endif // defined(IP_PKTINFO)
+
+#if defined(IPV6_PKTINFO)
+    if (cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_PKTINFO)
+    {
+      in6_pktinfo info;
+      std::memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+      ip::address_v6::bytes_type bytes;
+      std::memcpy(bytes.data(), &info.ipi6_addr, bytes.size());
+      has_destination_ = true;
+      destination_address_ = ip::address_v6(bytes);
+      interface_index_ = static_cast<unsigned int>(info.ipi6_ifindex);
+    }
+#endif // defined(IPV6_PKTINFO)
+  }
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_RECEIVE_METADATA)
+
+#endif // ASIO_IMPL_RECEIVE_METADATA_IPP
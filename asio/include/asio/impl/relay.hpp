@@ -0,0 +1,710 @@
+//
+// impl/relay.hpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_RELAY_HPP
+#define ASIO_IMPL_RELAY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <vector>
+#include "asio/associated_allocator.hpp"
+#include "asio/associated_executor.hpp"
+#include "asio/buffer.hpp"
+#include "asio/executor.hpp"
+#include "asio/socket_base.hpp"
+#include "asio/write.hpp"
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+
+#if defined(ASIO_HAS_SPLICE)
+# include <cerrno>
+# include <fcntl.h>
+# include <unistd.h>
+#endif // defined(ASIO_HAS_SPLICE)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+#if !defined(ASIO_BASIC_STREAM_SOCKET_FWD_DECL)
+#define ASIO_BASIC_STREAM_SOCKET_FWD_DECL
+
+// Forward declaration with defaulted arguments.
+template <typename Protocol, typename Executor = executor>
+class basic_stream_socket;
+
+#endif // !defined(ASIO_BASIC_STREAM_SOCKET_FWD_DECL)
+
+#if defined(ASIO_HAS_SPLICE) && defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+namespace posix {
+
+template <typename Executor>
+class basic_stream_descriptor;
+
+} // namespace posix
+#endif // defined(ASIO_HAS_SPLICE) && defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+
+namespace detail
+{
+  // Determines whether a stream's native handle may be passed to splice(),
+  // and how the end of file is propagated to the stream.
+  template <typename Stream>
+  struct relay_stream_traits
+  {
+    static int native_handle(Stream&)
+    {
+      return -1;
+    }
+
+    template <typename Handler>
+    static void async_wait_read(Stream&, const Handler&)
+    {
+    }
+
+    template <typename Handler>
+    static void async_wait_write(Stream&, const Handler&)
+    {
+    }
+
+    static void shutdown_send(Stream&, asio::error_code&)
+    {
+    }
+  };
+
+  template <typename Protocol, typename Executor>
+  struct relay_stream_traits<basic_stream_socket<Protocol, Executor> >
+  {
+    typedef basic_stream_socket<Protocol, Executor> stream_type;
+
+    static int native_handle(stream_type& s)
+    {
+#if defined(ASIO_HAS_SPLICE)
+      return s.native_handle();
+#else // defined(ASIO_HAS_SPLICE)
+      (void)s;
+      return -1;
+#endif // defined(ASIO_HAS_SPLICE)
+    }
+
+    template <typename Handler>
+    static void async_wait_read(stream_type& s, const Handler& handler)
+    {
+      s.async_wait(socket_base::wait_read, handler);
+    }
+
+    template <typename Handler>
+    static void async_wait_write(stream_type& s, const Handler& handler)
+    {
+      s.async_wait(socket_base::wait_write, handler);
+    }
+
+    static void shutdown_send(stream_type& s, asio::error_code& ec)
+    {
+      s.shutdown(socket_base::shutdown_send, ec);
+    }
+  };
+
+#if defined(ASIO_HAS_SPLICE) && defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+  template <typename Executor>
+  struct relay_stream_traits<posix::basic_stream_descriptor<Executor> >
+  {
+    typedef posix::basic_stream_descriptor<Executor> stream_type;
+
+    static int native_handle(stream_type& d)
+    {
+      return d.native_handle();
+    }
+
+    template <typename Handler>
+    static void async_wait_read(stream_type& d, const Handler& handler)
+    {
+      d.async_wait(stream_type::wait_read, handler);
+    }
+
+    template <typename Handler>
+    static void async_wait_write(stream_type& d, const Handler& handler)
+    {
+      d.async_wait(stream_type::wait_write, handler);
+    }
+
+    static void shutdown_send(stream_type&, asio::error_code&)
+    {
+    }
+  };
+#endif // defined(ASIO_HAS_SPLICE) && defined(ASIO_HAS_POSIX_STREAM_DESCRIPTOR)
+
+  template <typename Op>
+  class relay_handler;
+
+  // The state of a relay operation. It is shared by the handlers of the
+  // intermediate operations, as a read and a write may be outstanding at the
+  // same time, and is destroyed when the last of those handlers is destroyed.
+  // As those handlers may run concurrently, access to the state is serialised
+  // by a mutex. The state is allocated using the handler's associated
+  // allocator.
+  template <typename AsyncReadStream, typename AsyncWriteStream,
+      typename RelayHandler>
+  class relay_op
+    : private noncopyable
+  {
+  public:
+    typedef RelayHandler handler_type;
+
+    enum event
+    {
+      splice_start,
+      splice_ready,
+      read_done,
+      write_done
+    };
+
+    // The size of each of the buffers used when copying, and the maximum
+    // number of bytes spliced at a time.
+    enum { buffer_size = 65536 };
+
+    relay_op(AsyncReadStream& source,
+        AsyncWriteStream& sink, RelayHandler& handler)
+      : ref_count_(0),
+        source_(source),
+        sink_(sink),
+        reading_(false),
+        writing_(false),
+        eof_(false),
+        start_(true),
+        read_index_(0),
+        write_index_(0),
+        total_transferred_(0),
+#if defined(ASIO_HAS_SPLICE)
+        source_descriptor_(-1),
+        sink_descriptor_(-1),
+        pipe_size_(0),
+#endif // defined(ASIO_HAS_SPLICE)
+        handler_(ASIO_MOVE_CAST(RelayHandler)(handler))
+    {
+      filled_[0] = filled_[1] = 0;
+#if defined(ASIO_HAS_SPLICE)
+      pipe_[0] = pipe_[1] = -1;
+#endif // defined(ASIO_HAS_SPLICE)
+    }
+
+    ~relay_op()
+    {
+#if defined(ASIO_HAS_SPLICE)
+      close_pipe();
+#endif // defined(ASIO_HAS_SPLICE)
+    }
+
+    // Allocate and construct an operation.
+    static relay_op* create(AsyncReadStream& source,
+        AsyncWriteStream& sink, RelayHandler& handler)
+    {
+      allocator_type a(get_allocator(handler));
+      relay_op* o = a.allocate(1);
+      deallocation_guard guard = { &a, o };
+      new (o) relay_op(source, sink, handler);
+      guard.o_ = 0;
+      return o;
+    }
+
+    // Destroy and deallocate an operation. A local copy of the handler is
+    // made first, as a sub-object of the handler may be the true owner of the
+    // memory.
+    static void destroy(relay_op* o)
+    {
+      RelayHandler handler(ASIO_MOVE_CAST(RelayHandler)(o->handler_));
+      allocator_type a(get_allocator(handler));
+      o->~relay_op();
+      a.deallocate(o, 1);
+    }
+
+    void start()
+    {
+      mutex::scoped_lock lock(mutex_);
+
+#if defined(ASIO_HAS_SPLICE)
+      source_descriptor_ =
+        relay_stream_traits<AsyncReadStream>::native_handle(source_);
+      sink_descriptor_ =
+        relay_stream_traits<AsyncWriteStream>::native_handle(sink_);
+      if (source_descriptor_ != -1 && sink_descriptor_ != -1
+          && ::pipe2(pipe_, O_NONBLOCK | O_CLOEXEC) == 0)
+      {
+        // The splices below must not block. Starting a wait on each stream
+        // ensures that its descriptor has been put into non-blocking mode.
+        relay_stream_traits<AsyncWriteStream>::async_wait_write(sink_,
+            relay_handler<relay_op>(this, splice_start));
+        return;
+      }
+      pipe_[0] = pipe_[1] = -1;
+#endif // defined(ASIO_HAS_SPLICE)
+
+      start_copy(lock, 0);
+    }
+
+    void operator()(event e, const asio::error_code& ec,
+        std::size_t bytes_transferred)
+    {
+      mutex::scoped_lock lock(mutex_);
+
+      start_ = false;
+      switch (e)
+      {
+#if defined(ASIO_HAS_SPLICE)
+      case splice_start:
+        // The wait on the source also waits for the first data to arrive.
+        if (ec)
+          complete(lock, ec);
+        else
+          relay_stream_traits<AsyncReadStream>::async_wait_read(source_,
+              relay_handler<relay_op>(this, splice_ready));
+        return;
+      case splice_ready:
+        if (ec)
+          complete(lock, ec);
+        else
+          splice(lock);
+        return;
+#endif // defined(ASIO_HAS_SPLICE)
+      case read_done:
+        reading_ = false;
+        if (bytes_transferred > 0)
+        {
+          filled_[read_index_] = bytes_transferred;
+          read_index_ ^= 1;
+        }
+        if (ec == asio::error::eof)
+          eof_ = true;
+        else if (ec && !ec_)
+          ec_ = ec;
+        break;
+      case write_done:
+        writing_ = false;
+        total_transferred_ += bytes_transferred;
+        if (ec && !ec_)
+          ec_ = ec;
+        filled_[write_index_] = 0;
+        write_index_ ^= 1;
+        break;
+      default:
+        break;
+      }
+
+      copy(lock);
+    }
+
+    // Copy data through the two buffers. A read into one buffer may be
+    // outstanding while the other buffer is being written.
+    void copy(mutex::scoped_lock& lock)
+    {
+      if (!reading_ && !writing_ && (ec_ || (eof_ && filled_[read_index_] == 0
+              && filled_[write_index_] == 0)))
+      {
+        finish(lock);
+        return;
+      }
+
+      if (!reading_ && !eof_ && !ec_ && filled_[read_index_] == 0)
+      {
+        reading_ = true;
+        source_.async_read_some(
+            asio::buffer(&buffers_[read_index_ * buffer_size], buffer_size),
+            relay_handler<relay_op>(this, read_done));
+      }
+
+      if (!writing_ && !ec_ && filled_[write_index_] > 0)
+      {
+        writing_ = true;
+        asio::async_write(sink_, asio::buffer(
+              &buffers_[write_index_ * buffer_size], filled_[write_index_]),
+            relay_handler<relay_op>(this, write_done));
+      }
+    }
+
+    // Switch to copying, with the first buffer holding the specified number
+    // of bytes that are waiting to be written.
+    void start_copy(mutex::scoped_lock& lock, std::size_t pending)
+    {
+      buffers_.resize(2 * buffer_size);
+      eof_ = false;
+      filled_[0] = pending;
+      read_index_ = pending > 0 ? 1 : 0;
+      copy(lock);
+    }
+
+#if defined(ASIO_HAS_SPLICE)
+    // Move data from the source to the sink through the pipe until both
+    // streams would block. To give other handlers a chance to run, the
+    // operation yields after a fixed number of splices.
+    void splice(mutex::scoped_lock& lock)
+    {
+      for (int i = 0; i < 16; ++i)
+      {
+        if (pipe_size_ == 0)
+        {
+          ssize_t n = ::splice(source_descriptor_, 0, pipe_[1], 0,
+              buffer_size, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+          if (n > 0)
+            pipe_size_ = static_cast<std::size_t>(n);
+          else if (n == 0)
+          {
+            finish(lock);
+            return;
+          }
+          else if (errno == EINTR)
+            continue;
+          else if (errno == EAGAIN || errno == EWOULDBLOCK)
+          {
+            relay_stream_traits<AsyncReadStream>::async_wait_read(source_,
+                relay_handler<relay_op>(this, splice_ready));
+            return;
+          }
+          else if (errno == EINVAL && total_transferred_ == 0)
+          {
+            // The source does not support splicing.
+            close_pipe();
+            start_copy(lock, 0);
+            return;
+          }
+          else
+          {
+            complete(lock, asio::error_code(errno,
+                  asio::error::get_system_category()));
+            return;
+          }
+        }
+
+        ssize_t n = ::splice(pipe_[0], 0, sink_descriptor_, 0,
+            pipe_size_, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        if (n >= 0)
+        {
+          pipe_size_ -= static_cast<std::size_t>(n);
+          total_transferred_ += static_cast<std::size_t>(n);
+        }
+        else if (errno == EINTR)
+          continue;
+        else if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+          relay_stream_traits<AsyncWriteStream>::async_wait_write(sink_,
+              relay_handler<relay_op>(this, splice_ready));
+          return;
+        }
+        else if (errno == EINVAL && total_transferred_ == 0)
+        {
+          // The sink does not support splicing. Recover the data that has
+          // already been moved into the pipe and write it by copying.
+          buffers_.resize(2 * buffer_size);
+          ssize_t bytes = ::read(pipe_[0], &buffers_[0], pipe_size_);
+          close_pipe();
+          start_copy(lock, bytes > 0 ? static_cast<std::size_t>(bytes) : 0);
+          return;
+        }
+        else
+        {
+          complete(lock, asio::error_code(errno,
+                asio::error::get_system_category()));
+          return;
+        }
+      }
+
+      relay_stream_traits<AsyncReadStream>::async_wait_read(source_,
+          relay_handler<relay_op>(this, splice_ready));
+    }
+
+    void close_pipe()
+    {
+      if (pipe_[0] != -1)
+        ::close(pipe_[0]);
+      if (pipe_[1] != -1)
+        ::close(pipe_[1]);
+      pipe_[0] = pipe_[1] = -1;
+    }
+#endif // defined(ASIO_HAS_SPLICE)
+
+    // Propagate the end of file to the sink, if there was no error.
+    void finish(mutex::scoped_lock& lock)
+    {
+      asio::error_code ec = ec_;
+      if (!ec)
+        relay_stream_traits<AsyncWriteStream>::shutdown_send(sink_, ec);
+      complete(lock, ec);
+    }
+
+    // Make the final upcall. No intermediate operations are outstanding, so
+    // the lock is not needed while the handler runs.
+    void complete(mutex::scoped_lock& lock, const asio::error_code& ec)
+    {
+      const std::size_t total_transferred = total_transferred_;
+      lock.unlock();
+      handler_(ec, total_transferred);
+    }
+
+  //private:
+    typedef typename associated_allocator<RelayHandler>::type
+      associated_allocator_type;
+    typedef typename get_hook_allocator<RelayHandler,
+      associated_allocator_type>::type hook_allocator_type;
+    typedef ASIO_REBIND_ALLOC(hook_allocator_type, relay_op) allocator_type;
+
+    static allocator_type get_allocator(RelayHandler& handler)
+    {
+      return allocator_type(
+          get_hook_allocator<RelayHandler, associated_allocator_type>::get(
+            handler, asio::get_associated_allocator(handler)));
+    }
+
+    // Deallocates the memory if the operation's constructor throws.
+    struct deallocation_guard
+    {
+      allocator_type* a_;
+      relay_op* o_;
+
+      ~deallocation_guard()
+      {
+        if (o_)
+          a_->deallocate(o_, 1);
+      }
+    };
+
+    atomic_count ref_count_;
+    mutex mutex_;
+    AsyncReadStream& source_;
+    AsyncWriteStream& sink_;
+    std::vector<char> buffers_;
+    std::size_t filled_[2];
+    bool reading_;
+    bool writing_;
+    bool eof_;
+    bool start_;
+    int read_index_;
+    int write_index_;
+    std::size_t total_transferred_;
+    asio::error_code ec_;
+#if defined(ASIO_HAS_SPLICE)
+    int source_descriptor_;
+    int sink_descriptor_;
+    int pipe_[2];
+    std::size_t pipe_size_;
+#endif // defined(ASIO_HAS_SPLICE)
+    RelayHandler handler_;
+  };
+
+  // The handler for a relay operation's intermediate operations. Holds a
+  // counted reference to the shared operation state.
+  template <typename Op>
+  class relay_handler
+  {
+  public:
+    relay_handler(Op* op, typename Op::event e)
+      : op_(op),
+        event_(e)
+    {
+      ref_count_up(op_->ref_count_);
+    }
+
+    relay_handler(const relay_handler& other)
+      : op_(other.op_),
+        event_(other.event_)
+    {
+      ref_count_up(op_->ref_count_);
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    relay_handler(relay_handler&& other)
+      : op_(other.op_),
+        event_(other.event_)
+    {
+      other.op_ = 0;
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    ~relay_handler()
+    {
+      if (op_ && ref_count_down(op_->ref_count_))
+        Op::destroy(op_);
+    }
+
+    void operator()(const asio::error_code& ec)
+    {
+      (*op_)(event_, ec, 0);
+    }
+
+    void operator()(const asio::error_code& ec,
+        std::size_t bytes_transferred)
+    {
+      (*op_)(event_, ec, bytes_transferred);
+    }
+
+  //private:
+    Op* op_;
+    typename Op::event event_;
+
+  private:
+    relay_handler& operator=(const relay_handler&);
+  };
+
+  template <typename Op>
+  inline asio_handler_allocate_is_deprecated
+  asio_handler_allocate(std::size_t size,
+      relay_handler<Op>* this_handler)
+  {
+#if defined(ASIO_NO_DEPRECATED)
+    asio_handler_alloc_helpers::allocate(size, this_handler->op_->handler_);
+    return asio_handler_allocate_is_no_longer_used();
+#else // defined(ASIO_NO_DEPRECATED)
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->op_->handler_);
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Op>
+  inline asio_handler_deallocate_is_deprecated
+  asio_handler_deallocate(void* pointer, std::size_t size,
+      relay_handler<Op>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->op_->handler_);
+#if defined(ASIO_NO_DEPRECATED)
+    return asio_handler_deallocate_is_no_longer_used();
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Op>
+  inline bool asio_handler_is_continuation(
+      relay_handler<Op>* this_handler)
+  {
+    return this_handler->op_->start_ ? false
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->op_->handler_);
+  }
+
+  template <typename Function, typename Op>
+  inline asio_handler_invoke_is_deprecated
+  asio_handler_invoke(Function& function,
+      relay_handler<Op>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->op_->handler_);
+#if defined(ASIO_NO_DEPRECATED)
+    return asio_handler_invoke_is_no_longer_used();
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Function, typename Op>
+  inline asio_handler_invoke_is_deprecated
+  asio_handler_invoke(const Function& function,
+      relay_handler<Op>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->op_->handler_);
+#if defined(ASIO_NO_DEPRECATED)
+    return asio_handler_invoke_is_no_longer_used();
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename AsyncReadStream>
+  class initiate_async_relay
+  {
+  public:
+    typedef typename AsyncReadStream::executor_type executor_type;
+
+    explicit initiate_async_relay(AsyncReadStream& source)
+      : source_(source)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return source_.get_executor();
+    }
+
+    template <typename RelayHandler, typename AsyncWriteStream>
+    void operator()(ASIO_MOVE_ARG(RelayHandler) handler,
+        AsyncWriteStream* sink) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(RelayHandler, handler) type_check;
+
+      non_const_lvalue<RelayHandler> handler2(handler);
+      typedef relay_op<AsyncReadStream, AsyncWriteStream,
+        typename decay<RelayHandler>::type> op;
+      op* o = op::create(source_, *sink, handler2.value);
+
+      // The operation is owned by the handlers of its intermediate operations,
+      // the first of which is created by start(). A reference is held until
+      // start() returns, so that the operation is destroyed if it fails.
+      relay_handler<op> owner(o, op::read_done);
+      o->start();
+    }
+
+  private:
+    AsyncReadStream& source_;
+  };
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename Op, typename Allocator>
+struct associated_allocator<detail::relay_handler<Op>, Allocator>
+{
+  typedef typename associated_allocator<
+    typename Op::handler_type, Allocator>::type type;
+
+  static type get(const detail::relay_handler<Op>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<typename Op::handler_type,
+      Allocator>::get(h.op_->handler_, a);
+  }
+};
+
+template <typename Op, typename Executor>
+struct associated_executor<detail::relay_handler<Op>, Executor>
+{
+  typedef typename associated_executor<
+    typename Op::handler_type, Executor>::type type;
+
+  static type get(const detail::relay_handler<Op>& h,
+      const Executor& ex = Executor()) ASIO_NOEXCEPT
+  {
+    return associated_executor<typename Op::handler_type,
+      Executor>::get(h.op_->handler_, ex);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+template <typename AsyncReadStream, typename AsyncWriteStream,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) RelayHandler>
+inline ASIO_INITFN_AUTO_RESULT_TYPE(RelayHandler,
+    void (asio::error_code, std::size_t))
+async_relay(AsyncReadStream& source, AsyncWriteStream& sink,
+    ASIO_MOVE_ARG(RelayHandler) handler)
+{
+  return async_initiate<RelayHandler,
+    void (asio::error_code, std::size_t)>(
+      detail::initiate_async_relay<AsyncReadStream>(source),
+      handler, &sink);
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_RELAY_HPP
@@ -0,0 +1,435 @@
+//
+// impl/write_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_WRITE_QUEUE_HPP
+#define ASIO_IMPL_WRITE_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/socket_types.hpp"
+#include "asio/socket_base.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A buffer sequence that refers to the buffers gathered by a write_queue.
+class write_queue_buffers
+{
+public:
+  typedef const_buffer value_type;
+  typedef const const_buffer* const_iterator;
+
+  write_queue_buffers(const const_buffer* buffers, std::size_t count)
+    : begin_(buffers),
+      end_(buffers + count)
+  {
+  }
+
+  const_iterator begin() const
+  {
+    return begin_;
+  }
+
+  const_iterator end() const
+  {
+    return end_;
+  }
+
+private:
+  const const_buffer* begin_;
+  const const_buffer* end_;
+};
+
+// Base class for the writes queued by a write_queue.
+class write_queue_op
+{
+public:
+  // Gather the write's data, starting at the specified offset, into at most
+  // max_count buffers. Returns the number of buffers used.
+  std::size_t gather(std::size_t offset,
+      const_buffer* buffers, std::size_t max_count)
+  {
+    return gather_func_(this, offset, buffers, max_count);
+  }
+
+  // Invoke the handler with the stored result.
+  void complete()
+  {
+    complete_func_(this, true);
+  }
+
+  // Destroy the write without invoking the handler.
+  void destroy()
+  {
+    complete_func_(this, false);
+  }
+
+protected:
+  typedef std::size_t (*gather_func_type)(write_queue_op*,
+      std::size_t, const_buffer*, std::size_t);
+  typedef void (*complete_func_type)(write_queue_op*, bool);
+
+  write_queue_op(gather_func_type gather_func,
+      complete_func_type complete_func, std::size_t size)
+    : next_(0),
+      size_(size),
+      bytes_transferred_(0),
+      gather_func_(gather_func),
+      complete_func_(complete_func)
+  {
+  }
+
+  // Prevents deletion through this type.
+  ~write_queue_op()
+  {
+  }
+
+private:
+  template <typename> friend class asio::write_queue;
+  friend struct write_queue_op_list;
+
+  write_queue_op* next_;
+  std::size_t size_;
+
+protected:
+  asio::error_code ec_;
+  std::size_t bytes_transferred_;
+
+private:
+  gather_func_type gather_func_;
+  complete_func_type complete_func_;
+};
+
+// A list of writes that are ready to complete. Any writes that remain in the
+// list when it is destroyed, such as when a handler throws, are destroyed.
+struct write_queue_op_list
+{
+  write_queue_op* head_;
+  write_queue_op** tail_;
+
+  write_queue_op_list()
+    : head_(0),
+      tail_(&head_)
+  {
+  }
+
+  ~write_queue_op_list()
+  {
+    while (write_queue_op* op = pop())
+      op->destroy();
+  }
+
+  void push(write_queue_op* op)
+  {
+    op->next_ = 0;
+    *tail_ = op;
+    tail_ = &op->next_;
+  }
+
+  write_queue_op* pop()
+  {
+    write_queue_op* op = head_;
+    if (op)
+    {
+      head_ = op->next_;
+      if (!head_)
+        tail_ = &head_;
+    }
+    return op;
+  }
+};
+
+// Copy the buffers that follow the specified offset into an array.
+template <typename Iterator>
+std::size_t write_queue_gather(Iterator begin, Iterator end,
+    std::size_t offset, const_buffer* buffers, std::size_t max_count)
+{
+  std::size_t count = 0;
+  for (Iterator iter = begin; iter != end && count < max_count; ++iter)
+  {
+    const_buffer buffer(*iter);
+    if (offset >= buffer.size())
+    {
+      offset -= buffer.size();
+      continue;
+    }
+    buffers[count++] = buffer + offset;
+    offset = 0;
+  }
+  return count;
+}
+
+template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+class write_queue_handler_op : public write_queue_op
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(write_queue_handler_op);
+
+  write_queue_handler_op(const ConstBufferSequence& buffers,
+      Handler& handler, const IoExecutor& io_ex)
+    : write_queue_op(&write_queue_handler_op::do_gather,
+        &write_queue_handler_op::do_complete, asio::buffer_size(buffers)),
+      buffers_(buffers),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      io_executor_(io_ex)
+  {
+    handler_work<Handler, IoExecutor>::start(handler_, io_executor_);
+  }
+
+  static std::size_t do_gather(write_queue_op* base, std::size_t offset,
+      const_buffer* buffers, std::size_t max_count)
+  {
+    write_queue_handler_op* o(static_cast<write_queue_handler_op*>(base));
+    return write_queue_gather(asio::buffer_sequence_begin(o->buffers_),
+        asio::buffer_sequence_end(o->buffers_), offset, buffers, max_count);
+  }
+
+  static void do_complete(write_queue_op* base, bool invoke)
+  {
+    // Take ownership of the handler object.
+    write_queue_handler_op* o(static_cast<write_queue_handler_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+    handler_work<Handler, IoExecutor> w(o->handler_, o->io_executor_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made.
+    detail::binder2<Handler, asio::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (invoke)
+    {
+      fenced_block b(fenced_block::half);
+      w.complete(handler, handler.handler_);
+    }
+  }
+
+private:
+  ConstBufferSequence buffers_;
+  Handler handler_;
+  IoExecutor io_executor_;
+};
+
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename Stream>
+class write_queue<Stream>::initiate_async_write
+{
+public:
+  typedef typename write_queue<Stream>::executor_type executor_type;
+
+  explicit initiate_async_write(write_queue* self)
+    : self_(self)
+  {
+  }
+
+  executor_type get_executor() const ASIO_NOEXCEPT
+  {
+    return self_->get_executor();
+  }
+
+  template <typename WriteHandler, typename ConstBufferSequence>
+  void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+      const ConstBufferSequence& buffers) const
+  {
+    // If you get an error on the following line it means that your handler
+    // does not meet the documented type requirements for a WriteHandler.
+    ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    detail::non_const_lvalue<WriteHandler> handler2(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef detail::write_queue_handler_op<ConstBufferSequence,
+        typename decay<WriteHandler>::type, executor_type> op;
+    typename op::ptr p = { asio::detail::addressof(handler2.value),
+      op::ptr::allocate(handler2.value), 0 };
+    p.p = new (p.v) op(buffers, handler2.value, self_->get_executor());
+
+    self_->enqueue(p.p);
+    p.v = p.p = 0;
+  }
+
+private:
+  write_queue* self_;
+};
+
+template <typename Stream>
+class write_queue<Stream>::send_handler
+{
+public:
+  explicit send_handler(write_queue* self)
+    : self_(self)
+  {
+  }
+
+  void operator()(const asio::error_code& ec,
+      std::size_t bytes_transferred)
+  {
+    self_->handle_send(ec, bytes_transferred);
+  }
+
+private:
+  write_queue* self_;
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+template <typename Stream>
+write_queue<Stream>::~write_queue()
+{
+  while (detail::write_queue_op* op = head_)
+  {
+    head_ = op->next_;
+    op->destroy();
+  }
+}
+
+template <typename Stream>
+template <typename ConstBufferSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteHandler>
+inline ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+    void (asio::error_code, std::size_t))
+write_queue<Stream>::async_write(const ConstBufferSequence& buffers,
+    ASIO_MOVE_ARG(WriteHandler) handler)
+{
+  return async_initiate<WriteHandler,
+    void (asio::error_code, std::size_t)>(
+      initiate_async_write(this), handler, buffers);
+}
+
+template <typename Stream>
+void write_queue<Stream>::enqueue(detail::write_queue_op* op)
+{
+  op->next_ = 0;
+  if (tail_)
+    tail_->next_ = op;
+  else
+    head_ = op;
+  tail_ = op;
+  ++pending_writes_;
+
+  if (!sending_)
+    start_send();
+}
+
+template <typename Stream>
+void write_queue<Stream>::start_send()
+{
+  const std::size_t max_count = max_send_buffers;
+
+  std::size_t count = 0;
+  std::size_t offset = head_offset_;
+  socket_base::message_flags flags = 0;
+  for (detail::write_queue_op* op = head_; op; op = op->next_)
+  {
+    std::size_t start = count;
+    count += op->gather(offset, buffers_ + count, max_count - count);
+
+    std::size_t gathered = 0;
+    for (std::size_t i = start; i < count; ++i)
+      gathered += buffers_[i].size();
+
+    if (gathered < op->size_ - offset || count == max_count)
+    {
+#if defined(MSG_MORE)
+      // Tell the kernel that more data will follow immediately, so that it
+      // may coalesce this send with the next.
+      for (detail::write_queue_op* next = op; next; next = next->next_)
+      {
+        if (next->size_ > (next == op ? offset + gathered : 0))
+        {
+          flags |= MSG_MORE;
+          break;
+        }
+      }
+#endif // defined(MSG_MORE)
+      break;
+    }
+
+    offset = 0;
+  }
+
+  sending_ = true;
+  next_layer_.async_send(detail::write_queue_buffers(buffers_, count),
+      flags, send_handler(this));
+}
+
+template <typename Stream>
+void write_queue<Stream>::handle_send(const asio::error_code& ec,
+    std::size_t bytes_transferred)
+{
+  detail::write_queue_op_list completed;
+
+  // Complete the writes that have been sent in full.
+  while (head_ && head_->size_ - head_offset_ <= bytes_transferred)
+  {
+    detail::write_queue_op* op = head_;
+    bytes_transferred -= op->size_ - head_offset_;
+    head_ = op->next_;
+    if (!head_)
+      tail_ = 0;
+    head_offset_ = 0;
+    --pending_writes_;
+
+    op->ec_ = asio::error_code();
+    op->bytes_transferred_ = op->size_;
+    completed.push(op);
+  }
+  head_offset_ += bytes_transferred;
+
+  if (ec)
+  {
+    // A failed send fails all of the queued writes.
+    while (detail::write_queue_op* op = head_)
+    {
+      head_ = op->next_;
+      op->ec_ = ec;
+      op->bytes_transferred_ = head_offset_;
+      head_offset_ = 0;
+      completed.push(op);
+    }
+    tail_ = 0;
+    pending_writes_ = 0;
+    sending_ = false;
+  }
+  else if (head_)
+  {
+    // Start the next send before making the upcalls, so that any writes the
+    // handlers start are queued behind it.
+    start_send();
+  }
+  else
+    sending_ = false;
+
+  while (detail::write_queue_op* op = completed.pop())
+    op->complete();
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_WRITE_QUEUE_HPP
@@ -0,0 +1,208 @@
+//
+// incoming_cpu_dispatcher.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_INCOMING_CPU_DISPATCHER_HPP
+#define ASIO_INCOMING_CPU_DISPATCHER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include "asio/error_code.hpp"
+#include "asio/socket_base.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/detail/socket_types.hpp"
+#include "asio/detail/throw_exception.hpp"
+
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT)
+# include "asio/detail/reactive_socket_multishot_accept_op.hpp"
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Selects an I/O executor for each accepted socket according to the CPU on
+/// which the socket's packets are received.
+/**
+ * In a deployment where each CPU runs its own @c io_context, and the kernel
+ * steers each flow's packets to a CPU (for example, using RSS or RPS), a
+ * connection is best serviced by the @c io_context running on that CPU. The
+ * incoming_cpu_dispatcher class maps CPU numbers to executors, and uses the
+ * socket_base::incoming_cpu socket option to find the executor for a socket.
+ * Sockets for which the CPU is unknown, or has not been mapped, use the
+ * default executor.
+ *
+ * The dispatcher may be passed to basic_socket_acceptor::async_multishot_accept
+ * so that each native socket is assigned directly to a socket object that
+ * uses the selected executor, and is registered only with the corresponding
+ * @c io_context.
+ *
+ * Pinning the threads that run each @c io_context to the corresponding CPU
+ * is the responsibility of the application.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * asio::io_context contexts[2];
+ * asio::incoming_cpu_dispatcher<asio::io_context::executor_type>
+ *   dispatcher(contexts[0].get_executor());
+ * dispatcher.add(0, contexts[0].get_executor());
+ * dispatcher.add(1, contexts[1].get_executor());
+ * ...
+ * acceptor.async_multishot_accept(dispatcher, accept_handler);
+ * @endcode
+ */
+template <typename Executor>
+class incoming_cpu_dispatcher
+{
+public:
+  /// The type of the executors to which sockets are dispatched.
+  typedef Executor executor_type;
+
+  /// Construct a dispatcher with the specified default executor.
+  explicit incoming_cpu_dispatcher(const executor_type& default_ex)
+    : default_executor_(default_ex)
+  {
+  }
+
+  /// Map a CPU to an executor.
+  /**
+   * @param cpu The CPU number, as reported by the socket_base::incoming_cpu
+   * socket option.
+   *
+   * @param ex The executor to be used for sockets received on that CPU. Any
+   * previous mapping for the CPU is replaced.
+   *
+   * @throws std::out_of_range Thrown if @c cpu is negative.
+   */
+  void add(int cpu, const executor_type& ex)
+  {
+    if (cpu < 0)
+    {
+      std::out_of_range ex_cpu("incoming_cpu_dispatcher cpu");
+      asio::detail::throw_exception(ex_cpu);
+    }
+
+    std::size_t index = static_cast<std::size_t>(cpu);
+    if (index >= executor_index_.size())
+      executor_index_.resize(index + 1, no_executor);
+
+    // Executors are not required to be assignable, so each distinct executor
+    // is stored once and shared by all the CPUs that map to it. This keeps
+    // the list bounded when CPUs are remapped.
+    std::size_t slot = 0;
+    while (slot < executors_.size() && !(executors_[slot] == ex))
+      ++slot;
+    if (slot == executors_.size())
+      executors_.push_back(ex);
+    executor_index_[index] = slot;
+  }
+
+  /// Get the default executor.
+  executor_type get_default_executor() const ASIO_NOEXCEPT
+  {
+    return default_executor_;
+  }
+
+  /// Get the executor mapped to a CPU.
+  /**
+   * @returns The executor mapped to @c cpu, or the default executor if there
+   * is no such mapping.
+   */
+  executor_type get_executor(int cpu) const ASIO_NOEXCEPT
+  {
+    if (cpu >= 0 && static_cast<std::size_t>(cpu) < executor_index_.size())
+    {
+      std::size_t index = executor_index_[cpu];
+      if (index != no_executor)
+        return executors_[index];
+    }
+    return default_executor_;
+  }
+
+  /// Select the executor for a socket.
+  /**
+   * @returns The executor mapped to the CPU on which the socket's packets are
+   * received, or the default executor if that CPU cannot be determined.
+   */
+  template <typename Socket>
+  executor_type select(Socket& s) const
+  {
+    socket_base::incoming_cpu option;
+    asio::error_code ec;
+    s.get_option(option, ec);
+    return get_executor(ec ? -1 : option.value());
+  }
+
+  /// Select the executor for a native socket.
+  template <typename Protocol>
+  executor_type select(const Protocol& protocol,
+      asio::detail::socket_type s) const
+  {
+    socket_base::incoming_cpu option;
+    asio::error_code ec;
+    std::size_t size = option.size(protocol);
+    asio::detail::socket_ops::getsockopt(s, 0,
+        option.level(protocol), option.name(protocol),
+        option.data(protocol), &size, ec);
+    return get_executor(ec ? -1 : option.value());
+  }
+
+private:
+  // Marks a CPU that has no executor.
+  static const std::size_t no_executor = ~static_cast<std::size_t>(0);
+
+  // The executor used when no mapping applies.
+  executor_type default_executor_;
+
+  // The distinct mapped executors.
+  std::vector<executor_type> executors_;
+
+  // The index into executors_ for each CPU.
+  std::vector<std::size_t> executor_index_;
+};
+
+template <typename Executor>
+const std::size_t incoming_cpu_dispatcher<Executor>::no_executor;
+
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT)
+namespace detail {
+
+template <typename Executor>
+struct multishot_accept_peer_executor<incoming_cpu_dispatcher<Executor> >
+{
+  typedef Executor type;
+
+  template <typename Protocol>
+  static type get(const incoming_cpu_dispatcher<Executor>& d,
+      const Protocol& protocol, socket_type s)
+  {
+    if (s == invalid_socket)
+      return d.get_default_executor();
+    return d.select(protocol, s);
+  }
+};
+
+} // namespace detail
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_INCOMING_CPU_DISPATCHER_HPP
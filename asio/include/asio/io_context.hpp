@@ -20,6 +20,7 @@
 #include <stdexcept>
 #include <typeinfo>
 #include "asio/async_result.hpp"
+#include "asio/detail/memory_resource.hpp"
 #include "asio/detail/wrapped_handler.hpp"
 #include "asio/error_code.hpp"
 #include "asio/execution_context.hpp"
@@ -213,6 +214,37 @@ public:
    */
   ASIO_DECL explicit io_context(int concurrency_hint);
 
+#if defined(ASIO_HAS_STD_MEMORY_RESOURCE) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Constructor.
+  /**
+   * Construct with a memory resource to be used for the io_context's internal
+   * allocations. This includes the memory used for asynchronous operations
+   * and for functions submitted through the io_context's executor, when these
+   * are allocated by a thread that is running the io_context, as well as
+   * per-descriptor reactor state, timer queues and strand implementations.
+   *
+   * @param resource The memory resource to use. The resource must outlive the
+   * io_context object and any handlers associated with it.
+   */
+  ASIO_DECL explicit io_context(std::pmr::memory_resource* resource);
+
+  /// Constructor.
+  /**
+   * Construct with a hint about the required level of concurrency and a
+   * memory resource to be used for the io_context's internal allocations.
+   *
+   * @param concurrency_hint A suggestion to the implementation on how many
+   * threads it should allow to run simultaneously.
+   *
+   * @param resource The memory resource to use. The resource must outlive the
+   * io_context object and any handlers associated with it.
+   */
+  ASIO_DECL io_context(int concurrency_hint,
+      std::pmr::memory_resource* resource);
+#endif // defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Destructor.
   /**
    * On destruction, the io_context performs the following sequence of
@@ -250,6 +282,18 @@ public:
   /// Obtains the executor associated with the io_context.
   executor_type get_executor() ASIO_NOEXCEPT;
 
+#if defined(ASIO_HAS_STD_MEMORY_RESOURCE) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Obtains the memory resource used for internal allocations.
+  /**
+   * @returns The memory resource specified on construction, or a null pointer
+   * if the io_context uses the default allocation functions.
+   */
+  ASIO_DECL std::pmr::memory_resource* get_memory_resource() const
+    ASIO_NOEXCEPT;
+#endif // defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Run the io_context object's event processing loop.
   /**
    * The run() function blocks until all work has finished and there are no
@@ -493,6 +537,105 @@ public:
    */
   ASIO_DECL void restart();
 
+  /// Reserve capacity in the io_context's internal data structures.
+  /**
+   * This function is used to preallocate the internal state needed to
+   * support the specified number of concurrently open sockets and
+   * descriptors, and of concurrently pending timers per timer type, so that
+   * this memory is not allocated while the program is servicing a burst of
+   * activity. The reserved capacity is retained by subsequent calls to
+   * trim().
+   *
+   * @param descriptors The number of sockets and descriptors for which to
+   * reserve state.
+   *
+   * @param timers The number of pending waits to reserve space for in the
+   * queue of each timer type used with the io_context.
+   *
+   * @throws std::bad_alloc Thrown if memory cannot be allocated.
+   *
+   * @note Memory for asynchronous operations is cached per thread while
+   * run(), run_one(), poll() or poll_one() is executing, and is not affected
+   * by this function. To preallocate operation memory, construct the
+   * io_context with a pooling @c std::pmr::memory_resource.
+   */
+  ASIO_DECL void reserve(std::size_t descriptors, std::size_t timers);
+
+  /// Release memory held by the io_context for reuse.
+  /**
+   * This function releases memory that the io_context retains for reuse but
+   * does not currently need, beyond any capacity requested by reserve(). This
+   * includes space in the timer queues, and the memory cached by the calling
+   * thread if it is running the io_context.
+   *
+   * The state associated with closed sockets and descriptors can only be
+   * released when no other thread is running the io_context. If some other
+   * thread is executing run(), run_one(), poll() or poll_one(), this state is
+   * retained.
+   */
+  ASIO_DECL void trim();
+
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Categories of the io_context's internal allocations.
+  enum allocation_category
+  {
+    /// Asynchronous operations on sockets and descriptors.
+    reactor_operations,
+
+    /// Asynchronous waits on timers.
+    timer_operations,
+
+    /// The state of strands created by asio::make_strand().
+    strand_state,
+
+    /// Frames of coroutines launched by asio::co_spawn().
+    coroutine_frames,
+
+    /// Asynchronous host name resolution.
+    resolver_operations,
+
+    /// Other pending handlers and function objects.
+    other_operations,
+
+    /// Reactor state for open sockets and descriptors, including state that
+    /// is retained for reuse.
+    pooled_objects,
+
+    /// Memory retained for reuse by the threads running the io_context.
+    cached_memory
+  };
+
+  /// Statistics describing one category of internal allocation.
+  struct allocation_statistics
+  {
+    /// The number of live allocations.
+    std::size_t count;
+
+    /// The number of bytes in live allocations.
+    std::size_t bytes;
+
+    /// The highest number of live allocations.
+    std::size_t peak_count;
+
+    /// The highest number of bytes in live allocations.
+    std::size_t peak_bytes;
+  };
+
+  /// Obtain statistics for a category of internal allocation.
+  /**
+   * This function is available when the program is compiled with
+   * @c ASIO_ENABLE_ALLOCATION_ACCOUNTING defined.
+   *
+   * Operations, coroutine frames and cached memory are recorded against the
+   * io_context being run by the thread that allocates them. Allocations made
+   * by a thread that is not running an io_context are not recorded.
+   */
+  ASIO_DECL allocation_statistics get_allocation_statistics(
+      allocation_category category) const;
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+       //   || defined(GENERATING_DOCUMENTATION)
+
 #if !defined(ASIO_NO_DEPRECATED)
   /// (Deprecated: Use restart().) Reset the io_context in preparation for a
   /// subsequent run() invocation.
@@ -604,6 +747,12 @@ private:
   // Helper function to add the implementation.
   ASIO_DECL impl_type& add_impl(impl_type* impl);
 
+#if defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+  // Helper function to add the memory resource and then the implementation.
+  ASIO_DECL impl_type& add_impl(std::pmr::memory_resource* resource,
+      int concurrency_hint);
+#endif // defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+
   // Backwards compatible overload for use with services derived from
   // io_context::service.
   template <typename Service>
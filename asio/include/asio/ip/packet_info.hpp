@@ -0,0 +1,75 @@
+//
+// ip/packet_info.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IP_PACKET_INFO_HPP
+#define ASIO_IP_PACKET_INFO_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/socket_option.hpp"
+#include "asio/ip/detail/socket_option.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace ip {
+
+/// Socket option to report the destination address and arriving interface of
+/// each received packet.
+/**
+ * Implements the IPPROTO_IP/IP_PKTINFO and IPPROTO_IPV6/IPV6_RECVPKTINFO
+ * socket options. The information is obtained using
+ * basic_datagram_socket::async_receive_with_metadata() or
+ * basic_datagram_socket::async_receive_from_with_metadata(). On platforms that
+ * do not support these options, getting or setting them fails with
+ * asio::error::invalid_argument.
+ *
+ * @par Examples
+ * Setting the option:
+ * @code
+ * asio::ip::udp::socket socket(my_context);
+ * ...
+ * asio::ip::packet_info option(true);
+ * socket.set_option(option);
+ * @endcode
+ *
+ * @par
+ * Getting the current option value:
+ * @code
+ * asio::ip::udp::socket socket(my_context);
+ * ...
+ * asio::ip::packet_info option;
+ * socket.get_option(option);
+ * bool is_set = option.value();
+ * @endcode
+ *
+ * @par Concepts:
+ * GettableSocketOption, SettableSocketOption.
+ */
+#if defined(GENERATING_DOCUMENTATION)
+typedef implementation_defined packet_info;
+#elif defined(IP_PKTINFO) && defined(IPV6_RECVPKTINFO)
+typedef asio::ip::detail::socket_option::family_boolean<
+    IPPROTO_IP, IP_PKTINFO, IPPROTO_IPV6, IPV6_RECVPKTINFO> packet_info;
+#else
+typedef asio::detail::socket_option::boolean<
+    asio::detail::custom_socket_option_level,
+    asio::detail::always_fail_option> packet_info;
+#endif
+
+} // namespace ip
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IP_PACKET_INFO_HPP
@@ -125,6 +125,39 @@ public:
     ASIO_OS_DEF(IPPROTO_TCP), ASIO_OS_DEF(TCP_NODELAY)> no_delay;
 #endif
 
+  /// Socket option for the length of an acceptor's TCP Fast Open queue.
+  /**
+   * Implements the IPPROTO_TCP/TCP_FASTOPEN socket option. When set to a
+   * non-zero value on an acceptor before it starts listening, clients that
+   * present a valid Fast Open cookie may send data with their connection
+   * request, and that data is available to read as soon as the connection is
+   * accepted. The value limits the number of such connections that may be
+   * pending at one time. On platforms that do not support this option,
+   * getting or setting it fails with asio::error::invalid_argument.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * asio::ip::tcp::fast_open option(16);
+   * acceptor.set_option(option);
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined fast_open;
+#elif defined(ASIO_HAS_TCP_FAST_OPEN)
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(IPPROTO_TCP), TCP_FASTOPEN> fast_open;
+#else
+  typedef asio::detail::socket_option::integer<
+    asio::detail::custom_socket_option_level,
+    asio::detail::always_fail_option> fast_open;
+#endif
+
   /// Compare two protocols for equality.
   friend bool operator==(const tcp& p1, const tcp& p2)
   {
@@ -17,6 +17,7 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/basic_datagram_socket.hpp"
+#include "asio/detail/socket_option.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/ip/basic_endpoint.hpp"
 #include "asio/ip/basic_resolver.hpp"
@@ -81,6 +82,70 @@ public:
   /// The UDP resolver type.
   typedef basic_resolver<udp> resolver;
 
+  /// Socket option for the size of the segments sent by UDP segmentation
+  /// offload.
+  /**
+   * Implements the IPPROTO_UDP/UDP_SEGMENT socket option. When set to a
+   * non-zero value, each send of a buffer larger than the segment size is
+   * split by the kernel into datagrams of that size, the last of which may be
+   * shorter. On platforms that do not support this option, getting or setting
+   * it fails with asio::error::invalid_argument.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::segment_size option(1200);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined segment_size;
+#elif defined(ASIO_HAS_UDP_GSO)
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(IPPROTO_UDP), UDP_SEGMENT> segment_size;
+#else
+  typedef asio::detail::socket_option::integer<
+    asio::detail::custom_socket_option_level,
+    asio::detail::always_fail_option> segment_size;
+#endif
+
+  /// Socket option to enable coalescing of received datagrams.
+  /**
+   * Implements the IPPROTO_UDP/UDP_GRO socket option. When enabled, the
+   * kernel may deliver several datagrams from the same sender as a single
+   * buffer. Use basic_datagram_socket::async_receive_from_coalesced() to
+   * obtain the size of the individual datagrams. On platforms that do not
+   * support this option, getting or setting it fails with
+   * asio::error::invalid_argument.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::ip::udp::gro option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined gro;
+#elif defined(ASIO_HAS_UDP_GSO)
+  typedef asio::detail::socket_option::boolean<
+    ASIO_OS_DEF(IPPROTO_UDP), UDP_GRO> gro;
+#else
+  typedef asio::detail::socket_option::boolean<
+    asio::detail::custom_socket_option_level,
+    asio::detail::always_fail_option> gro;
+#endif
+
   /// Compare two protocols for equality.
   friend bool operator==(const udp& p1, const udp& p2)
   {
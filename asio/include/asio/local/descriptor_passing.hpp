@@ -0,0 +1,243 @@
+//
+// local/descriptor_passing.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_LOCAL_DESCRIPTOR_PASSING_HPP
+#define ASIO_LOCAL_DESCRIPTOR_PASSING_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/basic_socket.hpp"
+#include "asio/basic_stream_socket.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace local {
+
+/// The maximum number of descriptors that may be passed by a single
+/// operation.
+const std::size_t max_passed_descriptors = 64;
+
+/**
+ * @defgroup async_send_descriptors asio::local::async_send_descriptors
+ *
+ * @brief The @c async_send_descriptors function starts an asynchronous
+ * operation to send data and file descriptors on a UNIX domain stream socket.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to send data and file descriptors.
+/**
+ * This function is used to asynchronously send data on a UNIX domain stream
+ * socket, together with a set of file descriptors that are passed to the peer
+ * as @c SCM_RIGHTS ancillary data. The function call always returns
+ * immediately.
+ *
+ * The receiving process obtains its own duplicates of the descriptors, which
+ * refer to the same open file descriptions. The caller retains ownership of
+ * the descriptors it passes, and may close them once the operation completes.
+ *
+ * @param s The socket on which the data and descriptors are to be sent.
+ *
+ * @param buffers One or more data buffers to be sent on the socket. If any
+ * descriptors are passed, the buffers must not be empty. Although the buffers
+ * object may be copied as necessary, ownership of the underlying memory blocks
+ * is retained by the caller, which must guarantee that they remain valid until
+ * the handler is called.
+ *
+ * @param descriptors A pointer to an array of file descriptors to be passed.
+ * The array must remain valid until the handler is called.
+ *
+ * @param count The number of descriptors in the array. It must not exceed
+ * max_passed_descriptors.
+ *
+ * @param handler The handler to be called when the send operation completes.
+ * Copies will be made of the handler as required. The function signature of
+ * the handler must be:
+ * @code void handler(
+ *   const asio::error_code& error, // Result of operation.
+ *   std::size_t bytes_transferred           // Number of bytes sent.
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. On
+ * immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ *
+ * @note As with the socket's async_send function, the operation may not
+ * transmit all of the data. The descriptors are attached to the first byte
+ * sent, so the remainder may be written using asio::async_write.
+ *
+ * @par Example
+ * To hand an accepted connection to a worker process:
+ * @code
+ * int fd = connection.native_handle();
+ * asio::local::async_send_descriptors(worker, asio::buffer("c", 1),
+ *     &fd, 1, handler);
+ * @endcode
+ */
+template <typename Protocol, typename Executor, typename ConstBufferSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteHandler
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(Executor)>
+ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+    void (asio::error_code, std::size_t))
+async_send_descriptors(basic_stream_socket<Protocol, Executor>& s,
+    const ConstBufferSequence& buffers, const int* descriptors,
+    std::size_t count, ASIO_MOVE_ARG(WriteHandler) handler
+      ASIO_DEFAULT_COMPLETION_TOKEN(Executor));
+
+/*@}*/
+
+/**
+ * @defgroup async_receive_descriptors asio::local::async_receive_descriptors
+ *
+ * @brief The @c async_receive_descriptors function starts an asynchronous
+ * operation to receive data and file descriptors on a UNIX domain stream
+ * socket.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to receive data and file descriptors.
+/**
+ * This function is used to asynchronously receive data on a UNIX domain
+ * stream socket, together with any file descriptors passed by the peer. The
+ * function call always returns immediately.
+ *
+ * Ownership of the received descriptors passes to the caller. Where it is
+ * supported, the descriptors are created with the close-on-exec flag set.
+ * Descriptors in excess of @c max_descriptors are closed.
+ *
+ * @param s The socket on which the data and descriptors are to be received.
+ *
+ * @param buffers One or more buffers into which the data will be received.
+ * The buffers must not be empty. Although the buffers object may be copied as
+ * necessary, ownership of the underlying memory blocks is retained by the
+ * caller, which must guarantee that they remain valid until the handler is
+ * called.
+ *
+ * @param descriptors A pointer to an array that receives the descriptors. The
+ * array must remain valid until the handler is called.
+ *
+ * @param max_descriptors The number of elements in the array. At most
+ * max_passed_descriptors descriptors are received by a single operation.
+ *
+ * @param descriptor_count Set to the number of descriptors received. The
+ * referenced object must remain valid until the handler is called.
+ *
+ * @param handler The handler to be called when the receive operation
+ * completes. Copies will be made of the handler as required. The function
+ * signature of the handler must be:
+ * @code void handler(
+ *   const asio::error_code& error, // Result of operation.
+ *   std::size_t bytes_transferred           // Number of bytes received.
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. On
+ * immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ */
+template <typename Protocol, typename Executor,
+    typename MutableBufferSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) ReadHandler
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(Executor)>
+ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+    void (asio::error_code, std::size_t))
+async_receive_descriptors(basic_stream_socket<Protocol, Executor>& s,
+    const MutableBufferSequence& buffers, int* descriptors,
+    std::size_t max_descriptors, std::size_t& descriptor_count,
+    ASIO_MOVE_ARG(ReadHandler) handler
+      ASIO_DEFAULT_COMPLETION_TOKEN(Executor));
+
+/// Start an asynchronous operation to receive data and a socket.
+/**
+ * This function is used to asynchronously receive data on a UNIX domain
+ * stream socket, together with a socket descriptor passed by the peer. The
+ * function call always returns immediately.
+ *
+ * If a descriptor is received, it is assigned to the @c peer socket, using
+ * the protocol determined from the descriptor's local address. If no
+ * descriptor is received the peer socket is left closed, and any additional
+ * descriptors are closed.
+ *
+ * @param s The socket on which the data and descriptor are to be received.
+ *
+ * @param buffers One or more buffers into which the data will be received.
+ * The buffers must not be empty. Although the buffers object may be copied as
+ * necessary, ownership of the underlying memory blocks is retained by the
+ * caller, which must guarantee that they remain valid until the handler is
+ * called.
+ *
+ * @param peer The socket to which the received descriptor will be assigned.
+ * It must not be open. Ownership of the peer object is retained by the
+ * caller, which must guarantee that it is valid until the handler is called.
+ *
+ * @param handler The handler to be called when the receive operation
+ * completes. Copies will be made of the handler as required. The function
+ * signature of the handler must be:
+ * @code void handler(
+ *   const asio::error_code& error, // Result of operation.
+ *   std::size_t bytes_transferred           // Number of bytes received.
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. On
+ * immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ *
+ * @note If the received descriptor cannot be assigned to the peer socket, it
+ * is closed and the handler is passed the error. The data has still been
+ * received in this case.
+ *
+ * @par Example
+ * A worker process receiving a connection from a listening process:
+ * @code
+ * char tag;
+ * asio::ip::tcp::socket connection(my_context);
+ * asio::local::async_receive_descriptors(listener, asio::buffer(&tag, 1),
+ *     connection, handler);
+ * @endcode
+ */
+template <typename Protocol, typename Executor,
+    typename MutableBufferSequence, typename PeerProtocol,
+    typename PeerExecutor,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) ReadHandler
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(Executor)>
+ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+    void (asio::error_code, std::size_t))
+async_receive_descriptors(basic_stream_socket<Protocol, Executor>& s,
+    const MutableBufferSequence& buffers,
+    basic_socket<PeerProtocol, PeerExecutor>& peer,
+    ASIO_MOVE_ARG(ReadHandler) handler
+      ASIO_DEFAULT_COMPLETION_TOKEN(Executor));
+
+/*@}*/
+
+} // namespace local
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/local/impl/descriptor_passing.hpp"
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_LOCAL_DESCRIPTOR_PASSING_HPP
@@ -0,0 +1,747 @@
+//
+// local/impl/descriptor_passing.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_LOCAL_IMPL_DESCRIPTOR_PASSING_HPP
+#define ASIO_LOCAL_IMPL_DESCRIPTOR_PASSING_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <cstring>
+#include <unistd.h>
+#include "asio/associated_allocator.hpp"
+#include "asio/associated_executor.hpp"
+#include "asio/buffer.hpp"
+#include "asio/post.hpp"
+#include "asio/socket_base.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_cont_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/handler_tracking.hpp"
+#include "asio/detail/handler_type_requirements.hpp"
+#include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/local/basic_endpoint.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail
+{
+  // The size of the control buffer used to pass descriptors. It is large
+  // enough for a single SCM_RIGHTS message of max_passed_descriptors.
+  enum { descriptor_control_size = 512 };
+
+  union descriptor_control_buffer
+  {
+    cmsghdr header;
+    char buffer[descriptor_control_size];
+  };
+
+  // Checks that a socket is a UNIX domain socket.
+  template <typename Protocol>
+  inline void check_local_protocol()
+  {
+    asio::local::basic_endpoint<Protocol>* tmp
+      = static_cast<typename Protocol::endpoint*>(0);
+    (void)tmp;
+  }
+
+  template <typename Protocol, typename Executor,
+      typename ConstBufferSequence, typename WriteHandler>
+  class send_descriptors_op
+  {
+  public:
+    send_descriptors_op(basic_stream_socket<Protocol, Executor>& socket,
+        const ConstBufferSequence& buffers, const int* descriptors,
+        std::size_t count, WriteHandler& handler)
+      : socket_(socket),
+        buffers_(buffers),
+        descriptors_(descriptors),
+        count_(count),
+        start_(0),
+        handler_(ASIO_MOVE_CAST(WriteHandler)(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    send_descriptors_op(const send_descriptors_op& other)
+      : socket_(other.socket_),
+        buffers_(other.buffers_),
+        descriptors_(other.descriptors_),
+        count_(other.count_),
+        start_(other.start_),
+        handler_(other.handler_)
+    {
+    }
+
+    send_descriptors_op(send_descriptors_op&& other)
+      : socket_(other.socket_),
+        buffers_(ASIO_MOVE_CAST(ConstBufferSequence)(other.buffers_)),
+        descriptors_(other.descriptors_),
+        count_(other.count_),
+        start_(other.start_),
+        handler_(ASIO_MOVE_CAST(WriteHandler)(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(asio::error_code ec,
+        std::size_t bytes_transferred = 0, int start = 0)
+    {
+      switch (start_ = start)
+      {
+        case 1:
+        if (count_ > asio::local::max_passed_descriptors
+            || (count_ > 0 && asio::buffer_size(buffers_) == 0))
+          ec = asio::error::invalid_argument;
+        else
+          socket_.native_non_blocking(true, ec);
+        /* fall-through */ case 0:
+        if (!ec && !perform(ec, bytes_transferred))
+        {
+          ASIO_HANDLER_LOCATION((__FILE__, __LINE__,
+                "async_send_descriptors"));
+          socket_.async_wait(socket_base::wait_write,
+              ASIO_MOVE_CAST(send_descriptors_op)(*this));
+          return;
+        }
+        if (start_ == 1)
+        {
+          ASIO_HANDLER_LOCATION((__FILE__, __LINE__,
+                "async_send_descriptors"));
+          asio::post(socket_.get_executor(),
+              detail::bind_handler(ASIO_MOVE_CAST(send_descriptors_op)(
+                  *this), ec, bytes_transferred, 2));
+          return;
+        }
+        /* fall-through */ default:
+        handler_(static_cast<const asio::error_code&>(ec),
+            static_cast<const std::size_t&>(bytes_transferred));
+      }
+    }
+
+    // Attempt the send. Returns false if the socket is not ready.
+    bool perform(asio::error_code& ec, std::size_t& bytes_transferred)
+    {
+      buffer_sequence_adapter<asio::const_buffer,
+          ConstBufferSequence> bufs(buffers_);
+
+      descriptor_control_buffer control;
+      std::size_t control_size = 0;
+      if (count_ > 0)
+      {
+        std::memset(control.buffer, 0, sizeof(control.buffer));
+        control.header.cmsg_level = SOL_SOCKET;
+        control.header.cmsg_type = SCM_RIGHTS;
+        control.header.cmsg_len = CMSG_LEN(sizeof(int) * count_);
+        std::memcpy(CMSG_DATA(&control.header),
+            descriptors_, sizeof(int) * count_);
+        control_size = CMSG_SPACE(sizeof(int) * count_);
+      }
+
+      return socket_ops::non_blocking_sendmsg_control(
+          socket_.native_handle(), bufs.buffers(), bufs.count(), 0,
+          control_size ? control.buffer : 0, control_size,
+          ec, bytes_transferred);
+    }
+
+  //private:
+    basic_stream_socket<Protocol, Executor>& socket_;
+    ConstBufferSequence buffers_;
+    const int* descriptors_;
+    std::size_t count_;
+    int start_;
+    WriteHandler handler_;
+  };
+
+  template <typename Protocol, typename Executor,
+      typename ConstBufferSequence, typename WriteHandler>
+  inline asio_handler_allocate_is_deprecated
+  asio_handler_allocate(std::size_t size,
+      send_descriptors_op<Protocol, Executor,
+        ConstBufferSequence, WriteHandler>* this_handler)
+  {
+#if defined(ASIO_NO_DEPRECATED)
+    asio_handler_alloc_helpers::allocate(size, this_handler->handler_);
+    return asio_handler_allocate_is_no_longer_used();
+#else // defined(ASIO_NO_DEPRECATED)
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Protocol, typename Executor,
+      typename ConstBufferSequence, typename WriteHandler>
+  inline asio_handler_deallocate_is_deprecated
+  asio_handler_deallocate(void* pointer, std::size_t size,
+      send_descriptors_op<Protocol, Executor,
+        ConstBufferSequence, WriteHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+#if defined(ASIO_NO_DEPRECATED)
+    return asio_handler_deallocate_is_no_longer_used();
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Protocol, typename Executor,
+      typename ConstBufferSequence, typename WriteHandler>
+  inline bool asio_handler_is_continuation(
+      send_descriptors_op<Protocol, Executor,
+        ConstBufferSequence, WriteHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename Protocol, typename Executor,
+      typename ConstBufferSequence, typename WriteHandler>
+  inline asio_handler_invoke_is_deprecated
+  asio_handler_invoke(Function& function,
+      send_descriptors_op<Protocol, Executor,
+        ConstBufferSequence, WriteHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+#if defined(ASIO_NO_DEPRECATED)
+    return asio_handler_invoke_is_no_longer_used();
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Function, typename Protocol, typename Executor,
+      typename ConstBufferSequence, typename WriteHandler>
+  inline asio_handler_invoke_is_deprecated
+  asio_handler_invoke(const Function& function,
+      send_descriptors_op<Protocol, Executor,
+        ConstBufferSequence, WriteHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+#if defined(ASIO_NO_DEPRECATED)
+    return asio_handler_invoke_is_no_longer_used();
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  // Stores received descriptors in an array supplied by the caller.
+  class descriptor_array_receiver
+  {
+  public:
+    descriptor_array_receiver(int* descriptors,
+        std::size_t max_descriptors, std::size_t& descriptor_count)
+      : descriptors_(descriptors),
+        max_descriptors_(max_descriptors),
+        descriptor_count_(&descriptor_count)
+    {
+    }
+
+    std::size_t capacity() const
+    {
+      return max_descriptors_;
+    }
+
+    void check(asio::error_code&) const
+    {
+    }
+
+    void assign(const int* descriptors, std::size_t count,
+        asio::error_code&)
+    {
+      if (count > 0)
+        std::memcpy(descriptors_, descriptors, sizeof(int) * count);
+      *descriptor_count_ = count;
+    }
+
+  private:
+    int* descriptors_;
+    std::size_t max_descriptors_;
+    std::size_t* descriptor_count_;
+  };
+
+  // Assigns a received descriptor to a socket.
+  template <typename Protocol, typename Executor>
+  class socket_descriptor_receiver
+  {
+  public:
+    explicit socket_descriptor_receiver(
+        basic_socket<Protocol, Executor>& peer)
+      : peer_(&peer)
+    {
+    }
+
+    std::size_t capacity() const
+    {
+      return 1;
+    }
+
+    void check(asio::error_code& ec) const
+    {
+      if (peer_->is_open())
+        ec = asio::error::already_open;
+    }
+
+    void assign(const int* descriptors, std::size_t count,
+        asio::error_code& ec)
+    {
+      if (count == 0)
+        return;
+
+      // The protocol is determined by the family of the socket's address.
+      typename Protocol::endpoint endpoint;
+      std::size_t addr_len = endpoint.capacity();
+      if (socket_ops::getsockname(descriptors[0],
+            endpoint.data(), &addr_len, ec) == 0)
+      {
+        endpoint.resize(addr_len);
+        peer_->assign(endpoint.protocol(), descriptors[0], ec);
+      }
+
+      if (ec)
+        ::close(descriptors[0]);
+    }
+
+  private:
+    basic_socket<Protocol, Executor>* peer_;
+  };
+
+  template <typename Protocol, typename Executor,
+      typename MutableBufferSequence, typename Receiver,
+      typename ReadHandler>
+  class receive_descriptors_op
+  {
+  public:
+    receive_descriptors_op(basic_stream_socket<Protocol, Executor>& socket,
+        const MutableBufferSequence& buffers, const Receiver& receiver,
+        ReadHandler& handler)
+      : socket_(socket),
+        buffers_(buffers),
+        receiver_(receiver),
+        start_(0),
+        handler_(ASIO_MOVE_CAST(ReadHandler)(handler))
+    {
+    }
+
+#if defined(ASIO_HAS_MOVE)
+    receive_descriptors_op(const receive_descriptors_op& other)
+      : socket_(other.socket_),
+        buffers_(other.buffers_),
+        receiver_(other.receiver_),
+        start_(other.start_),
+        handler_(other.handler_)
+    {
+    }
+
+    receive_descriptors_op(receive_descriptors_op&& other)
+      : socket_(other.socket_),
+        buffers_(ASIO_MOVE_CAST(MutableBufferSequence)(other.buffers_)),
+        receiver_(other.receiver_),
+        start_(other.start_),
+        handler_(ASIO_MOVE_CAST(ReadHandler)(other.handler_))
+    {
+    }
+#endif // defined(ASIO_HAS_MOVE)
+
+    void operator()(asio::error_code ec,
+        std::size_t bytes_transferred = 0, int start = 0)
+    {
+      switch (start_ = start)
+      {
+        case 1:
+        // No descriptors are reported unless the receive succeeds.
+        receiver_.assign(0, 0, ec);
+        receiver_.check(ec);
+        if (!ec && asio::buffer_size(buffers_) == 0)
+          ec = asio::error::invalid_argument;
+        if (!ec)
+          socket_.native_non_blocking(true, ec);
+        /* fall-through */ case 0:
+        if (!ec && !perform(ec, bytes_transferred))
+        {
+          ASIO_HANDLER_LOCATION((__FILE__, __LINE__,
+                "async_receive_descriptors"));
+          socket_.async_wait(socket_base::wait_read,
+              ASIO_MOVE_CAST(receive_descriptors_op)(*this));
+          return;
+        }
+        if (start_ == 1)
+        {
+          ASIO_HANDLER_LOCATION((__FILE__, __LINE__,
+                "async_receive_descriptors"));
+          asio::post(socket_.get_executor(),
+              detail::bind_handler(ASIO_MOVE_CAST(receive_descriptors_op)(
+                  *this), ec, bytes_transferred, 2));
+          return;
+        }
+        /* fall-through */ default:
+        handler_(static_cast<const asio::error_code&>(ec),
+            static_cast<const std::size_t&>(bytes_transferred));
+      }
+    }
+
+    // Attempt the receive. Returns false if the socket is not ready.
+    bool perform(asio::error_code& ec, std::size_t& bytes_transferred)
+    {
+      buffer_sequence_adapter<asio::mutable_buffer,
+          MutableBufferSequence> bufs(buffers_);
+
+      std::size_t capacity = receiver_.capacity();
+      if (capacity > asio::local::max_passed_descriptors)
+        capacity = asio::local::max_passed_descriptors;
+
+      descriptor_control_buffer control;
+      std::size_t control_size = CMSG_SPACE(sizeof(int) * capacity);
+
+      int flags = 0;
+#if defined(MSG_CMSG_CLOEXEC)
+      flags |= MSG_CMSG_CLOEXEC;
+#endif // defined(MSG_CMSG_CLOEXEC)
+
+      int out_flags = 0;
+      if (!socket_ops::non_blocking_recvmsg_control(
+            socket_.native_handle(), bufs.buffers(), bufs.count(),
+            flags, true, 0, 0, control.buffer, &control_size,
+            out_flags, ec, bytes_transferred))
+        return false;
+
+      // Take ownership of the received descriptors, closing any that do not
+      // fit in the receiver.
+      int descriptors[asio::local::max_passed_descriptors];
+      std::size_t count = 0;
+      if (control_size > 0)
+      {
+        msghdr msg = msghdr();
+        msg.msg_control = control.buffer;
+        msg.msg_controllen = control_size;
+        for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+            cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+          if (cmsg->cmsg_level != SOL_SOCKET
+              || cmsg->cmsg_type != SCM_RIGHTS)
+            continue;
+
+          const unsigned char* data = CMSG_DATA(cmsg);
+          std::size_t n = (cmsg->cmsg_len - (data
+                - reinterpret_cast<const unsigned char*>(cmsg)))
+            / sizeof(int);
+          for (std::size_t i = 0; i < n; ++i)
+          {
+            int descriptor;
+            std::memcpy(&descriptor, data + i * sizeof(int), sizeof(int));
+            if (count < capacity)
+              descriptors[count++] = descriptor;
+            else
+              ::close(descriptor);
+          }
+        }
+      }
+
+      receiver_.assign(descriptors, count, ec);
+      return true;
+    }
+
+  //private:
+    basic_stream_socket<Protocol, Executor>& socket_;
+    MutableBufferSequence buffers_;
+    Receiver receiver_;
+    int start_;
+    ReadHandler handler_;
+  };
+
+  template <typename Protocol, typename Executor,
+      typename MutableBufferSequence, typename Receiver,
+      typename ReadHandler>
+  inline asio_handler_allocate_is_deprecated
+  asio_handler_allocate(std::size_t size,
+      receive_descriptors_op<Protocol, Executor,
+        MutableBufferSequence, Receiver, ReadHandler>* this_handler)
+  {
+#if defined(ASIO_NO_DEPRECATED)
+    asio_handler_alloc_helpers::allocate(size, this_handler->handler_);
+    return asio_handler_allocate_is_no_longer_used();
+#else // defined(ASIO_NO_DEPRECATED)
+    return asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Protocol, typename Executor,
+      typename MutableBufferSequence, typename Receiver,
+      typename ReadHandler>
+  inline asio_handler_deallocate_is_deprecated
+  asio_handler_deallocate(void* pointer, std::size_t size,
+      receive_descriptors_op<Protocol, Executor,
+        MutableBufferSequence, Receiver, ReadHandler>* this_handler)
+  {
+    asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+#if defined(ASIO_NO_DEPRECATED)
+    return asio_handler_deallocate_is_no_longer_used();
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Protocol, typename Executor,
+      typename MutableBufferSequence, typename Receiver,
+      typename ReadHandler>
+  inline bool asio_handler_is_continuation(
+      receive_descriptors_op<Protocol, Executor,
+        MutableBufferSequence, Receiver, ReadHandler>* this_handler)
+  {
+    return this_handler->start_ == 0 ? true
+      : asio_handler_cont_helpers::is_continuation(
+          this_handler->handler_);
+  }
+
+  template <typename Function, typename Protocol, typename Executor,
+      typename MutableBufferSequence, typename Receiver,
+      typename ReadHandler>
+  inline asio_handler_invoke_is_deprecated
+  asio_handler_invoke(Function& function,
+      receive_descriptors_op<Protocol, Executor,
+        MutableBufferSequence, Receiver, ReadHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+#if defined(ASIO_NO_DEPRECATED)
+    return asio_handler_invoke_is_no_longer_used();
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Function, typename Protocol, typename Executor,
+      typename MutableBufferSequence, typename Receiver,
+      typename ReadHandler>
+  inline asio_handler_invoke_is_deprecated
+  asio_handler_invoke(const Function& function,
+      receive_descriptors_op<Protocol, Executor,
+        MutableBufferSequence, Receiver, ReadHandler>* this_handler)
+  {
+    asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+#if defined(ASIO_NO_DEPRECATED)
+    return asio_handler_invoke_is_no_longer_used();
+#endif // defined(ASIO_NO_DEPRECATED)
+  }
+
+  template <typename Protocol, typename Executor>
+  class initiate_async_send_descriptors
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_descriptors(
+        basic_stream_socket<Protocol, Executor>& s)
+      : socket_(s)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return socket_.get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(ASIO_MOVE_ARG(WriteHandler) handler,
+        const ConstBufferSequence& buffers, const int* descriptors,
+        std::size_t count) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      non_const_lvalue<WriteHandler> handler2(handler);
+      send_descriptors_op<Protocol, Executor, ConstBufferSequence,
+        typename decay<WriteHandler>::type>(socket_, buffers,
+          descriptors, count, handler2.value)(asio::error_code(), 0, 1);
+    }
+
+  private:
+    basic_stream_socket<Protocol, Executor>& socket_;
+  };
+
+  template <typename Protocol, typename Executor>
+  class initiate_async_receive_descriptors
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_descriptors(
+        basic_stream_socket<Protocol, Executor>& s)
+      : socket_(s)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return socket_.get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence,
+        typename Receiver>
+    void operator()(ASIO_MOVE_ARG(ReadHandler) handler,
+        const MutableBufferSequence& buffers, const Receiver& receiver) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      non_const_lvalue<ReadHandler> handler2(handler);
+      receive_descriptors_op<Protocol, Executor, MutableBufferSequence,
+        Receiver, typename decay<ReadHandler>::type>(socket_, buffers,
+          receiver, handler2.value)(asio::error_code(), 0, 1);
+    }
+
+  private:
+    basic_stream_socket<Protocol, Executor>& socket_;
+  };
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <typename Protocol, typename Executor,
+    typename ConstBufferSequence, typename WriteHandler, typename Allocator>
+struct associated_allocator<
+    detail::send_descriptors_op<Protocol, Executor,
+      ConstBufferSequence, WriteHandler>, Allocator>
+{
+  typedef typename associated_allocator<WriteHandler, Allocator>::type type;
+
+  static type get(
+      const detail::send_descriptors_op<Protocol, Executor,
+        ConstBufferSequence, WriteHandler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<WriteHandler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename Protocol, typename Executor,
+    typename ConstBufferSequence, typename WriteHandler, typename Executor1>
+struct associated_executor<
+    detail::send_descriptors_op<Protocol, Executor,
+      ConstBufferSequence, WriteHandler>, Executor1>
+{
+  typedef typename associated_executor<WriteHandler, Executor1>::type type;
+
+  static type get(
+      const detail::send_descriptors_op<Protocol, Executor,
+        ConstBufferSequence, WriteHandler>& h,
+      const Executor1& ex = Executor1()) ASIO_NOEXCEPT
+  {
+    return associated_executor<WriteHandler, Executor1>::get(h.handler_, ex);
+  }
+};
+
+template <typename Protocol, typename Executor,
+    typename MutableBufferSequence, typename Receiver,
+    typename ReadHandler, typename Allocator>
+struct associated_allocator<
+    detail::receive_descriptors_op<Protocol, Executor,
+      MutableBufferSequence, Receiver, ReadHandler>, Allocator>
+{
+  typedef typename associated_allocator<ReadHandler, Allocator>::type type;
+
+  static type get(
+      const detail::receive_descriptors_op<Protocol, Executor,
+        MutableBufferSequence, Receiver, ReadHandler>& h,
+      const Allocator& a = Allocator()) ASIO_NOEXCEPT
+  {
+    return associated_allocator<ReadHandler, Allocator>::get(h.handler_, a);
+  }
+};
+
+template <typename Protocol, typename Executor,
+    typename MutableBufferSequence, typename Receiver,
+    typename ReadHandler, typename Executor1>
+struct associated_executor<
+    detail::receive_descriptors_op<Protocol, Executor,
+      MutableBufferSequence, Receiver, ReadHandler>, Executor1>
+{
+  typedef typename associated_executor<ReadHandler, Executor1>::type type;
+
+  static type get(
+      const detail::receive_descriptors_op<Protocol, Executor,
+        MutableBufferSequence, Receiver, ReadHandler>& h,
+      const Executor1& ex = Executor1()) ASIO_NOEXCEPT
+  {
+    return associated_executor<ReadHandler, Executor1>::get(h.handler_, ex);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+namespace local {
+
+template <typename Protocol, typename Executor, typename ConstBufferSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) WriteHandler>
+inline ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+    void (asio::error_code, std::size_t))
+async_send_descriptors(basic_stream_socket<Protocol, Executor>& s,
+    const ConstBufferSequence& buffers, const int* descriptors,
+    std::size_t count, ASIO_MOVE_ARG(WriteHandler) handler)
+{
+  asio::detail::check_local_protocol<Protocol>();
+
+  return async_initiate<WriteHandler,
+    void (asio::error_code, std::size_t)>(
+      asio::detail::initiate_async_send_descriptors<Protocol, Executor>(s),
+      handler, buffers, descriptors, count);
+}
+
+template <typename Protocol, typename Executor,
+    typename MutableBufferSequence,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) ReadHandler>
+inline ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+    void (asio::error_code, std::size_t))
+async_receive_descriptors(basic_stream_socket<Protocol, Executor>& s,
+    const MutableBufferSequence& buffers, int* descriptors,
+    std::size_t max_descriptors, std::size_t& descriptor_count,
+    ASIO_MOVE_ARG(ReadHandler) handler)
+{
+  asio::detail::check_local_protocol<Protocol>();
+
+  return async_initiate<ReadHandler,
+    void (asio::error_code, std::size_t)>(
+      asio::detail::initiate_async_receive_descriptors<Protocol, Executor>(s),
+      handler, buffers, asio::detail::descriptor_array_receiver(
+        descriptors, max_descriptors, descriptor_count));
+}
+
+template <typename Protocol, typename Executor,
+    typename MutableBufferSequence, typename PeerProtocol,
+    typename PeerExecutor,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) ReadHandler>
+inline ASIO_INITFN_AUTO_RESULT_TYPE(ReadHandler,
+    void (asio::error_code, std::size_t))
+async_receive_descriptors(basic_stream_socket<Protocol, Executor>& s,
+    const MutableBufferSequence& buffers,
+    basic_socket<PeerProtocol, PeerExecutor>& peer,
+    ASIO_MOVE_ARG(ReadHandler) handler)
+{
+  asio::detail::check_local_protocol<Protocol>();
+
+  return async_initiate<ReadHandler,
+    void (asio::error_code, std::size_t)>(
+      asio::detail::initiate_async_receive_descriptors<Protocol, Executor>(s),
+      handler, buffers, asio::detail::socket_descriptor_receiver<
+        PeerProtocol, PeerExecutor>(peer));
+}
+
+} // namespace local
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_LOCAL_IMPL_DESCRIPTOR_PASSING_HPP
@@ -0,0 +1,158 @@
+//
+// receive_metadata.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_RECEIVE_METADATA_HPP
+#define ASIO_RECEIVE_METADATA_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_RECEIVE_METADATA) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include "asio/detail/cstdint.hpp"
+#include "asio/ip/address.hpp"
+#include "asio/socket_base.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Information about a received message that is reported by the kernel
+/// alongside the data.
+/**
+ * The receive_metadata class holds the ancillary data that accompanies a
+ * received message, such as kernel receive timestamps and the destination
+ * address of a datagram. An object of this type is passed by reference to
+ * basic_datagram_socket::async_receive_with_metadata(),
+ * basic_datagram_socket::async_receive_from_with_metadata() or
+ * basic_stream_socket::async_receive_with_metadata(), and is filled in when
+ * the operation completes. The object has a fixed size and is reusable, so
+ * no memory is allocated to receive the metadata.
+ *
+ * Each item is only reported if it was enabled on the socket using the
+ * corresponding socket option:
+ *
+ * @li socket_base::timestamp enables the software receive timestamp.
+ *
+ * @li socket_base::timestamping enables software and hardware receive
+ * timestamps.
+ *
+ * @li ip::packet_info enables the destination address and interface.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class receive_metadata
+{
+public:
+  /// Default constructor.
+  ASIO_DECL receive_metadata() ASIO_NOEXCEPT;
+
+  /// Get the flags that were returned by the receive operation.
+  socket_base::message_flags flags() const ASIO_NOEXCEPT
+  {
+    return flags_;
+  }
+
+  /// Determine whether the received datagram was larger than the supplied
+  /// buffers, in which case the excess data was discarded.
+  ASIO_DECL bool truncated() const ASIO_NOEXCEPT;
+
+  /// Determine whether some of the ancillary data was discarded because
+  /// there was insufficient space to receive it.
+  ASIO_DECL bool control_truncated() const ASIO_NOEXCEPT;
+
+  /// Determine whether a software receive timestamp is available.
+  bool has_software_timestamp() const ASIO_NOEXCEPT
+  {
+    return has_software_timestamp_;
+  }
+
+  /// Get the software receive timestamp, as the number of nanoseconds since
+  /// the epoch of the system clock.
+  asio::uint64_t software_timestamp() const ASIO_NOEXCEPT
+  {
+    return software_timestamp_;
+  }
+
+  /// Determine whether a hardware receive timestamp is available.
+  bool has_hardware_timestamp() const ASIO_NOEXCEPT
+  {
+    return has_hardware_timestamp_;
+  }
+
+  /// Get the raw hardware receive timestamp, in nanoseconds, as reported by
+  /// the network interface.
+  asio::uint64_t hardware_timestamp() const ASIO_NOEXCEPT
+  {
+    return hardware_timestamp_;
+  }
+
+  /// Determine whether the destination address and interface are available.
+  bool has_destination() const ASIO_NOEXCEPT
+  {
+    return has_destination_;
+  }
+
+  /// Get the destination address of the received datagram.
+  const ip::address& destination_address() const ASIO_NOEXCEPT
+  {
+    return destination_address_;
+  }
+
+  /// Get the index of the interface on which the datagram was received.
+  unsigned int interface_index() const ASIO_NOEXCEPT
+  {
+    return interface_index_;
+  }
+
+  /// Decode the ancillary data returned by @c recvmsg().
+  /**
+   * This function is used by the implementation of the receive operations to
+   * fill in the object.
+   *
+   * @param flags The value of the @c msg_flags member of the @c msghdr.
+   *
+   * @param control The buffer containing the ancillary data.
+   *
+   * @param control_size The number of bytes of ancillary data.
+   */
+  ASIO_DECL void assign(socket_base::message_flags flags,
+      const void* control, std::size_t control_size);
+
+private:
+  socket_base::message_flags flags_;
+  bool has_software_timestamp_;
+  bool has_hardware_timestamp_;
+  bool has_destination_;
+  asio::uint64_t software_timestamp_;
+  asio::uint64_t hardware_timestamp_;
+  ip::address destination_address_;
+  unsigned int interface_index_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/receive_metadata.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_RECEIVE_METADATA)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_RECEIVE_METADATA_HPP
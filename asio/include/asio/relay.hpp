@@ -0,0 +1,122 @@
+//
+// relay.hpp
+// ~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_RELAY_HPP
+#define ASIO_RELAY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/**
+ * @defgroup async_relay asio::async_relay
+ *
+ * @brief The @c async_relay function is a composed asynchronous operation that
+ * copies all data from one stream to another before completion.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to copy all data from one stream to
+/// another.
+/**
+ * This function is used to asynchronously relay data read from a source
+ * stream to a sink stream. The function call always returns immediately. The
+ * asynchronous operation will continue until one of the following conditions
+ * is true:
+ *
+ * @li The source stream has reached end of file and all data read from it has
+ * been written to the sink stream.
+ *
+ * @li An error occurred.
+ *
+ * When the source stream reaches end of file and the sink stream is a
+ * basic_stream_socket, the send side of the sink socket is shut down. This
+ * propagates a half-close, so that a bidirectional relay may be implemented
+ * as two independent operations, one for each direction:
+ * @code
+ * asio::async_relay(client, server, client_to_server_handler);
+ * asio::async_relay(server, client, server_to_client_handler);
+ * @endcode
+ *
+ * On Linux, when both streams are basic_stream_socket or
+ * posix::basic_stream_descriptor objects, the data is moved between the
+ * streams with @c splice() through a pipe, without being copied into user
+ * space. Otherwise, such as when either stream is an ssl::stream, the
+ * operation is implemented in terms of the source stream's async_read_some
+ * function and async_write on the sink stream, using two buffers so that
+ * reading and writing overlap.
+ *
+ * This is known as a <em>composed operation</em>. The program must ensure
+ * that the source stream performs no other read operations, and the sink
+ * stream performs no other write operations, until this operation completes.
+ * Reads and writes may be outstanding at the same time, and the operation
+ * serialises access to its internal state, so the io_context may be run from
+ * multiple threads without the handler being bound to a strand. If an error
+ * occurs, the operation completes once all outstanding intermediate
+ * operations have completed. For example, following a write error this will
+ * be when the pending read on the source stream completes, which may be
+ * arranged by closing the source stream.
+ *
+ * @param source The stream from which the data is to be read. The type must
+ * support the AsyncReadStream concept.
+ *
+ * @param sink The stream to which the data is to be written. The type must
+ * support the AsyncWriteStream concept.
+ *
+ * @param handler The handler to be called when the relay operation completes.
+ * Copies will be made of the handler as required. The function signature of
+ * the handler must be:
+ * @code void handler(
+ *   // Result of operation. Reaching end of file on the source stream is not
+ *   // an error.
+ *   const asio::error_code& error,
+ *
+ *   // Number of bytes written to the sink stream.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. On
+ * immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using asio::post().
+ *
+ * @note When @c splice() is used, writing to a socket whose peer has closed
+ * the connection may raise the @c SIGPIPE signal, as with the socket's
+ * async_send_file function.
+ */
+template <typename AsyncReadStream, typename AsyncWriteStream,
+    ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+      std::size_t)) RelayHandler
+        ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(
+          typename AsyncReadStream::executor_type)>
+ASIO_INITFN_AUTO_RESULT_TYPE(RelayHandler,
+    void (asio::error_code, std::size_t))
+async_relay(AsyncReadStream& source, AsyncWriteStream& sink,
+    ASIO_MOVE_ARG(RelayHandler) handler
+      ASIO_DEFAULT_COMPLETION_TOKEN(
+        typename AsyncReadStream::executor_type));
+
+/*@}*/
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/relay.hpp"
+
+#endif // ASIO_RELAY_HPP
@@ -225,6 +225,104 @@ public:
     ASIO_OS_DEF(SOL_SOCKET), ASIO_OS_DEF(SO_KEEPALIVE)> keep_alive;
 #endif
 
+  /// Socket option to obtain the CPU on which a socket's packets are received.
+  /**
+   * Implements the SOL_SOCKET/SO_INCOMING_CPU socket option. On platforms
+   * that do not support this option, getting or setting it fails with
+   * asio::error::invalid_argument.
+   *
+   * @par Examples
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::incoming_cpu option;
+   * socket.get_option(option);
+   * int cpu = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined incoming_cpu;
+#elif defined(SO_INCOMING_CPU)
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(SOL_SOCKET), SO_INCOMING_CPU> incoming_cpu;
+#else
+  typedef asio::detail::socket_option::integer<
+    asio::detail::custom_socket_option_level,
+    asio::detail::always_fail_option> incoming_cpu;
+#endif
+
+  /// Socket option to report the time at which each packet was received.
+  /**
+   * Implements the SOL_SOCKET/SO_TIMESTAMPNS socket option, or the
+   * SOL_SOCKET/SO_TIMESTAMP socket option on platforms that do not support
+   * nanosecond resolution. The timestamp is obtained using
+   * basic_datagram_socket::async_receive_with_metadata() or
+   * basic_stream_socket::async_receive_with_metadata().
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::socket_base::timestamp option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined timestamp;
+#elif defined(SO_TIMESTAMPNS)
+  typedef asio::detail::socket_option::boolean<
+    ASIO_OS_DEF(SOL_SOCKET), SO_TIMESTAMPNS> timestamp;
+#elif defined(SO_TIMESTAMP)
+  typedef asio::detail::socket_option::boolean<
+    ASIO_OS_DEF(SOL_SOCKET), SO_TIMESTAMP> timestamp;
+#else
+  typedef asio::detail::socket_option::boolean<
+    asio::detail::custom_socket_option_level,
+    asio::detail::always_fail_option> timestamp;
+#endif
+
+  /// Socket option to select the software and hardware timestamps that are
+  /// generated for each packet.
+  /**
+   * Implements the SOL_SOCKET/SO_TIMESTAMPING socket option. The value is a
+   * combination of the @c SOF_TIMESTAMPING_* flags defined in
+   * @c <linux/net_tstamp.h>. On platforms that do not support this option,
+   * getting or setting it fails with asio::error::invalid_argument.
+   *
+   * @par Examples
+   * Setting the option to report software and raw hardware receive
+   * timestamps:
+   * @code
+   * asio::ip::udp::socket socket(my_context);
+   * ...
+   * asio::socket_base::timestamping option(
+   *     SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE
+   *     | SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined timestamping;
+#elif defined(SO_TIMESTAMPING)
+  typedef asio::detail::socket_option::integer<
+    ASIO_OS_DEF(SOL_SOCKET), SO_TIMESTAMPING> timestamping;
+#else
+  typedef asio::detail::socket_option::integer<
+    asio::detail::custom_socket_option_level,
+    asio::detail::always_fail_option> timestamping;
+#endif
+
   /// Socket option for the send buffer size of a socket.
   /**
    * Implements the SOL_SOCKET/SO_SNDBUF socket option.
@@ -545,6 +643,26 @@ public:
 #endif
 #endif // !defined(ASIO_NO_DEPRECATED)
 
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Statistics recorded by a multishot accept operation.
+  /**
+   * @sa basic_socket_acceptor::async_multishot_accept
+   */
+  struct multishot_accept_statistics
+  {
+    /// The number of wakeups on which one or more connections were accepted.
+    std::size_t wakeups;
+
+    /// The total number of connections accepted.
+    std::size_t accepted;
+
+    /// The largest number of connections accepted on a single wakeup.
+    std::size_t peak_accepted;
+  };
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
+       //   || defined(GENERATING_DOCUMENTATION)
+
 protected:
   /// Protected destructor to prevent deletion through this type.
   ~socket_base()
@@ -0,0 +1,204 @@
+//
+// write_queue.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_WRITE_QUEUE_HPP
+#define ASIO_WRITE_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/async_result.hpp"
+#include "asio/buffer.hpp"
+#include "asio/error.hpp"
+#include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/type_traits.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class write_queue_op;
+
+} // namespace detail
+
+/// Queues whole-message writes on a stream socket.
+/**
+ * The write_queue class template allows any number of asynchronous writes to
+ * be outstanding on a stream socket at once. Each write is a complete message
+ * that is sent in the order in which the writes were started, without being
+ * interleaved with other messages. While a send is in progress, newly started
+ * writes are queued. When the send completes, all queued messages are
+ * gathered into a single send operation, so that a burst of small messages
+ * costs one system call rather than one each.
+ *
+ * A single send transfers at most an implementation-defined number of
+ * buffers, which does not exceed the platform's limit on the length of an
+ * I/O vector. Where the platform supports it, a send that does not include all
+ * queued data is made with the @c MSG_MORE flag, so that the remainder may be
+ * coalesced with it into full-sized segments.
+ *
+ * The next layer must provide an @c async_send member function that accepts
+ * message flags, as basic_stream_socket does.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * A session that replies to each request without tracking its own queue of
+ * outgoing messages:
+ * @code
+ * asio::write_queue<asio::ip::tcp::socket&> queue(socket);
+ * ...
+ * queue.async_write(asio::buffer(reply->data(), reply->size()),
+ *     [reply](std::error_code ec, std::size_t) { ... });
+ * @endcode
+ */
+template <typename Stream>
+class write_queue
+  : private noncopyable
+{
+public:
+  /// The type of the next layer.
+  typedef typename remove_reference<Stream>::type next_layer_type;
+
+  /// The type of the executor associated with the object.
+  typedef typename next_layer_type::executor_type executor_type;
+
+  /// Construct, passing the specified argument to initialise the next layer.
+  template <typename Arg>
+  explicit write_queue(Arg& a)
+    : next_layer_(a),
+      head_(0),
+      tail_(0),
+      head_offset_(0),
+      pending_writes_(0),
+      sending_(false)
+  {
+  }
+
+  /// Destructor.
+  /**
+   * Destroys any writes that have not completed, without invoking their
+   * handlers. The write_queue must not be destroyed while a send is in
+   * progress.
+   */
+  ~write_queue();
+
+  /// Get a reference to the next layer.
+  next_layer_type& next_layer()
+  {
+    return next_layer_;
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() ASIO_NOEXCEPT
+  {
+    return next_layer_.get_executor();
+  }
+
+  /// Get the number of writes that have been started and not yet completed.
+  std::size_t pending_writes() const ASIO_NOEXCEPT
+  {
+    return pending_writes_;
+  }
+
+  /// Start an asynchronous operation to write a message to the stream.
+  /**
+   * This function is used to asynchronously write all of the supplied data to
+   * the stream. The function call always returns immediately. It may be
+   * called while other writes are outstanding, in which case the data is sent
+   * once all previously started writes have been sent.
+   *
+   * @param buffers One or more buffers containing the data to be written.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the handler is called.
+   *
+   * @param handler The handler to be called when all of the data has been
+   * written, or when an error occurs. Copies will be made of the handler as
+   * required. The function signature of the handler must be:
+   * @code void handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred           // Number of bytes written from
+   *                                           // the buffers.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. On
+   * immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @note If a send fails, every queued write completes with the error. The
+   * write that was being sent reports the number of its bytes that were
+   * written, and the others report zero.
+   */
+  template <typename ConstBufferSequence,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::size_t)) WriteHandler
+          ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(WriteHandler,
+      void (asio::error_code, std::size_t))
+  async_write(const ConstBufferSequence& buffers,
+      ASIO_MOVE_ARG(WriteHandler) handler
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type));
+
+private:
+  class initiate_async_write;
+  class send_handler;
+
+  // Add a write to the end of the queue, and start a send if necessary.
+  void enqueue(detail::write_queue_op* op);
+
+  // Gather the queued writes into a single send.
+  void start_send();
+
+  // Complete the writes that have been sent, and start the next send.
+  void handle_send(const asio::error_code& ec,
+      std::size_t bytes_transferred);
+
+  // The next layer.
+  Stream next_layer_;
+
+  // The queued writes, in the order in which they were started.
+  detail::write_queue_op* head_;
+  detail::write_queue_op* tail_;
+
+  // The number of bytes of the first queued write that have been sent.
+  std::size_t head_offset_;
+
+  // The number of queued writes.
+  std::size_t pending_writes_;
+
+  // Whether a send is in progress.
+  bool sending_;
+
+  // The maximum number of buffers gathered into a single send. This is lower
+  // than the platform's I/O vector limit, which may be as high as 1024, to
+  // keep the write_queue object small.
+  enum { max_send_buffers =
+    64 < detail::buffer_sequence_adapter_base::max_buffers
+      ? 64 : detail::buffer_sequence_adapter_base::max_buffers };
+
+  // The buffers gathered for the send in progress.
+  const_buffer buffers_[max_send_buffers];
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#include "asio/impl/write_queue.hpp"
+
+#endif // ASIO_WRITE_QUEUE_HPP
@@ -0,0 +1,279 @@
+//
+// connection_churn.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+using asio::ip::tcp;
+
+// A server-side connection, which waits for the client to close.
+class connection
+{
+public:
+  explicit connection(asio::io_context& ioc)
+    : socket_(ioc)
+  {
+  }
+
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT)
+  explicit connection(tcp::socket socket)
+    : socket_(std::move(socket))
+  {
+  }
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
+
+  tcp::socket& socket()
+  {
+    return socket_;
+  }
+
+  void start()
+  {
+    socket_.async_read_some(asio::buffer(data_), read_handler(this));
+  }
+
+private:
+  struct read_handler
+  {
+    explicit read_handler(connection* c) : connection_(c) {}
+
+    void operator()(const asio::error_code&, std::size_t)
+    {
+      delete connection_;
+    }
+
+    connection* connection_;
+  };
+
+  tcp::socket socket_;
+  char data_[64];
+};
+
+// Accepts connections until the required number have been accepted.
+class server
+{
+public:
+  server(asio::io_context& ioc, int connections)
+    : io_context_(ioc),
+      acceptor_(ioc, tcp::endpoint(asio::ip::address_v4::loopback(), 0)),
+      remaining_(connections),
+      new_connection_(0)
+  {
+    acceptor_.listen(asio::socket_base::max_listen_connections);
+  }
+
+  tcp::endpoint local_endpoint() const
+  {
+    return acceptor_.local_endpoint();
+  }
+
+  void start_accept()
+  {
+    new_connection_ = new connection(io_context_);
+    acceptor_.async_accept(new_connection_->socket(), accept_handler(this));
+  }
+
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT)
+  void start_multishot_accept()
+  {
+    acceptor_.async_multishot_accept(
+        multishot_accept_handler(this), &statistics_);
+  }
+
+  void print_statistics() const
+  {
+    if (statistics_.wakeups > 0)
+    {
+      std::printf("%.2f connections per wakeup, at most %d\n",
+          static_cast<double>(statistics_.accepted) / statistics_.wakeups,
+          static_cast<int>(statistics_.peak_accepted));
+    }
+  }
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
+
+private:
+  struct accept_handler
+  {
+    explicit accept_handler(server* s) : server_(s) {}
+
+    void operator()(const asio::error_code& ec)
+    {
+      server_->handle_accept(ec);
+    }
+
+    server* server_;
+  };
+
+  void handle_accept(const asio::error_code& ec)
+  {
+    if (ec)
+    {
+      std::fprintf(stderr, "Accept failed: %s\n", ec.message().c_str());
+      delete new_connection_;
+      return;
+    }
+
+    new_connection_->start();
+    if (--remaining_ > 0)
+      start_accept();
+  }
+
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT)
+  struct multishot_accept_handler
+  {
+    explicit multishot_accept_handler(server* s) : server_(s) {}
+
+    void operator()(const asio::error_code& ec, tcp::socket socket)
+    {
+      server_->handle_multishot_accept(ec, std::move(socket));
+    }
+
+    server* server_;
+  };
+
+  void handle_multishot_accept(const asio::error_code& ec, tcp::socket socket)
+  {
+    if (ec)
+    {
+      if (ec != asio::error::operation_aborted)
+        std::fprintf(stderr, "Accept failed: %s\n", ec.message().c_str());
+      return;
+    }
+
+    (new connection(std::move(socket)))->start();
+    if (--remaining_ == 0)
+      acceptor_.cancel();
+  }
+
+  tcp::acceptor::multishot_accept_statistics statistics_;
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
+
+  asio::io_context& io_context_;
+  tcp::acceptor acceptor_;
+  int remaining_;
+  connection* new_connection_;
+};
+
+// Repeatedly opens a socket, connects it to the server, and closes it.
+class client
+{
+public:
+  client(asio::io_context& ioc, const tcp::endpoint& endpoint, int* remaining)
+    : socket_(ioc),
+      endpoint_(endpoint),
+      remaining_(remaining)
+  {
+  }
+
+  void start_connect()
+  {
+    --(*remaining_);
+    socket_.async_connect(endpoint_, connect_handler(this));
+  }
+
+private:
+  struct connect_handler
+  {
+    explicit connect_handler(client* c) : client_(c) {}
+
+    void operator()(const asio::error_code& ec)
+    {
+      client_->handle_connect(ec);
+    }
+
+    client* client_;
+  };
+
+  void handle_connect(const asio::error_code& ec)
+  {
+    if (ec)
+    {
+      std::fprintf(stderr, "Connect failed: %s\n", ec.message().c_str());
+      return;
+    }
+
+    asio::error_code ignored_ec;
+    socket_.close(ignored_ec);
+    if (*remaining_ > 0)
+      start_connect();
+  }
+
+  tcp::socket socket_;
+  tcp::endpoint endpoint_;
+  int* remaining_;
+};
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3 && argc != 4)
+  {
+    std::fprintf(stderr,
+        "Usage: connection_churn <connections> <clients> [multishot]\n");
+    return 1;
+  }
+
+  bool multishot = (argc == 4 && std::strcmp(argv[3], "multishot") == 0);
+#if !defined(ASIO_HAS_MULTISHOT_ACCEPT)
+  if (multishot)
+  {
+    std::fprintf(stderr, "Multishot accept is not supported\n");
+    return 1;
+  }
+#endif // !defined(ASIO_HAS_MULTISHOT_ACCEPT)
+
+  int connections = std::atoi(argv[1]);
+  int clients = std::atoi(argv[2]);
+  if (connections <= 0 || clients <= 0 || clients > connections)
+  {
+    std::fprintf(stderr, "Invalid number of connections or clients\n");
+    return 1;
+  }
+
+  asio::io_context ioc;
+  server s(ioc, connections);
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT)
+  if (multishot)
+    s.start_multishot_accept();
+  else
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
+    s.start_accept();
+
+  int remaining = connections;
+  std::vector<client*> client_list;
+  for (int i = 0; i < clients; ++i)
+    client_list.push_back(new client(ioc, s.local_endpoint(), &remaining));
+
+  std::clock_t start_time = std::clock();
+
+  for (int i = 0; i < clients; ++i)
+    client_list[i]->start_connect();
+  ioc.run();
+
+  std::clock_t elapsed = std::clock() - start_time;
+  double seconds = static_cast<double>(elapsed) / CLOCKS_PER_SEC;
+
+  std::printf("%d connections in %.3f seconds of CPU time\n",
+      connections, seconds);
+  std::printf("%.1f us per connection, %.0f connections/sec\n",
+      seconds * 1e6 / connections, connections / seconds);
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT)
+  if (multishot)
+    s.print_statistics();
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
+
+  for (int i = 0; i < clients; ++i)
+    delete client_list[i];
+
+  return 0;
+}
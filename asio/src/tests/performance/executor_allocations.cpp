@@ -0,0 +1,203 @@
+//
+// executor_allocations.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+#include <vector>
+
+// Count every allocation made through the global operator new.
+static std::size_t allocation_count = 0;
+
+void* operator new(std::size_t size)
+{
+  ++allocation_count;
+  if (void* p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) ASIO_NOEXCEPT
+{
+  std::free(p);
+}
+
+#if defined(__cpp_sized_deallocation)
+void operator delete(void* p, std::size_t) ASIO_NOEXCEPT
+{
+  std::free(p);
+}
+#endif // defined(__cpp_sized_deallocation)
+
+// Measures allocations and elapsed time over a number of operations.
+class measurement
+{
+public:
+  measurement(const char* name, int iterations)
+    : name_(name),
+      iterations_(iterations),
+      start_count_(allocation_count),
+      start_time_(std::clock())
+  {
+  }
+
+  ~measurement()
+  {
+    std::clock_t elapsed = std::clock() - start_time_;
+    std::size_t count = allocation_count - start_count_;
+    std::printf("%-44s %8.3f allocs/op %10.1f ns/op\n", name_,
+        static_cast<double>(count) / iterations_,
+        static_cast<double>(elapsed) * 1e9 / CLOCKS_PER_SEC / iterations_);
+  }
+
+private:
+  const char* name_;
+  int iterations_;
+  std::size_t start_count_;
+  std::clock_t start_time_;
+};
+
+// A function object small enough to be stored inline by asio::executor.
+struct small_function
+{
+  int* count_;
+
+  void operator()()
+  {
+    ++(*count_);
+  }
+};
+
+// A function object too large to be stored inline by asio::executor.
+struct large_function
+{
+  int* count_;
+  char padding_[256];
+
+  void operator()()
+  {
+    ++(*count_);
+  }
+};
+
+// Repeatedly posts a function object through a polymorphic executor from
+// within the io_context, so that the thread's recycled memory is available.
+template <typename Function>
+struct repost
+{
+  asio::executor* executor_;
+  Function function_;
+  int* remaining_;
+
+  void operator()()
+  {
+    function_();
+    if (--(*remaining_) > 0)
+      executor_->post(*this, std::allocator<void>());
+  }
+};
+
+template <typename Executor>
+void construct(const char* name, const Executor& e, int iterations)
+{
+  measurement m(name, iterations);
+  for (int i = 0; i < iterations; ++i)
+  {
+    asio::executor ex(e);
+    (void)ex;
+  }
+}
+
+void copy(const char* name, const asio::executor& ex, int iterations)
+{
+  std::vector<asio::executor> executors;
+  executors.reserve(iterations);
+
+  measurement m(name, iterations);
+  for (int i = 0; i < iterations; ++i)
+    executors.push_back(ex);
+}
+
+template <typename Function>
+void post_outside(const char* name, asio::io_context& ctx,
+    asio::executor& ex, Function f, int iterations)
+{
+  ctx.restart();
+
+  measurement m(name, iterations);
+  for (int i = 0; i < iterations; ++i)
+    ex.post(f, std::allocator<void>());
+  ctx.run();
+}
+
+template <typename Function>
+void post_inside(const char* name, asio::io_context& ctx,
+    asio::executor& ex, Function f, int iterations)
+{
+  ctx.restart();
+
+  measurement m(name, iterations);
+  int remaining = iterations;
+  repost<Function> r = { &ex, f, &remaining };
+  ex.post(r, std::allocator<void>());
+  ctx.run();
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::fprintf(stderr, "Usage: executor_allocations <iterations>\n");
+    return 1;
+  }
+
+  int iterations = std::atoi(argv[1]);
+  if (iterations <= 0)
+  {
+    std::fprintf(stderr, "Invalid number of iterations\n");
+    return 1;
+  }
+
+  asio::io_context ctx;
+  asio::strand<asio::io_context::executor_type> s(ctx.get_executor());
+  asio::executor io_ex(ctx.get_executor());
+  asio::executor strand_ex(s);
+  int count = 0;
+
+  construct("construct executor from io_context executor",
+      ctx.get_executor(), iterations);
+  construct("construct executor from strand", s, iterations);
+  copy("copy io_context executor", io_ex, iterations);
+  copy("copy strand executor", strand_ex, iterations);
+
+  small_function f1 = { &count };
+  post_outside("post small function from outside io_context",
+      ctx, io_ex, f1, iterations);
+  post_outside("post small function to strand from outside",
+      ctx, strand_ex, f1, iterations);
+  post_inside("post small function from inside io_context",
+      ctx, io_ex, f1, iterations);
+  post_inside("post small function to strand from inside",
+      ctx, strand_ex, f1, iterations);
+
+  large_function f2 = { &count, { 0 } };
+  post_outside("post large function from outside io_context",
+      ctx, io_ex, f2, iterations);
+  post_outside("post large function to strand from outside",
+      ctx, strand_ex, f2, iterations);
+  post_inside("post large function from inside io_context",
+      ctx, io_ex, f2, iterations);
+  post_inside("post large function to strand from inside",
+      ctx, strand_ex, f2, iterations);
+
+  return count == 8 * iterations ? 0 : 1;
+}
@@ -0,0 +1,206 @@
+//
+// sendfile_throughput.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+#if defined(ASIO_HAS_SENDFILE)
+
+#include <unistd.h>
+
+using asio::ip::tcp;
+
+// Reads and discards everything sent by the peer.
+class sink
+{
+public:
+  sink(tcp::socket& socket, std::size_t total)
+    : socket_(socket),
+      remaining_(total),
+      data_(65536)
+  {
+  }
+
+  void start()
+  {
+    socket_.async_read_some(asio::buffer(data_), read_handler(this));
+  }
+
+  std::size_t remaining() const
+  {
+    return remaining_;
+  }
+
+private:
+  struct read_handler
+  {
+    explicit read_handler(sink* s) : sink_(s) {}
+
+    void operator()(const asio::error_code& ec, std::size_t n)
+    {
+      sink_->remaining_ -= n;
+      if (!ec && sink_->remaining_ > 0)
+        sink_->start();
+    }
+
+    sink* sink_;
+  };
+
+  tcp::socket& socket_;
+  std::size_t remaining_;
+  std::vector<char> data_;
+};
+
+// Sends the file by reading each chunk into user space and writing it.
+class copy_source
+{
+public:
+  copy_source(tcp::socket& socket, int file, std::size_t total)
+    : socket_(socket),
+      file_(file),
+      offset_(0),
+      total_(total),
+      data_(65536)
+  {
+  }
+
+  void start()
+  {
+    std::size_t length = total_ - offset_;
+    if (length > data_.size())
+      length = data_.size();
+    ssize_t n = ::pread(file_, &data_[0], length, offset_);
+    if (n <= 0)
+    {
+      std::fprintf(stderr, "Read failed\n");
+      return;
+    }
+
+    asio::async_write(socket_,
+        asio::buffer(data_, static_cast<std::size_t>(n)),
+        write_handler(this));
+  }
+
+private:
+  struct write_handler
+  {
+    explicit write_handler(copy_source* s) : source_(s) {}
+
+    void operator()(const asio::error_code& ec, std::size_t n)
+    {
+      source_->offset_ += n;
+      if (ec)
+        std::fprintf(stderr, "Write failed: %s\n", ec.message().c_str());
+      else if (source_->offset_ < source_->total_)
+        source_->start();
+    }
+
+    copy_source* source_;
+  };
+
+  tcp::socket& socket_;
+  int file_;
+  std::size_t offset_;
+  std::size_t total_;
+  std::vector<char> data_;
+};
+
+struct send_file_handler
+{
+  void operator()(const asio::error_code& ec, std::size_t)
+  {
+    if (ec)
+      std::fprintf(stderr, "Send file failed: %s\n", ec.message().c_str());
+  }
+};
+
+void report(const char* name, std::size_t total, std::clock_t start_time)
+{
+  std::clock_t elapsed = std::clock() - start_time;
+  double seconds = static_cast<double>(elapsed) / CLOCKS_PER_SEC;
+  double megabytes = static_cast<double>(total) / (1024 * 1024);
+  std::printf("%-12s %8.3f seconds of CPU time, %8.1f MB per CPU second\n",
+      name, seconds, megabytes / seconds);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 2)
+  {
+    std::fprintf(stderr, "Usage: sendfile_throughput <megabytes>\n");
+    return 1;
+  }
+
+  int megabytes = std::atoi(argv[1]);
+  if (megabytes <= 0)
+  {
+    std::fprintf(stderr, "Invalid number of megabytes\n");
+    return 1;
+  }
+
+  std::FILE* file = std::tmpfile();
+  if (!file)
+  {
+    std::fprintf(stderr, "Unable to create temporary file\n");
+    return 1;
+  }
+
+  std::vector<char> chunk(1024 * 1024);
+  for (std::size_t i = 0; i < chunk.size(); ++i)
+    chunk[i] = static_cast<char>(i);
+  for (int i = 0; i < megabytes; ++i)
+    std::fwrite(&chunk[0], 1, chunk.size(), file);
+  std::fflush(file);
+  std::size_t total = static_cast<std::size_t>(megabytes) * chunk.size();
+
+  asio::io_context ioc;
+  tcp::acceptor acceptor(ioc,
+      tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  tcp::socket client_socket(ioc);
+  tcp::socket server_socket(ioc);
+  client_socket.connect(acceptor.local_endpoint());
+  acceptor.accept(server_socket);
+
+  {
+    sink s(client_socket, total);
+    copy_source c(server_socket, fileno(file), total);
+    std::clock_t start_time = std::clock();
+    s.start();
+    c.start();
+    ioc.run();
+    report("read/write", total, start_time);
+  }
+
+  {
+    sink s(client_socket, total);
+    std::clock_t start_time = std::clock();
+    s.start();
+    server_socket.async_send_file(fileno(file), 0, total, send_file_handler());
+    ioc.restart();
+    ioc.run();
+    report("sendfile", total, start_time);
+  }
+
+  std::fclose(file);
+  return 0;
+}
+
+#else // defined(ASIO_HAS_SENDFILE)
+
+int main()
+{
+  std::fprintf(stderr, "sendfile is not supported\n");
+  return 1;
+}
+
+#endif // defined(ASIO_HAS_SENDFILE)
@@ -0,0 +1,321 @@
+//
+// basic_connection_pool.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/basic_connection_pool.hpp"
+
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "archetypes/async_result.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+using bindns::placeholders::_1;
+
+#if defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+
+typedef asio::basic_connection_pool<asio::ip::tcp> tcp_pool;
+
+void handle_acquire(const asio::error_code& err,
+    asio::error_code* result_ec, bool* called)
+{
+  *result_ec = err;
+  *called = true;
+}
+
+// Run the io_context until the specified flag is set.
+void run_until(asio::io_context& ioc, const bool& flag)
+{
+  for (int i = 0; i < 100 && !flag; ++i)
+  {
+    ioc.restart();
+    ioc.run_for(asio::chrono::milliseconds(10));
+  }
+}
+
+#endif // defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+
+//------------------------------------------------------------------------------
+
+// basic_connection_pool_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// basic_connection_pool compile and link correctly. Runtime failures are
+// ignored.
+
+namespace basic_connection_pool_compile {
+
+#if defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+
+void acquire_handler(const asio::error_code&)
+{
+}
+
+#endif // defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+
+void test()
+{
+#if defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    archetypes::lazy_handler lazy;
+    ip::tcp::endpoint endpoint(ip::address_v4::loopback(), 0);
+
+    tcp_pool pool1(ioc);
+    tcp_pool pool2(ioc.get_executor());
+
+    tcp_pool::executor_type ex = pool1.get_executor();
+    (void)ex;
+
+    std::size_t max_connections = pool1.max_connections_per_endpoint();
+    (void)max_connections;
+    pool1.max_connections_per_endpoint(4);
+
+    tcp_pool::duration idle_timeout = pool1.idle_timeout();
+    (void)idle_timeout;
+    pool1.idle_timeout(chrono::seconds(10));
+
+    std::size_t idle = pool1.idle_connections();
+    (void)idle;
+
+    tcp_pool::socket_type socket1(ioc);
+    pool1.async_acquire(endpoint, socket1, &acquire_handler);
+    int i1 = pool1.async_acquire(endpoint, socket1, lazy);
+    (void)i1;
+
+    pool1.release(endpoint, socket1);
+  }
+  catch (std::exception&)
+  {
+  }
+#endif // defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+}
+
+} // namespace basic_connection_pool_compile
+
+//------------------------------------------------------------------------------
+
+// basic_connection_pool_reuse test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a released connection is handed out again,
+// and that a connection closed by the peer is replaced.
+
+namespace basic_connection_pool_reuse {
+
+void test()
+{
+#if defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::endpoint endpoint = acceptor.local_endpoint();
+  tcp_pool pool(ioc);
+
+  asio::error_code ec;
+  bool called = false;
+  tcp_pool::socket_type socket1(ioc);
+  pool.async_acquire(endpoint, socket1,
+      bindns::bind(handle_acquire, _1, &ec, &called));
+  ASIO_CHECK(!called);
+
+  run_until(ioc, called);
+  ASIO_CHECK(called);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(socket1.is_open());
+
+  ip::tcp::socket server(ioc);
+  acceptor.accept(server);
+  ip::tcp::endpoint local_endpoint = socket1.local_endpoint();
+
+  pool.release(endpoint, socket1);
+  ASIO_CHECK(!socket1.is_open());
+  ASIO_CHECK(pool.idle_connections() == 1);
+
+  // The idle connection is reused.
+  called = false;
+  tcp_pool::socket_type socket2(ioc);
+  pool.async_acquire(endpoint, socket2,
+      bindns::bind(handle_acquire, _1, &ec, &called));
+  ASIO_CHECK(!called);
+  ASIO_CHECK(pool.idle_connections() == 0);
+
+  run_until(ioc, called);
+  ASIO_CHECK(called);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(socket2.local_endpoint() == local_endpoint);
+
+  pool.release(endpoint, socket2);
+  ASIO_CHECK(pool.idle_connections() == 1);
+
+  // A connection closed by the peer fails the health check and is replaced.
+  server.close();
+  ioc.restart();
+  ioc.run_for(chrono::milliseconds(50));
+
+  called = false;
+  tcp_pool::socket_type socket3(ioc);
+  pool.async_acquire(endpoint, socket3,
+      bindns::bind(handle_acquire, _1, &ec, &called));
+  ASIO_CHECK(pool.idle_connections() == 0);
+
+  run_until(ioc, called);
+  ASIO_CHECK(called);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(socket3.is_open());
+  ASIO_CHECK(socket3.local_endpoint() != local_endpoint);
+#endif // defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+}
+
+} // namespace basic_connection_pool_reuse
+
+//------------------------------------------------------------------------------
+
+// basic_connection_pool_limit test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that an acquire operation waits once the limit on
+// connections to an endpoint is reached, and that waiting operations are
+// aborted when the pool is destroyed.
+
+namespace basic_connection_pool_limit {
+
+void test()
+{
+#if defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::endpoint endpoint = acceptor.local_endpoint();
+
+  asio::error_code ec1, ec2, ec3;
+  bool called1 = false, called2 = false, called3 = false;
+  tcp_pool::socket_type socket1(ioc);
+  tcp_pool::socket_type socket2(ioc);
+  tcp_pool::socket_type socket3(ioc);
+
+  {
+    tcp_pool pool(ioc);
+    pool.max_connections_per_endpoint(1);
+
+    pool.async_acquire(endpoint, socket1,
+        bindns::bind(handle_acquire, _1, &ec1, &called1));
+    pool.async_acquire(endpoint, socket2,
+        bindns::bind(handle_acquire, _1, &ec2, &called2));
+
+    run_until(ioc, called1);
+    ASIO_CHECK(called1);
+    ASIO_CHECK(!ec1);
+    ASIO_CHECK(!called2);
+
+    ip::tcp::endpoint local_endpoint = socket1.local_endpoint();
+
+    // Releasing the connection hands it to the waiting operation.
+    pool.release(endpoint, socket1);
+    ASIO_CHECK(pool.idle_connections() == 0);
+
+    run_until(ioc, called2);
+    ASIO_CHECK(called2);
+    ASIO_CHECK(!ec2);
+    ASIO_CHECK(socket2.local_endpoint() == local_endpoint);
+
+    pool.async_acquire(endpoint, socket3,
+        bindns::bind(handle_acquire, _1, &ec3, &called3));
+
+    ioc.restart();
+    ioc.poll();
+    ASIO_CHECK(!called3);
+  }
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called3);
+  ASIO_CHECK(ec3 == asio::error::operation_aborted);
+#endif // defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+}
+
+} // namespace basic_connection_pool_limit
+
+//------------------------------------------------------------------------------
+
+// basic_connection_pool_idle_timeout test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that idle connections are closed once the idle
+// timeout has elapsed.
+
+namespace basic_connection_pool_idle_timeout {
+
+void test()
+{
+#if defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::endpoint endpoint = acceptor.local_endpoint();
+  tcp_pool pool(ioc);
+  pool.idle_timeout(chrono::milliseconds(20));
+
+  asio::error_code ec;
+  bool called = false;
+  tcp_pool::socket_type socket1(ioc);
+  pool.async_acquire(endpoint, socket1,
+      bindns::bind(handle_acquire, _1, &ec, &called));
+
+  run_until(ioc, called);
+  ASIO_CHECK(called);
+  ASIO_CHECK(!ec);
+
+  pool.release(endpoint, socket1);
+  ASIO_CHECK(pool.idle_connections() == 1);
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(pool.idle_connections() == 0);
+#endif // defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+}
+
+} // namespace basic_connection_pool_idle_timeout
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "basic_connection_pool",
+  ASIO_COMPILE_TEST_CASE(basic_connection_pool_compile::test)
+  ASIO_TEST_CASE(basic_connection_pool_reuse::test)
+  ASIO_TEST_CASE(basic_connection_pool_limit::test)
+  ASIO_TEST_CASE(basic_connection_pool_idle_timeout::test)
+)
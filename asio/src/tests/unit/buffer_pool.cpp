@@ -0,0 +1,200 @@
+//
+// buffer_pool.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/buffer_pool.hpp"
+
+#include <cstring>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+using bindns::placeholders::_1;
+using bindns::placeholders::_2;
+
+//------------------------------------------------------------------------------
+
+// buffer_pool_reuse test
+// ~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that released buffers are reused, and that no more
+// than the maximum number of idle buffers are retained.
+
+namespace buffer_pool_reuse {
+
+void test()
+{
+  asio::buffer_pool pool(1024, 2);
+  ASIO_CHECK(pool.buffer_size() == 1024);
+  ASIO_CHECK(pool.in_use() == 0);
+  ASIO_CHECK(pool.idle() == 0);
+
+  asio::mutable_buffer b1 = pool.acquire();
+  asio::mutable_buffer b2 = pool.acquire();
+  asio::mutable_buffer b3 = pool.acquire();
+  ASIO_CHECK(b1.size() == 1024);
+  ASIO_CHECK(b1.data() != 0);
+  ASIO_CHECK(b1.data() != b2.data());
+  ASIO_CHECK(pool.in_use() == 3);
+
+  pool.release(b1);
+  pool.release(asio::buffer(b2, 100));
+  pool.release(b3);
+  ASIO_CHECK(pool.in_use() == 0);
+  ASIO_CHECK(pool.idle() == 2);
+
+  asio::mutable_buffer b4 = pool.acquire();
+  ASIO_CHECK(b4.size() == 1024);
+  ASIO_CHECK(pool.in_use() == 1);
+  ASIO_CHECK(pool.idle() == 1);
+  pool.release(b4);
+
+  // Releasing an empty buffer has no effect.
+  pool.release(asio::mutable_buffer());
+  ASIO_CHECK(pool.in_use() == 0);
+  ASIO_CHECK(pool.idle() == 2);
+}
+
+} // namespace buffer_pool_reuse
+
+//------------------------------------------------------------------------------
+
+// buffer_pool_read test
+// ~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a pooled read holds a buffer only once data
+// has arrived.
+
+namespace buffer_pool_read {
+
+#if defined(ASIO_HAS_POOLED_READ)
+
+void handle_read(const asio::error_code& err, asio::mutable_buffer data,
+    asio::error_code* result_ec, asio::mutable_buffer* result)
+{
+  *result_ec = err;
+  *result = data;
+}
+
+// A pool that has no buffers to give.
+struct empty_pool
+{
+  asio::mutable_buffer acquire()
+  {
+    return asio::mutable_buffer();
+  }
+
+  void release(const asio::mutable_buffer&)
+  {
+  }
+};
+
+#endif // defined(ASIO_HAS_POOLED_READ)
+
+void test()
+{
+#if defined(ASIO_HAS_POOLED_READ)
+  using namespace std; // For memcmp.
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+  buffer_pool pool(4096);
+
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::socket client(ioc);
+  client.connect(acceptor.local_endpoint());
+  ip::tcp::socket server(ioc);
+  acceptor.accept(server);
+
+  asio::error_code ec;
+  mutable_buffer data;
+  server.async_read_some_pooled(pool,
+      bindns::bind(handle_read, _1, _2, &ec, &data));
+
+  // No buffer is held while waiting for data.
+  ioc.poll();
+  ASIO_CHECK(data.size() == 0);
+  ASIO_CHECK(pool.in_use() == 0);
+
+  const char msg[] = "0123456789";
+  write(client, buffer(msg));
+  ioc.run();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(data.size() == sizeof(msg));
+  ASIO_CHECK(memcmp(data.data(), msg, sizeof(msg)) == 0);
+  ASIO_CHECK(pool.in_use() == 1);
+  pool.release(data);
+  ASIO_CHECK(pool.in_use() == 0);
+
+  // The operation completes with an error if no buffer is available.
+  empty_pool exhausted;
+  write(client, buffer(msg));
+  server.async_read_some_pooled(exhausted,
+      bindns::bind(handle_read, _1, _2, &ec, &data));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(ec == asio::error::no_buffer_space);
+  ASIO_CHECK(data.size() == 0);
+
+  // The data remains available to a later read.
+  server.async_read_some_pooled(pool,
+      bindns::bind(handle_read, _1, _2, &ec, &data));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(data.size() == sizeof(msg));
+  pool.release(data);
+
+  // End of file completes with an empty buffer.
+  client.close();
+  server.async_read_some_pooled(pool,
+      bindns::bind(handle_read, _1, _2, &ec, &data));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(ec == asio::error::eof);
+  ASIO_CHECK(data.size() == 0);
+  ASIO_CHECK(pool.in_use() == 0);
+#endif // defined(ASIO_HAS_POOLED_READ)
+}
+
+} // namespace buffer_pool_read
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "buffer_pool",
+  ASIO_TEST_CASE(buffer_pool_reuse::test)
+  ASIO_TEST_CASE(buffer_pool_read::test)
+)
@@ -0,0 +1,105 @@
+//
+// cancellation_signal.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/cancellation_signal.hpp"
+
+#include "unit_test.hpp"
+
+namespace cancellation_signal_test {
+
+struct counting_handler
+{
+  explicit counting_handler(int* calls)
+    : calls_(calls)
+  {
+  }
+
+  void operator()()
+  {
+    ++(*calls_);
+  }
+
+  int* calls_;
+};
+
+struct large_handler : counting_handler
+{
+  explicit large_handler(int* calls)
+    : counting_handler(calls)
+  {
+  }
+
+  char padding_[256];
+};
+
+void test()
+{
+  asio::cancellation_slot unconnected_slot;
+  ASIO_CHECK(!unconnected_slot.is_connected());
+  ASIO_CHECK(!unconnected_slot.has_handler());
+  unconnected_slot.clear();
+
+  asio::cancellation_signal signal;
+  asio::cancellation_slot slot = signal.slot();
+  ASIO_CHECK(slot.is_connected());
+  ASIO_CHECK(!slot.has_handler());
+  ASIO_CHECK(slot == signal.slot());
+  ASIO_CHECK(slot != unconnected_slot);
+
+  // Emitting a signal with no handler has no effect.
+  signal.emit();
+
+  int calls = 0;
+  counting_handler& h1 = slot.emplace<counting_handler>(&calls);
+  ASIO_CHECK(slot.has_handler());
+  ASIO_CHECK(h1.calls_ == &calls);
+
+  signal.emit();
+  ASIO_CHECK(calls == 1);
+  signal.emit();
+  ASIO_CHECK(calls == 2);
+
+  // A new handler replaces the old one, reusing its storage.
+  int other_calls = 0;
+  counting_handler& h2 = slot.assign(counting_handler(&other_calls));
+  ASIO_CHECK(&h2 == &h1);
+  signal.emit();
+  ASIO_CHECK(calls == 2);
+  ASIO_CHECK(other_calls == 1);
+
+  // A larger handler needs new storage.
+  slot.emplace<large_handler>(&calls);
+  signal.emit();
+  ASIO_CHECK(calls == 3);
+  ASIO_CHECK(other_calls == 1);
+
+  slot.clear();
+  ASIO_CHECK(!slot.has_handler());
+  ASIO_CHECK(slot.is_connected());
+  signal.emit();
+  ASIO_CHECK(calls == 3);
+
+  // The signal destroys any handler that is still installed.
+  slot.emplace<counting_handler>(&calls);
+}
+
+} // namespace cancellation_signal_test
+
+ASIO_TEST_SUITE
+(
+  "cancellation_signal",
+  ASIO_TEST_CASE(cancellation_signal_test::test)
+)
@@ -17,6 +17,8 @@
 #include "asio/connect.hpp"
 
 #include <vector>
+#include "asio/bind_cancellation_slot.hpp"
+#include "asio/cancellation_signal.hpp"
 #include "asio/detail/thread.hpp"
 #include "asio/ip/tcp.hpp"
 
@@ -812,6 +814,21 @@ void test_async_connect_range()
   io_context.run();
   ASIO_CHECK(result == endpoints[1]);
   ASIO_CHECK(!ec);
+
+  // An attempt that is cancelled through the handler's cancellation slot ends
+  // the operation, rather than moving on to the next endpoint.
+  endpoints.erase(endpoints.begin());
+
+  asio::cancellation_signal signal;
+  asio::async_connect(socket, endpoints,
+      asio::bind_cancellation_slot(signal.slot(),
+        bindns::bind(range_handler, _1, _2, &ec, &result)));
+  signal.emit();
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(result == asio::ip::tcp::endpoint());
+  ASIO_CHECK(ec == asio::error::operation_aborted);
+  ASIO_CHECK(!signal.slot().has_handler());
 }
 
 void test_async_connect_range_cond()
@@ -1172,6 +1189,94 @@ void test_async_connect_iter_cond()
   ASIO_CHECK(ec == asio::error::not_found);
 }
 
+void test_async_race_connect()
+{
+#if defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+  connection_sink sink;
+  asio::io_context io_context;
+  asio::ip::tcp::socket socket(io_context);
+  std::vector<asio::ip::tcp::endpoint> endpoints;
+  asio::ip::tcp::endpoint result;
+  asio::error_code ec;
+
+  asio::async_race_connect(socket, endpoints,
+      asio::chrono::milliseconds(10),
+      bindns::bind(range_handler, _1, _2, &ec, &result));
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(result == asio::ip::tcp::endpoint());
+  ASIO_CHECK(ec == asio::error::not_found);
+
+  endpoints.push_back(sink.target_endpoint());
+
+  asio::async_race_connect(socket, endpoints,
+      asio::chrono::milliseconds(10),
+      bindns::bind(range_handler, _1, _2, &ec, &result));
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(result == endpoints[0]);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(socket.is_open());
+  ASIO_CHECK(socket.remote_endpoint(ec) == sink.target_endpoint());
+
+  // An endpoint that does not respond must not hold up the next one for
+  // longer than the attempt delay.
+  endpoints.insert(endpoints.begin(), asio::ip::tcp::endpoint(
+        asio::ip::make_address_v4("192.0.2.1"), 9));
+
+  asio::chrono::steady_clock::time_point start
+    = asio::chrono::steady_clock::now();
+  asio::async_race_connect(socket, endpoints,
+      asio::chrono::milliseconds(10),
+      bindns::bind(range_handler, _1, _2, &ec, &result));
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(result == endpoints[1]);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(socket.is_open());
+  ASIO_CHECK(asio::chrono::steady_clock::now() - start
+      < asio::chrono::seconds(5));
+
+  endpoints.clear();
+  endpoints.push_back(asio::ip::tcp::endpoint());
+  endpoints.push_back(asio::ip::tcp::endpoint());
+
+  asio::async_race_connect(socket, endpoints,
+      asio::chrono::milliseconds(10),
+      bindns::bind(range_handler, _1, _2, &ec, &result));
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(result == asio::ip::tcp::endpoint());
+  ASIO_CHECK(!!ec);
+  ASIO_CHECK(!socket.is_open());
+
+  endpoints.push_back(sink.target_endpoint());
+
+  asio::async_race_connect(socket, endpoints,
+      asio::chrono::milliseconds(10),
+      bindns::bind(range_handler, _1, _2, &ec, &result));
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(result == endpoints[2]);
+  ASIO_CHECK(!ec);
+
+  asio::cancellation_signal signal;
+  asio::async_race_connect(socket, endpoints,
+      asio::chrono::milliseconds(10),
+      asio::bind_cancellation_slot(signal.slot(),
+        bindns::bind(range_handler, _1, _2, &ec, &result)));
+  signal.emit();
+  io_context.restart();
+  io_context.run();
+  ASIO_CHECK(result == asio::ip::tcp::endpoint());
+  ASIO_CHECK(ec == asio::error::operation_aborted);
+  ASIO_CHECK(!socket.is_open());
+
+  // Emitting the signal after the operation has completed has no effect.
+  signal.emit();
+#endif // defined(ASIO_HAS_MOVE) && defined(ASIO_HAS_CHRONO)
+}
+
 ASIO_TEST_SUITE
 (
   "connect",
@@ -1187,4 +1292,5 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(test_async_connect_range_cond)
   ASIO_TEST_CASE(test_async_connect_iter)
   ASIO_TEST_CASE(test_async_connect_iter_cond)
+  ASIO_TEST_CASE(test_async_race_connect)
 )
@@ -0,0 +1,250 @@
+//
+// detail/thread_info_base.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/detail/thread_info_base.hpp"
+
+#include "asio/thread.hpp"
+#include "../unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+using asio::detail::thread_info_base;
+
+//------------------------------------------------------------------------------
+
+// thread_info_base_size_class test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a freed block is recycled and then reused by
+// an allocation in the same size class, but not by one in a different class.
+
+namespace thread_info_base_size_class {
+
+void test()
+{
+  const std::size_t sizes[] = { 16, 32, 64, 128, 256, 512, 1020 };
+  const std::size_t num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+
+  thread_info_base info;
+  thread_info_base::cache_statistics stats;
+
+  for (std::size_t i = 0; i < num_sizes; ++i)
+  {
+    void* p1 = thread_info_base::allocate(&info, sizes[i]);
+    stats = thread_info_base::statistics(&info);
+    ASIO_CHECK(stats.misses == i + 1);
+    ASIO_CHECK(stats.hits == i);
+
+    thread_info_base::deallocate(&info, p1, sizes[i]);
+    stats = thread_info_base::statistics(&info);
+    ASIO_CHECK(stats.recycled == 2 * i + 1);
+    ASIO_CHECK(stats.released == 0);
+
+    // A smaller request that maps to the same class reuses the block.
+    std::size_t size = sizes[i] - 3;
+    void* p2 = thread_info_base::allocate(&info, size);
+    ASIO_CHECK(p2 == p1);
+    stats = thread_info_base::statistics(&info);
+    ASIO_CHECK(stats.hits == i + 1);
+    ASIO_CHECK(stats.misses == i + 1);
+
+    thread_info_base::deallocate(&info, p2, size);
+  }
+
+  // Each size class now holds one block. Allocations in a class only take
+  // blocks from that class.
+  void* small = thread_info_base::allocate(&info, 16);
+  void* medium = thread_info_base::allocate(&info, 100);
+  stats = thread_info_base::statistics(&info);
+  ASIO_CHECK(stats.hits == num_sizes + 2);
+  ASIO_CHECK(stats.misses == num_sizes);
+  ASIO_CHECK(small != medium);
+
+  void* other_small = thread_info_base::allocate(&info, 16);
+  stats = thread_info_base::statistics(&info);
+  ASIO_CHECK(stats.hits == num_sizes + 2);
+  ASIO_CHECK(stats.misses == num_sizes + 1);
+
+  thread_info_base::deallocate(&info, other_small, 16);
+  thread_info_base::deallocate(&info, medium, 100);
+  thread_info_base::deallocate(&info, small, 16);
+  stats = thread_info_base::statistics(&info);
+  ASIO_CHECK(stats.recycled == 2 * num_sizes + 3);
+  ASIO_CHECK(stats.released == 0);
+}
+
+} // namespace thread_info_base_size_class
+
+//------------------------------------------------------------------------------
+
+// thread_info_base_cache_size test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that no more than
+// ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE blocks are retained per size class, and
+// that blocks beyond that limit are released.
+
+namespace thread_info_base_cache_size {
+
+void test()
+{
+  const std::size_t cache_size = ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE;
+  const std::size_t extra = 2;
+  void* blocks[ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE + 2];
+
+  thread_info_base info;
+  thread_info_base::cache_statistics stats;
+
+  for (std::size_t i = 0; i < cache_size + extra; ++i)
+    blocks[i] = thread_info_base::allocate(&info, 64);
+  stats = thread_info_base::statistics(&info);
+  ASIO_CHECK(stats.misses == cache_size + extra);
+
+  for (std::size_t i = 0; i < cache_size + extra; ++i)
+    thread_info_base::deallocate(&info, blocks[i], 64);
+  stats = thread_info_base::statistics(&info);
+  ASIO_CHECK(stats.recycled == cache_size);
+  ASIO_CHECK(stats.released == extra);
+
+  // Only the retained blocks are available for reuse.
+  for (std::size_t i = 0; i < cache_size + extra; ++i)
+    blocks[i] = thread_info_base::allocate(&info, 64);
+  stats = thread_info_base::statistics(&info);
+  ASIO_CHECK(stats.hits == cache_size);
+  ASIO_CHECK(stats.misses == 2 * (cache_size + extra) - cache_size);
+
+  for (std::size_t i = 0; i < cache_size + extra; ++i)
+    thread_info_base::deallocate(&info, blocks[i], 64);
+
+  // The limit applies to each purpose separately.
+  void* frame = thread_info_base::allocate(
+      thread_info_base::awaitable_frame_tag(), &info, 64);
+  stats = thread_info_base::statistics(&info);
+  ASIO_CHECK(stats.hits == cache_size);
+
+  thread_info_base::deallocate(
+      thread_info_base::awaitable_frame_tag(), &info, frame, 64);
+  stats = thread_info_base::statistics(&info);
+  ASIO_CHECK(stats.recycled == 2 * cache_size + 1);
+  ASIO_CHECK(stats.released == 2 * extra);
+}
+
+} // namespace thread_info_base_cache_size
+
+//------------------------------------------------------------------------------
+
+// thread_info_base_cross_thread test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a block freed on a different thread to the
+// one that allocated it is retained in the cache of the freeing thread.
+
+namespace thread_info_base_cross_thread {
+
+void free_and_reallocate(void* pointer, void** result,
+    thread_info_base::cache_statistics* stats)
+{
+  thread_info_base info;
+  thread_info_base::deallocate(&info, pointer, 200);
+  *result = thread_info_base::allocate(&info, 200);
+  *stats = thread_info_base::statistics(&info);
+  thread_info_base::deallocate(&info, *result, 200);
+}
+
+void test()
+{
+  thread_info_base info;
+
+  void* p = thread_info_base::allocate(&info, 200);
+  void* result = 0;
+  thread_info_base::cache_statistics other_stats = { 0, 0, 0, 0 };
+
+  asio::thread th(bindns::bind(free_and_reallocate, p, &result, &other_stats));
+  th.join();
+
+  ASIO_CHECK(result == p);
+  ASIO_CHECK(other_stats.recycled == 1);
+  ASIO_CHECK(other_stats.hits == 1);
+  ASIO_CHECK(other_stats.misses == 0);
+
+  // The allocating thread's cache is unaffected.
+  thread_info_base::cache_statistics stats =
+    thread_info_base::statistics(&info);
+  ASIO_CHECK(stats.misses == 1);
+  ASIO_CHECK(stats.recycled == 0);
+  ASIO_CHECK(stats.released == 0);
+}
+
+} // namespace thread_info_base_cross_thread
+
+//------------------------------------------------------------------------------
+
+// thread_info_base_oversize test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that allocations larger than the largest size
+// class bypass the cache.
+
+namespace thread_info_base_oversize {
+
+void test()
+{
+  thread_info_base info;
+  thread_info_base::cache_statistics stats;
+
+  const std::size_t sizes[] = { 1021, 4096 };
+  for (std::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+  {
+    void* p = thread_info_base::allocate(&info, sizes[i]);
+    thread_info_base::deallocate(&info, p, sizes[i]);
+    p = thread_info_base::allocate(&info, sizes[i]);
+    thread_info_base::deallocate(&info, p, sizes[i]);
+  }
+
+  stats = thread_info_base::statistics(&info);
+  ASIO_CHECK(stats.hits == 0);
+  ASIO_CHECK(stats.misses == 4);
+  ASIO_CHECK(stats.recycled == 0);
+  ASIO_CHECK(stats.released == 4);
+
+  // Without thread information, nothing is cached or counted.
+  void* p = thread_info_base::allocate(0, 64);
+  thread_info_base::deallocate(0, p, 64);
+  stats = thread_info_base::statistics(0);
+  ASIO_CHECK(stats.hits == 0);
+  ASIO_CHECK(stats.misses == 0);
+  ASIO_CHECK(stats.recycled == 0);
+  ASIO_CHECK(stats.released == 0);
+}
+
+} // namespace thread_info_base_oversize
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "detail/thread_info_base",
+  ASIO_TEST_CASE(thread_info_base_size_class::test)
+  ASIO_TEST_CASE(thread_info_base_cache_size::test)
+  ASIO_TEST_CASE(thread_info_base_cross_thread::test)
+  ASIO_TEST_CASE(thread_info_base_oversize::test)
+)
@@ -16,10 +16,259 @@
 // Test that header file is self-contained.
 #include "asio/executor.hpp"
 
+#include <stdexcept>
+#include "asio/io_context.hpp"
+#include "asio/strand.hpp"
+#include "asio/system_executor.hpp"
 #include "unit_test.hpp"
 
+using namespace asio;
+
+// An executor that is too large to be stored inline in asio::executor.
+class large_executor
+{
+public:
+  explicit large_executor(io_context& ctx)
+    : executor_(ctx.get_executor())
+  {
+    padding_[0] = 0;
+  }
+
+  execution_context& context() const ASIO_NOEXCEPT
+  {
+    return executor_.context();
+  }
+
+  void on_work_started() const ASIO_NOEXCEPT
+  {
+    executor_.on_work_started();
+  }
+
+  void on_work_finished() const ASIO_NOEXCEPT
+  {
+    executor_.on_work_finished();
+  }
+
+  template <typename Function, typename Allocator>
+  void dispatch(ASIO_MOVE_ARG(Function) f, const Allocator& a) const
+  {
+    executor_.dispatch(ASIO_MOVE_CAST(Function)(f), a);
+  }
+
+  template <typename Function, typename Allocator>
+  void post(ASIO_MOVE_ARG(Function) f, const Allocator& a) const
+  {
+    executor_.post(ASIO_MOVE_CAST(Function)(f), a);
+  }
+
+  template <typename Function, typename Allocator>
+  void defer(ASIO_MOVE_ARG(Function) f, const Allocator& a) const
+  {
+    executor_.defer(ASIO_MOVE_CAST(Function)(f), a);
+  }
+
+  friend bool operator==(const large_executor& a,
+      const large_executor& b) ASIO_NOEXCEPT
+  {
+    return a.executor_ == b.executor_;
+  }
+
+  friend bool operator!=(const large_executor& a,
+      const large_executor& b) ASIO_NOEXCEPT
+  {
+    return a.executor_ != b.executor_;
+  }
+
+private:
+  io_context::executor_type executor_;
+  char padding_[256];
+};
+
+// A small executor whose copy constructor may throw, and which therefore cannot
+// be stored inline in asio::executor.
+class throwing_copy_executor
+{
+public:
+  explicit throwing_copy_executor(io_context& ctx)
+    : executor_(ctx.get_executor())
+  {
+  }
+
+  throwing_copy_executor(const throwing_copy_executor& other)
+    : executor_(other.executor_)
+  {
+    if (fail_copy)
+      throw std::runtime_error("throwing_copy_executor");
+  }
+
+  execution_context& context() const ASIO_NOEXCEPT
+  {
+    return executor_.context();
+  }
+
+  void on_work_started() const ASIO_NOEXCEPT
+  {
+    executor_.on_work_started();
+  }
+
+  void on_work_finished() const ASIO_NOEXCEPT
+  {
+    executor_.on_work_finished();
+  }
+
+  template <typename Function, typename Allocator>
+  void dispatch(ASIO_MOVE_ARG(Function) f, const Allocator& a) const
+  {
+    executor_.dispatch(ASIO_MOVE_CAST(Function)(f), a);
+  }
+
+  template <typename Function, typename Allocator>
+  void post(ASIO_MOVE_ARG(Function) f, const Allocator& a) const
+  {
+    executor_.post(ASIO_MOVE_CAST(Function)(f), a);
+  }
+
+  template <typename Function, typename Allocator>
+  void defer(ASIO_MOVE_ARG(Function) f, const Allocator& a) const
+  {
+    executor_.defer(ASIO_MOVE_CAST(Function)(f), a);
+  }
+
+  friend bool operator==(const throwing_copy_executor& a,
+      const throwing_copy_executor& b) ASIO_NOEXCEPT
+  {
+    return a.executor_ == b.executor_;
+  }
+
+  friend bool operator!=(const throwing_copy_executor& a,
+      const throwing_copy_executor& b) ASIO_NOEXCEPT
+  {
+    return a.executor_ != b.executor_;
+  }
+
+  static bool fail_copy;
+
+private:
+  io_context::executor_type executor_;
+};
+
+bool throwing_copy_executor::fail_copy = false;
+
+// A function object small enough to be stored inline.
+struct small_function
+{
+  int* count_;
+
+  void operator()()
+  {
+    ++(*count_);
+  }
+};
+
+// A function object too large to be stored inline.
+struct large_function
+{
+  int* count_;
+  char padding_[256];
+
+  void operator()()
+  {
+    ++(*count_);
+  }
+};
+
+template <typename Executor>
+void test_executor_copy_and_move(io_context& ctx, const Executor& e1)
+{
+  int count = 0;
+  small_function f1 = { &count };
+  large_function f2 = { &count, { 0 } };
+
+  executor ex1(e1);
+  ASIO_CHECK(ex1.target<Executor>() != 0);
+  ASIO_CHECK(*ex1.target<Executor>() == e1);
+
+  executor ex2(ex1);
+  ASIO_CHECK(ex2 == ex1);
+  ASIO_CHECK(ex2.target<Executor>() != 0);
+  ASIO_CHECK(*ex2.target<Executor>() == e1);
+
+  executor ex3;
+  ASIO_CHECK(!ex3);
+  ex3 = ex2;
+  ASIO_CHECK(ex3 == ex1);
+  const executor& self = ex3;
+  ex3 = self;
+  ASIO_CHECK(ex3 == ex1);
+
+#if defined(ASIO_HAS_MOVE)
+  executor ex4(std::move(ex3));
+  ASIO_CHECK(!ex3);
+  ASIO_CHECK(ex4 == ex1);
+
+  ex3 = std::move(ex4);
+  ASIO_CHECK(!ex4);
+  ASIO_CHECK(ex3 == ex1);
+#endif // defined(ASIO_HAS_MOVE)
+
+  ex2 = executor();
+  ASIO_CHECK(!ex2);
+  ASIO_CHECK(ex1 != ex2);
+
+  ex1.post(f1, std::allocator<void>());
+  ex1.post(f2, std::allocator<void>());
+  ex3.defer(f1, std::allocator<void>());
+  ex3.defer(f2, std::allocator<void>());
+  ex3.dispatch(f1, std::allocator<void>());
+  ex3.dispatch(f2, std::allocator<void>());
+  ASIO_CHECK(count == 0);
+
+  ctx.restart();
+  ctx.run();
+  ASIO_CHECK(count == 6);
+}
+
+void executor_copy_and_move_test()
+{
+  io_context ctx;
+
+  test_executor_copy_and_move(ctx, ctx.get_executor());
+  test_executor_copy_and_move(ctx, make_strand(ctx));
+  test_executor_copy_and_move(ctx, large_executor(ctx));
+  test_executor_copy_and_move(ctx, throwing_copy_executor(ctx));
+
+  // Copying or moving the polymorphic wrapper never copies an executor that
+  // may throw, as such executors are not stored inline.
+  executor ex0 = throwing_copy_executor(ctx);
+  throwing_copy_executor::fail_copy = true;
+  executor ex5(ex0);
+  ASIO_CHECK(ex5 == ex0);
+#if defined(ASIO_HAS_MOVE)
+  executor ex6(std::move(ex5));
+  ASIO_CHECK(ex6 == ex0);
+#endif // defined(ASIO_HAS_MOVE)
+  throwing_copy_executor::fail_copy = false;
+
+  executor ex1(ctx.get_executor());
+  executor ex2(make_strand(ctx));
+  executor ex3 = large_executor(ctx);
+  executor ex4 = system_executor();
+  ASIO_CHECK(ex1 != ex2);
+  ASIO_CHECK(ex1 != ex3);
+  ASIO_CHECK(ex1 != ex4);
+  ASIO_CHECK(ex2 != ex3);
+
+  ex1 = ex2;
+  ASIO_CHECK(ex1 == ex2);
+  ex2 = ex3;
+  ASIO_CHECK(ex2 == ex3);
+  ex3 = ex4;
+  ASIO_CHECK(ex3 == ex4);
+  ASIO_CHECK(ex3.target<system_executor>() != 0);
+}
+
 ASIO_TEST_SUITE
 (
   "executor",
-  ASIO_TEST_CASE(null_test)
+  ASIO_TEST_CASE(executor_copy_and_move_test)
 )
@@ -19,6 +19,8 @@
 #include <cstring>
 #include "asio/io_context.hpp"
 #include "asio/ip/tcp.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
 #include "../unit_test.hpp"
 
 #if defined(__cplusplus_cli) || defined(__cplusplus_winrt)
@@ -241,8 +243,209 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// generic_stream_protocol_converting_move test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that outstanding operations on a socket are
+// detached from the original object when the socket is moved into an object
+// of the generic::stream_protocol type.
+
+namespace generic_stream_protocol_converting_move {
+
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT)
+struct multishot_accept_handler
+{
+  asio::error_code* final_error_;
+  int* completions_;
+
+  void operator()(const asio::error_code& err, asio::ip::tcp::socket)
+  {
+    if (err)
+    {
+      *final_error_ = err;
+      ++(*completions_);
+    }
+  }
+};
+
+void test_multishot_accept()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+  typedef basic_socket_acceptor<generic::stream_protocol> acceptor_type;
+
+  io_context ioc;
+
+  ip::tcp::acceptor* tcp_acceptor = new ip::tcp::acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::endpoint server_endpoint = tcp_acceptor->local_endpoint();
+
+  error_code final_error;
+  int completions = 0;
+  multishot_accept_handler handler = { &final_error, &completions };
+  tcp_acceptor->async_multishot_accept(handler);
+  ioc.poll();
+
+  // The multishot operation is stopped by the move, and must not refer to the
+  // original acceptor once it has been destroyed.
+  acceptor_type acceptor(std::move(*tcp_acceptor));
+  delete tcp_acceptor;
+
+  ip::tcp::socket client_side_socket(ioc);
+  client_side_socket.connect(server_endpoint);
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(final_error == asio::error::operation_aborted);
+  ASIO_CHECK(acceptor.is_open());
+}
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
+
+#if defined(ASIO_HAS_MULTISHOT_RECEIVE) && defined(ASIO_HAS_MOVE)
+struct multishot_receive_handler
+{
+  asio::error_code* final_error_;
+  int* completions_;
+
+  void operator()(const asio::error_code& err, std::size_t)
+  {
+    if (err)
+    {
+      *final_error_ = err;
+      ++(*completions_);
+    }
+  }
+};
+
+void test_multishot_receive()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+  namespace generic = asio::generic;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket* tcp_socket = new ip::tcp::socket(ioc);
+  client_side_socket.connect(acceptor.local_endpoint());
+  acceptor.accept(*tcp_socket);
+
+  char read_buffer[100];
+  error_code final_error;
+  int completions = 0;
+  multishot_receive_handler handler = { &final_error, &completions };
+  tcp_socket->async_multishot_receive(buffer(read_buffer), handler);
+  ioc.poll();
+
+  // The multishot operation is stopped by the move, and must not refer to the
+  // original socket once it has been destroyed.
+  generic::stream_protocol::socket server_side_socket(std::move(*tcp_socket));
+  delete tcp_socket;
+
+  const char write_data[] = "hello";
+  asio::write(client_side_socket, buffer(write_data));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(final_error == asio::error::operation_aborted);
+  ASIO_CHECK(server_side_socket.is_open());
+
+  // The new socket remains usable.
+  asio::write(client_side_socket, buffer(write_data));
+  char read_data[sizeof(write_data)] = "";
+  std::size_t length = asio::read(server_side_socket, buffer(read_data));
+  ASIO_CHECK(length == sizeof(write_data));
+}
+#endif // defined(ASIO_HAS_MULTISHOT_RECEIVE) && defined(ASIO_HAS_MOVE)
+
+#if defined(ASIO_HAS_SOCKET_EXPIRY) && defined(ASIO_HAS_MOVE)
+struct read_handler
+{
+  asio::error_code* error_;
+  int* completions_;
+
+  void operator()(const asio::error_code& err, std::size_t)
+  {
+    *error_ = err;
+    ++(*completions_);
+  }
+};
+
+void test_expiry()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+  namespace generic = asio::generic;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+
+  char read_buffer[100];
+  error_code error;
+  int completions = 0;
+  read_handler handler = { &error, &completions };
+
+  for (int i = 0; i < 2; ++i)
+  {
+    ip::tcp::socket client_side_socket(ioc);
+    ip::tcp::socket* tcp_socket = new ip::tcp::socket(ioc);
+    client_side_socket.connect(acceptor.local_endpoint());
+    acceptor.accept(*tcp_socket);
+
+    completions = 0;
+    tcp_socket->expires_after(i == 0
+        ? chrono::steady_clock::duration(chrono::milliseconds(10))
+        : chrono::steady_clock::duration(chrono::hours(1)));
+    tcp_socket->async_read_some(buffer(read_buffer), handler);
+    ioc.restart();
+    ioc.poll();
+
+    generic::stream_protocol::socket server_side_socket(
+        std::move(*tcp_socket));
+    delete tcp_socket;
+
+    // The outstanding operation times out at the expiry time set on the
+    // original socket, or at an earlier one set on the new socket.
+    if (i == 1)
+      server_side_socket.expires_after(chrono::milliseconds(10));
+
+    ioc.restart();
+    ioc.run_for(chrono::seconds(5));
+
+    ASIO_CHECK(completions == 1);
+    ASIO_CHECK(error == asio::error::timed_out);
+  }
+}
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY) && defined(ASIO_HAS_MOVE)
+
+void test()
+{
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT)
+  test_multishot_accept();
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
+#if defined(ASIO_HAS_MULTISHOT_RECEIVE) && defined(ASIO_HAS_MOVE)
+  test_multishot_receive();
+#endif // defined(ASIO_HAS_MULTISHOT_RECEIVE) && defined(ASIO_HAS_MOVE)
+#if defined(ASIO_HAS_SOCKET_EXPIRY) && defined(ASIO_HAS_MOVE)
+  test_expiry();
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY) && defined(ASIO_HAS_MOVE)
+}
+
+} // namespace generic_stream_protocol_converting_move
+
+//------------------------------------------------------------------------------
+
 ASIO_TEST_SUITE
 (
   "generic/stream_protocol",
   ASIO_TEST_CASE(generic_stream_protocol_socket_compile::test)
+  ASIO_TEST_CASE(generic_stream_protocol_converting_move::test)
 )
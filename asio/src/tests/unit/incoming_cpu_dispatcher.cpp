@@ -0,0 +1,166 @@
+//
+// incoming_cpu_dispatcher.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/incoming_cpu_dispatcher.hpp"
+
+#include <stdexcept>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// incoming_cpu_dispatcher_mapping test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that CPUs are mapped to the correct executors.
+
+namespace incoming_cpu_dispatcher_mapping {
+
+void test()
+{
+  using namespace asio;
+
+  io_context ioc1;
+  io_context ioc2;
+  incoming_cpu_dispatcher<io_context::executor_type> d(ioc1.get_executor());
+
+  ASIO_CHECK(d.get_default_executor() == ioc1.get_executor());
+  ASIO_CHECK(d.get_executor(0) == ioc1.get_executor());
+  ASIO_CHECK(d.get_executor(-1) == ioc1.get_executor());
+
+  d.add(3, ioc2.get_executor());
+  ASIO_CHECK(d.get_executor(0) == ioc1.get_executor());
+  ASIO_CHECK(d.get_executor(3) == ioc2.get_executor());
+  ASIO_CHECK(d.get_executor(4) == ioc1.get_executor());
+
+  d.add(3, ioc1.get_executor());
+  ASIO_CHECK(d.get_executor(3) == ioc1.get_executor());
+
+  // Remapping a CPU does not affect the other mappings.
+  d.add(1, ioc2.get_executor());
+  for (int i = 0; i < 10; ++i)
+  {
+    d.add(3, (i % 2) ? ioc1.get_executor() : ioc2.get_executor());
+    ASIO_CHECK(d.get_executor(1) == ioc2.get_executor());
+  }
+  ASIO_CHECK(d.get_executor(3) == ioc1.get_executor());
+  d.add(1, ioc1.get_executor());
+  ASIO_CHECK(d.get_executor(1) == ioc1.get_executor());
+  ASIO_CHECK(d.get_executor(3) == ioc1.get_executor());
+
+#if !defined(ASIO_NO_EXCEPTIONS)
+  bool thrown = false;
+  try
+  {
+    d.add(-1, ioc2.get_executor());
+  }
+  catch (std::out_of_range&)
+  {
+    thrown = true;
+  }
+  ASIO_CHECK(thrown);
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+
+  // A socket whose CPU cannot be determined uses the default executor.
+  ip::tcp::socket s(ioc2);
+  ASIO_CHECK(d.select(s) == ioc1.get_executor());
+}
+
+} // namespace incoming_cpu_dispatcher_mapping
+
+//------------------------------------------------------------------------------
+
+// incoming_cpu_dispatcher_accept test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that sockets accepted using a dispatcher are
+// associated with the executor mapped to their incoming CPU.
+
+namespace incoming_cpu_dispatcher_accept {
+
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT)
+
+struct accept_handler
+{
+  const asio::incoming_cpu_dispatcher<
+    asio::io_context::executor_type>* dispatcher_;
+  std::vector<asio::ip::tcp::socket>* sockets_;
+
+  void operator()(const asio::error_code& err, asio::ip::tcp::socket peer)
+  {
+    if (!err)
+    {
+      ASIO_CHECK(peer.get_executor() == dispatcher_->select(peer));
+      sockets_->push_back(std::move(peer));
+    }
+  }
+};
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+  io_context shards[2];
+
+  // Map even CPUs to one shard and odd CPUs to the other.
+  incoming_cpu_dispatcher<io_context::executor_type> d(ioc.get_executor());
+  for (int cpu = 0; cpu < 64; ++cpu)
+    d.add(cpu, shards[cpu % 2].get_executor());
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  std::vector<ip::tcp::socket> server_side_sockets;
+  accept_handler handler = { &d, &server_side_sockets };
+  acceptor.async_multishot_accept(d, handler);
+
+  std::vector<ip::tcp::socket> client_side_sockets;
+  for (int i = 0; i < 4; ++i)
+  {
+    client_side_sockets.push_back(ip::tcp::socket(ioc));
+    client_side_sockets.back().connect(server_endpoint);
+  }
+
+  while (server_side_sockets.size() < 4)
+    ioc.run_one();
+
+  acceptor.close();
+  ioc.run();
+
+  ASIO_CHECK(server_side_sockets.size() == 4);
+}
+
+#else // defined(ASIO_HAS_MULTISHOT_ACCEPT)
+
+void test()
+{
+}
+
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
+
+} // namespace incoming_cpu_dispatcher_accept
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "incoming_cpu_dispatcher",
+  ASIO_TEST_CASE(incoming_cpu_dispatcher_mapping::test)
+  ASIO_TEST_CASE(incoming_cpu_dispatcher_accept::test)
+)
@@ -354,9 +354,169 @@ void io_context_service_test()
   ASIO_CHECK(!asio::has_service<test_service>(ioc3));
 }
 
+#if defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+  counting_resource()
+    : allocations_(0),
+      bytes_in_use_(0)
+  {
+  }
+
+  std::size_t allocations() const
+  {
+    return allocations_;
+  }
+
+  std::size_t bytes_in_use() const
+  {
+    return bytes_in_use_;
+  }
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment)
+  {
+    ++allocations_;
+    bytes_in_use_ += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+  {
+    bytes_in_use_ -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const ASIO_NOEXCEPT
+  {
+    return this == &other;
+  }
+
+  std::size_t allocations_;
+  std::size_t bytes_in_use_;
+};
+
+#endif // defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+
+void io_context_memory_resource_test()
+{
+#if defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+  counting_resource resource;
+
+  {
+    io_context ioc(&resource);
+    ASIO_CHECK(ioc.get_memory_resource() == &resource);
+
+    int count = 0;
+    post(ioc, bindns::bind(decrement_to_zero, &ioc, &count));
+    count = 5;
+
+    // The timer must not expire until the chain of posted handlers is done.
+    timer t(ioc, chronons::milliseconds(100));
+    t.async_wait(bindns::bind(increment, &count));
+
+    ioc.run();
+
+    ASIO_CHECK(count == 1);
+    ASIO_CHECK(resource.allocations() > 0);
+  }
+
+  // All memory must have been returned once the io_context is destroyed.
+  ASIO_CHECK(resource.bytes_in_use() == 0);
+
+  io_context ioc2;
+  ASIO_CHECK(ioc2.get_memory_resource() == 0);
+#endif // defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+}
+
+void io_context_reserve_trim_test()
+{
+  using namespace asio;
+
+  io_context ioc;
+  ioc.reserve(16, 16);
+
+  int count = 0;
+  timer t(ioc, chronons::milliseconds(1));
+  t.async_wait(bindns::bind(increment, &count));
+  post(ioc, bindns::bind(&io_context::trim, &ioc));
+  ioc.run();
+
+  ASIO_CHECK(count == 1);
+
+  ioc.trim();
+
+#if defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+  counting_resource resource;
+
+  {
+    io_context ioc2(&resource);
+    ioc2.reserve(16, 0);
+    std::size_t reserved_bytes = resource.bytes_in_use();
+
+    // Trimming retains the reserved capacity.
+    ioc2.trim();
+    ASIO_CHECK(resource.bytes_in_use() == reserved_bytes);
+
+    ioc2.reserve(0, 0);
+    ioc2.trim();
+    ASIO_CHECK(resource.bytes_in_use() < reserved_bytes);
+  }
+
+  ASIO_CHECK(resource.bytes_in_use() == 0);
+#endif // defined(ASIO_HAS_STD_MEMORY_RESOURCE)
+}
+
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
+void check_timer_operations(asio::io_context* ioc, std::size_t expected)
+{
+  asio::io_context::allocation_statistics s =
+    ioc->get_allocation_statistics(asio::io_context::timer_operations);
+  ASIO_CHECK(s.count == expected);
+  ASIO_CHECK(s.peak_count >= expected);
+}
+
+void start_timer(asio::io_context* ioc, timer* t, int* count)
+{
+  t->async_wait(bindns::bind(increment, count));
+  check_timer_operations(ioc, 1);
+}
+
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+
+void io_context_allocation_accounting_test()
+{
+#if defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+  using namespace asio;
+
+  io_context ioc;
+  check_timer_operations(&ioc, 0);
+
+  int count = 0;
+  timer t(ioc, chronons::milliseconds(1));
+  post(ioc, bindns::bind(start_timer, &ioc, &t, &count));
+  ioc.run();
+
+  ASIO_CHECK(count == 1);
+  check_timer_operations(&ioc, 0);
+
+  io_context::allocation_statistics s =
+    ioc.get_allocation_statistics(io_context::timer_operations);
+  ASIO_CHECK(s.bytes == 0);
+  ASIO_CHECK(s.peak_count == 1);
+  ASIO_CHECK(s.peak_bytes > 0);
+#endif // defined(ASIO_ENABLE_ALLOCATION_ACCOUNTING)
+}
+
 ASIO_TEST_SUITE
 (
   "io_context",
   ASIO_TEST_CASE(io_context_test)
   ASIO_TEST_CASE(io_context_service_test)
+  ASIO_TEST_CASE(io_context_memory_resource_test)
+  ASIO_TEST_CASE(io_context_reserve_trim_test)
+  ASIO_TEST_CASE(io_context_allocation_accounting_test)
 )
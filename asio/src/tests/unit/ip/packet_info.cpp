@@ -0,0 +1,133 @@
+//
+// packet_info.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/ip/packet_info.hpp"
+
+#include "asio/io_context.hpp"
+#include "asio/ip/udp.hpp"
+#include "../unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// ip_packet_info_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the ip::packet_info socket option compiles
+// and link correctly. Runtime failures are ignored.
+
+namespace ip_packet_info_compile {
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    ip::udp::socket sock(ioc);
+
+    // packet_info class.
+
+    ip::packet_info packet_info1(true);
+    sock.set_option(packet_info1);
+    ip::packet_info packet_info2;
+    sock.get_option(packet_info2);
+    packet_info1 = true;
+    (void)static_cast<bool>(packet_info1);
+    (void)static_cast<bool>(!packet_info1);
+    (void)static_cast<bool>(packet_info1.value());
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ip_packet_info_compile
+
+//------------------------------------------------------------------------------
+
+// ip_packet_info_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the ip::packet_info
+// socket option.
+
+namespace ip_packet_info_runtime {
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+  asio::error_code ec;
+
+  ip::udp::socket sock_v4(ioc, ip::udp::v4());
+
+  ip::packet_info packet_info1(true);
+  ASIO_CHECK(packet_info1.value());
+  ASIO_CHECK(static_cast<bool>(packet_info1));
+  ASIO_CHECK(!!packet_info1);
+  sock_v4.set_option(packet_info1, ec);
+  if (ec == asio::error::invalid_argument)
+    return; // Option is not supported on this platform.
+  ASIO_CHECK(!ec);
+
+  ip::packet_info packet_info2;
+  sock_v4.get_option(packet_info2, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(packet_info2.value());
+  ASIO_CHECK(static_cast<bool>(packet_info2));
+  ASIO_CHECK(!!packet_info2);
+
+  ip::packet_info packet_info3(false);
+  ASIO_CHECK(!packet_info3.value());
+  ASIO_CHECK(!static_cast<bool>(packet_info3));
+  ASIO_CHECK(!packet_info3);
+  sock_v4.set_option(packet_info3, ec);
+  ASIO_CHECK(!ec);
+
+  ip::packet_info packet_info4;
+  sock_v4.get_option(packet_info4, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(!packet_info4.value());
+  ASIO_CHECK(!static_cast<bool>(packet_info4));
+  ASIO_CHECK(!packet_info4);
+
+  ip::udp::socket sock_v6(ioc);
+  sock_v6.open(ip::udp::v6(), ec);
+  if (!ec)
+  {
+    ip::packet_info packet_info5(true);
+    sock_v6.set_option(packet_info5, ec);
+    ASIO_CHECK(!ec);
+
+    ip::packet_info packet_info6;
+    sock_v6.get_option(packet_info6, ec);
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(packet_info6.value());
+  }
+}
+
+} // namespace ip_packet_info_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "ip/packet_info",
+  ASIO_TEST_CASE(ip_packet_info_compile::test)
+  ASIO_TEST_CASE(ip_packet_info_runtime::test)
+)
@@ -19,9 +19,20 @@
 // Test that header file is self-contained.
 #include "asio/ip/tcp.hpp"
 
+#include <cstdio>
 #include <cstring>
+#include <string>
+#include <vector>
+#include "asio/bind_cancellation_slot.hpp"
+#include "asio/bind_executor.hpp"
+#include "asio/buffer_pool.hpp"
+#include "asio/cancellation_signal.hpp"
 #include "asio/io_context.hpp"
 #include "asio/read.hpp"
+#include "asio/read_until.hpp"
+#include "asio/steady_timer.hpp"
+#include "asio/strand.hpp"
+#include "asio/thread.hpp"
 #include "asio/write.hpp"
 #include "../unit_test.hpp"
 #include "../archetypes/async_result.hpp"
@@ -70,6 +81,16 @@ void test()
     (void)static_cast<bool>(no_delay1);
     (void)static_cast<bool>(!no_delay1);
     (void)static_cast<bool>(no_delay1.value());
+
+    // fast_open class.
+
+    ip::tcp::acceptor acceptor(ioc);
+    ip::tcp::fast_open fast_open1(16);
+    acceptor.set_option(fast_open1);
+    ip::tcp::fast_open fast_open2;
+    acceptor.get_option(fast_open2);
+    fast_open1 = 16;
+    (void)static_cast<int>(fast_open1.value());
   }
   catch (std::exception&)
   {
@@ -203,6 +224,23 @@ private:
 #endif // defined(ASIO_HAS_MOVE)
 };
 
+struct pooled_read_handler
+{
+  pooled_read_handler() {}
+  void operator()(const asio::error_code&, asio::mutable_buffer) {}
+#if defined(ASIO_HAS_MOVE)
+  pooled_read_handler(pooled_read_handler&&) {}
+private:
+  pooled_read_handler(const pooled_read_handler&);
+#endif // defined(ASIO_HAS_MOVE)
+};
+
+struct multishot_receive_handler
+{
+  multishot_receive_handler() {}
+  void operator()(const asio::error_code&, std::size_t) {}
+};
+
 void test()
 {
 #if defined(ASIO_HAS_BOOST_ARRAY)
@@ -310,6 +348,11 @@ void test()
     socket1.release();
     socket1.release(ec);
 
+#if defined(ASIO_HAS_SOCKET_MIGRATION)
+    socket1.migrate(ioc.get_executor());
+    socket1.migrate(ioc.get_executor(), ec);
+#endif // defined(ASIO_HAS_SOCKET_MIGRATION)
+
     ip::tcp::socket::native_handle_type native_socket5
       = socket1.native_handle();
     (void)native_socket5;
@@ -317,6 +360,13 @@ void test()
     socket1.cancel();
     socket1.cancel(ec);
 
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+    chrono::steady_clock::time_point expiry = socket1.expiry();
+    socket1.expires_at(expiry);
+    socket1.expires_after(chrono::seconds(1));
+    socket1.expires_never();
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
     bool at_mark1 = socket1.at_mark();
     (void)at_mark1;
     bool at_mark2 = socket1.at_mark(ec);
@@ -516,6 +566,67 @@ void test()
     (void)i26;
     int i27 = socket1.async_read_some(null_buffers(), lazy);
     (void)i27;
+
+    socket1.async_send_zero_copy(buffer(mutable_char_buffer), send_handler());
+    socket1.async_send_zero_copy(buffer(const_char_buffer), send_handler());
+    socket1.async_send_zero_copy(mutable_buffers, send_handler());
+    socket1.async_send_zero_copy(const_buffers, send_handler());
+    socket1.async_send_zero_copy(buffer(mutable_char_buffer),
+        in_flags, send_handler());
+    socket1.async_send_zero_copy(buffer(const_char_buffer),
+        in_flags, send_handler());
+    socket1.async_send_zero_copy(mutable_buffers, in_flags, send_handler());
+    socket1.async_send_zero_copy(const_buffers, in_flags, send_handler());
+    int i28 = socket1.async_send_zero_copy(buffer(const_char_buffer), lazy);
+    (void)i28;
+    int i29 = socket1.async_send_zero_copy(const_buffers, in_flags, lazy);
+    (void)i29;
+
+#if defined(ASIO_HAS_SENDFILE)
+    socket1.async_send_file(0, 0, 0, send_handler());
+    int i30 = socket1.async_send_file(0, 0, 0, lazy);
+    (void)i30;
+#endif // defined(ASIO_HAS_SENDFILE)
+
+#if defined(ASIO_HAS_RECEIVE_METADATA)
+    receive_metadata metadata;
+
+    socket1.async_receive_with_metadata(buffer(mutable_char_buffer),
+        metadata, receive_handler());
+    socket1.async_receive_with_metadata(mutable_buffers,
+        metadata, in_flags, receive_handler());
+    int i31 = socket1.async_receive_with_metadata(buffer(mutable_char_buffer),
+        metadata, lazy);
+    (void)i31;
+    int i32 = socket1.async_receive_with_metadata(mutable_buffers,
+        metadata, in_flags, lazy);
+    (void)i32;
+#endif // defined(ASIO_HAS_RECEIVE_METADATA)
+
+#if defined(ASIO_HAS_POOLED_READ)
+    buffer_pool pool(1024);
+
+    socket1.async_read_some_pooled(pool, pooled_read_handler());
+    int i33 = socket1.async_read_some_pooled(pool, lazy);
+    (void)i33;
+#endif // defined(ASIO_HAS_POOLED_READ)
+
+#if defined(ASIO_HAS_MULTISHOT_RECEIVE)
+    socket1.async_multishot_receive(buffer(mutable_char_buffer),
+        multishot_receive_handler());
+    socket1.async_multishot_receive(mutable_buffers,
+        multishot_receive_handler());
+#endif // defined(ASIO_HAS_MULTISHOT_RECEIVE)
+
+#if defined(ASIO_HAS_TCP_FAST_OPEN)
+    socket1.async_fast_open_connect(ip::tcp::endpoint(ip::tcp::v4(), 0),
+        buffer(const_char_buffer), send_handler());
+    socket1.async_fast_open_connect(ip::tcp::endpoint(ip::tcp::v6(), 0),
+        const_buffers, send_handler());
+    int i34 = socket1.async_fast_open_connect(
+        ip::tcp::endpoint(ip::tcp::v4(), 0), buffer(const_char_buffer), lazy);
+    (void)i34;
+#endif // defined(ASIO_HAS_TCP_FAST_OPEN)
   }
   catch (std::exception&)
   {
@@ -567,6 +678,31 @@ void handle_write(const asio::error_code& err,
   ASIO_CHECK(bytes_transferred == sizeof(write_data));
 }
 
+void handle_send_zero_copy(const asio::error_code& err,
+    size_t bytes_transferred, size_t* sent)
+{
+  ASIO_CHECK(!err);
+  ASIO_CHECK(bytes_transferred > 0);
+  *sent = bytes_transferred;
+}
+
+#if defined(ASIO_HAS_SENDFILE)
+void handle_send_file(const asio::error_code& err,
+    size_t bytes_transferred, asio::error_code* result, size_t* sent)
+{
+  *result = err;
+  *sent = bytes_transferred;
+}
+
+void handle_large_read(const asio::error_code& err,
+    size_t bytes_transferred, bool* called)
+{
+  *called = true;
+  ASIO_CHECK(!err);
+  ASIO_CHECK(bytes_transferred == 60000);
+}
+#endif // defined(ASIO_HAS_SENDFILE)
+
 void handle_read_cancel(const asio::error_code& err,
     size_t bytes_transferred, bool* called)
 {
@@ -653,6 +789,75 @@ void test()
   ASIO_CHECK(write_completed);
   ASIO_CHECK(memcmp(read_buffer, write_data, sizeof(write_data)) == 0);
 
+  // Zero-copy sends, both above and below the threshold for copying.
+
+  std::vector<char> large_write_data(65536);
+  for (size_t i = 0; i < large_write_data.size(); ++i)
+    large_write_data[i] = static_cast<char>(i % 251);
+  std::vector<char> large_read_data(large_write_data.size());
+
+  for (int i = 0; i < 4; ++i)
+  {
+    size_t size = (i % 2) ? large_write_data.size() : sizeof(write_data);
+    size_t sent = 0;
+    server_side_socket.async_send_zero_copy(
+        asio::buffer(large_write_data, size),
+        bindns::bind(handle_send_zero_copy, _1, _2, &sent));
+
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(sent > 0);
+
+    size_t length = asio::read(client_side_socket,
+        asio::buffer(large_read_data, sent));
+    ASIO_CHECK(length == sent);
+    ASIO_CHECK(memcmp(&large_read_data[0], &large_write_data[0], sent) == 0);
+  }
+
+#if defined(ASIO_HAS_SENDFILE)
+  // Send a range of bytes from a file, then attempt to send beyond its end.
+
+  if (FILE* file = std::tmpfile())
+  {
+    std::fwrite(&large_write_data[0], 1, large_write_data.size(), file);
+    std::fflush(file);
+
+    asio::error_code send_file_error;
+    size_t sent = 0;
+    server_side_socket.async_send_file(fileno(file), 1000, 60000,
+        bindns::bind(handle_send_file, _1, _2, &send_file_error, &sent));
+
+    bool large_read_completed = false;
+    asio::async_read(client_side_socket,
+        asio::buffer(large_read_data, 60000),
+        bindns::bind(handle_large_read, _1, _2, &large_read_completed));
+
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(!send_file_error);
+    ASIO_CHECK(sent == 60000);
+    ASIO_CHECK(large_read_completed);
+    ASIO_CHECK(memcmp(&large_read_data[0],
+          &large_write_data[1000], 60000) == 0);
+
+    server_side_socket.async_send_file(fileno(file), 60000, 10000,
+        bindns::bind(handle_send_file, _1, _2, &send_file_error, &sent));
+
+    ioc.restart();
+    ioc.run();
+    ASIO_CHECK(send_file_error == asio::error::eof);
+    ASIO_CHECK(sent == large_write_data.size() - 60000);
+
+    size_t length = asio::read(client_side_socket,
+        asio::buffer(large_read_data, sent));
+    ASIO_CHECK(length == sent);
+    ASIO_CHECK(memcmp(&large_read_data[0],
+          &large_write_data[60000], sent) == 0);
+
+    std::fclose(file);
+  }
+#endif // defined(ASIO_HAS_SENDFILE)
+
   // Cancelled read.
 
   bool read_cancel_completed = false;
@@ -690,6 +895,970 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ip_tcp_socket_multishot_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the multishot receive
+// function of the ip::tcp::socket class.
+
+namespace ip_tcp_socket_multishot_runtime {
+
+#if defined(ASIO_HAS_MULTISHOT_RECEIVE)
+
+struct multishot_receive_handler
+{
+  const char* buffer_;
+  std::vector<char>* received_;
+  asio::error_code* final_error_;
+  int* completions_;
+  asio::ip::tcp::socket* socket_to_close_;
+
+  void operator()(const asio::error_code& err, std::size_t bytes_transferred)
+  {
+    if (err)
+    {
+      ASIO_CHECK(bytes_transferred == 0);
+      *final_error_ = err;
+      ++(*completions_);
+    }
+    else
+    {
+      ASIO_CHECK(*completions_ == 0);
+      ASIO_CHECK(bytes_transferred > 0);
+      received_->insert(received_->end(),
+          buffer_, buffer_ + bytes_transferred);
+      if (socket_to_close_)
+        socket_to_close_->close();
+    }
+  }
+};
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+  client_side_socket.connect(acceptor.local_endpoint());
+  acceptor.accept(server_side_socket);
+
+  // Data is delivered chunk by chunk until the peer closes the connection. The
+  // small buffer means that most reads are performed in-line.
+  std::vector<char> write_data(64 * 1024);
+  for (std::size_t i = 0; i < write_data.size(); ++i)
+    write_data[i] = static_cast<char>(i % 251);
+
+  char read_buffer[100];
+  std::vector<char> received;
+  error_code final_error;
+  int completions = 0;
+  multishot_receive_handler handler = { read_buffer,
+    &received, &final_error, &completions, 0 };
+  server_side_socket.async_multishot_receive(buffer(read_buffer), handler);
+
+  asio::write(client_side_socket, buffer(write_data, 10));
+  while (received.size() < 10)
+    ioc.run_one();
+
+  ASIO_CHECK(completions == 0);
+
+  asio::write(client_side_socket, buffer(write_data) + 10);
+  client_side_socket.close();
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(final_error == asio::error::eof);
+  ASIO_CHECK(received == write_data);
+
+  // No data is lost when the handler's executor defers its invocation, as a
+  // strand does when it is not running in the current thread.
+  client_side_socket = ip::tcp::socket(ioc);
+  server_side_socket = ip::tcp::socket(ioc);
+  client_side_socket.connect(acceptor.local_endpoint());
+  acceptor.accept(server_side_socket);
+
+  io_context handler_ioc;
+  received.clear();
+  completions = 0;
+  server_side_socket.async_multishot_receive(buffer(read_buffer),
+      bind_executor(make_strand(handler_ioc), handler));
+
+  asio::write(client_side_socket, buffer(write_data));
+  client_side_socket.close();
+  while (completions == 0)
+  {
+    ioc.restart();
+    ioc.poll();
+    handler_ioc.restart();
+    handler_ioc.poll();
+  }
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(final_error == asio::error::eof);
+  ASIO_CHECK(received == write_data);
+
+  // Cancellation stops the operation.
+  client_side_socket = ip::tcp::socket(ioc);
+  server_side_socket = ip::tcp::socket(ioc);
+  client_side_socket.connect(acceptor.local_endpoint());
+  acceptor.accept(server_side_socket);
+
+  received.clear();
+  completions = 0;
+  server_side_socket.async_multishot_receive(buffer(read_buffer), handler);
+
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(completions == 0);
+
+  server_side_socket.cancel();
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(final_error == asio::error::operation_aborted);
+  ASIO_CHECK(received.empty());
+
+  // The operation may be stopped by closing the socket from the handler.
+  completions = 0;
+  handler.socket_to_close_ = &server_side_socket;
+  server_side_socket.async_multishot_receive(buffer(read_buffer), handler);
+
+  asio::write(client_side_socket, buffer(write_data));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(received.size() > 0);
+  ASIO_CHECK(received.size() <= sizeof(read_buffer));
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(final_error == asio::error::operation_aborted);
+  ASIO_CHECK(!server_side_socket.is_open());
+
+  // A zero-sized buffer is rejected.
+  client_side_socket = ip::tcp::socket(ioc);
+  server_side_socket = ip::tcp::socket(ioc);
+  client_side_socket.connect(acceptor.local_endpoint());
+  acceptor.accept(server_side_socket);
+
+  completions = 0;
+  handler.socket_to_close_ = 0;
+  server_side_socket.async_multishot_receive(mutable_buffer(), handler);
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(final_error == asio::error::invalid_argument);
+}
+
+#else // defined(ASIO_HAS_MULTISHOT_RECEIVE)
+
+void test()
+{
+}
+
+#endif // defined(ASIO_HAS_MULTISHOT_RECEIVE)
+
+} // namespace ip_tcp_socket_multishot_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_tcp_socket_expiry_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of socket expiry times.
+
+namespace ip_tcp_socket_expiry_runtime {
+
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+
+struct expiry_handler
+{
+  asio::error_code* ec_;
+  int* completions_;
+
+  void operator()(const asio::error_code& err, std::size_t = 0)
+  {
+    *ec_ = err;
+    ++(*completions_);
+  }
+};
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+  typedef chrono::steady_clock clock;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+  client_side_socket.connect(acceptor.local_endpoint());
+  acceptor.accept(server_side_socket);
+
+  char read_buffer[16];
+  error_code ec;
+  int completions = 0;
+  expiry_handler handler = { &ec, &completions };
+
+  ASIO_CHECK(server_side_socket.expiry() == (clock::time_point::max)());
+
+  // An outstanding operation times out, leaving the socket open.
+  clock::time_point start = clock::now();
+  server_side_socket.expires_after(chrono::milliseconds(50));
+  server_side_socket.async_read_some(buffer(read_buffer), handler);
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(ec == asio::error::timed_out);
+  ASIO_CHECK(clock::now() - start >= chrono::milliseconds(50));
+  ASIO_CHECK(server_side_socket.is_open());
+
+  // An operation started after the expiry time fails immediately.
+  completions = 0;
+  server_side_socket.async_read_some(buffer(read_buffer), handler);
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(ec == asio::error::timed_out);
+
+  // Clearing the expiry time allows operations to complete normally, and the
+  // data is not lost.
+  completions = 0;
+  server_side_socket.expires_never();
+  server_side_socket.async_read_some(buffer(read_buffer), handler);
+  asio::write(client_side_socket, buffer("abc", 3));
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(!ec);
+
+  // A distant expiry time does not keep the io_context running once the
+  // operations have completed.
+  completions = 0;
+  start = clock::now();
+  server_side_socket.expires_after(chrono::seconds(60));
+  server_side_socket.async_read_some(buffer(read_buffer), handler);
+  asio::write(client_side_socket, buffer("abc", 3));
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(clock::now() - start < chrono::seconds(30));
+
+  // An earlier expiry time applies to an outstanding operation.
+  completions = 0;
+  start = clock::now();
+  server_side_socket.async_read_some(buffer(read_buffer), handler);
+  server_side_socket.expires_after(chrono::milliseconds(20));
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(ec == asio::error::timed_out);
+  ASIO_CHECK(clock::now() - start < chrono::seconds(30));
+
+  // So does a later one.
+  completions = 0;
+  start = clock::now();
+  server_side_socket.expires_after(chrono::milliseconds(20));
+  server_side_socket.async_read_some(buffer(read_buffer), handler);
+  server_side_socket.expires_after(chrono::milliseconds(100));
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(ec == asio::error::timed_out);
+  ASIO_CHECK(clock::now() - start >= chrono::milliseconds(100));
+
+  // The expiry time moves with the socket.
+  completions = 0;
+  server_side_socket.expires_after(chrono::milliseconds(20));
+  server_side_socket.async_read_some(buffer(read_buffer), handler);
+  ip::tcp::socket moved_socket(std::move(server_side_socket));
+  ASIO_CHECK(moved_socket.expiry() != (clock::time_point::max)());
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(ec == asio::error::timed_out);
+
+  // Closing the socket cancels the operation and clears the expiry time.
+  completions = 0;
+  moved_socket.expires_after(chrono::seconds(60));
+  moved_socket.async_read_some(buffer(read_buffer), handler);
+  moved_socket.close();
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(ec == asio::error::operation_aborted);
+  ASIO_CHECK(moved_socket.expiry() == (clock::time_point::max)());
+
+  // A connect is not started once the expiry time has been reached.
+  completions = 0;
+  ip::tcp::socket connecting_socket(ioc, ip::tcp::v4());
+  connecting_socket.expires_at(clock::now());
+  connecting_socket.async_connect(acceptor.local_endpoint(), handler);
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(ec == asio::error::timed_out);
+}
+
+#else // defined(ASIO_HAS_SOCKET_EXPIRY)
+
+void test()
+{
+}
+
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
+} // namespace ip_tcp_socket_expiry_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_tcp_socket_cancellation_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of per-operation
+// cancellation of socket operations.
+
+namespace ip_tcp_socket_cancellation_runtime {
+
+struct cancellation_handler
+{
+  asio::error_code* ec_;
+  int* completions_;
+
+  void operator()(const asio::error_code& err, std::size_t = 0)
+  {
+    *ec_ = err;
+    ++(*completions_);
+  }
+};
+
+struct composed_handler
+{
+  asio::error_code* ec_;
+  std::size_t* bytes_transferred_;
+  int* completions_;
+
+  void operator()(const asio::error_code& err, std::size_t n)
+  {
+    *ec_ = err;
+    *bytes_transferred_ = n;
+    ++(*completions_);
+  }
+};
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+  client_side_socket.connect(acceptor.local_endpoint());
+  acceptor.accept(server_side_socket);
+
+  char read_buffer[16];
+  error_code read_ec, wait_ec;
+  int read_completions = 0, wait_completions = 0;
+  cancellation_handler read_handler = { &read_ec, &read_completions };
+  cancellation_handler wait_handler = { &wait_ec, &wait_completions };
+
+  // A read and a wait are both queued for readability. Emitting the signal
+  // cancels the read alone.
+  cancellation_signal signal;
+  server_side_socket.async_read_some(buffer(read_buffer),
+      bind_cancellation_slot(signal.slot(), read_handler));
+  server_side_socket.async_wait(socket_base::wait_read, wait_handler);
+
+  ioc.poll();
+  ASIO_CHECK(read_completions == 0);
+  ASIO_CHECK(wait_completions == 0);
+
+  signal.emit();
+  ioc.poll();
+  ASIO_CHECK(read_completions == 1);
+  ASIO_CHECK(read_ec == asio::error::operation_aborted);
+  ASIO_CHECK(wait_completions == 0);
+
+  asio::write(client_side_socket, buffer("abc", 3));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(wait_completions == 1);
+  ASIO_CHECK(!wait_ec);
+
+  // The slot may be reused, and the data is still available to the next read.
+  read_completions = 0;
+  server_side_socket.async_read_some(buffer(read_buffer),
+      bind_cancellation_slot(signal.slot(), read_handler));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(read_completions == 1);
+  ASIO_CHECK(!read_ec);
+
+  // Emitting the signal once the operation has completed has no effect.
+  signal.emit();
+  ioc.restart();
+  ASIO_CHECK(ioc.poll() == 0);
+
+  // An operation may still be cancelled after its socket has been moved.
+  read_completions = 0;
+  server_side_socket.async_wait(socket_base::wait_read,
+      bind_cancellation_slot(signal.slot(), read_handler));
+  ip::tcp::socket moved_socket(std::move(server_side_socket));
+  signal.emit();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(read_completions == 1);
+  ASIO_CHECK(read_ec == asio::error::operation_aborted);
+  ASIO_CHECK(!signal.slot().has_handler());
+
+  // Closing the socket removes the handler of a pending operation from the
+  // slot, so the signal may be emitted even after the descriptor's state has
+  // been freed.
+  read_completions = 0;
+  moved_socket.async_wait(socket_base::wait_read,
+      bind_cancellation_slot(signal.slot(), read_handler));
+  ASIO_CHECK(signal.slot().has_handler());
+  moved_socket.close();
+  ASIO_CHECK(!signal.slot().has_handler());
+  ioc.trim();
+  signal.emit();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(read_completions == 1);
+  ASIO_CHECK(read_ec == asio::error::operation_aborted);
+
+  // The same applies when the socket is destroyed.
+  read_completions = 0;
+  {
+    ip::tcp::socket socket(ioc, ip::tcp::v4());
+    socket.async_wait(socket_base::wait_read,
+        bind_cancellation_slot(signal.slot(), read_handler));
+    ASIO_CHECK(signal.slot().has_handler());
+  }
+  ASIO_CHECK(!signal.slot().has_handler());
+  ioc.trim();
+  signal.emit();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(read_completions == 1);
+  ASIO_CHECK(read_ec == asio::error::operation_aborted);
+
+  // A pending accept may be cancelled, leaving the acceptor usable.
+  ip::tcp::socket writer(ioc);
+  ip::tcp::socket reader(ioc);
+  read_completions = 0;
+  acceptor.async_accept(reader,
+      bind_cancellation_slot(signal.slot(), read_handler));
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(read_completions == 0);
+  signal.emit();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(read_completions == 1);
+  ASIO_CHECK(read_ec == asio::error::operation_aborted);
+  ASIO_CHECK(!reader.is_open());
+
+  writer.connect(acceptor.local_endpoint());
+  acceptor.accept(reader);
+
+  // Composed operations connect the slot to each of their intermediate
+  // operations in turn. A write that cannot finish because the peer is not
+  // reading is cancelled part way through.
+  std::vector<char> write_data(32 * 1024 * 1024);
+  std::size_t bytes_transferred = 0;
+  composed_handler write_handler = { &read_ec,
+    &bytes_transferred, &read_completions };
+  read_completions = 0;
+  asio::async_write(writer, buffer(write_data),
+      bind_cancellation_slot(signal.slot(), write_handler));
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(read_completions == 0);
+  signal.emit();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(read_completions == 1);
+  ASIO_CHECK(read_ec == asio::error::operation_aborted);
+  ASIO_CHECK(bytes_transferred < write_data.size());
+  ASIO_CHECK(!signal.slot().has_handler());
+
+  // Likewise a read that has received only part of its data.
+  char read_data[100];
+  read_completions = 0;
+  asio::async_read(writer, buffer(read_data),
+      bind_cancellation_slot(signal.slot(), write_handler));
+  asio::write(reader, buffer(read_data, 10));
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(read_completions == 0);
+  signal.emit();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(read_completions == 1);
+  ASIO_CHECK(read_ec == asio::error::operation_aborted);
+  ASIO_CHECK(bytes_transferred == 10);
+
+  // And a read_until that has not yet found its delimiter.
+  std::string line;
+  read_completions = 0;
+  asio::async_read_until(writer, asio::dynamic_buffer(line), '\n',
+      bind_cancellation_slot(signal.slot(), write_handler));
+  asio::write(reader, buffer("abc", 3));
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(read_completions == 0);
+  signal.emit();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(read_completions == 1);
+  ASIO_CHECK(read_ec == asio::error::operation_aborted);
+  ASIO_CHECK(line == "abc");
+}
+
+} // namespace ip_tcp_socket_cancellation_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_tcp_socket_fast_open_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of connecting with TCP Fast
+// Open.
+
+namespace ip_tcp_socket_fast_open_runtime {
+
+#if defined(ASIO_HAS_TCP_FAST_OPEN)
+
+struct connect_handler
+{
+  asio::error_code* ec_;
+  std::size_t* bytes_transferred_;
+
+  void operator()(const asio::error_code& err, std::size_t n)
+  {
+    *ec_ = err;
+    *bytes_transferred_ = n;
+  }
+};
+
+struct accept_handler
+{
+  asio::error_code* ec_;
+
+  void operator()(const asio::error_code& err)
+  {
+    *ec_ = err;
+  }
+};
+
+void test()
+{
+  using namespace std; // For memcmp.
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc);
+  acceptor.open(ip::tcp::v4());
+  acceptor.bind(ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+
+  // The acceptor may only accept data with connection requests if enabled by
+  // the net.ipv4.tcp_fastopen sysctl, but the data must arrive either way.
+  error_code option_ec;
+  acceptor.set_option(ip::tcp::fast_open(16), option_ec);
+  acceptor.listen();
+
+  const char request[] = "hello fast open";
+  const std::size_t request_size = sizeof(request) - 1;
+
+  // The first connection obtains a cookie, which later connections may use
+  // to send the request with the SYN.
+  for (int i = 0; i < 3; ++i)
+  {
+    ip::tcp::socket client_side_socket(ioc);
+    ip::tcp::socket server_side_socket(ioc);
+
+    error_code connect_ec, accept_ec;
+    std::size_t bytes_sent = ~std::size_t(0);
+    connect_handler ch = { &connect_ec, &bytes_sent };
+    accept_handler ah = { &accept_ec };
+
+    client_side_socket.async_fast_open_connect(acceptor.local_endpoint(),
+        buffer(request, request_size), ch);
+    acceptor.async_accept(server_side_socket, ah);
+    ioc.restart();
+    ioc.run();
+
+    ASIO_CHECK(!connect_ec);
+    ASIO_CHECK(!accept_ec);
+    ASIO_CHECK(bytes_sent <= request_size);
+
+    asio::write(client_side_socket,
+        buffer(request + bytes_sent, request_size - bytes_sent));
+
+    char response[sizeof(request)] = "";
+    asio::read(server_side_socket, buffer(response, request_size));
+    ASIO_CHECK(memcmp(response, request, request_size) == 0);
+  }
+
+  // A failed connect reports no data as sent.
+  ip::tcp::endpoint closed_endpoint = acceptor.local_endpoint();
+  acceptor.close();
+
+  ip::tcp::socket client_side_socket(ioc);
+  error_code connect_ec;
+  std::size_t bytes_sent = ~std::size_t(0);
+  connect_handler ch = { &connect_ec, &bytes_sent };
+  client_side_socket.async_fast_open_connect(closed_endpoint,
+      buffer(request, request_size), ch);
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(connect_ec == asio::error::connection_refused);
+  ASIO_CHECK(bytes_sent == 0);
+}
+
+#else // defined(ASIO_HAS_TCP_FAST_OPEN)
+
+void test()
+{
+}
+
+#endif // defined(ASIO_HAS_TCP_FAST_OPEN)
+
+} // namespace ip_tcp_socket_fast_open_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_tcp_socket_zero_copy_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a zero-copy send completes while an
+// out-of-band receive is outstanding on the same socket.
+
+namespace ip_tcp_socket_zero_copy_runtime {
+
+#if defined(ASIO_HAS_MSG_ZEROCOPY) && defined(ASIO_HAS_CHRONO)
+
+struct io_handler
+{
+  asio::error_code* ec_;
+  std::size_t* bytes_transferred_;
+  bool* called_;
+
+  void operator()(const asio::error_code& err, std::size_t n)
+  {
+    *ec_ = err;
+    *bytes_transferred_ = n;
+    *called_ = true;
+  }
+};
+
+// Run the io_context until the specified flag is set.
+void run_until(asio::io_context& ioc, const bool& flag)
+{
+  for (int i = 0; i < 100 && !flag; ++i)
+  {
+    ioc.restart();
+    ioc.run_for(asio::chrono::milliseconds(10));
+  }
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::socket client_side_socket(ioc);
+  client_side_socket.connect(acceptor.local_endpoint());
+  ip::tcp::socket server_side_socket(ioc);
+  acceptor.accept(server_side_socket);
+
+  char oob_data = 0;
+  error_code oob_ec;
+  std::size_t oob_bytes = 0;
+  bool oob_called = false;
+  io_handler oob_handler = { &oob_ec, &oob_bytes, &oob_called };
+  server_side_socket.async_receive(buffer(&oob_data, 1),
+      socket_base::message_out_of_band, oob_handler);
+
+  // The first send on the socket uses MSG_ZEROCOPY, even on loopback, and so
+  // waits for the kernel to release its buffers.
+  std::vector<char> data(65536, 'z');
+  error_code send_ec;
+  std::size_t sent = 0;
+  bool send_called = false;
+  io_handler send_handler = { &send_ec, &sent, &send_called };
+  server_side_socket.async_send_zero_copy(buffer(data), send_handler);
+
+  run_until(ioc, send_called);
+  ASIO_CHECK(send_called);
+  ASIO_CHECK(!send_ec);
+  ASIO_CHECK(sent > 0);
+  ASIO_CHECK(!oob_called);
+
+  std::vector<char> received(sent);
+  asio::read(client_side_socket, buffer(received));
+  ASIO_CHECK(received == std::vector<char>(sent, 'z'));
+
+  // The out-of-band receive is unaffected.
+  client_side_socket.send(buffer("!", 1), socket_base::message_out_of_band);
+
+  run_until(ioc, oob_called);
+  ASIO_CHECK(oob_called);
+  ASIO_CHECK(!oob_ec);
+  ASIO_CHECK(oob_bytes == 1);
+  ASIO_CHECK(oob_data == '!');
+}
+
+#else // defined(ASIO_HAS_MSG_ZEROCOPY) && defined(ASIO_HAS_CHRONO)
+
+void test()
+{
+}
+
+#endif // defined(ASIO_HAS_MSG_ZEROCOPY) && defined(ASIO_HAS_CHRONO)
+
+} // namespace ip_tcp_socket_zero_copy_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_tcp_socket_migration_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of moving a socket between
+// execution contexts.
+
+namespace ip_tcp_socket_migration_runtime {
+
+#if defined(ASIO_HAS_SOCKET_MIGRATION)
+
+struct migrating_read_handler
+{
+  asio::ip::tcp::socket* socket_;
+  asio::io_context* target_;
+  asio::error_code* read_ec_;
+  std::size_t* bytes_read_;
+  asio::error_code* migrate_ec_;
+
+  void operator()(const asio::error_code& err, std::size_t n)
+  {
+    *read_ec_ = err;
+    *bytes_read_ = n;
+    if (target_)
+      socket_->migrate(target_->get_executor(), *migrate_ec_);
+  }
+};
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc1;
+  io_context ioc2;
+
+  ip::tcp::acceptor acceptor(ioc1,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+
+  ip::tcp::socket client_side_socket(ioc1);
+  ip::tcp::socket server_side_socket(ioc1);
+  client_side_socket.connect(acceptor.local_endpoint());
+  acceptor.accept(server_side_socket);
+
+  server_side_socket.set_option(ip::tcp::no_delay(true));
+  server_side_socket.non_blocking(true);
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+  server_side_socket.expires_after(chrono::seconds(60));
+  chrono::steady_clock::time_point expiry = server_side_socket.expiry();
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
+  char read_buffer[16];
+  error_code read_ec;
+  std::size_t bytes_read = 0;
+  error_code migrate_ec;
+  migrating_read_handler handler = { &server_side_socket,
+    0, &read_ec, &bytes_read, &migrate_ec };
+
+  // A socket with an outstanding operation is not moved.
+  server_side_socket.async_read_some(buffer(read_buffer), handler);
+  server_side_socket.migrate(ioc2.get_executor(), migrate_ec);
+  ASIO_CHECK(migrate_ec == asio::error::in_progress);
+  ASIO_CHECK(server_side_socket.is_open());
+
+  asio::write(client_side_socket, buffer("abc", 3));
+  ioc1.run();
+
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(bytes_read == 3);
+
+  // Once the operation has completed, the socket is moved, retaining its
+  // options and state.
+  server_side_socket.migrate(ioc2.get_executor(), migrate_ec);
+  ASIO_CHECK(!migrate_ec);
+  ASIO_CHECK(server_side_socket.is_open());
+  ASIO_CHECK(server_side_socket.non_blocking());
+  ip::tcp::no_delay no_delay;
+  server_side_socket.get_option(no_delay);
+  ASIO_CHECK(no_delay.value());
+#if defined(ASIO_HAS_SOCKET_EXPIRY)
+  ASIO_CHECK(server_side_socket.expiry() == expiry);
+#endif // defined(ASIO_HAS_SOCKET_EXPIRY)
+
+  // Subsequent operations are performed by the new execution context. Data
+  // that arrived before the operation was started is not lost.
+  bytes_read = 0;
+  asio::write(client_side_socket, buffer("defg", 4));
+  handler.target_ = &ioc1;
+  server_side_socket.async_read_some(buffer(read_buffer), handler);
+  ioc1.restart();
+  ioc1.poll();
+  ASIO_CHECK(bytes_read == 0);
+
+  ioc2.run();
+
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(bytes_read == 4);
+  ASIO_CHECK(std::memcmp(read_buffer, "defg", 4) == 0);
+
+  // The socket can be moved back from within a completion handler.
+  ASIO_CHECK(!migrate_ec);
+
+  bytes_read = 0;
+  handler.target_ = 0;
+  server_side_socket.async_read_some(buffer(read_buffer), handler);
+  asio::write(client_side_socket, buffer("hi", 2));
+  ioc2.restart();
+  ioc2.poll();
+  ASIO_CHECK(bytes_read == 0);
+
+  ioc1.restart();
+  ioc1.run();
+
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(bytes_read == 2);
+}
+
+#else // defined(ASIO_HAS_SOCKET_MIGRATION)
+
+void test()
+{
+}
+
+#endif // defined(ASIO_HAS_SOCKET_MIGRATION)
+
+} // namespace ip_tcp_socket_migration_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_tcp_socket_scatter_gather_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a socket transfers a sequence of more buffers
+// than a buffer sequence adapter holds in-line in a single operation.
+
+namespace ip_tcp_socket_scatter_gather_runtime {
+
+struct io_handler
+{
+  asio::error_code* ec_;
+  std::size_t* bytes_transferred_;
+
+  void operator()(const asio::error_code& err, std::size_t n)
+  {
+    *ec_ = err;
+    *bytes_transferred_ = n;
+  }
+};
+
+void test()
+{
+  using namespace std; // For memcmp and memset.
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::socket client_side_socket(ioc);
+  client_side_socket.connect(acceptor.local_endpoint());
+  ip::tcp::socket server_side_socket(ioc);
+  acceptor.accept(server_side_socket);
+
+  const std::size_t num_buffers = 200;
+  const std::size_t max_buffers =
+    asio::detail::buffer_sequence_adapter_base::max_buffers;
+  const std::size_t expected =
+    num_buffers < max_buffers ? num_buffers : max_buffers;
+
+  char send_data[num_buffers];
+  char recv_data[num_buffers];
+  std::vector<const_buffer> send_buffers;
+  std::vector<mutable_buffer> recv_buffers;
+  for (std::size_t i = 0; i < num_buffers; ++i)
+  {
+    send_data[i] = static_cast<char>('a' + i % 26);
+    send_buffers.push_back(buffer(send_data + i, 1));
+    recv_buffers.push_back(buffer(recv_data + i, 1));
+  }
+
+  memset(recv_data, 0, sizeof(recv_data));
+  std::size_t n = client_side_socket.write_some(send_buffers);
+  ASIO_CHECK(n == expected);
+  n = asio::read(server_side_socket,
+      recv_buffers, asio::transfer_exactly(expected));
+  ASIO_CHECK(n == expected);
+  ASIO_CHECK(memcmp(recv_data, send_data, expected) == 0);
+
+  asio::error_code ec;
+  n = 0;
+  memset(recv_data, 0, sizeof(recv_data));
+  io_handler write_handler = { &ec, &n };
+  client_side_socket.async_write_some(send_buffers, write_handler);
+  ioc.run();
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == expected);
+
+  n = 0;
+  io_handler read_handler = { &ec, &n };
+  asio::async_read(server_side_socket, recv_buffers,
+      asio::transfer_exactly(expected), read_handler);
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == expected);
+  ASIO_CHECK(memcmp(recv_data, send_data, expected) == 0);
+}
+
+} // namespace ip_tcp_socket_scatter_gather_runtime
+
+//------------------------------------------------------------------------------
+
 // ip_tcp_acceptor_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public member functions on the class
@@ -742,6 +1911,15 @@ private:
 };
 #endif // defined(ASIO_HAS_MOVE)
 
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT)
+struct multishot_accept_handler
+{
+  multishot_accept_handler() {}
+  void operator()(
+      const asio::error_code&, asio::ip::tcp::socket) {}
+};
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
+
 void test()
 {
   using namespace asio;
@@ -931,6 +2109,18 @@ void test()
     acceptor1.async_accept(ioc_ex, peer_endpoint, move_accept_handler());
     acceptor1.async_accept(ioc_ex, peer_endpoint, move_accept_ioc_handler());
 #endif // defined(ASIO_HAS_MOVE)
+
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT)
+    ip::tcp::acceptor::multishot_accept_statistics statistics;
+    acceptor1.async_multishot_accept(multishot_accept_handler());
+    acceptor1.async_multishot_accept(multishot_accept_handler(), &statistics);
+    acceptor1.async_multishot_accept(ioc, multishot_accept_handler());
+    acceptor1.async_multishot_accept(ioc,
+        multishot_accept_handler(), &statistics);
+    acceptor1.async_multishot_accept(ioc_ex, multishot_accept_handler());
+    acceptor1.async_multishot_accept(ioc_ex,
+        multishot_accept_handler(), &statistics);
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
   }
   catch (std::exception&)
   {
@@ -958,6 +2148,115 @@ void handle_connect(const asio::error_code& err)
   ASIO_CHECK(!err);
 }
 
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT)
+struct multishot_accept_handler
+{
+  std::vector<asio::ip::tcp::socket>* sockets_;
+  asio::error_code* final_error_;
+  int* completions_;
+  asio::ip::tcp::acceptor* acceptor_to_close_;
+
+  void operator()(const asio::error_code& err, asio::ip::tcp::socket peer)
+  {
+    if (err)
+    {
+      ASIO_CHECK(!peer.is_open());
+      *final_error_ = err;
+      ++(*completions_);
+    }
+    else
+    {
+      ASIO_CHECK(*completions_ == 0);
+      ASIO_CHECK(peer.is_open());
+      sockets_->push_back(std::move(peer));
+      if (acceptor_to_close_)
+        acceptor_to_close_->close();
+    }
+  }
+};
+
+void test_multishot()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  std::vector<ip::tcp::socket> server_side_sockets;
+  error_code final_error;
+  int completions = 0;
+  multishot_accept_handler handler = { &server_side_sockets,
+    &final_error, &completions, 0 };
+  ip::tcp::acceptor::multishot_accept_statistics statistics;
+  acceptor.async_multishot_accept(handler, &statistics);
+
+  // Connections that are already queued are accepted together.
+  std::vector<ip::tcp::socket> client_side_sockets;
+  for (int i = 0; i < 5; ++i)
+  {
+    client_side_sockets.push_back(ip::tcp::socket(ioc));
+    client_side_sockets.back().connect(server_endpoint);
+  }
+
+  while (server_side_sockets.size() < 5)
+    ioc.run_one();
+
+  ASIO_CHECK(completions == 0);
+  ASIO_CHECK(statistics.accepted == 5);
+  ASIO_CHECK(statistics.wakeups >= 1);
+  ASIO_CHECK(statistics.wakeups <= 5);
+  ASIO_CHECK(statistics.peak_accepted >= 1);
+
+  // The operation continues to accept connections without being restarted.
+  client_side_sockets.push_back(ip::tcp::socket(ioc));
+  client_side_sockets.back().connect(server_endpoint);
+
+  while (server_side_sockets.size() < 6)
+    ioc.run_one();
+
+  ASIO_CHECK(completions == 0);
+  ASIO_CHECK(statistics.accepted == 6);
+
+  using namespace std; // For memcmp.
+  const char write_data[] = "hello";
+  char read_data[sizeof(write_data)] = "";
+  asio::write(client_side_sockets.back(), buffer(write_data));
+  std::size_t length = asio::read(server_side_sockets.back(),
+      buffer(read_data));
+  ASIO_CHECK(length == sizeof(write_data));
+  ASIO_CHECK(memcmp(read_data, write_data, sizeof(write_data)) == 0);
+
+  // Cancellation stops the operation.
+  acceptor.cancel();
+  ioc.run();
+
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(final_error == asio::error::operation_aborted);
+  ASIO_CHECK(server_side_sockets.size() == 6);
+
+  // The operation may be stopped by closing the acceptor from the handler.
+  server_side_sockets.clear();
+  completions = 0;
+  handler.acceptor_to_close_ = &acceptor;
+  acceptor.async_multishot_accept(handler);
+
+  client_side_sockets.push_back(ip::tcp::socket(ioc));
+  client_side_sockets.back().connect(server_endpoint);
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(server_side_sockets.size() == 1);
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(final_error == asio::error::operation_aborted);
+  ASIO_CHECK(!acceptor.is_open());
+}
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
+
 void test()
 {
   using namespace asio;
@@ -1014,12 +2313,141 @@ void test()
   server_side_remote_endpoint = server_side_socket.remote_endpoint();
   ASIO_CHECK(server_side_remote_endpoint.port()
       == client_endpoint.port());
+
+  // Synchronous operations on asynchronously opened and accepted sockets must
+  // still block until they complete.
+  ASIO_CHECK(!client_side_socket.non_blocking());
+  ASIO_CHECK(!server_side_socket.non_blocking());
+
+  using namespace std; // For memcmp.
+  const char write_data[] = "hello";
+  char read_data[sizeof(write_data)] = "";
+  asio::write(client_side_socket, buffer(write_data));
+  std::size_t length = asio::read(server_side_socket, buffer(read_data));
+  ASIO_CHECK(length == sizeof(write_data));
+  ASIO_CHECK(memcmp(read_data, write_data, sizeof(write_data)) == 0);
+
+#if !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+  // A released socket is in blocking mode, even if it was created in
+  // non-blocking mode, unless the user asked for non-blocking mode.
+  ip::tcp::socket::native_handle_type native_socket =
+    server_side_socket.release();
+  ASIO_CHECK((::fcntl(native_socket, F_GETFL, 0) & O_NONBLOCK) == 0);
+  server_side_socket.assign(ip::tcp::v4(), native_socket);
+
+  client_side_socket.non_blocking(true);
+  native_socket = client_side_socket.release();
+  ASIO_CHECK((::fcntl(native_socket, F_GETFL, 0) & O_NONBLOCK) != 0);
+  client_side_socket.assign(ip::tcp::v4(), native_socket);
+#endif // !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+#if defined(ASIO_HAS_MULTISHOT_ACCEPT)
+  test_multishot();
+#endif // defined(ASIO_HAS_MULTISHOT_ACCEPT)
 }
 
 } // namespace ip_tcp_acceptor_runtime
 
 //------------------------------------------------------------------------------
 
+// ip_tcp_blocking_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that synchronous operations block until they
+// complete on sockets that have been opened in non-blocking mode, as they are
+// on platforms such as Linux.
+
+namespace ip_tcp_blocking_runtime {
+
+#if defined(ASIO_HAS_CHRONO)
+
+struct delayed_client
+{
+  asio::ip::tcp::endpoint endpoint_;
+  asio::error_code* ec_;
+  std::size_t* bytes_transferred_;
+  char* data_;
+
+  void operator()()
+  {
+    asio::io_context ioc;
+    asio::steady_timer timer(ioc);
+    asio::ip::tcp::socket socket(ioc);
+
+    timer.expires_after(asio::chrono::milliseconds(50));
+    timer.wait();
+    socket.connect(endpoint_, *ec_);
+    if (*ec_)
+      return;
+
+    timer.expires_after(asio::chrono::milliseconds(50));
+    timer.wait();
+    asio::write(socket, asio::buffer("hello", 5), *ec_);
+    if (*ec_)
+      return;
+
+    *bytes_transferred_ = socket.read_some(asio::buffer(data_, 5), *ec_);
+  }
+};
+
+void test()
+{
+  using namespace std; // For memcmp.
+  using namespace asio;
+  namespace ip = asio::ip;
+  typedef asio::chrono::steady_clock clock;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+
+  asio::error_code client_ec;
+  std::size_t client_bytes_transferred = 0;
+  char client_data[5] = "";
+  delayed_client client = { acceptor.local_endpoint(),
+    &client_ec, &client_bytes_transferred, client_data };
+  clock::time_point start = clock::now();
+  asio::thread client_thread(client);
+
+  // The acceptor is non-blocking, so accept() waits using poll().
+  ip::tcp::socket server_side_socket(ioc);
+  asio::error_code ec;
+  acceptor.accept(server_side_socket, ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(clock::now() - start >= asio::chrono::milliseconds(50));
+
+  char data[5] = "";
+  std::size_t length = server_side_socket.read_some(buffer(data), ec);
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(length == 5);
+  ASIO_CHECK(memcmp(data, "hello", 5) == 0);
+
+  // The client's socket was opened non-blocking, so its read_some() waits
+  // using poll().
+  asio::steady_timer timer(ioc);
+  timer.expires_after(asio::chrono::milliseconds(50));
+  timer.wait();
+  asio::write(server_side_socket, buffer("world", 5), ec);
+  ASIO_CHECK(!ec);
+
+  client_thread.join();
+  ASIO_CHECK(!client_ec);
+  ASIO_CHECK(client_bytes_transferred == 5);
+  ASIO_CHECK(memcmp(client_data, "world", 5) == 0);
+}
+
+#else // defined(ASIO_HAS_CHRONO)
+
+void test()
+{
+}
+
+#endif // defined(ASIO_HAS_CHRONO)
+
+} // namespace ip_tcp_blocking_runtime
+
+//------------------------------------------------------------------------------
+
 // ip_tcp_resolver_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public member functions on the class
@@ -1337,8 +2765,16 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(ip_tcp_runtime::test)
   ASIO_TEST_CASE(ip_tcp_socket_compile::test)
   ASIO_TEST_CASE(ip_tcp_socket_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_socket_multishot_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_socket_expiry_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_socket_cancellation_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_socket_fast_open_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_socket_zero_copy_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_socket_migration_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_socket_scatter_gather_runtime::test)
   ASIO_TEST_CASE(ip_tcp_acceptor_compile::test)
   ASIO_TEST_CASE(ip_tcp_acceptor_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_blocking_runtime::test)
   ASIO_TEST_CASE(ip_tcp_resolver_compile::test)
   ASIO_TEST_CASE(ip_tcp_resolver_entry_compile::test)
   ASIO_TEST_CASE(ip_tcp_resolver_entry_compile::test)
@@ -17,6 +17,7 @@
 #include "asio/ip/udp.hpp"
 
 #include <cstring>
+#include <vector>
 #include "asio/io_context.hpp"
 #include "../unit_test.hpp"
 #include "../archetypes/async_result.hpp"
@@ -32,6 +33,52 @@
 
 //------------------------------------------------------------------------------
 
+// ip_udp_compile test
+// ~~~~~~~~~~~~~~~~~~~
+// The following test checks that all nested classes, enums and constants in
+// ip::udp compile and link correctly. Runtime failures are ignored.
+
+namespace ip_udp_compile {
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    ip::udp::socket sock(ioc);
+
+    // segment_size class.
+
+    ip::udp::segment_size segment_size1(1200);
+    sock.set_option(segment_size1);
+    ip::udp::segment_size segment_size2;
+    sock.get_option(segment_size2);
+    segment_size1 = 1200;
+    (void)static_cast<int>(segment_size1.value());
+
+    // gro class.
+
+    ip::udp::gro gro1(true);
+    sock.set_option(gro1);
+    ip::udp::gro gro2;
+    sock.get_option(gro2);
+    gro1 = true;
+    (void)static_cast<bool>(gro1);
+    (void)static_cast<bool>(!gro1);
+    (void)static_cast<bool>(gro1.value());
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ip_udp_compile
+
+//------------------------------------------------------------------------------
+
 // ip_udp_socket_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public member functions on the class
@@ -83,6 +130,12 @@ private:
 #endif // defined(ASIO_HAS_MOVE)
 };
 
+struct multishot_receive_handler
+{
+  multishot_receive_handler() {}
+  void operator()(const asio::error_code&, std::size_t) {}
+};
+
 void test()
 {
   using namespace asio;
@@ -440,6 +493,91 @@ void test()
     int i29 = socket1.async_receive_from(null_buffers(),
         endpoint, in_flags, lazy);
     (void)i29;
+
+#if defined(ASIO_HAS_MMSG)
+    std::vector<const_buffer> const_buffers(2, buffer(const_char_buffer));
+    std::vector<mutable_buffer> mutable_buffers(2,
+        buffer(mutable_char_buffer));
+    ip::udp::endpoint endpoints[2];
+    std::size_t sizes[2];
+
+    socket1.async_send_to_batch(const_buffers, endpoints, send_handler());
+    socket1.async_send_to_batch(const_buffers,
+        endpoints, in_flags, send_handler());
+    int i30 = socket1.async_send_to_batch(const_buffers, endpoints, lazy);
+    (void)i30;
+    int i31 = socket1.async_send_to_batch(const_buffers,
+        endpoints, in_flags, lazy);
+    (void)i31;
+
+    socket1.async_receive_from_batch(mutable_buffers,
+        endpoints, sizes, receive_handler());
+    socket1.async_receive_from_batch(mutable_buffers,
+        endpoints, sizes, in_flags, receive_handler());
+    int i32 = socket1.async_receive_from_batch(mutable_buffers,
+        endpoints, sizes, lazy);
+    (void)i32;
+    int i33 = socket1.async_receive_from_batch(mutable_buffers,
+        endpoints, sizes, in_flags, lazy);
+    (void)i33;
+#endif // defined(ASIO_HAS_MMSG)
+
+#if defined(ASIO_HAS_UDP_GSO)
+    std::size_t segment_size = 0;
+
+    socket1.async_send_to_segmented(buffer(const_char_buffer),
+        endpoint, 32, send_handler());
+    socket1.async_send_to_segmented(buffer(const_char_buffer),
+        endpoint, 32, in_flags, send_handler());
+    int i34 = socket1.async_send_to_segmented(buffer(const_char_buffer),
+        endpoint, 32, lazy);
+    (void)i34;
+    int i35 = socket1.async_send_to_segmented(buffer(const_char_buffer),
+        endpoint, 32, in_flags, lazy);
+    (void)i35;
+
+    socket1.async_receive_from_coalesced(buffer(mutable_char_buffer),
+        endpoint, segment_size, receive_handler());
+    socket1.async_receive_from_coalesced(buffer(mutable_char_buffer),
+        endpoint, segment_size, in_flags, receive_handler());
+    int i36 = socket1.async_receive_from_coalesced(buffer(mutable_char_buffer),
+        endpoint, segment_size, lazy);
+    (void)i36;
+    int i37 = socket1.async_receive_from_coalesced(buffer(mutable_char_buffer),
+        endpoint, segment_size, in_flags, lazy);
+    (void)i37;
+#endif // defined(ASIO_HAS_UDP_GSO)
+
+#if defined(ASIO_HAS_RECEIVE_METADATA)
+    receive_metadata metadata;
+
+    socket1.async_receive_with_metadata(buffer(mutable_char_buffer),
+        metadata, receive_handler());
+    socket1.async_receive_with_metadata(buffer(mutable_char_buffer),
+        metadata, in_flags, receive_handler());
+    int i38 = socket1.async_receive_with_metadata(buffer(mutable_char_buffer),
+        metadata, lazy);
+    (void)i38;
+    int i39 = socket1.async_receive_with_metadata(buffer(mutable_char_buffer),
+        metadata, in_flags, lazy);
+    (void)i39;
+
+    socket1.async_receive_from_with_metadata(buffer(mutable_char_buffer),
+        endpoint, metadata, receive_handler());
+    socket1.async_receive_from_with_metadata(buffer(mutable_char_buffer),
+        endpoint, metadata, in_flags, receive_handler());
+    int i40 = socket1.async_receive_from_with_metadata(
+        buffer(mutable_char_buffer), endpoint, metadata, lazy);
+    (void)i40;
+    int i41 = socket1.async_receive_from_with_metadata(
+        buffer(mutable_char_buffer), endpoint, metadata, in_flags, lazy);
+    (void)i41;
+#endif // defined(ASIO_HAS_RECEIVE_METADATA)
+
+#if defined(ASIO_HAS_MULTISHOT_RECEIVE)
+    socket1.async_multishot_receive(buffer(mutable_char_buffer),
+        multishot_receive_handler());
+#endif // defined(ASIO_HAS_MULTISHOT_RECEIVE)
   }
   catch (std::exception&)
   {
@@ -521,6 +659,306 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ip_udp_socket_batch_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the batch send and
+// receive functions of the ip::udp::socket class.
+
+namespace ip_udp_socket_batch_runtime {
+
+#if defined(ASIO_HAS_MMSG)
+
+void handle_batch(const asio::error_code& err,
+    size_t messages_transferred, size_t* result)
+{
+  ASIO_CHECK(!err);
+  *result = messages_transferred;
+}
+
+void test()
+{
+  using namespace std; // For memcmp.
+  using namespace asio;
+  namespace ip = asio::ip;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  io_context ioc;
+
+  ip::udp::socket s1(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket s2(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket s3(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+
+  // Send datagrams of different sizes from s1 to both s2 and s3.
+  const char send_msg[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  std::vector<const_buffer> send_buffers;
+  send_buffers.push_back(buffer(send_msg, 1));
+  send_buffers.push_back(buffer(send_msg, 5));
+  send_buffers.push_back(buffer(send_msg, 10));
+  send_buffers.push_back(buffer(send_msg, 26));
+  ip::udp::endpoint destinations[4] = {
+    s2.local_endpoint(), s3.local_endpoint(),
+    s2.local_endpoint(), s2.local_endpoint() };
+
+  size_t messages_sent = 0;
+  s1.async_send_to_batch(send_buffers, destinations,
+      bindns::bind(handle_batch, _1, _2, &messages_sent));
+
+  ioc.run();
+
+  ASIO_CHECK(messages_sent == 4);
+
+  // Receive the datagrams sent to s2 with one operation.
+  char recv_msg[4][32];
+  std::vector<mutable_buffer> recv_buffers;
+  for (int i = 0; i < 4; ++i)
+    recv_buffers.push_back(buffer(recv_msg[i]));
+  ip::udp::endpoint senders[4];
+  size_t sizes[4] = { 0, 0, 0, 0 };
+
+  size_t messages_received = 0;
+  s2.async_receive_from_batch(recv_buffers, senders, sizes,
+      bindns::bind(handle_batch, _1, _2, &messages_received));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(messages_received == 3);
+  ASIO_CHECK(sizes[0] == 1);
+  ASIO_CHECK(sizes[1] == 10);
+  ASIO_CHECK(sizes[2] == 26);
+  ASIO_CHECK(memcmp(recv_msg[2], send_msg, 26) == 0);
+  ASIO_CHECK(senders[0] == s1.local_endpoint());
+  ASIO_CHECK(senders[2] == s1.local_endpoint());
+
+  messages_received = 0;
+  s3.async_receive_from_batch(recv_buffers, senders, sizes,
+      bindns::bind(handle_batch, _1, _2, &messages_received));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(messages_received == 1);
+  ASIO_CHECK(sizes[0] == 5);
+  ASIO_CHECK(memcmp(recv_msg[0], send_msg, 5) == 0);
+  ASIO_CHECK(senders[0] == s1.local_endpoint());
+}
+
+#else // defined(ASIO_HAS_MMSG)
+
+void test()
+{
+}
+
+#endif // defined(ASIO_HAS_MMSG)
+
+} // namespace ip_udp_socket_batch_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_udp_socket_segmented_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the segmented send and
+// coalesced receive functions of the ip::udp::socket class.
+
+namespace ip_udp_socket_segmented_runtime {
+
+#if defined(ASIO_HAS_UDP_GSO)
+
+void handle_transfer(const asio::error_code& err,
+    size_t bytes_transferred, asio::error_code* result_ec,
+    size_t* result)
+{
+  *result_ec = err;
+  *result = bytes_transferred;
+}
+
+void test()
+{
+  using namespace std; // For memcmp.
+  using namespace asio;
+  namespace ip = asio::ip;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  io_context ioc;
+  asio::error_code ec;
+
+  ip::udp::socket s1(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket s2(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+
+  // Segment sizes that cannot be passed to the kernel are rejected.
+  const size_t invalid_segment_sizes[] = { 0, 65536, 65536 + 300 };
+  for (size_t i = 0; i < sizeof(invalid_segment_sizes) / sizeof(size_t); ++i)
+  {
+    char data[600] = "";
+    size_t bytes_sent = 1;
+    s1.async_send_to_segmented(buffer(data), s2.local_endpoint(),
+        invalid_segment_sizes[i],
+        bindns::bind(handle_transfer, _1, _2, &ec, &bytes_sent));
+
+    ioc.restart();
+    ioc.run();
+
+    ASIO_CHECK(ec == asio::error::invalid_argument);
+    ASIO_CHECK(bytes_sent == 0);
+  }
+  ioc.restart();
+
+  s2.set_option(ip::udp::gro(true), ec);
+  if (ec)
+    return; // Kernel does not support UDP_GRO.
+
+  // Send 1000 bytes as datagrams of 300 bytes.
+  char send_msg[1000];
+  for (size_t i = 0; i < sizeof(send_msg); ++i)
+    send_msg[i] = static_cast<char>(i % 251);
+
+  size_t bytes_sent = 0;
+  s1.async_send_to_segmented(buffer(send_msg), s2.local_endpoint(), 300,
+      bindns::bind(handle_transfer, _1, _2, &ec, &bytes_sent));
+
+  ioc.run();
+
+  if (ec == asio::error::no_protocol_option
+      || ec == asio::error::invalid_argument)
+    return; // Kernel does not support UDP_SEGMENT.
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(bytes_sent == sizeof(send_msg));
+
+  // Receive until all datagrams have arrived, whether or not the kernel
+  // coalesced them.
+  char recv_msg[65536];
+  size_t total_received = 0;
+  while (!ec && total_received < sizeof(send_msg))
+  {
+    ip::udp::endpoint sender;
+    size_t segment_size = 0;
+    size_t bytes_received = 0;
+    s2.async_receive_from_coalesced(
+        buffer(recv_msg + total_received, sizeof(recv_msg) - total_received),
+        sender, segment_size,
+        bindns::bind(handle_transfer, _1, _2, &ec, &bytes_received));
+
+    ioc.restart();
+    ioc.run();
+
+    ASIO_CHECK(!ec);
+    ASIO_CHECK(sender == s1.local_endpoint());
+    ASIO_CHECK(segment_size == 300 || segment_size == bytes_received);
+    total_received += bytes_received;
+  }
+
+  ASIO_CHECK(total_received == sizeof(send_msg));
+  ASIO_CHECK(memcmp(recv_msg, send_msg, sizeof(send_msg)) == 0);
+}
+
+#else // defined(ASIO_HAS_UDP_GSO)
+
+void test()
+{
+}
+
+#endif // defined(ASIO_HAS_UDP_GSO)
+
+} // namespace ip_udp_socket_segmented_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_udp_socket_multishot_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the multishot receive
+// function of the ip::udp::socket class.
+
+namespace ip_udp_socket_multishot_runtime {
+
+#if defined(ASIO_HAS_MULTISHOT_RECEIVE)
+
+struct multishot_receive_handler
+{
+  std::vector<std::size_t>* sizes_;
+  asio::error_code* final_error_;
+  int* completions_;
+
+  void operator()(const asio::error_code& err, std::size_t bytes_transferred)
+  {
+    if (err)
+    {
+      *final_error_ = err;
+      ++(*completions_);
+    }
+    else
+      sizes_->push_back(bytes_transferred);
+  }
+};
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+
+  ip::udp::socket s1(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket s2(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  s1.connect(s2.local_endpoint());
+  s2.connect(s1.local_endpoint());
+
+  // Each datagram is delivered separately, including empty datagrams.
+  char read_buffer[64];
+  std::vector<std::size_t> sizes;
+  error_code final_error;
+  int completions = 0;
+  multishot_receive_handler handler = { &sizes, &final_error, &completions };
+  s2.async_multishot_receive(buffer(read_buffer), handler);
+
+  const char data[] = "0123456789";
+  s1.send(buffer(data, 10));
+  s1.send(buffer(data, 0));
+  s1.send(buffer(data, 5));
+
+  while (sizes.size() < 3)
+    ioc.run_one();
+
+  ASIO_CHECK(completions == 0);
+  ASIO_CHECK(sizes[0] == 10);
+  ASIO_CHECK(sizes[1] == 0);
+  ASIO_CHECK(sizes[2] == 5);
+
+  // Cancellation stops the operation.
+  s2.cancel();
+  ioc.run();
+
+  ASIO_CHECK(sizes.size() == 3);
+  ASIO_CHECK(completions == 1);
+  ASIO_CHECK(final_error == asio::error::operation_aborted);
+}
+
+#else // defined(ASIO_HAS_MULTISHOT_RECEIVE)
+
+void test()
+{
+}
+
+#endif // defined(ASIO_HAS_MULTISHOT_RECEIVE)
+
+} // namespace ip_udp_socket_multishot_runtime
+
+//------------------------------------------------------------------------------
+
 // ip_udp_resolver_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public member functions on the class
@@ -667,7 +1105,11 @@ void test()
 ASIO_TEST_SUITE
 (
   "ip/udp",
+  ASIO_TEST_CASE(ip_udp_compile::test)
   ASIO_TEST_CASE(ip_udp_socket_compile::test)
   ASIO_TEST_CASE(ip_udp_socket_runtime::test)
+  ASIO_TEST_CASE(ip_udp_socket_batch_runtime::test)
+  ASIO_TEST_CASE(ip_udp_socket_segmented_runtime::test)
+  ASIO_TEST_CASE(ip_udp_socket_multishot_runtime::test)
   ASIO_TEST_CASE(ip_udp_resolver_compile::test)
 )
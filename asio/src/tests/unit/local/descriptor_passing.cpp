@@ -0,0 +1,311 @@
+//
+// descriptor_passing.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/local/descriptor_passing.hpp"
+
+#include <cstring>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
+#include "asio/read.hpp"
+#include "asio/write.hpp"
+#include "../unit_test.hpp"
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+# include <fcntl.h>
+# include <unistd.h>
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+using bindns::placeholders::_1;
+using bindns::placeholders::_2;
+
+void handle_transfer(const asio::error_code& err,
+    std::size_t bytes_transferred, asio::error_code* result_ec,
+    std::size_t* result)
+{
+  *result_ec = err;
+  *result = bytes_transferred;
+}
+
+//------------------------------------------------------------------------------
+
+// local_descriptor_passing_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all descriptor passing functions compile and
+// link correctly. Runtime failures are ignored.
+
+namespace local_descriptor_passing_compile {
+
+struct transfer_handler
+{
+  transfer_handler() {}
+  void operator()(const asio::error_code&, std::size_t) {}
+#if defined(ASIO_HAS_MOVE)
+  transfer_handler(transfer_handler&&) {}
+private:
+  transfer_handler(const transfer_handler&);
+#endif // defined(ASIO_HAS_MOVE)
+};
+
+void test()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  using namespace asio;
+  namespace local = asio::local;
+  typedef local::stream_protocol sp;
+
+  try
+  {
+    io_context ioc;
+    char mutable_char_buffer[128] = "";
+    const char const_char_buffer[128] = "";
+    int descriptors[4] = { 0, 1, 2, 3 };
+    std::size_t descriptor_count = 0;
+
+    sp::socket s1(ioc);
+    sp::socket s2(ioc);
+    ip::tcp::socket peer(ioc);
+
+    local::async_send_descriptors(s1, buffer(const_char_buffer),
+        descriptors, 1, transfer_handler());
+    local::async_send_descriptors(s1, buffer(mutable_char_buffer),
+        descriptors, 4, transfer_handler());
+
+    local::async_receive_descriptors(s2, buffer(mutable_char_buffer),
+        descriptors, 4, descriptor_count, transfer_handler());
+    local::async_receive_descriptors(s2, buffer(mutable_char_buffer),
+        peer, transfer_handler());
+  }
+  catch (std::exception&)
+  {
+  }
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+} // namespace local_descriptor_passing_compile
+
+//------------------------------------------------------------------------------
+
+// local_descriptor_passing_socket test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a connected socket is handed off to the peer
+// and assigned to a socket object.
+
+namespace local_descriptor_passing_socket {
+
+void test()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  using namespace std; // For memcmp.
+  using namespace asio;
+  namespace ip = asio::ip;
+  namespace local = asio::local;
+  typedef local::stream_protocol sp;
+
+  io_context ioc;
+
+  sp::socket sender(ioc);
+  sp::socket receiver(ioc);
+  local::connect_pair(sender, receiver);
+
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::socket client(ioc);
+  client.connect(acceptor.local_endpoint());
+  ip::tcp::socket connection(ioc);
+  acceptor.accept(connection);
+
+  int descriptor = connection.native_handle();
+  asio::error_code send_ec;
+  std::size_t bytes_sent = 0;
+  local::async_send_descriptors(sender, buffer("c", 1), &descriptor, 1,
+      bindns::bind(handle_transfer, _1, _2, &send_ec, &bytes_sent));
+
+  char tag = 0;
+  ip::tcp::socket peer(ioc);
+  asio::error_code receive_ec;
+  std::size_t bytes_received = 0;
+  local::async_receive_descriptors(receiver, buffer(&tag, 1), peer,
+      bindns::bind(handle_transfer, _1, _2, &receive_ec, &bytes_received));
+
+  ioc.run();
+
+  ASIO_CHECK(!send_ec);
+  ASIO_CHECK(bytes_sent == 1);
+  ASIO_CHECK(!receive_ec);
+  ASIO_CHECK(bytes_received == 1);
+  ASIO_CHECK(tag == 'c');
+  ASIO_CHECK(peer.is_open());
+  ASIO_CHECK(peer.local_endpoint() == connection.local_endpoint());
+
+  // The original may be closed once the handoff is complete.
+  connection.close();
+
+  const char msg[] = "0123456789";
+  write(peer, buffer(msg));
+  char recv_msg[sizeof(msg)];
+  read(client, buffer(recv_msg));
+  ASIO_CHECK(memcmp(recv_msg, msg, sizeof(msg)) == 0);
+
+  // A socket that is already open cannot receive another.
+  local::async_receive_descriptors(receiver, buffer(&tag, 1), peer,
+      bindns::bind(handle_transfer, _1, _2, &receive_ec, &bytes_received));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(receive_ec == asio::error::already_open);
+  ASIO_CHECK(bytes_received == 0);
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+} // namespace local_descriptor_passing_socket
+
+//------------------------------------------------------------------------------
+
+// local_descriptor_passing_array test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that descriptors are received into an array, that
+// those which do not fit are closed, and that end of file is reported.
+
+namespace local_descriptor_passing_array {
+
+void test()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  using namespace asio;
+  namespace local = asio::local;
+  typedef local::stream_protocol sp;
+
+  io_context ioc;
+
+  sp::socket sender(ioc);
+  sp::socket receiver(ioc);
+  local::connect_pair(sender, receiver);
+
+  int pipe1[2];
+  ASIO_CHECK(::pipe(pipe1) == 0);
+  int pipe2[2];
+  ASIO_CHECK(::pipe(pipe2) == 0);
+
+  int descriptors[3] = { pipe1[1], pipe2[1], pipe1[1] };
+  asio::error_code send_ec;
+  std::size_t bytes_sent = 0;
+  local::async_send_descriptors(sender, buffer("ab", 2), descriptors, 3,
+      bindns::bind(handle_transfer, _1, _2, &send_ec, &bytes_sent));
+
+  char data[8];
+  int received[2] = { -1, -1 };
+  std::size_t descriptor_count = 0;
+  asio::error_code receive_ec;
+  std::size_t bytes_received = 0;
+  local::async_receive_descriptors(receiver, buffer(data), received, 2,
+      descriptor_count,
+      bindns::bind(handle_transfer, _1, _2, &receive_ec, &bytes_received));
+
+  ioc.run();
+
+  ASIO_CHECK(!send_ec);
+  ASIO_CHECK(bytes_sent == 2);
+  ASIO_CHECK(!receive_ec);
+  ASIO_CHECK(bytes_received == 2);
+  ASIO_CHECK(descriptor_count == 2);
+
+  // The received descriptors refer to the write ends of the pipes.
+  ASIO_CHECK(::write(received[0], "x", 1) == 1);
+  ASIO_CHECK(::write(received[1], "y", 1) == 1);
+  char c = 0;
+  ASIO_CHECK(::read(pipe1[0], &c, 1) == 1 && c == 'x');
+  ASIO_CHECK(::read(pipe2[0], &c, 1) == 1 && c == 'y');
+#if defined(FD_CLOEXEC) && defined(MSG_CMSG_CLOEXEC)
+  ASIO_CHECK((::fcntl(received[0], F_GETFD) & FD_CLOEXEC) != 0);
+#endif // defined(FD_CLOEXEC) && defined(MSG_CMSG_CLOEXEC)
+
+  // Once all write ends are closed, the pipes report end of file. This
+  // checks that the third descriptor was closed rather than leaked.
+  ::close(received[0]);
+  ::close(received[1]);
+  ::close(pipe1[1]);
+  ::close(pipe2[1]);
+  ASIO_CHECK(::read(pipe1[0], &c, 1) == 0);
+  ASIO_CHECK(::read(pipe2[0], &c, 1) == 0);
+  ::close(pipe1[0]);
+  ::close(pipe2[0]);
+
+  // Descriptors cannot be passed without data.
+  local::async_send_descriptors(sender, buffer(data, 0), descriptors, 1,
+      bindns::bind(handle_transfer, _1, _2, &send_ec, &bytes_sent));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(send_ec == asio::error::invalid_argument);
+  ASIO_CHECK(bytes_sent == 0);
+
+  // Data may be sent without descriptors.
+  local::async_send_descriptors(sender, buffer("c", 1), descriptors, 0,
+      bindns::bind(handle_transfer, _1, _2, &send_ec, &bytes_sent));
+  local::async_receive_descriptors(receiver, buffer(data), received, 2,
+      descriptor_count,
+      bindns::bind(handle_transfer, _1, _2, &receive_ec, &bytes_received));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(!send_ec);
+  ASIO_CHECK(bytes_sent == 1);
+  ASIO_CHECK(!receive_ec);
+  ASIO_CHECK(bytes_received == 1);
+  ASIO_CHECK(data[0] == 'c');
+  ASIO_CHECK(descriptor_count == 0);
+
+  sender.close();
+  local::async_receive_descriptors(receiver, buffer(data), received, 2,
+      descriptor_count,
+      bindns::bind(handle_transfer, _1, _2, &receive_ec, &bytes_received));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(receive_ec == asio::error::eof);
+  ASIO_CHECK(bytes_received == 0);
+  ASIO_CHECK(descriptor_count == 0);
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+} // namespace local_descriptor_passing_array
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "local/descriptor_passing",
+  ASIO_TEST_CASE(local_descriptor_passing_compile::test)
+  ASIO_TEST_CASE(local_descriptor_passing_socket::test)
+  ASIO_TEST_CASE(local_descriptor_passing_array::test)
+)
@@ -0,0 +1,199 @@
+//
+// receive_metadata.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/receive_metadata.hpp"
+
+#include <cstring>
+#include "asio/io_context.hpp"
+#include "asio/ip/packet_info.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/ip/udp.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_RECEIVE_METADATA)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+using bindns::placeholders::_1;
+using bindns::placeholders::_2;
+
+void handle_receive(const asio::error_code& err,
+    std::size_t bytes_transferred, asio::error_code* result_ec,
+    std::size_t* result)
+{
+  *result_ec = err;
+  *result = bytes_transferred;
+}
+
+#endif // defined(ASIO_HAS_RECEIVE_METADATA)
+
+//------------------------------------------------------------------------------
+
+// receive_metadata_datagram test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the timestamp, destination address and
+// truncation flag are reported for a received datagram.
+
+namespace receive_metadata_datagram {
+
+void test()
+{
+#if defined(ASIO_HAS_RECEIVE_METADATA)
+  using namespace std; // For memcmp.
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+  asio::error_code ec;
+
+  ip::udp::socket s1(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket s2(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+
+  s2.set_option(socket_base::timestamp(true), ec);
+  bool have_timestamp = !ec;
+  s2.set_option(ip::packet_info(true), ec);
+  bool have_packet_info = !ec;
+
+  const char send_msg[] = "0123456789";
+  s1.send_to(buffer(send_msg), s2.local_endpoint());
+  s1.send_to(buffer(send_msg), s2.local_endpoint());
+
+  receive_metadata metadata;
+  ASIO_CHECK(metadata.flags() == 0);
+  ASIO_CHECK(!metadata.has_software_timestamp());
+  ASIO_CHECK(!metadata.has_hardware_timestamp());
+  ASIO_CHECK(!metadata.has_destination());
+
+  char recv_msg[32];
+  ip::udp::endpoint sender;
+  size_t bytes_received = 0;
+  s2.async_receive_from_with_metadata(buffer(recv_msg), sender, metadata,
+      bindns::bind(handle_receive, _1, _2, &ec, &bytes_received));
+
+  ioc.run();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(bytes_received == sizeof(send_msg));
+  ASIO_CHECK(memcmp(recv_msg, send_msg, sizeof(send_msg)) == 0);
+  ASIO_CHECK(sender == s1.local_endpoint());
+  ASIO_CHECK(!metadata.truncated());
+  ASIO_CHECK(!metadata.control_truncated());
+  ASIO_CHECK(metadata.has_software_timestamp() == have_timestamp);
+  if (have_timestamp)
+    ASIO_CHECK(metadata.software_timestamp() != 0);
+  ASIO_CHECK(metadata.has_destination() == have_packet_info);
+  if (have_packet_info)
+  {
+    ASIO_CHECK(metadata.destination_address() == ip::address_v4::loopback());
+    ASIO_CHECK(metadata.interface_index() != 0);
+  }
+
+  // A datagram larger than the buffer is truncated.
+  s2.connect(s1.local_endpoint());
+  s2.async_receive_with_metadata(buffer(recv_msg, 4), metadata,
+      bindns::bind(handle_receive, _1, _2, &ec, &bytes_received));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(bytes_received == 4);
+  ASIO_CHECK(metadata.truncated());
+#endif // defined(ASIO_HAS_RECEIVE_METADATA)
+}
+
+} // namespace receive_metadata_datagram
+
+//------------------------------------------------------------------------------
+
+// receive_metadata_stream test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that data and end of file are received on a
+// stream socket.
+
+namespace receive_metadata_stream {
+
+void test()
+{
+#if defined(ASIO_HAS_RECEIVE_METADATA)
+  using namespace std; // For memcmp.
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+  asio::error_code ec;
+
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::socket client(ioc);
+  client.connect(acceptor.local_endpoint());
+  ip::tcp::socket server(ioc);
+  acceptor.accept(server);
+
+  server.set_option(socket_base::timestamp(true), ec);
+  bool have_timestamp = !ec;
+
+  const char send_msg[] = "0123456789";
+  client.send(buffer(send_msg));
+
+  receive_metadata metadata;
+  char recv_msg[32];
+  size_t bytes_received = 0;
+  server.async_receive_with_metadata(buffer(recv_msg), metadata,
+      bindns::bind(handle_receive, _1, _2, &ec, &bytes_received));
+
+  ioc.run();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(bytes_received == sizeof(send_msg));
+  ASIO_CHECK(memcmp(recv_msg, send_msg, sizeof(send_msg)) == 0);
+  // A stream socket only reports a timestamp if the kernel stamped the
+  // segment on arrival, which it may not do for the first segments after
+  // timestamping is enabled.
+  ASIO_CHECK(have_timestamp || !metadata.has_software_timestamp());
+  ASIO_CHECK(!metadata.has_destination());
+
+  client.shutdown(socket_base::shutdown_send);
+  server.async_receive_with_metadata(buffer(recv_msg), metadata,
+      bindns::bind(handle_receive, _1, _2, &ec, &bytes_received));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(ec == asio::error::eof);
+  ASIO_CHECK(bytes_received == 0);
+#endif // defined(ASIO_HAS_RECEIVE_METADATA)
+}
+
+} // namespace receive_metadata_stream
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "receive_metadata",
+  ASIO_TEST_CASE(receive_metadata_datagram::test)
+  ASIO_TEST_CASE(receive_metadata_stream::test)
+)
@@ -0,0 +1,468 @@
+//
+// relay.cpp
+// ~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/relay.hpp"
+
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/read.hpp"
+#include "asio/thread.hpp"
+#include "asio/write.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+using bindns::placeholders::_1;
+using bindns::placeholders::_2;
+
+// A stream that forwards to a socket, but which async_relay cannot splice.
+class wrapped_stream
+{
+public:
+  typedef asio::ip::tcp::socket::executor_type executor_type;
+
+  explicit wrapped_stream(asio::ip::tcp::socket& socket)
+    : socket_(socket)
+  {
+  }
+
+  executor_type get_executor()
+  {
+    return socket_.get_executor();
+  }
+
+  template <typename MutableBufferSequence, typename ReadHandler>
+  void async_read_some(const MutableBufferSequence& buffers,
+      ASIO_MOVE_ARG(ReadHandler) handler)
+  {
+    socket_.async_read_some(buffers,
+        ASIO_MOVE_CAST(ReadHandler)(handler));
+  }
+
+  template <typename ConstBufferSequence, typename WriteHandler>
+  void async_write_some(const ConstBufferSequence& buffers,
+      ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    socket_.async_write_some(buffers,
+        ASIO_MOVE_CAST(WriteHandler)(handler));
+  }
+
+private:
+  asio::ip::tcp::socket& socket_;
+};
+
+// Two connected pairs of sockets. Data is written to the first pair's client,
+// relayed from the first pair's server to the second pair's client, and read
+// from the second pair's server.
+struct socket_pairs
+{
+  explicit socket_pairs(asio::io_context& ioc)
+    : acceptor(ioc, asio::ip::tcp::endpoint(
+          asio::ip::address_v4::loopback(), 0)),
+      writer(ioc),
+      source(ioc),
+      sink(ioc),
+      reader(ioc)
+  {
+    writer.connect(acceptor.local_endpoint());
+    acceptor.accept(source);
+    sink.connect(acceptor.local_endpoint());
+    acceptor.accept(reader);
+  }
+
+  asio::ip::tcp::acceptor acceptor;
+  asio::ip::tcp::socket writer;
+  asio::ip::tcp::socket source;
+  asio::ip::tcp::socket sink;
+  asio::ip::tcp::socket reader;
+};
+
+void handle_relay(const asio::error_code& err, std::size_t bytes_transferred,
+    std::size_t expected_bytes_transferred, bool* called)
+{
+  *called = true;
+  ASIO_CHECK(!err);
+  ASIO_CHECK(bytes_transferred == expected_bytes_transferred);
+}
+
+void handle_write(const asio::error_code& err,
+    asio::ip::tcp::socket* writer)
+{
+  ASIO_CHECK(!err);
+  asio::error_code ec;
+  writer->shutdown(asio::ip::tcp::socket::shutdown_send, ec);
+  ASIO_CHECK(!ec);
+}
+
+void handle_read(const asio::error_code& err, std::size_t bytes_transferred,
+    asio::error_code* result, std::size_t* result_bytes_transferred)
+{
+  *result = err;
+  *result_bytes_transferred = bytes_transferred;
+}
+
+//------------------------------------------------------------------------------
+
+// relay_splice test
+// ~~~~~~~~~~~~~~~~~
+// The following test checks that data is relayed between two sockets, and that
+// the end of file is propagated to the sink by shutting down its send side.
+
+namespace relay_splice {
+
+void test()
+{
+  asio::io_context ioc;
+  socket_pairs s(ioc);
+
+  const std::size_t length = 1024 * 1024 + 123;
+  std::vector<char> data(length);
+  for (std::size_t i = 0; i < length; ++i)
+    data[i] = static_cast<char>(i % 251);
+  std::vector<char> received(length + 1);
+
+  bool relayed = false;
+  asio::async_relay(s.source, s.sink,
+      bindns::bind(handle_relay, _1, _2, length, &relayed));
+
+  asio::async_write(s.writer, asio::buffer(data),
+      bindns::bind(handle_write, _1, &s.writer));
+
+  asio::error_code read_ec;
+  std::size_t read_length = 0;
+  asio::async_read(s.reader, asio::buffer(received),
+      bindns::bind(handle_read, _1, _2, &read_ec, &read_length));
+
+  ioc.run();
+
+  ASIO_CHECK(relayed);
+  ASIO_CHECK(read_ec == asio::error::eof);
+  ASIO_CHECK(read_length == length);
+  ASIO_CHECK(std::equal(data.begin(), data.end(), received.begin()));
+}
+
+} // namespace relay_splice
+
+//------------------------------------------------------------------------------
+
+// relay_copy test
+// ~~~~~~~~~~~~~~~
+// The following test checks that data is relayed by copying when the streams
+// cannot be spliced.
+
+namespace relay_copy {
+
+void test()
+{
+  asio::io_context ioc;
+  socket_pairs s(ioc);
+  wrapped_stream source(s.source);
+  wrapped_stream sink(s.sink);
+
+  const std::size_t length = 1024 * 1024 + 123;
+  std::vector<char> data(length);
+  for (std::size_t i = 0; i < length; ++i)
+    data[i] = static_cast<char>(i % 251);
+  std::vector<char> received(length);
+
+  bool relayed = false;
+  asio::async_relay(source, sink,
+      bindns::bind(handle_relay, _1, _2, length, &relayed));
+
+  asio::async_write(s.writer, asio::buffer(data),
+      bindns::bind(handle_write, _1, &s.writer));
+
+  // The wrapped sink is not a socket, so the end of file is not propagated.
+  asio::error_code read_ec;
+  std::size_t read_length = 0;
+  asio::async_read(s.reader, asio::buffer(received),
+      bindns::bind(handle_read, _1, _2, &read_ec, &read_length));
+
+  ioc.run();
+
+  ASIO_CHECK(relayed);
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(read_length == length);
+  ASIO_CHECK(std::equal(data.begin(), data.end(), received.begin()));
+}
+
+} // namespace relay_copy
+
+//------------------------------------------------------------------------------
+
+// relay_error test
+// ~~~~~~~~~~~~~~~~
+// The following test checks that the operation completes with an error when
+// the source is closed.
+
+namespace relay_error {
+
+void handle_relay_error(const asio::error_code& err,
+    std::size_t bytes_transferred, bool* called)
+{
+  *called = true;
+  ASIO_CHECK(err == asio::error::operation_aborted);
+  ASIO_CHECK(bytes_transferred == 0);
+}
+
+void test()
+{
+  asio::io_context ioc;
+  socket_pairs s(ioc);
+
+  bool relayed = false;
+  asio::async_relay(s.source, s.sink,
+      bindns::bind(handle_relay_error, _1, _2, &relayed));
+
+  ioc.poll();
+  ASIO_CHECK(!relayed);
+
+  s.source.close();
+  ioc.run();
+  ASIO_CHECK(relayed);
+
+  wrapped_stream source(s.sink);
+  wrapped_stream sink(s.writer);
+  relayed = false;
+  asio::async_relay(source, sink,
+      bindns::bind(handle_relay_error, _1, _2, &relayed));
+
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(!relayed);
+
+  s.sink.close();
+  ioc.run();
+  ASIO_CHECK(relayed);
+}
+
+} // namespace relay_error
+
+//------------------------------------------------------------------------------
+
+// relay_threads test
+// ~~~~~~~~~~~~~~~~~~
+// The following test checks that data is relayed by copying when the
+// io_context is run from several threads, and the handler is not bound to a
+// strand, so that the read and write handlers may run concurrently.
+
+namespace relay_threads {
+
+void io_context_run(asio::io_context* ioc)
+{
+  ioc->run();
+}
+
+void test()
+{
+  asio::io_context ioc;
+  socket_pairs s(ioc);
+  wrapped_stream source(s.source);
+  wrapped_stream sink(s.sink);
+
+  const std::size_t length = 8 * 1024 * 1024 + 123;
+  std::vector<char> data(length);
+  for (std::size_t i = 0; i < length; ++i)
+    data[i] = static_cast<char>(i % 251);
+  std::vector<char> received(length);
+
+  bool relayed = false;
+  asio::async_relay(source, sink,
+      bindns::bind(handle_relay, _1, _2, length, &relayed));
+
+  asio::async_write(s.writer, asio::buffer(data),
+      bindns::bind(handle_write, _1, &s.writer));
+
+  asio::error_code read_ec;
+  std::size_t read_length = 0;
+  asio::async_read(s.reader, asio::buffer(received),
+      bindns::bind(handle_read, _1, _2, &read_ec, &read_length));
+
+  asio::thread thread1(bindns::bind(io_context_run, &ioc));
+  asio::thread thread2(bindns::bind(io_context_run, &ioc));
+  asio::thread thread3(bindns::bind(io_context_run, &ioc));
+  ioc.run();
+  thread1.join();
+  thread2.join();
+  thread3.join();
+
+  ASIO_CHECK(relayed);
+  ASIO_CHECK(!read_ec);
+  ASIO_CHECK(read_length == length);
+  ASIO_CHECK(std::equal(data.begin(), data.end(), received.begin()));
+}
+
+} // namespace relay_threads
+
+//------------------------------------------------------------------------------
+
+// relay_custom_allocation test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the operation's memory is obtained from the
+// handler's associated allocator, and is returned once the operation ends.
+
+namespace relay_custom_allocation {
+
+struct custom_allocation_handler
+{
+  custom_allocation_handler(std::size_t expected_bytes_transferred,
+      bool* called, int* live_count, int* total_count)
+    : expected_bytes_transferred_(expected_bytes_transferred),
+      called_(called),
+      live_count_(live_count),
+      total_count_(total_count)
+  {
+  }
+
+  void operator()(const asio::error_code& err,
+      std::size_t bytes_transferred)
+  {
+    handle_relay(err, bytes_transferred,
+        expected_bytes_transferred_, called_);
+  }
+
+  template <typename T>
+  struct allocator
+  {
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind
+    {
+      typedef allocator<U> other;
+    };
+
+    explicit allocator(int* live_count, int* total_count) ASIO_NOEXCEPT
+      : live_count_(live_count),
+        total_count_(total_count)
+    {
+    }
+
+    template <typename U>
+    allocator(const allocator<U>& other) ASIO_NOEXCEPT
+      : live_count_(other.live_count_),
+        total_count_(other.total_count_)
+    {
+    }
+
+    pointer allocate(size_type n, const void* = 0)
+    {
+      ++(*live_count_);
+      ++(*total_count_);
+      return static_cast<T*>(::operator new(sizeof(T) * n));
+    }
+
+    void deallocate(pointer p, size_type)
+    {
+      --(*live_count_);
+      ::operator delete(p);
+    }
+
+    size_type max_size() const
+    {
+      return ~size_type(0);
+    }
+
+    void construct(pointer p, const T& v)
+    {
+      new (p) T(v);
+    }
+
+    void destroy(pointer p)
+    {
+      p->~T();
+    }
+
+    int* live_count_;
+    int* total_count_;
+  };
+
+  typedef allocator<int> allocator_type;
+
+  allocator_type get_allocator() const ASIO_NOEXCEPT
+  {
+    return allocator_type(live_count_, total_count_);
+  }
+
+  std::size_t expected_bytes_transferred_;
+  bool* called_;
+  int* live_count_;
+  int* total_count_;
+};
+
+void test()
+{
+  asio::io_context ioc;
+  socket_pairs s(ioc);
+  wrapped_stream source(s.source);
+  wrapped_stream sink(s.sink);
+
+  const char data[] = "relayed data";
+  const std::size_t length = sizeof(data);
+  char received[sizeof(data)];
+
+  bool relayed = false;
+  int live_count = 0;
+  int total_count = 0;
+  asio::async_relay(source, sink, custom_allocation_handler(
+        length, &relayed, &live_count, &total_count));
+  ASIO_CHECK(live_count > 0);
+
+  asio::write(s.writer, asio::buffer(data));
+  s.writer.shutdown(asio::ip::tcp::socket::shutdown_send);
+
+  asio::error_code read_ec;
+  std::size_t read_length = 0;
+  asio::async_read(s.reader, asio::buffer(received),
+      bindns::bind(handle_read, _1, _2, &read_ec, &read_length));
+
+  ioc.run();
+
+  ASIO_CHECK(relayed);
+  ASIO_CHECK(read_length == length);
+  ASIO_CHECK(total_count > 0);
+  ASIO_CHECK(live_count == 0);
+}
+
+} // namespace relay_custom_allocation
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "relay",
+  ASIO_TEST_CASE(relay_splice::test)
+  ASIO_TEST_CASE(relay_copy::test)
+  ASIO_TEST_CASE(relay_error::test)
+  ASIO_TEST_CASE(relay_threads::test)
+  ASIO_TEST_CASE(relay_custom_allocation::test)
+)
@@ -177,6 +177,26 @@ void test()
     (void)static_cast<bool>(!enable_connection_aborted1);
     (void)static_cast<bool>(enable_connection_aborted1.value());
 
+    // timestamp class.
+
+    socket_base::timestamp timestamp1(true);
+    sock.set_option(timestamp1);
+    socket_base::timestamp timestamp2;
+    sock.get_option(timestamp2);
+    timestamp1 = true;
+    (void)static_cast<bool>(timestamp1);
+    (void)static_cast<bool>(!timestamp1);
+    (void)static_cast<bool>(timestamp1.value());
+
+    // timestamping class.
+
+    socket_base::timestamping timestamping1(0);
+    sock.set_option(timestamping1);
+    socket_base::timestamping timestamping2;
+    sock.get_option(timestamping2);
+    timestamping1 = 0;
+    (void)static_cast<int>(timestamping1.value());
+
     // bytes_readable class.
 
     socket_base::bytes_readable bytes_readable;
@@ -25,6 +25,8 @@
 
 #if defined(ASIO_HAS_STD_CHRONO)
 
+#include "asio/bind_cancellation_slot.hpp"
+#include "asio/cancellation_signal.hpp"
 #include "asio/executor_work_guard.hpp"
 #include "asio/io_context.hpp"
 #include "asio/thread.hpp"
@@ -69,6 +71,11 @@ void increment_if_not_cancelled(int* count,
     ++(*count);
 }
 
+void record_error(asio::error_code* result, const asio::error_code& ec)
+{
+  *result = ec;
+}
+
 void cancel_timer(asio::system_timer* t)
 {
   std::size_t num_cancelled = t->cancel();
@@ -265,6 +272,74 @@ void system_timer_cancel_test()
     ASIO_CHECK(timers[i].t.cancel() == 1);
 }
 
+void system_timer_cancellation_slot_test()
+{
+  using bindns::placeholders::_1;
+
+  asio::io_context ioc;
+  asio::system_timer t(ioc, asio::chrono::milliseconds(50));
+
+  asio::cancellation_signal signal;
+  asio::error_code ec1 = asio::error::would_block;
+  asio::error_code ec2 = asio::error::would_block;
+  t.async_wait(bindns::bind(record_error, &ec1, _1));
+  t.async_wait(asio::bind_cancellation_slot(signal.slot(),
+        bindns::bind(record_error, &ec2, _1)));
+
+  // Emitting the signal cancels only the second wait.
+  ioc.poll();
+  ASIO_CHECK(ec1 == asio::error::would_block);
+  ASIO_CHECK(ec2 == asio::error::would_block);
+  signal.emit();
+  ioc.poll();
+  ASIO_CHECK(ec1 == asio::error::would_block);
+  ASIO_CHECK(ec2 == asio::error::operation_aborted);
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(!ec1);
+
+  // Emitting the signal after the operation has completed has no effect.
+  ASIO_CHECK(!signal.slot().has_handler());
+  signal.emit();
+  ioc.restart();
+  ASIO_CHECK(ioc.poll() == 0);
+
+  // The slot may be reused as soon as the signal has been emitted, before the
+  // cancelled operation's handler has run.
+  ec1 = asio::error::would_block;
+  ec2 = asio::error::would_block;
+  t.expires_after(asio::chrono::seconds(10));
+  t.async_wait(asio::bind_cancellation_slot(signal.slot(),
+        bindns::bind(record_error, &ec1, _1)));
+  signal.emit();
+  t.async_wait(asio::bind_cancellation_slot(signal.slot(),
+        bindns::bind(record_error, &ec2, _1)));
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(ec1 == asio::error::operation_aborted);
+  ASIO_CHECK(ec2 == asio::error::would_block);
+  ASIO_CHECK(signal.slot().has_handler());
+  signal.emit();
+  ioc.run();
+  ASIO_CHECK(ec2 == asio::error::operation_aborted);
+
+  // Destroying the timer removes the handler of a pending wait from the slot,
+  // so the signal may still be emitted.
+  ec2 = asio::error::would_block;
+  {
+    asio::system_timer t2(ioc, asio::chrono::seconds(10));
+    t2.async_wait(asio::bind_cancellation_slot(signal.slot(),
+          bindns::bind(record_error, &ec2, _1)));
+    ASIO_CHECK(signal.slot().has_handler());
+  }
+  ASIO_CHECK(!signal.slot().has_handler());
+  signal.emit();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(ec2 == asio::error::operation_aborted);
+}
+
 struct custom_allocation_timer_handler
 {
   custom_allocation_timer_handler(int* count) : count_(count) {}
@@ -471,6 +546,7 @@ ASIO_TEST_SUITE
   "system_timer",
   ASIO_TEST_CASE(system_timer_test)
   ASIO_TEST_CASE(system_timer_cancel_test)
+  ASIO_TEST_CASE(system_timer_cancellation_slot_test)
   ASIO_TEST_CASE(system_timer_custom_allocation_test)
   ASIO_TEST_CASE(system_timer_thread_test)
   ASIO_TEST_CASE(system_timer_move_test)
@@ -49,7 +49,8 @@ public:
     : io_context_(io_context),
       length_(max_length),
       position_(0),
-      next_write_length_(max_length)
+      next_write_length_(max_length),
+      write_count_(0)
   {
     memset(data_, 0, max_length);
   }
@@ -67,6 +68,7 @@ public:
     length_ = length;
     position_ = 0;
     next_write_length_ = length;
+    write_count_ = 0;
   }
 
   void next_write_length(size_t length)
@@ -74,6 +76,11 @@ public:
     next_write_length_ = length;
   }
 
+  size_t write_count() const
+  {
+    return write_count_;
+  }
+
   template <typename Iterator>
   bool check_buffers(Iterator begin, Iterator end, size_t length)
   {
@@ -109,6 +116,7 @@ public:
         asio::buffer(data_, length_) + position_,
         buffers, next_write_length_);
     position_ += n;
+    ++write_count_;
     return n;
   }
 
@@ -137,6 +145,7 @@ private:
   size_t length_;
   size_t position_;
   size_t next_write_length_;
+  size_t write_count_;
 };
 
 static const char write_data[]
@@ -231,6 +240,34 @@ void test_2_arg_vector_buffers_write()
   ASIO_CHECK(s.check_buffers(buffers, sizeof(write_data)));
 }
 
+void test_2_arg_long_vector_buffers_write()
+{
+  asio::io_context ioc;
+  test_stream s(ioc);
+  std::vector<asio::const_buffer> buffers;
+  for (size_t i = 0; i < 1000; ++i)
+    buffers.push_back(asio::buffer(write_data + i % 52, 1));
+
+  // A long sequence is written using as few operations as the platform's
+  // limit on the number of buffers per operation allows.
+  const size_t max_buffers =
+    asio::detail::buffer_sequence_adapter_base::max_buffers;
+  const size_t min_writes = (buffers.size() + max_buffers - 1) / max_buffers;
+
+  s.reset();
+  size_t bytes_transferred = asio::write(s, buffers);
+  ASIO_CHECK(bytes_transferred == buffers.size());
+  ASIO_CHECK(s.check_buffers(buffers, buffers.size()));
+  ASIO_CHECK(s.write_count() == min_writes);
+
+  s.reset();
+  s.next_write_length(10);
+  bytes_transferred = asio::write(s, buffers);
+  ASIO_CHECK(bytes_transferred == buffers.size());
+  ASIO_CHECK(s.check_buffers(buffers, buffers.size()));
+  ASIO_CHECK(s.write_count() == buffers.size() / 10);
+}
+
 void test_2_arg_dynamic_string_write()
 {
   asio::io_context ioc;
@@ -2454,6 +2491,50 @@ void test_3_arg_vector_buffers_async_write()
   ASIO_CHECK(s.check_buffers(buffers, sizeof(write_data)));
 }
 
+void test_3_arg_long_vector_buffers_async_write()
+{
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  asio::io_context ioc;
+  test_stream s(ioc);
+  std::vector<asio::const_buffer> buffers;
+  for (size_t i = 0; i < 1000; ++i)
+    buffers.push_back(asio::buffer(write_data + i % 52, 1));
+
+  const size_t max_buffers =
+    asio::detail::buffer_sequence_adapter_base::max_buffers;
+  const size_t min_writes = (buffers.size() + max_buffers - 1) / max_buffers;
+
+  s.reset();
+  bool called = false;
+  asio::async_write(s, buffers,
+      bindns::bind(async_write_handler,
+        _1, _2, buffers.size(), &called));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(s.check_buffers(buffers, buffers.size()));
+  ASIO_CHECK(s.write_count() == min_writes);
+
+  s.reset();
+  s.next_write_length(10);
+  called = false;
+  asio::async_write(s, buffers,
+      bindns::bind(async_write_handler,
+        _1, _2, buffers.size(), &called));
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(called);
+  ASIO_CHECK(s.check_buffers(buffers, buffers.size()));
+  ASIO_CHECK(s.write_count() == buffers.size() / 10);
+}
+
 void test_3_arg_dynamic_string_async_write()
 {
 #if defined(ASIO_HAS_BOOST_BIND)
@@ -4873,6 +4954,7 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(test_2_arg_const_buffer_write)
   ASIO_TEST_CASE(test_2_arg_mutable_buffer_write)
   ASIO_TEST_CASE(test_2_arg_vector_buffers_write)
+  ASIO_TEST_CASE(test_2_arg_long_vector_buffers_write)
   ASIO_TEST_CASE(test_2_arg_dynamic_string_write)
   ASIO_TEST_CASE(test_3_arg_nothrow_zero_buffers_write)
   ASIO_TEST_CASE(test_3_arg_nothrow_const_buffer_write)
@@ -4892,6 +4974,7 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(test_3_arg_boost_array_buffers_async_write)
   ASIO_TEST_CASE(test_3_arg_std_array_buffers_async_write)
   ASIO_TEST_CASE(test_3_arg_vector_buffers_async_write)
+  ASIO_TEST_CASE(test_3_arg_long_vector_buffers_async_write)
   ASIO_TEST_CASE(test_3_arg_dynamic_string_async_write)
   ASIO_TEST_CASE(test_3_arg_streambuf_async_write)
   ASIO_TEST_CASE(test_4_arg_const_buffer_async_write)
@@ -0,0 +1,246 @@
+//
+// write_queue.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2020 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/write_queue.hpp"
+
+#include <cstring>
+#include <vector>
+#include "asio/io_context.hpp"
+#include "asio/ip/tcp.hpp"
+#include "asio/read.hpp"
+#include "archetypes/async_result.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+using bindns::placeholders::_1;
+using bindns::placeholders::_2;
+
+// A socket wrapper that records each send made through it.
+class counting_socket
+{
+public:
+  typedef asio::ip::tcp::socket::executor_type executor_type;
+
+  explicit counting_socket(asio::ip::tcp::socket& socket)
+    : socket_(socket)
+  {
+  }
+
+  executor_type get_executor()
+  {
+    return socket_.get_executor();
+  }
+
+  template <typename ConstBufferSequence, typename WriteHandler>
+  void async_send(const ConstBufferSequence& buffers,
+      asio::socket_base::message_flags flags,
+      ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    send_sizes.push_back(asio::buffer_size(buffers));
+    send_flags.push_back(flags);
+    socket_.async_send(buffers, flags,
+        ASIO_MOVE_CAST(WriteHandler)(handler));
+  }
+
+  std::vector<std::size_t> send_sizes;
+  std::vector<asio::socket_base::message_flags> send_flags;
+
+private:
+  asio::ip::tcp::socket& socket_;
+};
+
+void handle_write(const asio::error_code& err, std::size_t bytes_transferred,
+    std::vector<std::size_t>* completed, asio::error_code* result_ec)
+{
+  if (err)
+    *result_ec = err;
+  completed->push_back(bytes_transferred);
+}
+
+//------------------------------------------------------------------------------
+
+// write_queue_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// write_queue compile and link correctly. Runtime failures are ignored.
+
+namespace write_queue_compile {
+
+void write_some_handler(const asio::error_code&, std::size_t)
+{
+}
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  try
+  {
+    io_context ioc;
+    char mutable_char_buffer[128] = "";
+    const char const_char_buffer[128] = "";
+    std::vector<const_buffer> const_buffers(2, buffer(const_char_buffer));
+    archetypes::lazy_handler lazy;
+
+    ip::tcp::socket socket1(ioc);
+    write_queue<ip::tcp::socket&> queue1(socket1);
+
+    ip::tcp::socket& next_layer = queue1.next_layer();
+    (void)next_layer;
+
+    write_queue<ip::tcp::socket&>::executor_type ex = queue1.get_executor();
+    (void)ex;
+
+    std::size_t pending = queue1.pending_writes();
+    (void)pending;
+
+    queue1.async_write(buffer(mutable_char_buffer), &write_some_handler);
+    queue1.async_write(buffer(const_char_buffer), &write_some_handler);
+    queue1.async_write(const_buffers, &write_some_handler);
+    int i1 = queue1.async_write(buffer(const_char_buffer), lazy);
+    (void)i1;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace write_queue_compile
+
+//------------------------------------------------------------------------------
+
+// write_queue_gather test
+// ~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that writes started while a send is in progress
+// are gathered into a single send, and that each write completes once all of
+// its data has been sent.
+
+namespace write_queue_gather {
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::socket client(ioc);
+  client.connect(acceptor.local_endpoint());
+  ip::tcp::socket server(ioc);
+  acceptor.accept(server);
+
+  counting_socket counter(client);
+  write_queue<counting_socket&> queue(counter);
+
+  // More writes than can be gathered into a single send.
+  const std::size_t count = 200;
+  std::vector<std::vector<char> > messages(count);
+  std::vector<char> expected;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    messages[i].assign(i % 17 + 1, static_cast<char>(i));
+    expected.insert(expected.end(), messages[i].begin(), messages[i].end());
+  }
+
+  std::vector<std::size_t> completed;
+  asio::error_code ec;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    std::vector<const_buffer> buffers;
+    buffers.push_back(buffer(messages[i].data(), 1));
+    buffers.push_back(buffer(messages[i]) + 1);
+    queue.async_write(buffers,
+        bindns::bind(handle_write, _1, _2, &completed, &ec));
+  }
+
+  ASIO_CHECK(queue.pending_writes() == count);
+  ASIO_CHECK(counter.send_sizes.size() == 1);
+  ASIO_CHECK(counter.send_sizes[0] == messages[0].size());
+
+  ioc.run();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(queue.pending_writes() == 0);
+  ASIO_CHECK(completed.size() == count);
+  for (std::size_t i = 0; i < completed.size() && i < count; ++i)
+    ASIO_CHECK(completed[i] == messages[i].size());
+
+  // The first write is sent alone, and the rest are gathered.
+  ASIO_CHECK(counter.send_sizes.size() > 2);
+  ASIO_CHECK(counter.send_sizes.size() < count / 2);
+
+  std::vector<char> received(expected.size());
+  asio::read(server, buffer(received));
+  ASIO_CHECK(received == expected);
+}
+
+} // namespace write_queue_gather
+
+//------------------------------------------------------------------------------
+
+// write_queue_error test
+// ~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a failed send fails all queued writes.
+
+namespace write_queue_error {
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+  ip::tcp::socket socket(ioc);
+  write_queue<ip::tcp::socket&> queue(socket);
+
+  const char data[] = "data";
+  std::vector<std::size_t> completed;
+  asio::error_code ec;
+  queue.async_write(buffer(data),
+      bindns::bind(handle_write, _1, _2, &completed, &ec));
+  queue.async_write(buffer(data),
+      bindns::bind(handle_write, _1, _2, &completed, &ec));
+
+  ioc.run();
+
+  ASIO_CHECK(!!ec);
+  ASIO_CHECK(completed.size() == 2);
+  ASIO_CHECK(queue.pending_writes() == 0);
+}
+
+} // namespace write_queue_error
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "write_queue",
+  ASIO_COMPILE_TEST_CASE(write_queue_compile::test)
+  ASIO_TEST_CASE(write_queue_gather::test)
+  ASIO_TEST_CASE(write_queue_error::test)
+)